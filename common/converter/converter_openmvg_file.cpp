@@ -3,6 +3,7 @@
 #include <sstream>
 #include <filesystem>
 #include <iostream>
+#include <cmath>
 #include <cstring>
 #include <nlohmann/json.hpp> // 需要添加这个第三方库来解析JSON | Need to add this third-party library for JSON parsing
 #include <po_core/po_logger.hpp>
@@ -140,8 +141,10 @@ namespace PoSDK
                 // Try to read optional scale and orientation (if present) | 尝试读取可选的尺度和方向（如果存在）
                 if (iss >> scale >> orientation)
                 {
-                    // SIOPointFeature format | SIOPointFeature格式
-                    image_features.AddFeature(Feature(x, y), scale, orientation);
+                    // SIOPointFeature format, orientation stored in degrees like cv::KeyPoint::angle
+                    // SIOPointFeature格式，方向按cv::KeyPoint::angle约定以度存储
+                    constexpr double kRadToDeg = 57.29577951308232; // 180/pi
+                    image_features.AddFeature(Feature(x, y), scale, orientation * static_cast<float>(kRadToDeg));
                 }
                 else
                 {
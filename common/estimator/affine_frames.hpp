@@ -0,0 +1,66 @@
+/**
+ * @file affine_frames.hpp
+ * @brief Local affine frames of feature matches for the affine-correspondence solvers | 仿射对应求解器使用的匹配局部仿射
+ * @details Features carry scale and orientation (cv::KeyPoint size/angle, OpenMVG SIOPointFeature), which
+ *          give a similarity approximation of the local affine transformation between the two views.
+ *          特征携带尺度和方向（cv::KeyPoint的size/angle、OpenMVG SIOPointFeature），由此得到两视图间
+ *          局部仿射变换的相似变换近似。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include "minimal_solvers.hpp"
+#include <po_core/types.hpp>
+
+namespace common
+{
+    /**
+     * @brief Build per-match affine frames aligned with types::MatchesToBearingPairs
+     *        构建与types::MatchesToBearingPairs对齐的逐匹配仿射
+     * @param matches Matches of the view pair (IdMatches or DataSample<IdMatches>) | 视图对匹配
+     * @param features_info Features with scale/orientation | 带尺度/方向的特征
+     * @param camera_models Camera models (focal lengths map pixels to normalized coordinates) | 相机模型
+     * @param view_pair View pair | 视图对
+     * @param frames Output frames, one per match | 输出的逐匹配仿射
+     * @return false if a camera is missing or a matched feature has no scale | 相机缺失或匹配特征无尺度时返回false
+     */
+    template <typename MatchContainer>
+    inline bool MatchesToAffineFrames(const MatchContainer &matches,
+                                      const PoSDK::types::FeaturesInfo &features_info,
+                                      const PoSDK::types::CameraModels &camera_models,
+                                      const PoSDK::types::ViewPair &view_pair,
+                                      minimal::AffineFrames &frames)
+    {
+        frames.clear();
+        const PoSDK::types::CameraModel *camera_i = camera_models[view_pair.first];
+        const PoSDK::types::CameraModel *camera_j = camera_models[view_pair.second];
+        if (!camera_i || !camera_j)
+            return false;
+
+        const auto &intrinsics_i = camera_i->GetIntrinsics();
+        const auto &intrinsics_j = camera_j->GetIntrinsics();
+        const auto &points_i = features_info[view_pair.first]->GetFeaturePoints();
+        const auto &points_j = features_info[view_pair.second]->GetFeaturePoints();
+
+        frames.reserve(matches.size());
+        for (const auto &match : matches)
+        {
+            const double size_i = points_i.GetSize(match.i);
+            const double size_j = points_j.GetSize(match.j);
+            // Point-only features (e.g. OpenMVG PointFeature) have no usable frame | 仅含坐标的特征无可用仿射
+            if (!(size_i > 0.0) || !(size_j > 0.0))
+            {
+                frames.clear();
+                return false;
+            }
+            frames.push_back(minimal::SimilarityFrame(size_i, points_i.GetAngle(match.i),
+                                                      size_j, points_j.GetAngle(match.j),
+                                                      intrinsics_i.GetFx(), intrinsics_i.GetFy(),
+                                                      intrinsics_j.GetFx(), intrinsics_j.GetFy()));
+        }
+        return true;
+    }
+
+} // namespace common
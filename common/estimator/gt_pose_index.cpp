@@ -0,0 +1,79 @@
+/**
+ * @file gt_pose_index.cpp
+ * @brief Indexed ground-truth relative pose lookup | 带索引的真值相对位姿查询
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#include "gt_pose_index.hpp"
+#include <algorithm>
+
+namespace common
+{
+    using namespace PoSDK::types;
+
+    void GTRelativePoseIndex::Reset(const RelativePoses *source)
+    {
+        source_ = source;
+        entries_.clear();
+        {
+            std::lock_guard<std::mutex> lock(derived_mutex_);
+            derived_.clear();
+        }
+        if (!source_)
+        {
+            return;
+        }
+
+        entries_.reserve(source_->size());
+        for (const auto &pose : *source_)
+        {
+            entries_.push_back({Key(pose.GetViewIdI(), pose.GetViewIdJ()), pose.GetRotation(), pose.GetTranslation()});
+        }
+        // Keep the first pose of duplicated pairs, as a linear scan would | 重复视图对保留第一个，与线性扫描一致
+        std::stable_sort(entries_.begin(), entries_.end(),
+                         [](const Entry &a, const Entry &b)
+                         { return a.key < b.key; });
+        entries_.erase(std::unique(entries_.begin(), entries_.end(),
+                                   [](const Entry &a, const Entry &b)
+                                   { return a.key == b.key; }),
+                       entries_.end());
+    }
+
+    bool GTRelativePoseIndex::Find(const ViewPair &view_pair, Matrix3d &R, Vector3d &t) const
+    {
+        if (!source_)
+        {
+            return false;
+        }
+
+        const uint64_t key = Key(view_pair.first, view_pair.second);
+        auto it = std::lower_bound(entries_.begin(), entries_.end(), key,
+                                   [](const Entry &entry, uint64_t value)
+                                   { return entry.key < value; });
+        if (it != entries_.end() && it->key == key)
+        {
+            R = it->R;
+            t = it->t;
+            return true;
+        }
+
+        // Not stored under this key: resolve once through the container and cache
+        // 未以该键存储：经容器求一次并缓存
+        std::lock_guard<std::mutex> lock(derived_mutex_);
+        auto derived_it = derived_.find(key);
+        if (derived_it == derived_.end())
+        {
+            DerivedPose derived;
+            derived.found = source_->GetRelativePose(view_pair, derived.R, derived.t);
+            derived_it = derived_.emplace(key, derived).first;
+        }
+        if (!derived_it->second.found)
+        {
+            return false;
+        }
+        R = derived_it->second.R;
+        t = derived_it->second.t;
+        return true;
+    }
+
+} // namespace common
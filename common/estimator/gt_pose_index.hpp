@@ -0,0 +1,78 @@
+/**
+ * @file gt_pose_index.hpp
+ * @brief Indexed ground-truth relative pose lookup | 带索引的真值相对位姿查询
+ * @details Per-pair evaluation needs the GT relative pose of every estimated view pair. Looking
+ *          each pair up in the GT container scans the pose list, which makes evaluation O(P^2)
+ *          over P pairs. The index is built once per GT container as a sorted flat array keyed
+ *          by (view_i, view_j); pairs stored under another key (e.g. reversed) are resolved once
+ *          through RelativePoses::GetRelativePose() and cached.
+ *          逐对评估需要每个估计视图对的真值相对位姿。逐对在真值容器中查找需要线性扫描，P个视图对的
+ *          评估代价为O(P^2)。本索引对每个真值容器只构建一次（按(view_i, view_j)排序的扁平数组）；
+ *          以其他键存储的视图对（如反向）首次查询时经RelativePoses::GetRelativePose()求得并缓存。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <po_core/types.hpp>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace common
+{
+    /**
+     * @brief Sorted flat index over a GT RelativePoses container | 真值RelativePoses的排序扁平索引
+     * @note Find() is thread-safe once Reset() returned | Reset()返回后Find()线程安全
+     */
+    class GTRelativePoseIndex
+    {
+    public:
+        /**
+         * @brief (Re)build the index for a GT container | 为真值容器（重新）建立索引
+         * @param source GT relative poses, must outlive the index; nullptr clears it
+         *               真值相对位姿，生命周期须长于索引；nullptr清空索引
+         */
+        void Reset(const PoSDK::types::RelativePoses *source);
+
+        /**
+         * @brief GT relative pose of a view pair, as returned by RelativePoses::GetRelativePose()
+         *        视图对的真值相对位姿，与RelativePoses::GetRelativePose()的返回一致
+         */
+        bool Find(const PoSDK::types::ViewPair &view_pair,
+                  PoSDK::types::Matrix3d &R, PoSDK::types::Vector3d &t) const;
+
+        bool Empty() const { return source_ == nullptr; }
+        size_t Size() const { return entries_.size(); }
+
+    private:
+        struct Entry
+        {
+            uint64_t key = 0;
+            PoSDK::types::Matrix3d R;
+            PoSDK::types::Vector3d t;
+        };
+
+        struct DerivedPose
+        {
+            bool found = false;
+            PoSDK::types::Matrix3d R;
+            PoSDK::types::Vector3d t;
+        };
+
+        static uint64_t Key(PoSDK::types::IndexT view_i, PoSDK::types::IndexT view_j)
+        {
+            return (static_cast<uint64_t>(view_i) << 32) | static_cast<uint64_t>(view_j);
+        }
+
+        const PoSDK::types::RelativePoses *source_ = nullptr;
+        std::vector<Entry> entries_;
+
+        // Pairs resolved through the container, including misses | 经容器求得的视图对（含未找到的）
+        mutable std::mutex derived_mutex_;
+        mutable std::unordered_map<uint64_t, DerivedPose> derived_;
+    };
+
+} // namespace common
@@ -0,0 +1,428 @@
+/**
+ * @file minimal_ransac.hpp
+ * @brief RANSAC over PoSDK bearing pairs with the native minimal solvers | 基于原生最小求解器的BearingPairs RANSAC
+ * @details The solver is a compile-time parameter, so sampling, model generation and scoring are
+ *          specialised per sample size without virtual calls or adapter conversion.
+ *          求解器为编译期参数，采样、模型生成和评分按样本数特化，无虚函数调用和适配器转换。
+ *
+ *          Hypothesis scoring runs on structure-of-arrays bearings, optionally in float32 (twice the SIMD
+ *          width, half the memory traffic); minimal solvers, least-squares refits and the final pose stay double.
+ *          假设评分在SoA布局的射线上进行，可选float32（SIMD宽度加倍、内存流量减半）；
+ *          最小求解器、最小二乘重拟合和最终位姿保持double。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include "minimal_solvers.hpp"
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace common
+{
+    namespace minimal
+    {
+        /**
+         * @brief Precision of the inlier scoring | 内点评分精度
+         */
+        enum class ScoringPrecision
+        {
+            Double,
+            Float
+        };
+
+        /**
+         * @brief Native RANSAC options | 原生RANSAC参数
+         */
+        struct NativeRansacOptions
+        {
+            // Inlier threshold on AngularEpipolarError (~ 1 - cos, OpenGV units) | 内点阈值（约为1 - cos，与OpenGV一致）
+            double threshold = 1e-6;
+            size_t max_iterations = 1000;
+            double confidence = 0.99;
+            uint32_t seed = 0;
+            // Known rotation for TwoPointSolver (xj ~ R xi + t) | TwoPointSolver使用的已知旋转
+            bool has_prior_rotation = false;
+            Mat3<double> prior_rotation = Mat3<double>::Identity();
+            // Local affine frames aligned with the bearing pairs, for TwoAffineSolver | TwoAffineSolver使用的局部仿射（与bearing pairs对齐）
+            const AffineFrames *affine_frames = nullptr;
+            // Scoring precision (solvers and refits are always double) | 评分精度（求解器和重拟合始终为double）
+            ScoringPrecision scoring_precision = ScoringPrecision::Double;
+        };
+
+        /**
+         * @brief Native RANSAC result, pose in the PoSDK convention xj ~ R xi + t | 原生RANSAC结果（PoSDK约定）
+         */
+        struct NativeRansacResult
+        {
+            bool success = false;
+            PoseSolution<double> pose;
+            std::vector<int> inliers;
+            size_t iterations = 0;
+        };
+
+        /**
+         * @brief Vectorised AngularEpipolarError inlier test over structure-of-arrays bearings
+         *        基于SoA射线的向量化AngularEpipolarError内点判定
+         * @details The test 0.5 r^2 (n1 + n2) < threshold n1 n2 is the division-free form of
+         *          AngularEpipolarError < threshold. Columns are processed in cache-sized blocks.
+         *          0.5 r^2 (n1 + n2) < threshold n1 n2 为AngularEpipolarError < threshold的无除法形式，按缓存大小分块处理。
+         */
+        template <typename Scalar>
+        class EpipolarScorer
+        {
+        public:
+            static constexpr int kBlock = 256;
+            using Points = Eigen::Matrix<Scalar, 3, Eigen::Dynamic>;
+            using Row = Eigen::Array<Scalar, 1, Eigen::Dynamic>;
+
+            explicit EpipolarScorer(const PoSDK::types::BearingPairs &pairs)
+                : xi_(3, pairs.size()), xj_(3, pairs.size()), norm_i_(pairs.size()), norm_j_(pairs.size()),
+                  exi_(3, kBlock), etxj_(3, kBlock)
+            {
+                for (size_t p = 0; p < pairs.size(); ++p)
+                {
+                    xi_.col(p) = pairs[p].template head<3>().template cast<Scalar>();
+                    xj_.col(p) = pairs[p].template tail<3>().template cast<Scalar>();
+                }
+                norm_i_ = xi_.colwise().squaredNorm().array();
+                norm_j_ = xj_.colwise().squaredNorm().array();
+            }
+
+            size_t size() const { return static_cast<size_t>(xi_.cols()); }
+
+            size_t Count(const Mat3<double> &E, double threshold) const
+            {
+                size_t count = 0;
+                Visit(E, threshold, [&](Eigen::Index begin, const auto &mask)
+                      { count += mask.count(); (void)begin; });
+                return count;
+            }
+
+            void Collect(const Mat3<double> &E, double threshold, std::vector<size_t> &indices) const
+            {
+                indices.clear();
+                Visit(E, threshold, [&](Eigen::Index begin, const auto &mask)
+                      {
+                          for (Eigen::Index k = 0; k < mask.size(); ++k)
+                              if (mask(k))
+                                  indices.push_back(static_cast<size_t>(begin + k)); });
+            }
+
+        private:
+            template <typename Visitor>
+            void Visit(const Mat3<double> &E_double, double threshold_double, Visitor &&visitor) const
+            {
+                const Mat3<Scalar> E = E_double.template cast<Scalar>();
+                const Mat3<Scalar> Et = E.transpose();
+                const Scalar threshold = static_cast<Scalar>(threshold_double);
+                const Eigen::Index total = xi_.cols();
+                for (Eigen::Index begin = 0; begin < total; begin += kBlock)
+                {
+                    const Eigen::Index n = std::min<Eigen::Index>(kBlock, total - begin);
+                    exi_.leftCols(n).noalias() = E * xi_.middleCols(begin, n);
+                    etxj_.leftCols(n).noalias() = Et * xj_.middleCols(begin, n);
+                    const Row r = xj_.middleCols(begin, n).cwiseProduct(exi_.leftCols(n)).colwise().sum().array();
+                    const Row n1 = exi_.leftCols(n).colwise().squaredNorm().array() * norm_j_.segment(begin, n);
+                    const Row n2 = etxj_.leftCols(n).colwise().squaredNorm().array() * norm_i_.segment(begin, n);
+                    const Eigen::Array<bool, 1, Eigen::Dynamic> mask = (Scalar(0.5) * r.square() * (n1 + n2)) < (threshold * n1 * n2);
+                    visitor(begin, mask);
+                }
+            }
+
+            Points xi_, xj_;
+            Row norm_i_, norm_j_;
+            mutable Points exi_, etxj_; // 分块临时缓冲（单线程使用）
+        };
+
+        // Solver traits: sample size, model capacity, whether hypotheses are refit on their inliers
+        // (solvers fed with approximate data), and Solve() producing essential matrices
+        // 求解器特征：样本数、模型容量、是否用内点重新拟合假设（输入为近似数据的求解器），以及生成本质矩阵的Solve()
+
+        struct FivePointSolver
+        {
+            static constexpr int kSampleSize = 5;
+            static constexpr int kMaxModels = 10;
+            static constexpr bool kRefitInliers = false;
+            static int Solve(const PoSDK::types::BearingPairs &pairs, const size_t *sample,
+                             const NativeRansacOptions &, FixedVector<Mat3<double>, kMaxModels> &models)
+            {
+                return FivePoint<double>(pairs, sample, models);
+            }
+        };
+
+        struct SevenPointSolver
+        {
+            static constexpr int kSampleSize = 7;
+            static constexpr int kMaxModels = 3;
+            static constexpr bool kRefitInliers = false;
+            static int Solve(const PoSDK::types::BearingPairs &pairs, const size_t *sample,
+                             const NativeRansacOptions &, FixedVector<Mat3<double>, kMaxModels> &models)
+            {
+                return SevenPoint<double>(pairs, sample, models);
+            }
+        };
+
+        struct EightPointSolver
+        {
+            static constexpr int kSampleSize = 8;
+            static constexpr int kMaxModels = 1;
+            static constexpr bool kRefitInliers = false;
+            static int Solve(const PoSDK::types::BearingPairs &pairs, const size_t *sample,
+                             const NativeRansacOptions &, FixedVector<Mat3<double>, kMaxModels> &models)
+            {
+                models.clear();
+                Mat3<double> E;
+                if (EightPoint<double, kSampleSize>(pairs, sample, E))
+                    models.push_back(E);
+                return models.size();
+            }
+        };
+
+        struct TwoPointSolver
+        {
+            static constexpr int kSampleSize = 2;
+            static constexpr int kMaxModels = 1;
+            static constexpr bool kRefitInliers = false;
+            static int Solve(const PoSDK::types::BearingPairs &pairs, const size_t *sample,
+                             const NativeRansacOptions &options, FixedVector<Mat3<double>, kMaxModels> &models)
+            {
+                models.clear();
+                PoseSolution<double> pose;
+                if (options.has_prior_rotation && TwoPointKnownRotation<double>(options.prior_rotation, pairs, sample, pose))
+                    models.push_back(PoseToEssential(pose));
+                return models.size();
+            }
+        };
+
+        struct UprightThreePointSolver
+        {
+            static constexpr int kSampleSize = 3;
+            static constexpr int kMaxModels = 6;
+            static constexpr bool kRefitInliers = false;
+            static int Solve(const PoSDK::types::BearingPairs &pairs, const size_t *sample,
+                             const NativeRansacOptions &, FixedVector<Mat3<double>, kMaxModels> &models)
+            {
+                models.clear();
+                FixedVector<PoseSolution<double>, kMaxModels> poses;
+                UprightThreePoint<double>(pairs, sample, poses);
+                for (const auto &pose : poses)
+                    models.push_back(PoseToEssential(pose));
+                return models.size();
+            }
+        };
+
+        struct TwoAffineSolver
+        {
+            static constexpr int kSampleSize = 2;
+            static constexpr int kMaxModels = 10;
+            static constexpr bool kRefitInliers = true;
+            static int Solve(const PoSDK::types::BearingPairs &pairs, const size_t *sample,
+                             const NativeRansacOptions &options, FixedVector<Mat3<double>, kMaxModels> &models)
+            {
+                models.clear();
+                if (!options.affine_frames || options.affine_frames->size() != pairs.size())
+                    return 0;
+                return TwoAffinePoint<double>(pairs, *options.affine_frames, sample, models);
+            }
+        };
+
+        namespace detail
+        {
+            template <class Solver, typename Scalar>
+            inline bool RunNativeRansacScored(const PoSDK::types::BearingPairs &pairs, const NativeRansacOptions &options,
+                                              const EpipolarScorer<Scalar> &scorer, NativeRansacResult &result)
+            {
+                constexpr int kSampleSize = Solver::kSampleSize;
+                const size_t num_points = pairs.size();
+
+                std::mt19937 rng(options.seed);
+                std::uniform_int_distribution<size_t> pick(0, num_points - 1);
+                const double log_failure = std::log(1.0 - std::min(options.confidence, 1.0 - 1e-12));
+
+                std::vector<size_t> inlier_indices;
+                const auto collect_inliers = [&](const Mat3<double> &E, double threshold, std::vector<size_t> &indices)
+                {
+                    scorer.Collect(E, threshold, indices);
+                };
+
+                // Local optimisation of an approximate hypothesis: exact five-point models from samples of its
+                // (loosened) inliers, then least-squares refits on a shrinking threshold; kept while the support grows
+                // 近似假设的局部优化：在其（放宽阈值的）内点中抽样求精确五点模型，再按逐步收紧的阈值最小二乘重拟合；支持集增大时保留
+                constexpr int kInnerSamples = 10;
+                std::vector<size_t> fit_indices, refit_indices;
+                FixedVector<Mat3<double>, 10> inner_models;
+                const auto try_model = [&](Mat3<double> &E, std::vector<size_t> &indices, const Mat3<double> &candidate)
+                {
+                    collect_inliers(candidate, options.threshold, refit_indices);
+                    if (refit_indices.size() > indices.size())
+                    {
+                        E = candidate;
+                        indices.swap(refit_indices);
+                    }
+                };
+                const auto refit_model = [&](Mat3<double> &E, std::vector<size_t> &indices)
+                {
+                    collect_inliers(E, 2.0 * options.threshold, fit_indices);
+                    if (fit_indices.size() >= 5)
+                    {
+                        std::uniform_int_distribution<size_t> pick_inlier(0, fit_indices.size() - 1);
+                        size_t inner_sample[5];
+                        for (int s = 0; s < kInnerSamples; ++s)
+                        {
+                            for (int k = 0; k < 5; ++k)
+                                inner_sample[k] = fit_indices[pick_inlier(rng)];
+                            FivePoint<double>(pairs, inner_sample, inner_models);
+                            for (const auto &candidate : inner_models)
+                                try_model(E, indices, candidate);
+                        }
+                    }
+                    for (const double scale : {4.0, 2.0, 1.0})
+                    {
+                        collect_inliers(E, scale * options.threshold, fit_indices);
+                        Mat3<double> refit;
+                        if (EssentialLeastSquares<double>(pairs, fit_indices.data(), fit_indices.size(), refit))
+                            try_model(E, indices, refit);
+                    }
+                };
+
+                size_t sample[kSampleSize];
+                FixedVector<Mat3<double>, Solver::kMaxModels> models;
+                Mat3<double> best_model = Mat3<double>::Zero();
+                size_t best_count = 0;
+                size_t required = options.max_iterations;
+
+                size_t iteration = 0;
+                for (; iteration < required; ++iteration)
+                {
+                    for (int k = 0; k < kSampleSize; ++k)
+                    {
+                        bool unique = false;
+                        while (!unique)
+                        {
+                            sample[k] = pick(rng);
+                            unique = true;
+                            for (int m = 0; m < k; ++m)
+                                unique = unique && sample[m] != sample[k];
+                        }
+                    }
+                    if (Solver::Solve(pairs, sample, options, models) == 0)
+                        continue;
+
+                    for (const auto &E : models)
+                    {
+                        size_t count = scorer.Count(E, options.threshold);
+                        if (count <= best_count)
+                            continue;
+
+                        best_model = E;
+                        if (Solver::kRefitInliers)
+                        {
+                            // Approximate hypotheses undercount their support; refit before it drives termination
+                            // 近似假设会低估支持集，先重拟合再用于终止判断
+                            collect_inliers(best_model, options.threshold, inlier_indices);
+                            refit_model(best_model, inlier_indices);
+                            count = inlier_indices.size();
+                        }
+                        best_count = count;
+                        const double inlier_ratio = static_cast<double>(count) / num_points;
+                        const double no_outlier = 1.0 - std::pow(inlier_ratio, kSampleSize);
+                        if (no_outlier <= 0.0)
+                        {
+                            required = iteration + 1;
+                        }
+                        else if (no_outlier < 1.0)
+                        {
+                            const double needed = log_failure / std::log(no_outlier);
+                            if (needed < static_cast<double>(required))
+                                required = std::max<size_t>(iteration + 1, static_cast<size_t>(std::ceil(needed)));
+                        }
+                    }
+                }
+                result.iterations = iteration;
+                if (best_count < static_cast<size_t>(kSampleSize))
+                    return false;
+
+                collect_inliers(best_model, options.threshold, inlier_indices);
+                if (Solver::kRefitInliers)
+                    refit_model(best_model, inlier_indices);
+                result.inliers.assign(inlier_indices.begin(), inlier_indices.end());
+                result.success = EssentialToPose<double>(best_model, pairs, inlier_indices.data(), inlier_indices.size(), result.pose);
+                return result.success;
+            }
+        } // namespace detail
+
+        /**
+         * @brief RANSAC with adaptive termination; the final pose is chosen by cheirality over all inliers
+         *        自适应终止的RANSAC；最终位姿按全部内点的正深度条件选取
+         */
+        template <class Solver>
+        inline bool RunNativeRansac(const PoSDK::types::BearingPairs &pairs, const NativeRansacOptions &options,
+                                    NativeRansacResult &result)
+        {
+            result = NativeRansacResult();
+            if (pairs.size() < static_cast<size_t>(Solver::kSampleSize))
+                return false;
+            if (options.scoring_precision == ScoringPrecision::Float)
+                return detail::RunNativeRansacScored<Solver, float>(pairs, options, EpipolarScorer<float>(pairs), result);
+            return detail::RunNativeRansacScored<Solver, double>(pairs, options, EpipolarScorer<double>(pairs), result);
+        }
+
+        /**
+         * @brief Agreement of two RANSAC results (e.g. float32 vs double scoring) | 两个RANSAC结果的一致性（如float32与double评分）
+         */
+        struct NativeRansacAgreement
+        {
+            double inlier_jaccard = 0.0;     // |A ∩ B| / |A ∪ B|
+            double rotation_deg = 0.0;       // 旋转差（度）
+            double translation_deg = 0.0;    // 平移方向夹角（度）
+            bool same_outcome = false;       // 两者同时成功或同时失败
+            bool both_succeeded = false;
+
+            bool WithinTolerance(double min_jaccard = 0.99, double max_angle_deg = 0.1) const
+            {
+                return same_outcome && (!both_succeeded || (inlier_jaccard >= min_jaccard &&
+                                                            rotation_deg <= max_angle_deg &&
+                                                            translation_deg <= max_angle_deg));
+            }
+        };
+
+        inline NativeRansacAgreement CompareNativeRansacResults(const NativeRansacResult &a, const NativeRansacResult &b)
+        {
+            NativeRansacAgreement agreement;
+            agreement.same_outcome = a.success == b.success;
+            agreement.both_succeeded = a.success && b.success;
+
+            // Inliers are produced in ascending index order | 内点按下标升序输出
+            size_t common_count = 0;
+            for (size_t p = 0, q = 0; p < a.inliers.size() && q < b.inliers.size();)
+            {
+                if (a.inliers[p] == b.inliers[q])
+                {
+                    ++common_count;
+                    ++p;
+                    ++q;
+                }
+                else if (a.inliers[p] < b.inliers[q])
+                    ++p;
+                else
+                    ++q;
+            }
+            const size_t union_count = a.inliers.size() + b.inliers.size() - common_count;
+            agreement.inlier_jaccard = union_count > 0 ? static_cast<double>(common_count) / union_count : 1.0;
+
+            if (agreement.both_succeeded)
+            {
+                const double to_deg = 180.0 / EIGEN_PI;
+                agreement.rotation_deg = Eigen::AngleAxisd(a.pose.R.transpose() * b.pose.R).angle() * to_deg;
+                const double cos_t = a.pose.t.normalized().dot(b.pose.t.normalized());
+                agreement.translation_deg = std::acos(std::max(-1.0, std::min(1.0, cos_t))) * to_deg;
+            }
+            return agreement;
+        }
+
+    } // namespace minimal
+} // namespace common
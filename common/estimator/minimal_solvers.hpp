@@ -0,0 +1,726 @@
+/**
+ * @file minimal_solvers.hpp
+ * @brief PoSDK-native minimal relative pose solvers | PoSDK原生最小相对位姿求解器
+ * @details Fixed-size, stack-allocated kernels templated on the scalar type. They read the
+ *          sampled correspondences directly from PoSDK BearingPairs (head = bearing in view i,
+ *          tail = bearing in view j), so backends call them without building OpenGV adapters,
+ *          PoseLib point arrays or cv::Mat buffers.
+ *          固定尺寸、栈上分配、按标量类型模板化的求解核。直接从PoSDK BearingPairs读取抽样对应
+ *          （head为视图i的射线，tail为视图j的射线），后端调用时无需构造OpenGV适配器、PoseLib点数组或cv::Mat。
+ *
+ *          Convention | 约定: xj ~ R * xi + t,  E = [t]x R,  xj^T E xi = 0
+ *
+ *          - FivePoint:  essential matrix from 5 bearings (Stewenius Groebner basis, <= 10 solutions)
+ *          - SevenPoint: essential matrix from 7 bearings (cubic det constraint, <= 3 solutions)
+ *          - EightPoint: essential matrix from N >= 8 bearings (linear, projected to the manifold)
+ *          - TwoPointKnownRotation: translation from 2 bearings given R
+ *          - UprightThreePoint: rotation about the camera y axis + translation from 3 gravity-aligned bearings
+ *          - TwoAffinePoint: essential matrix from 2 bearings with local affine frames (<= 10 solutions)
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <po_core/types.hpp>
+#include <Eigen/Dense>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace common
+{
+    namespace minimal
+    {
+        template <typename Scalar>
+        using Mat3 = Eigen::Matrix<Scalar, 3, 3>;
+        template <typename Scalar>
+        using Vec3 = Eigen::Matrix<Scalar, 3, 1>;
+        template <typename Scalar>
+        using Mat2 = Eigen::Matrix<Scalar, 2, 2>;
+
+        /**
+         * @brief Per-correspondence local affine frames, aligned with BearingPairs | 与BearingPairs对齐的逐对应局部仿射
+         * @details Frame k maps a small displacement around correspondence k in view i to view j,
+         *          both in normalized image coordinates (z = 1): dpj = A dpi.
+         *          第k个仿射将视图i中对应k附近的小位移映射到视图j（均为z = 1的归一化坐标）：dpj = A dpi。
+         */
+        using AffineFrames = std::vector<Mat2<double>, Eigen::aligned_allocator<Mat2<double>>>;
+
+        /**
+         * @brief Fixed-capacity, stack-allocated solution list | 固定容量的栈上解列表
+         */
+        template <typename T, int Capacity>
+        class FixedVector
+        {
+        public:
+            void push_back(const T &value)
+            {
+                if (size_ < Capacity)
+                    data_[size_++] = value;
+            }
+            void clear() { size_ = 0; }
+            int size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+            const T &operator[](int i) const { return data_[i]; }
+            T &operator[](int i) { return data_[i]; }
+            const T *begin() const { return data_.data(); }
+            const T *end() const { return data_.data() + size_; }
+
+        private:
+            std::array<T, Capacity> data_;
+            int size_ = 0;
+        };
+
+        template <typename Scalar>
+        struct PoseSolution
+        {
+            Mat3<Scalar> R = Mat3<Scalar>::Identity();
+            Vec3<Scalar> t = Vec3<Scalar>::Zero();
+        };
+
+        namespace detail
+        {
+            template <typename Scalar>
+            inline Vec3<Scalar> BearingI(const PoSDK::types::BearingPairs &pairs, size_t index)
+            {
+                return pairs[index].template head<3>().template cast<Scalar>();
+            }
+
+            template <typename Scalar>
+            inline Vec3<Scalar> BearingJ(const PoSDK::types::BearingPairs &pairs, size_t index)
+            {
+                return pairs[index].template tail<3>().template cast<Scalar>();
+            }
+
+            /**
+             * @brief Epipolar constraint row: xj^T E xi = row . vec(E), vec row-major
+             */
+            template <typename Scalar>
+            inline Eigen::Matrix<Scalar, 9, 1> EpipolarRow(const Vec3<Scalar> &xi, const Vec3<Scalar> &xj)
+            {
+                Eigen::Matrix<Scalar, 9, 1> row;
+                for (int r = 0; r < 3; ++r)
+                    for (int c = 0; c < 3; ++c)
+                        row(3 * r + c) = xj(r) * xi(c);
+                return row;
+            }
+
+            template <typename Scalar>
+            inline Mat3<Scalar> Unvec(const Eigen::Matrix<Scalar, 9, 1> &v)
+            {
+                Mat3<Scalar> E;
+                E << v(0), v(1), v(2), v(3), v(4), v(5), v(6), v(7), v(8);
+                return E;
+            }
+
+            /**
+             * @brief Null space of the N x 9 epipolar system via QR of its transpose (N < 9)
+             *        通过转置的QR分解求N x 9对极约束系统的零空间（N < 9）
+             */
+            template <typename Scalar, int N>
+            inline Eigen::Matrix<Scalar, 9, 9 - N> EpipolarNullSpace(const PoSDK::types::BearingPairs &pairs,
+                                                                     const size_t *sample)
+            {
+                static_assert(N < 9, "null space needs fewer than 9 constraints");
+                Eigen::Matrix<Scalar, 9, N> At;
+                for (int k = 0; k < N; ++k)
+                    At.col(k) = EpipolarRow<Scalar>(BearingI<Scalar>(pairs, sample[k]), BearingJ<Scalar>(pairs, sample[k]));
+                const Eigen::HouseholderQR<Eigen::Matrix<Scalar, 9, N>> qr(At);
+                const Eigen::Matrix<Scalar, 9, 9> Q = qr.householderQ();
+                return Q.template rightCols<9 - N>();
+            }
+
+            /**
+             * @brief The two affine constraints (E^T pj)_12 + A^T (E pi)_12 = 0 as rows over vec(E)
+             *        仿射约束 (E^T pj)_12 + A^T (E pi)_12 = 0 对应的两行（作用于vec(E)）
+             * @details pi, pj are the bearings scaled to z = 1 | pi、pj为缩放到z = 1的射线
+             */
+            template <typename Scalar>
+            inline Eigen::Matrix<Scalar, 9, 2> AffineRows(const Vec3<Scalar> &xi, const Vec3<Scalar> &xj, const Mat2<Scalar> &A)
+            {
+                const Vec3<Scalar> pi = xi / xi(2);
+                const Vec3<Scalar> pj = xj / xj(2);
+                Eigen::Matrix<Scalar, 9, 2> rows = Eigen::Matrix<Scalar, 9, 2>::Zero();
+                for (int a = 0; a < 2; ++a)
+                {
+                    for (int r = 0; r < 3; ++r)
+                    {
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            if (r < 2)
+                                rows(3 * r + c, a) += A(r, a) * pi(c);
+                            if (c == a)
+                                rows(3 * r + c, a) += pj(r);
+                        }
+                    }
+                }
+                return rows;
+            }
+
+            /**
+             * @brief Closest essential matrix (singular values 1, 1, 0) | 最近的本质矩阵（奇异值1,1,0）
+             */
+            template <typename Scalar>
+            inline Mat3<Scalar> ProjectToEssential(const Mat3<Scalar> &M)
+            {
+                const Eigen::JacobiSVD<Mat3<Scalar>> svd(M, Eigen::ComputeFullU | Eigen::ComputeFullV);
+                return svd.matrixU() * Vec3<Scalar>(1, 1, 0).asDiagonal() * svd.matrixV().transpose();
+            }
+
+            /**
+             * @brief Real roots of a x^3 + b x^2 + c x + d | 三次方程的实根
+             */
+            template <typename Scalar>
+            inline int SolveCubic(Scalar a, Scalar b, Scalar c, Scalar d, Scalar roots[3])
+            {
+                const Scalar eps = std::numeric_limits<Scalar>::epsilon() * 64;
+                const Scalar scale = std::max(std::max(std::abs(a), std::abs(b)), std::max(std::abs(c), std::abs(d)));
+                if (scale == Scalar(0))
+                    return 0;
+                if (std::abs(a) <= eps * scale)
+                {
+                    // Quadratic | 退化为二次方程
+                    if (std::abs(b) <= eps * scale)
+                    {
+                        if (std::abs(c) <= eps * scale)
+                            return 0;
+                        roots[0] = -d / c;
+                        return 1;
+                    }
+                    const Scalar disc = c * c - 4 * b * d;
+                    if (disc < 0)
+                        return 0;
+                    const Scalar q = -Scalar(0.5) * (c + std::copysign(std::sqrt(disc), c));
+                    int n = 0;
+                    roots[n++] = q / b;
+                    if (q != Scalar(0))
+                        roots[n++] = d / q;
+                    return n;
+                }
+
+                // Depressed cubic t^3 + p t + q with x = t - b / 3a | 化为缺项三次方程
+                const Scalar A = b / a, B = c / a, C = d / a;
+                const Scalar p = B - A * A / 3;
+                const Scalar q = 2 * A * A * A / 27 - A * B / 3 + C;
+                const Scalar shift = -A / 3;
+                const Scalar disc = q * q / 4 + p * p * p / 27;
+                if (disc > 0)
+                {
+                    const Scalar s = std::sqrt(disc);
+                    roots[0] = std::cbrt(-q / 2 + s) + std::cbrt(-q / 2 - s) + shift;
+                    return 1;
+                }
+                if (p == Scalar(0))
+                {
+                    roots[0] = shift;
+                    return 1;
+                }
+                const Scalar r = 2 * std::sqrt(-p / 3);
+                const Scalar arg = std::max(Scalar(-1), std::min(Scalar(1), 3 * q / (p * r)));
+                const Scalar phi = std::acos(arg) / 3;
+                const Scalar two_pi_3 = Scalar(2.0943951023931954923);
+                roots[0] = r * std::cos(phi) + shift;
+                roots[1] = r * std::cos(phi - two_pi_3) + shift;
+                roots[2] = r * std::cos(phi + two_pi_3) + shift;
+                return 3;
+            }
+
+            /**
+             * @brief Depths (lambda_i, lambda_j) with lambda_j xj = lambda_i R xi + t (least squares)
+             *        满足 lambda_j xj = lambda_i R xi + t 的深度（最小二乘）
+             */
+            template <typename Scalar>
+            inline bool InFront(const Mat3<Scalar> &R, const Vec3<Scalar> &t,
+                                const Vec3<Scalar> &xi, const Vec3<Scalar> &xj)
+            {
+                const Vec3<Scalar> a = R * xi;
+                const Scalar aa = a.dot(a), ab = a.dot(xj), bb = xj.dot(xj);
+                const Scalar at = a.dot(t), bt = xj.dot(t);
+                const Scalar det = aa * bb - ab * ab;
+                if (std::abs(det) <= std::numeric_limits<Scalar>::epsilon() * aa * bb)
+                    return false;
+                const Scalar lambda_i = (-at * bb + ab * bt) / det;
+                const Scalar lambda_j = (aa * bt - ab * at) / det;
+                return lambda_i > 0 && lambda_j > 0;
+            }
+
+            template <typename Scalar>
+            inline int CountInFront(const Mat3<Scalar> &R, const Vec3<Scalar> &t,
+                                    const PoSDK::types::BearingPairs &pairs, const size_t *indices, size_t count)
+            {
+                int n = 0;
+                for (size_t k = 0; k < count; ++k)
+                {
+                    const size_t idx = indices ? indices[k] : k;
+                    n += InFront<Scalar>(R, t, BearingI<Scalar>(pairs, idx), BearingJ<Scalar>(pairs, idx)) ? 1 : 0;
+                }
+                return n;
+            }
+
+            /**
+             * @brief Cubic polynomial in (x, y, z), monomials ordered as
+             *        x^3 x^2y xy^2 y^3 x^2z xyz y^2z xz^2 yz^2 z^3 | x^2 xy y^2 xz yz z^2 x y z 1
+             *        (x, y, z)的三次多项式，单项式顺序如上（前10项在Gauss-Jordan中消去）
+             */
+            template <typename Scalar>
+            using Poly3 = Eigen::Matrix<Scalar, 20, 1>;
+
+            struct MonomialTable
+            {
+                int product[20][20];
+
+                MonomialTable()
+                {
+                    static const int exponents[20][3] = {
+                        {3, 0, 0}, {2, 1, 0}, {1, 2, 0}, {0, 3, 0}, {2, 0, 1}, {1, 1, 1}, {0, 2, 1}, {1, 0, 2}, {0, 1, 2}, {0, 0, 3}, {2, 0, 0}, {1, 1, 0}, {0, 2, 0}, {1, 0, 1}, {0, 1, 1}, {0, 0, 2}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0, 0, 0}};
+                    for (int i = 0; i < 20; ++i)
+                    {
+                        for (int j = 0; j < 20; ++j)
+                        {
+                            product[i][j] = -1;
+                            const int e[3] = {exponents[i][0] + exponents[j][0],
+                                              exponents[i][1] + exponents[j][1],
+                                              exponents[i][2] + exponents[j][2]};
+                            for (int k = 0; k < 20; ++k)
+                            {
+                                if (exponents[k][0] == e[0] && exponents[k][1] == e[1] && exponents[k][2] == e[2])
+                                    product[i][j] = k;
+                            }
+                        }
+                    }
+                }
+
+                static const MonomialTable &Get()
+                {
+                    static const MonomialTable table;
+                    return table;
+                }
+            };
+
+            /**
+             * @brief Product of polynomials supported on monomials [P, 20) and [Q, 20) (degree sum <= 3)
+             *        支撑在单项式[P, 20)与[Q, 20)上的多项式乘积（次数和不超过3）
+             */
+            template <int P, int Q, typename Scalar>
+            inline Poly3<Scalar> Multiply(const Poly3<Scalar> &p, const Poly3<Scalar> &q)
+            {
+                const auto &table = MonomialTable::Get();
+                Poly3<Scalar> out = Poly3<Scalar>::Zero();
+                for (int i = P; i < 20; ++i)
+                    for (int j = Q; j < 20; ++j)
+                        out(table.product[i][j]) += p(i) * q(j);
+                return out;
+            }
+
+            template <typename Scalar>
+            inline bool AllFinite(const Mat3<Scalar> &M)
+            {
+                return M.allFinite();
+            }
+        } // namespace detail
+
+        /**
+         * @brief Linear least-squares essential matrix from count >= 8 bearings (e.g. all inliers)
+         *        由count >= 8条射线（如全部内点）线性最小二乘估计本质矩阵
+         */
+        template <typename Scalar>
+        inline bool EssentialLeastSquares(const PoSDK::types::BearingPairs &pairs, const size_t *indices, size_t count,
+                                          Mat3<Scalar> &E)
+        {
+            if (count < 8)
+                return false;
+            Eigen::Matrix<Scalar, 9, 9> AtA = Eigen::Matrix<Scalar, 9, 9>::Zero();
+            for (size_t k = 0; k < count; ++k)
+            {
+                const auto row = detail::EpipolarRow<Scalar>(detail::BearingI<Scalar>(pairs, indices[k]),
+                                                             detail::BearingJ<Scalar>(pairs, indices[k]));
+                AtA.template selfadjointView<Eigen::Lower>().rankUpdate(row);
+            }
+            const Eigen::SelfAdjointEigenSolver<Eigen::Matrix<Scalar, 9, 9>> eig(AtA.template selfadjointView<Eigen::Lower>());
+            E = detail::ProjectToEssential<Scalar>(detail::Unvec<Scalar>(eig.eigenvectors().col(0)));
+            return detail::AllFinite(E);
+        }
+
+        /**
+         * @brief Linear eight-point essential matrix from N >= 8 bearings | N >= 8 条射线的线性八点法本质矩阵
+         */
+        template <typename Scalar, int N>
+        inline bool EightPoint(const PoSDK::types::BearingPairs &pairs, const size_t *sample, Mat3<Scalar> &E)
+        {
+            static_assert(N >= 8, "eight-point needs at least 8 correspondences");
+            return EssentialLeastSquares<Scalar>(pairs, sample, N, E);
+        }
+
+        /**
+         * @brief Seven-point essential matrices (up to 3) | 七点法本质矩阵（最多3个）
+         */
+        template <typename Scalar>
+        inline int SevenPoint(const PoSDK::types::BearingPairs &pairs, const size_t *sample,
+                              FixedVector<Mat3<Scalar>, 3> &essentials)
+        {
+            essentials.clear();
+            const Eigen::Matrix<Scalar, 9, 2> null = detail::EpipolarNullSpace<Scalar, 7>(pairs, sample);
+            const Mat3<Scalar> F1 = detail::Unvec<Scalar>(null.col(0));
+            const Mat3<Scalar> F2 = detail::Unvec<Scalar>(null.col(1));
+
+            // det(l F1 + (1 - l) F2) is cubic in l; recover it from 4 samples | 行列式为l的三次多项式，由4个采样值恢复
+            const Scalar d0 = F2.determinant();
+            const Scalar d1 = F1.determinant();
+            const Scalar dm1 = (-F1 + 2 * F2).determinant();
+            const Scalar d2 = (2 * F1 - F2).determinant();
+            const Scalar b = (d1 + dm1) / 2 - d0;
+            const Scalar s = (d1 - dm1) / 2;
+            const Scalar a = (d2 - d0 - 4 * b - 2 * s) / 6;
+            const Scalar c = s - a;
+
+            Scalar roots[3];
+            const int num_roots = detail::SolveCubic<Scalar>(a, b, c, d0, roots);
+            for (int k = 0; k < num_roots; ++k)
+            {
+                const Mat3<Scalar> E = detail::ProjectToEssential<Scalar>(roots[k] * F1 + (1 - roots[k]) * F2);
+                if (detail::AllFinite(E))
+                    essentials.push_back(E);
+            }
+            return essentials.size();
+        }
+
+        namespace detail
+        {
+            /**
+             * @brief Essential matrices in a 4-dimensional space of 3x3 matrices (Stewenius action matrix)
+             *        4维3x3矩阵空间中的本质矩阵（Stewenius作用矩阵法）
+             */
+            template <typename Scalar>
+            inline int EssentialsInNullSpace(const Eigen::Matrix<Scalar, 9, 4> &null,
+                                             FixedVector<Mat3<Scalar>, 10> &essentials)
+            {
+                using Poly = detail::Poly3<Scalar>;
+                essentials.clear();
+
+                // E = x X + y Y + z Z + W | 本质矩阵位于4维零空间
+                Poly E[3][3];
+                for (int r = 0; r < 3; ++r)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        E[r][c] = Poly::Zero();
+                        E[r][c](16) = null(3 * r + c, 0);
+                        E[r][c](17) = null(3 * r + c, 1);
+                        E[r][c](18) = null(3 * r + c, 2);
+                        E[r][c](19) = null(3 * r + c, 3);
+                    }
+                }
+
+                // E E^T (quadratic) | E E^T（二次）
+                Poly EEt[3][3];
+                for (int r = 0; r < 3; ++r)
+                {
+                    for (int c = r; c < 3; ++c)
+                    {
+                        EEt[r][c] = detail::Multiply<16, 16>(E[r][0], E[c][0]) +
+                                    detail::Multiply<16, 16>(E[r][1], E[c][1]) +
+                                    detail::Multiply<16, 16>(E[r][2], E[c][2]);
+                        EEt[c][r] = EEt[r][c];
+                    }
+                }
+                const Poly half_trace = (EEt[0][0] + EEt[1][1] + EEt[2][2]) / 2;
+
+                // 10 cubic constraints: det(E) = 0 and E E^T E - tr(E E^T) E / 2 = 0 | 10个三次约束
+                Eigen::Matrix<Scalar, 10, 20> M;
+                const Poly cofactor0 = detail::Multiply<16, 16>(E[1][1], E[2][2]) - detail::Multiply<16, 16>(E[1][2], E[2][1]);
+                const Poly cofactor1 = detail::Multiply<16, 16>(E[1][2], E[2][0]) - detail::Multiply<16, 16>(E[1][0], E[2][2]);
+                const Poly cofactor2 = detail::Multiply<16, 16>(E[1][0], E[2][1]) - detail::Multiply<16, 16>(E[1][1], E[2][0]);
+                M.row(0) = (detail::Multiply<10, 16>(cofactor0, E[0][0]) +
+                            detail::Multiply<10, 16>(cofactor1, E[0][1]) +
+                            detail::Multiply<10, 16>(cofactor2, E[0][2]))
+                               .transpose();
+                for (int r = 0; r < 3; ++r)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        Poly entry = -detail::Multiply<10, 16>(half_trace, E[r][c]);
+                        for (int k = 0; k < 3; ++k)
+                            entry += detail::Multiply<10, 16>(EEt[r][k], E[k][c]);
+                        M.row(1 + 3 * r + c) = entry.transpose();
+                    }
+                }
+
+                // Gauss-Jordan: [I | B] | 高斯-约旦消元
+                const Eigen::PartialPivLU<Eigen::Matrix<Scalar, 10, 10>> lu(M.template leftCols<10>());
+                const Eigen::Matrix<Scalar, 10, 10> B = lu.solve(M.template rightCols<10>());
+                if (!B.allFinite())
+                    return 0;
+
+                // Action matrix of x on the basis x^2 xy y^2 xz yz z^2 x y z 1 | x在商环基上的作用矩阵
+                Eigen::Matrix<Scalar, 10, 10> action = Eigen::Matrix<Scalar, 10, 10>::Zero();
+                action.row(0) = -B.row(0);
+                action.row(1) = -B.row(1);
+                action.row(2) = -B.row(2);
+                action.row(3) = -B.row(4);
+                action.row(4) = -B.row(5);
+                action.row(5) = -B.row(7);
+                action(6, 0) = 1;
+                action(7, 1) = 1;
+                action(8, 3) = 1;
+                action(9, 6) = 1;
+
+                const Eigen::EigenSolver<Eigen::Matrix<Scalar, 10, 10>> eig(action);
+                if (eig.info() != Eigen::Success)
+                    return 0;
+                const auto values = eig.eigenvalues();
+                const auto vectors = eig.eigenvectors();
+                for (int k = 0; k < 10; ++k)
+                {
+                    if (std::abs(values(k).imag()) > Scalar(1e-8) * std::max(Scalar(1), std::abs(values(k).real())))
+                        continue;
+                    const Eigen::Matrix<Scalar, 10, 1> v = vectors.col(k).real();
+                    if (std::abs(v(9)) < std::numeric_limits<Scalar>::epsilon())
+                        continue;
+                    const Scalar x = v(6) / v(9), y = v(7) / v(9), z = v(8) / v(9);
+                    Mat3<Scalar> Ek = detail::Unvec<Scalar>(x * null.col(0) + y * null.col(1) + z * null.col(2) + null.col(3));
+                    const Scalar norm = Ek.norm();
+                    if (norm > 0 && detail::AllFinite(Ek))
+                        essentials.push_back(Ek / norm);
+                }
+                return essentials.size();
+            }
+        } // namespace detail
+
+        /**
+         * @brief Five-point essential matrices (up to 10), Stewenius action matrix | 五点法本质矩阵（最多10个）
+         */
+        template <typename Scalar>
+        inline int FivePoint(const PoSDK::types::BearingPairs &pairs, const size_t *sample,
+                             FixedVector<Mat3<Scalar>, 10> &essentials)
+        {
+            return detail::EssentialsInNullSpace<Scalar>(detail::EpipolarNullSpace<Scalar, 5>(pairs, sample), essentials);
+        }
+
+        /**
+         * @brief Two-point essential matrices from affine correspondences (up to 10) | 两对仿射对应的本质矩阵（最多10个）
+         * @details Each affine correspondence gives 1 epipolar + 2 affine constraints. The 6 x 9 system is
+         *          reduced to its 4 least-significant right singular vectors (exact when noise-free, least
+         *          squares for approximate frames such as SIFT similarities) and solved like the five-point problem.
+         *          每个仿射对应提供1个对极约束和2个仿射约束。6 x 9系统取最小的4个右奇异向量（无噪声时精确，
+         *          对SIFT相似变换等近似仿射为最小二乘），再按五点法求解。
+         */
+        template <typename Scalar>
+        inline int TwoAffinePoint(const PoSDK::types::BearingPairs &pairs, const AffineFrames &frames,
+                                  const size_t *sample, FixedVector<Mat3<Scalar>, 10> &essentials)
+        {
+            Eigen::Matrix<Scalar, 6, 9> A;
+            for (int k = 0; k < 2; ++k)
+            {
+                const Vec3<Scalar> xi = detail::BearingI<Scalar>(pairs, sample[k]);
+                const Vec3<Scalar> xj = detail::BearingJ<Scalar>(pairs, sample[k]);
+                const Eigen::Matrix<Scalar, 9, 2> affine = detail::AffineRows<Scalar>(xi, xj, frames[sample[k]].template cast<Scalar>());
+                A.row(3 * k) = detail::EpipolarRow<Scalar>(xi, xj).normalized().transpose();
+                A.row(3 * k + 1) = affine.col(0).normalized().transpose();
+                A.row(3 * k + 2) = affine.col(1).normalized().transpose();
+            }
+            const Eigen::JacobiSVD<Eigen::Matrix<Scalar, 6, 9>> svd(A, Eigen::ComputeFullV);
+            const Eigen::Matrix<Scalar, 9, 4> null = svd.matrixV().template rightCols<4>();
+            return detail::EssentialsInNullSpace<Scalar>(null, essentials);
+        }
+
+        /**
+         * @brief Affine frame from the scale and orientation of a feature match (similarity approximation)
+         *        由特征匹配的尺度和方向构造仿射（相似变换近似）
+         * @param size_i, size_j Feature sizes (any common unit, only the ratio is used) | 特征尺度（只使用比值）
+         * @param angle_i, angle_j Feature orientations in degrees (cv::KeyPoint convention) | 特征方向（度，cv::KeyPoint约定）
+         * @param fx_i, fy_i, fx_j, fy_j Focal lengths mapping pixels to normalized coordinates | 像素到归一化坐标的焦距
+         */
+        inline Mat2<double> SimilarityFrame(double size_i, double angle_i, double size_j, double angle_j,
+                                            double fx_i, double fy_i, double fx_j, double fy_j)
+        {
+            const double scale = size_j / size_i;
+            const double theta = (angle_j - angle_i) * EIGEN_PI / 180.0;
+            Mat2<double> A_pixel;
+            A_pixel << std::cos(theta), -std::sin(theta), std::sin(theta), std::cos(theta);
+            A_pixel *= scale;
+            // dpj = Kj^-1 A_pixel Ki dpi | 像素仿射换算到归一化坐标
+            return Eigen::Vector2d(1.0 / fx_j, 1.0 / fy_j).asDiagonal() * A_pixel * Eigen::Vector2d(fx_i, fy_i).asDiagonal();
+        }
+
+        /**
+         * @brief Decompose E and keep the pose with most bearings in front of both cameras
+         *        分解本质矩阵，选择使最多射线位于两相机前方的位姿
+         * @param indices Correspondences used for the cheirality vote, nullptr means 0..count-1
+         *                用于正深度投票的对应下标，nullptr表示0..count-1
+         */
+        template <typename Scalar>
+        inline bool EssentialToPose(const Mat3<Scalar> &E, const PoSDK::types::BearingPairs &pairs,
+                                    const size_t *indices, size_t count, PoseSolution<Scalar> &pose,
+                                    int *num_in_front = nullptr)
+        {
+            const Eigen::JacobiSVD<Mat3<Scalar>> svd(E, Eigen::ComputeFullU | Eigen::ComputeFullV);
+            Mat3<Scalar> U = svd.matrixU();
+            Mat3<Scalar> V = svd.matrixV();
+            if (U.determinant() < 0)
+                U.col(2) = -U.col(2);
+            if (V.determinant() < 0)
+                V.col(2) = -V.col(2);
+
+            Mat3<Scalar> W = Mat3<Scalar>::Zero();
+            W(0, 1) = -1;
+            W(1, 0) = 1;
+            W(2, 2) = 1;
+            const Mat3<Scalar> rotations[2] = {U * W * V.transpose(), U * W.transpose() * V.transpose()};
+            const Vec3<Scalar> t = U.col(2);
+
+            int best = -1;
+            for (const auto &R : rotations)
+            {
+                for (Scalar sign : {Scalar(1), Scalar(-1)})
+                {
+                    const int n = detail::CountInFront<Scalar>(R, sign * t, pairs, indices, count);
+                    if (n > best)
+                    {
+                        best = n;
+                        pose.R = R;
+                        pose.t = sign * t;
+                    }
+                }
+            }
+            if (num_in_front)
+                *num_in_front = best;
+            return best > 0;
+        }
+
+        /**
+         * @brief Translation from 2 bearings with known rotation R | 已知旋转R时由2条射线求平移
+         * @details t is orthogonal to (R xi) x xj for every correspondence | t与每个对应的(R xi) x xj正交
+         */
+        template <typename Scalar>
+        inline bool TwoPointKnownRotation(const Mat3<Scalar> &R, const PoSDK::types::BearingPairs &pairs,
+                                          const size_t *sample, PoseSolution<Scalar> &pose)
+        {
+            const Vec3<Scalar> n0 = (R * detail::BearingI<Scalar>(pairs, sample[0])).cross(detail::BearingJ<Scalar>(pairs, sample[0]));
+            const Vec3<Scalar> n1 = (R * detail::BearingI<Scalar>(pairs, sample[1])).cross(detail::BearingJ<Scalar>(pairs, sample[1]));
+            Vec3<Scalar> t = n0.cross(n1);
+            const Scalar norm = t.norm();
+            if (!(norm > std::numeric_limits<Scalar>::epsilon()))
+                return false;
+            t /= norm;
+            pose.R = R;
+            pose.t = detail::CountInFront<Scalar>(R, t, pairs, sample, 2) >= detail::CountInFront<Scalar>(R, -t, pairs, sample, 2) ? t : -t;
+            return true;
+        }
+
+        /**
+         * @brief Upright 3-point: rotation about the camera y axis plus translation (up to 6 solutions)
+         *        竖直三点法：绕相机y轴的旋转加平移（最多6个解）
+         * @details Bearings must be gravity-aligned (y axis along gravity). With q = tan(theta / 2), the rows
+         *          (1 + q^2) (R xi) x xj are quadratic in q and their determinant is a sextic in q.
+         *          射线须已按重力对齐（y轴沿重力方向）。令q = tan(theta / 2)，行向量(1 + q^2)(R xi) x xj为q的二次式，
+         *          其行列式为q的六次多项式。
+         */
+        template <typename Scalar>
+        inline int UprightThreePoint(const PoSDK::types::BearingPairs &pairs, const size_t *sample,
+                                     FixedVector<PoseSolution<Scalar>, 6> &poses)
+        {
+            poses.clear();
+
+            // R xi = c a + s b + d for R = Ry(theta) | 绕y轴旋转时 R xi = c a + s b + d
+            Vec3<Scalar> rows[3][3]; // rows[k][power]: (1 + q^2) n_k = rows[k][0] + rows[k][1] q + rows[k][2] q^2
+            for (int k = 0; k < 3; ++k)
+            {
+                const Vec3<Scalar> xi = detail::BearingI<Scalar>(pairs, sample[k]);
+                const Vec3<Scalar> xj = detail::BearingJ<Scalar>(pairs, sample[k]);
+                const Vec3<Scalar> a = Vec3<Scalar>(xi(0), 0, xi(2)).cross(xj);
+                const Vec3<Scalar> b = Vec3<Scalar>(xi(2), 0, -xi(0)).cross(xj);
+                const Vec3<Scalar> d = Vec3<Scalar>(0, xi(1), 0).cross(xj);
+                rows[k][0] = a + d;
+                rows[k][1] = 2 * b;
+                rows[k][2] = d - a;
+            }
+
+            // Sextic coefficients, ascending powers | 六次多项式系数（升幂）
+            Eigen::Matrix<Scalar, 7, 1> coeffs = Eigen::Matrix<Scalar, 7, 1>::Zero();
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    for (int k = 0; k < 3; ++k)
+                        coeffs(i + j + k) += rows[0][i].dot(rows[1][j].cross(rows[2][k]));
+
+            int degree = 6;
+            const Scalar scale = coeffs.cwiseAbs().maxCoeff();
+            if (!(scale > 0))
+                return 0;
+            while (degree > 0 && std::abs(coeffs(degree)) <= std::numeric_limits<Scalar>::epsilon() * 64 * scale)
+                --degree;
+            if (degree == 0)
+                return 0;
+
+            // Companion matrix (stack storage, dynamic size <= 6) | 友矩阵（栈上存储，尺寸<=6）
+            using Companion = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, 0, 6, 6>;
+            Companion companion = Companion::Zero(degree, degree);
+            for (int k = 0; k < degree; ++k)
+                companion(0, k) = -coeffs(degree - 1 - k) / coeffs(degree);
+            for (int k = 1; k < degree; ++k)
+                companion(k, k - 1) = 1;
+            const Eigen::EigenSolver<Companion> eig(companion, false);
+            if (eig.info() != Eigen::Success)
+                return 0;
+
+            for (int r = 0; r < degree; ++r)
+            {
+                const auto root = eig.eigenvalues()(r);
+                if (std::abs(root.imag()) > Scalar(1e-8) * std::max(Scalar(1), std::abs(root.real())))
+                    continue;
+                const Scalar q = root.real();
+                const Scalar c = (1 - q * q) / (1 + q * q), s = 2 * q / (1 + q * q);
+
+                PoseSolution<Scalar> pose;
+                pose.R << c, 0, s, 0, 1, 0, -s, 0, c;
+                Vec3<Scalar> n[3];
+                for (int k = 0; k < 3; ++k)
+                    n[k] = (pose.R * detail::BearingI<Scalar>(pairs, sample[k])).cross(detail::BearingJ<Scalar>(pairs, sample[k]));
+                Vec3<Scalar> t = n[0].cross(n[1]);
+                if (t.squaredNorm() < n[0].cross(n[2]).squaredNorm())
+                    t = n[0].cross(n[2]);
+                const Scalar norm = t.norm();
+                if (!(norm > std::numeric_limits<Scalar>::epsilon()))
+                    continue;
+                t /= norm;
+                pose.t = detail::CountInFront<Scalar>(pose.R, t, pairs, sample, 3) >= detail::CountInFront<Scalar>(pose.R, -t, pairs, sample, 3) ? t : -t;
+                poses.push_back(pose);
+            }
+            return poses.size();
+        }
+
+        /**
+         * @brief Essential matrix of a pose, E = [t]x R | 位姿对应的本质矩阵
+         */
+        template <typename Scalar>
+        inline Mat3<Scalar> PoseToEssential(const PoseSolution<Scalar> &pose)
+        {
+            Mat3<Scalar> tx;
+            tx << 0, -pose.t(2), pose.t(1), pose.t(2), 0, -pose.t(0), -pose.t(1), pose.t(0), 0;
+            return tx * pose.R;
+        }
+
+        /**
+         * @brief Symmetric angular epipolar error, approximately (1 - cos) summed over both views
+         *        对称角度对极误差，近似为两视图(1 - cos)之和
+         * @details 0.5 * (sin^2 of the angle between xj and the plane E xi + sin^2 of the angle between xi and E^T xj);
+         *          comparable to the thresholds of OpenGV's central relative pose SAC problem.
+         *          与OpenGV中心相对位姿SAC问题的阈值量纲一致。
+         */
+        template <typename Scalar>
+        inline Scalar AngularEpipolarError(const Mat3<Scalar> &E, const Vec3<Scalar> &xi, const Vec3<Scalar> &xj)
+        {
+            const Vec3<Scalar> Exi = E * xi;
+            const Vec3<Scalar> Etxj = E.transpose() * xj;
+            const Scalar r = xj.dot(Exi);
+            const Scalar n1 = Exi.squaredNorm() * xj.squaredNorm();
+            const Scalar n2 = Etxj.squaredNorm() * xi.squaredNorm();
+            if (!(n1 > 0) || !(n2 > 0))
+                return std::numeric_limits<Scalar>::max();
+            return Scalar(0.5) * (r * r / n1 + r * r / n2);
+        }
+
+    } // namespace minimal
+} // namespace common
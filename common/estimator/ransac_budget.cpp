@@ -0,0 +1,144 @@
+#include "ransac_budget.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace common
+{
+    RansacBudgetController::RansacBudgetController(const RansacBudgetOptions &options)
+        : options_(options)
+    {
+        options_.min_iterations = std::max<size_t>(1, options_.min_iterations);
+        options_.max_iterations = std::max(options_.min_iterations, options_.max_iterations);
+        options_.sample_size = std::max<size_t>(1, options_.sample_size);
+        options_.reference_matches = std::max<size_t>(1, options_.reference_matches);
+        options_.graph_prior_max = std::max(options_.graph_prior_min, options_.graph_prior_max);
+        options_.flagged_weight = std::clamp(options_.flagged_weight, 0.0, 1.0);
+        options_.max_inlier_ratio = std::max(options_.min_inlier_ratio, options_.max_inlier_ratio);
+    }
+
+    void RansacBudgetController::BuildViewGraphPrior(const PoSDK::types::Matches &matches)
+    {
+        std::unordered_map<PoSDK::types::IndexT, std::pair<double, size_t>> accum;
+        for (const auto &[view_pair, id_matches] : matches)
+        {
+            auto &acc_i = accum[view_pair.first];
+            acc_i.first += static_cast<double>(id_matches.size());
+            ++acc_i.second;
+            auto &acc_j = accum[view_pair.second];
+            acc_j.first += static_cast<double>(id_matches.size());
+            ++acc_j.second;
+        }
+
+        view_mean_matches_.clear();
+        view_mean_matches_.reserve(accum.size());
+        for (const auto &[view_id, acc] : accum)
+        {
+            view_mean_matches_[view_id] = acc.second > 0 ? acc.first / acc.second : 0.0;
+        }
+    }
+
+    PairMatchStatistics RansacBudgetController::CollectStatistics(const PoSDK::types::ViewPair &view_pair,
+                                                                  const PoSDK::types::IdMatches &matches) const
+    {
+        PairMatchStatistics stats;
+        stats.num_matches = matches.size();
+        for (const auto &match : matches)
+        {
+            if (match.is_inlier)
+                ++stats.num_flagged_inliers;
+        }
+
+        auto it_i = view_mean_matches_.find(view_pair.first);
+        auto it_j = view_mean_matches_.find(view_pair.second);
+        stats.view_i_mean_matches = it_i != view_mean_matches_.end() ? it_i->second : 0.0;
+        stats.view_j_mean_matches = it_j != view_mean_matches_.end() ? it_j->second : 0.0;
+        return stats;
+    }
+
+    double RansacBudgetController::PredictInlierRatio(const PairMatchStatistics &stats) const
+    {
+        if (stats.num_matches == 0)
+            return options_.min_inlier_ratio;
+
+        // Count prior: pairs with few matches are dominated by accidental matches
+        // 匹配数先验：匹配数少的视图对以偶然匹配为主
+        const double count_prior = options_.count_prior_floor +
+                                   options_.count_prior_gain * (1.0 - std::exp(-static_cast<double>(stats.num_matches) /
+                                                                               static_cast<double>(options_.reference_matches)));
+
+        // View-graph prior: a pair stronger than its views' average neighbour is likely a true overlap
+        // 视图图先验：强于两视图平均邻居的视图对更可能是真实重叠
+        double graph_prior = count_prior;
+        const double neighbour_mean = 0.5 * (stats.view_i_mean_matches + stats.view_j_mean_matches);
+        if (neighbour_mean > 0.0)
+        {
+            const double strength = static_cast<double>(stats.num_matches) / neighbour_mean;
+            graph_prior = std::clamp(options_.graph_prior_base + options_.graph_prior_slope * strength,
+                                     options_.graph_prior_min, options_.graph_prior_max);
+        }
+
+        double predicted = std::sqrt(count_prior * graph_prior);
+
+        // Matcher-side flags (e.g. after geometric filtering) are the most direct evidence, but
+        // all-true flags carry no information and are ignored
+        // 匹配阶段的内点标记（如几何过滤后）是最直接的证据，但全为true时不含信息，忽略
+        if (stats.num_flagged_inliers > 0 && stats.num_flagged_inliers < stats.num_matches)
+        {
+            const double flagged_ratio = static_cast<double>(stats.num_flagged_inliers) / stats.num_matches;
+            predicted = options_.flagged_weight * flagged_ratio + (1.0 - options_.flagged_weight) * predicted;
+        }
+
+        return std::clamp(predicted, options_.min_inlier_ratio, options_.max_inlier_ratio);
+    }
+
+    RansacBudget RansacBudgetController::ComputeBudget(const PairMatchStatistics &stats) const
+    {
+        RansacBudget budget;
+        budget.predicted_inlier_ratio = PredictInlierRatio(stats);
+        budget.is_hard = budget.predicted_inlier_ratio < options_.hard_ratio;
+        budget.confidence = budget.is_hard ? options_.hard_confidence : options_.confidence;
+
+        const double sizing_ratio = std::clamp(budget.predicted_inlier_ratio * options_.safety_factor, 0.01, 0.99);
+        budget.max_iterations = std::clamp(RequiredIterations(sizing_ratio, options_.sample_size, budget.confidence),
+                                           options_.min_iterations, options_.max_iterations);
+        return budget;
+    }
+
+    size_t RansacBudgetController::RequiredIterations(double inlier_ratio, size_t sample_size, double confidence)
+    {
+        const double w = std::clamp(inlier_ratio, 1e-6, 1.0);
+        const double p = std::clamp(confidence, 0.0, 1.0 - 1e-12);
+        const double all_inlier_prob = std::pow(w, static_cast<double>(sample_size));
+        if (all_inlier_prob >= 1.0 - 1e-12)
+            return 1;
+
+        const double denom = std::log(1.0 - all_inlier_prob);
+        if (denom >= 0.0)
+            return static_cast<size_t>(-1);
+
+        const double iterations = std::ceil(std::log(1.0 - p) / denom);
+        return iterations > 1e9 ? static_cast<size_t>(1e9) : static_cast<size_t>(iterations);
+    }
+
+    size_t RansacBudgetController::SampleSizeForAlgorithm(const std::string &algorithm)
+    {
+        std::string name = algorithm;
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        if (name.find("homography") != std::string::npos)
+            return 4;
+        if (name.find("eight") != std::string::npos || name.find("8pt") != std::string::npos ||
+            name.find("8point") != std::string::npos || name.find("fundamental") != std::string::npos)
+            return 8;
+        if (name.find("seven") != std::string::npos || name.find("7pt") != std::string::npos)
+            return 7;
+        if (name.find("twopt") != std::string::npos || name.find("2pt") != std::string::npos)
+            return 2; // 包括posdk_affine2pt_ransac（两对仿射对应）
+        if (name.find("rotationonly") != std::string::npos || name.find("3pt") != std::string::npos)
+            return 3;
+        return 5;
+    }
+
+} // namespace common
@@ -0,0 +1,131 @@
+/**
+ * @file ransac_budget.hpp
+ * @brief Per-pair RANSAC budget controller | 逐视图对RANSAC预算控制器
+ * @details Predicts the inlier ratio of a view pair from match-level statistics
+ *          (match count, matcher-side inlier flags, view-graph neighbourhood) and
+ *          derives the iteration cap and confidence for that pair. The inlier threshold is
+ *          left to each backend, whose units differ (pixels, 1-cos, epipolar distance).
+ *          根据匹配级统计量（匹配数、匹配阶段内点标记、视图图邻域）预测视图对的内点率，
+ *          并据此给出该视图对的迭代上限和置信度。内点阈值由各后端自行决定（单位各不相同：像素、1-cos、对极距离）。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <po_core/types.hpp>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace common
+{
+    /**
+     * @brief Budget controller options | 预算控制器参数
+     */
+    struct RansacBudgetOptions
+    {
+        // Minimal sample size of the solver | 求解器最小样本数
+        size_t sample_size = 5;
+        // Iteration cap bounds | 迭代上限范围
+        size_t min_iterations = 50;
+        size_t max_iterations = 2000;
+        // Target confidence for easy pairs | 简单视图对的目标置信度
+        double confidence = 0.99;
+        // Target confidence for hard pairs | 困难视图对的目标置信度
+        double hard_confidence = 0.999;
+        // Predicted ratio is multiplied by this factor before sizing (< 1 is conservative)
+        // 预测内点率在计算迭代次数前乘以该系数（<1更保守）
+        double safety_factor = 0.8;
+        // Pairs predicted below this ratio are treated as hard | 预测内点率低于该值视为困难视图对
+        double hard_ratio = 0.3;
+        // Match count at which the count prior saturates | 匹配数先验饱和的参考匹配数
+        size_t reference_matches = 200;
+        // Count prior = floor + gain * (1 - exp(-n / reference_matches)) | 匹配数先验 = 下限 + 增益 * (1 - exp(-n / 参考匹配数))
+        double count_prior_floor = 0.15;
+        double count_prior_gain = 0.6;
+        // Graph prior = base + slope * (matches / neighbour mean), clamped to [min, max]
+        // 视图图先验 = 基值 + 斜率 * (匹配数 / 邻域平均匹配数)，截断到[min, max]
+        double graph_prior_base = 0.25;
+        double graph_prior_slope = 0.35;
+        double graph_prior_min = 0.1;
+        double graph_prior_max = 0.9;
+        // Weight of the matcher-side inlier flags against the priors | 匹配阶段内点标记相对先验的权重
+        double flagged_weight = 0.7;
+        // Range of the predicted inlier ratio | 预测内点率的范围
+        double min_inlier_ratio = 0.05;
+        double max_inlier_ratio = 0.95;
+    };
+
+    /**
+     * @brief Match-level statistics of one view pair | 单个视图对的匹配级统计量
+     */
+    struct PairMatchStatistics
+    {
+        size_t num_matches = 0;
+        // Matches flagged as inliers by the matching stage | 匹配阶段标记为内点的匹配数
+        size_t num_flagged_inliers = 0;
+        // Mean match count over all pairs touching view i / view j | 视图i/j所有视图对的平均匹配数
+        double view_i_mean_matches = 0.0;
+        double view_j_mean_matches = 0.0;
+    };
+
+    /**
+     * @brief Budget of one view pair | 单个视图对的预算
+     */
+    struct RansacBudget
+    {
+        double predicted_inlier_ratio = 0.0;
+        size_t max_iterations = 0;
+        double confidence = 0.99;
+        bool is_hard = false;
+    };
+
+    /**
+     * @brief Per-pair RANSAC budget controller | 逐视图对RANSAC预算控制器
+     */
+    class RansacBudgetController
+    {
+    public:
+        explicit RansacBudgetController(const RansacBudgetOptions &options);
+
+        /**
+         * @brief Accumulate view-graph neighbourhood statistics | 累计视图图邻域统计量
+         * @param matches All view pairs of the dataset | 数据集全部视图对
+         */
+        void BuildViewGraphPrior(const PoSDK::types::Matches &matches);
+
+        /**
+         * @brief Collect the statistics of one pair | 收集单个视图对的统计量
+         */
+        PairMatchStatistics CollectStatistics(const PoSDK::types::ViewPair &view_pair,
+                                              const PoSDK::types::IdMatches &matches) const;
+
+        /**
+         * @brief Predict the inlier ratio of one pair in [min_inlier_ratio, max_inlier_ratio] | 预测视图对内点率（[min_inlier_ratio, max_inlier_ratio]）
+         */
+        double PredictInlierRatio(const PairMatchStatistics &stats) const;
+
+        /**
+         * @brief Compute the budget of one pair | 计算视图对的预算
+         */
+        RansacBudget ComputeBudget(const PairMatchStatistics &stats) const;
+
+        /**
+         * @brief Standard RANSAC iteration count for a given inlier ratio | 给定内点率下的标准RANSAC迭代次数
+         */
+        static size_t RequiredIterations(double inlier_ratio, size_t sample_size, double confidence);
+
+        /**
+         * @brief Minimal sample size from the algorithm name, 5 by default | 由算法名推断最小样本数，默认为5
+         */
+        static size_t SampleSizeForAlgorithm(const std::string &algorithm);
+
+        const RansacBudgetOptions &GetOptions() const { return options_; }
+
+    private:
+        RansacBudgetOptions options_;
+        std::unordered_map<PoSDK::types::IndexT, double> view_mean_matches_;
+    };
+
+} // namespace common
@@ -0,0 +1,255 @@
+/**
+ * @file track_selection.cpp
+ * @brief Observation-budgeted track subsampling for global SfM | 全局SfM的观测预算轨迹子采样
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#include "track_selection.hpp"
+#include "gt_pose_index.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace common
+{
+    using namespace PoSDK::types;
+
+    namespace
+    {
+        /// Sampson distance of a normalized correspondence under xj = R xi + t | xj = R xi + t下归一化对应的Sampson距离
+        double SampsonDistance(const Matrix3d &E, const Vector3d &xi, const Vector3d &xj)
+        {
+            const Vector3d Exi = E * xi;
+            const Vector3d Etxj = E.transpose() * xj;
+            const double numerator = xj.dot(Exi);
+            const double denominator = Exi.head<2>().squaredNorm() + Etxj.head<2>().squaredNorm();
+            if (!(denominator > 0.0))
+                return std::numeric_limits<double>::infinity();
+            return std::abs(numerator) / std::sqrt(denominator);
+        }
+
+        Matrix3d Skew(const Vector3d &v)
+        {
+            Matrix3d S;
+            S << 0.0, -v.z(), v.y(),
+                v.z(), 0.0, -v.x(),
+                -v.y(), v.x(), 0.0;
+            return S;
+        }
+    } // namespace
+
+    void SelectTracks(const Tracks &tracks,
+                      const CameraModels &cameras,
+                      const RelativePoses *relative_poses,
+                      const TrackSelectionOptions &options,
+                      TrackSelectionResult &result)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        result = TrackSelectionResult();
+        const size_t num_tracks = tracks.size();
+        result.total_tracks = num_tracks;
+
+        // 1. Flatten used observations: view, coordinate | 展平使用中的观测：视图与坐标
+        std::vector<size_t> offset(num_tracks + 1, 0);
+        for (size_t t = 0; t < num_tracks; ++t)
+        {
+            const TrackInfo &track = tracks.GetTrack(t);
+            size_t used = 0;
+            if (track.IsUsed())
+            {
+                for (size_t j = 0; j < track.GetObservationCount(); ++j)
+                    used += track.GetObservation(static_cast<IndexT>(j)).IsUsed();
+            }
+            offset[t + 1] = offset[t] + used;
+        }
+        const size_t num_obs = offset.back();
+        result.total_observations = num_obs;
+
+        std::vector<ViewId> obs_view(num_obs);
+        std::vector<Vector2d> obs_coord(num_obs);
+        ViewId max_view = 0;
+        for (size_t t = 0; t < num_tracks; ++t)
+        {
+            if (offset[t + 1] == offset[t])
+                continue;
+            const TrackInfo &track = tracks.GetTrack(t);
+            size_t k = offset[t];
+            for (size_t j = 0; j < track.GetObservationCount(); ++j)
+            {
+                const ObsInfo &ob = track.GetObservation(static_cast<IndexT>(j));
+                if (!ob.IsUsed())
+                    continue;
+                obs_view[k] = ob.GetViewId();
+                obs_coord[k] = ob.GetCoord();
+                max_view = std::max(max_view, ob.GetViewId());
+                ++k;
+            }
+        }
+
+        // Budget covers everything: keep all tracks | 预算覆盖全部观测：保留所有轨迹
+        const size_t min_length = std::max<size_t>(2, options.min_track_length);
+        if (options.target_observations == 0 || options.target_observations >= num_obs)
+        {
+            std::vector<char> seen(num_obs > 0 ? max_view + 1 : 0, 0);
+            for (size_t t = 0; t < num_tracks; ++t)
+            {
+                if (offset[t + 1] - offset[t] < min_length && options.target_observations != 0)
+                    continue;
+                result.selected.push_back(t);
+                result.selected_observations += offset[t + 1] - offset[t];
+                for (size_t k = offset[t]; k < offset[t + 1]; ++k)
+                    seen[obs_view[k]] = 1;
+            }
+            result.views = result.covered_views = static_cast<size_t>(std::count(seen.begin(), seen.end(), 1));
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return;
+        }
+
+        // 2. Per-image grid over the observation bounding box | 以观测包围盒划分逐图像网格
+        const size_t num_views = static_cast<size_t>(max_view) + 1;
+        const int cols = std::max(1, options.grid_cols);
+        const int rows = std::max(1, options.grid_rows);
+        std::vector<Eigen::Vector4d> bounds(num_views, Eigen::Vector4d(std::numeric_limits<double>::max(),
+                                                                       std::numeric_limits<double>::max(),
+                                                                       std::numeric_limits<double>::lowest(),
+                                                                       std::numeric_limits<double>::lowest()));
+        for (size_t k = 0; k < num_obs; ++k)
+        {
+            Eigen::Vector4d &b = bounds[obs_view[k]];
+            b(0) = std::min(b(0), obs_coord[k].x());
+            b(1) = std::min(b(1), obs_coord[k].y());
+            b(2) = std::max(b(2), obs_coord[k].x());
+            b(3) = std::max(b(3), obs_coord[k].y());
+        }
+        std::vector<uint32_t> obs_cell(num_obs);
+        const size_t cells_per_view = static_cast<size_t>(cols) * rows;
+        for (size_t k = 0; k < num_obs; ++k)
+        {
+            const Eigen::Vector4d &b = bounds[obs_view[k]];
+            const double w = std::max(b(2) - b(0), 1e-12), h = std::max(b(3) - b(1), 1e-12);
+            const int cx = std::clamp(static_cast<int>((obs_coord[k].x() - b(0)) / w * cols), 0, cols - 1);
+            const int cy = std::clamp(static_cast<int>((obs_coord[k].y() - b(1)) / h * rows), 0, rows - 1);
+            obs_cell[k] = static_cast<uint32_t>(cy * cols + cx);
+        }
+
+        // 3. Score: length^a * exp(-0.5 (sampson / sigma)^2) | 评分：长度^a × exp(-0.5 (Sampson/sigma)^2)
+        GTRelativePoseIndex pose_index;
+        pose_index.Reset(relative_poses);
+        const bool normalized = tracks.IsNormalized();
+        std::vector<Vector3d> rays;
+        std::vector<double> focal;
+        std::vector<double> score(num_tracks, 0.0);
+        for (size_t t = 0; t < num_tracks; ++t)
+        {
+            const size_t begin = offset[t], length = offset[t + 1] - begin;
+            if (length < min_length)
+                continue;
+            double consistency = 1.0;
+            if (!pose_index.Empty() && !cameras.empty())
+            {
+                rays.resize(length);
+                focal.resize(length);
+                for (size_t a = 0; a < length; ++a)
+                {
+                    const ViewId view = obs_view[begin + a];
+                    const CameraModel *camera = cameras[view];
+                    const Vector2d n = (normalized || !camera) ? obs_coord[begin + a] : camera->PixelToNormalized(obs_coord[begin + a]);
+                    rays[a] = Vector3d(n.x(), n.y(), 1.0);
+                    focal[a] = camera ? 0.5 * (camera->GetIntrinsics().GetFx() + camera->GetIntrinsics().GetFy()) : 1.0;
+                }
+                // Each observation is checked against the nearest earlier one with a relative pose
+                // 每个观测与之前最近的、有相对位姿的观测做对极检查
+                double sum_sq = 0.0;
+                size_t checked = 0;
+                for (size_t a = 1; a < length; ++a)
+                {
+                    for (size_t b = a; b-- > 0 && a - b <= 4;)
+                    {
+                        Matrix3d R;
+                        Vector3d tr;
+                        if (!pose_index.Find(ViewPair(obs_view[begin + b], obs_view[begin + a]), R, tr))
+                            continue;
+                        const double error = SampsonDistance(Skew(tr.normalized()) * R, rays[b], rays[a]) *
+                                             0.5 * (focal[a] + focal[b]);
+                        sum_sq += std::isfinite(error) ? error * error : 0.0;
+                        ++checked;
+                        break;
+                    }
+                }
+                if (checked > 0)
+                {
+                    const double rms = std::sqrt(sum_sq / checked) / std::max(options.consistency_sigma, 1e-9);
+                    consistency = std::exp(-0.5 * rms * rms);
+                }
+            }
+            score[t] = std::pow(static_cast<double>(length), options.length_exponent) * consistency;
+        }
+
+        std::vector<size_t> order;
+        order.reserve(num_tracks);
+        for (size_t t = 0; t < num_tracks; ++t)
+        {
+            if (offset[t + 1] - offset[t] >= min_length)
+                order.push_back(t);
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                         { return score[a] > score[b]; });
+
+        // 4. Greedy passes with a rising per-cell quota until the budget is met
+        //    A track is taken if any of its observations lands in a cell below the quota
+        //    逐轮提高单元格配额的贪心选择，直到满足预算；轨迹的任一观测落在未满配额的单元格即被选中
+        std::vector<uint32_t> cell_count(num_views * cells_per_view, 0);
+        std::vector<char> taken(num_tracks, 0);
+        size_t quota = 1;
+        size_t remaining = order.size();
+        while (result.selected_observations < options.target_observations && remaining > 0)
+        {
+            for (const size_t t : order)
+            {
+                if (taken[t])
+                    continue;
+                bool below_quota = false;
+                for (size_t k = offset[t]; k < offset[t + 1] && !below_quota; ++k)
+                    below_quota = cell_count[obs_view[k] * cells_per_view + obs_cell[k]] < quota;
+                if (!below_quota)
+                    continue;
+                taken[t] = 1;
+                --remaining;
+                for (size_t k = offset[t]; k < offset[t + 1]; ++k)
+                    ++cell_count[obs_view[k] * cells_per_view + obs_cell[k]];
+                result.selected_observations += offset[t + 1] - offset[t];
+                if (result.selected_observations >= options.target_observations)
+                    break;
+            }
+            result.final_cell_quota = quota;
+            quota += std::max<size_t>(1, quota / 2);
+        }
+
+        std::vector<char> seen(num_views, 0), covered(num_views, 0);
+        for (size_t t = 0; t < num_tracks; ++t)
+        {
+            for (size_t k = offset[t]; k < offset[t + 1]; ++k)
+            {
+                seen[obs_view[k]] = 1;
+                covered[obs_view[k]] |= taken[t];
+            }
+            if (taken[t])
+                result.selected.push_back(t);
+        }
+        result.views = static_cast<size_t>(std::count(seen.begin(), seen.end(), 1));
+        result.covered_views = static_cast<size_t>(std::count(covered.begin(), covered.end(), 1));
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void ExtractTracks(const Tracks &tracks, const std::vector<size_t> &selected, Tracks &subset)
+    {
+        subset.clear();
+        subset.reserve(selected.size());
+        for (const size_t t : selected)
+            subset.push_back(tracks.GetTrack(t));
+        subset.SetNormalized(tracks.IsNormalized());
+    }
+
+} // namespace common
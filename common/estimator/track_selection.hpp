@@ -0,0 +1,69 @@
+/**
+ * @file track_selection.hpp
+ * @brief Observation-budgeted track subsampling for global SfM | 全局SfM的观测预算轨迹子采样
+ * @details Global translation estimation and bundle adjustment cost grows with the number of
+ *          observations, while most tracks are redundant for the poses. Tracks are scored by length
+ *          and two-view epipolar consistency (Sampson error under the estimated relative poses), then
+ *          picked in score order under a per-image grid quota that is raised until the observation
+ *          budget is reached, so every image keeps its best tracks spread over the whole frame.
+ *          全局平移估计和光束法平差的代价随观测数增长，而多数轨迹对位姿是冗余的。轨迹按长度和双视图
+ *          对极一致性（在估计的相对位姿下的Sampson误差）评分，再在逐图像网格配额下按分数挑选，配额逐步
+ *          提高直到达到观测预算，使每幅图像都保留分布于整幅画面的最优轨迹。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <po_core/types.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace common
+{
+    struct TrackSelectionOptions
+    {
+        size_t target_observations = 0;  ///< Observation budget, 0 = keep all | 观测预算，0表示全部保留
+        int grid_cols = 8;               ///< Grid columns per image | 每幅图像的网格列数
+        int grid_rows = 6;               ///< Grid rows per image | 每幅图像的网格行数
+        double length_exponent = 1.0;    ///< Score ~ length^exponent | 分数与长度的幂次关系
+        double consistency_sigma = 2.0;  ///< Pixels; score ~ exp(-0.5 (sampson / sigma)^2) | 像素
+        size_t min_track_length = 2;     ///< Shorter tracks are never selected | 更短的轨迹不参与选择
+    };
+
+    struct TrackSelectionResult
+    {
+        std::vector<size_t> selected;      ///< Selected track ids, ascending | 选中的轨迹ID（升序）
+        size_t total_tracks = 0;
+        size_t total_observations = 0;     ///< Used observations of all tracks | 全部轨迹的使用中观测数
+        size_t selected_observations = 0;
+        size_t views = 0;                  ///< Views with at least one observation | 至少有一个观测的视图数
+        size_t covered_views = 0;          ///< Views kept by the selection | 选择后仍被覆盖的视图数
+        size_t final_cell_quota = 0;       ///< Grid quota of the last pass | 最后一轮的网格配额
+        double seconds = 0.0;
+    };
+
+    /**
+     * @brief Select a spatially uniform, high-quality track subset | 选择空间均匀的高质量轨迹子集
+     * @param tracks Tracks in pixel or normalized coordinates | 像素或归一化坐标的轨迹
+     * @param cameras Camera models (pixel -> normalized for the epipolar check) | 相机模型
+     * @param relative_poses Relative poses (xj = R xi + t) for the consistency score; nullptr scores by length only
+     *                       用于一致性评分的相对位姿；nullptr时仅按长度评分
+     * @param options Budget and grid | 预算与网格
+     * @param result Output selection | 输出选择结果
+     */
+    void SelectTracks(const PoSDK::types::Tracks &tracks,
+                      const PoSDK::types::CameraModels &cameras,
+                      const PoSDK::types::RelativePoses *relative_poses,
+                      const TrackSelectionOptions &options,
+                      TrackSelectionResult &result);
+
+    /**
+     * @brief Copy the selected tracks into a new collection (keeps the normalization flag)
+     *        将选中的轨迹复制到新集合（保留归一化标记）
+     */
+    void ExtractTracks(const PoSDK::types::Tracks &tracks,
+                       const std::vector<size_t> &selected,
+                       PoSDK::types::Tracks &subset);
+
+} // namespace common
@@ -0,0 +1,453 @@
+#include "track_triangulation.hpp"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace common
+{
+    using namespace PoSDK::types;
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        int ResolveThreads(int num_threads)
+        {
+            if (num_threads > 0)
+                return num_threads;
+            return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+
+        /// World-to-camera rotation and camera centre of a view: xc = R * (X - C) | 视图的世界到相机旋转与相机中心
+        struct ViewCamera
+        {
+            Matrix3d R = Matrix3d::Identity();
+            Vector3d C = Vector3d::Zero();
+            double focal = 1.0;
+            bool valid = false;
+        };
+
+        bool ToViewCamera(const Matrix3d &rotation, const Vector3d &translation, PoseFormat format, ViewCamera &camera)
+        {
+            if (!rotation.allFinite() || !translation.allFinite())
+                return false;
+            switch (format)
+            {
+            case PoseFormat::RwTw: // xc = Rw * (Xw - tw)
+                camera.R = rotation;
+                camera.C = translation;
+                break;
+            case PoseFormat::RwTc: // xc = Rw * Xw + tc
+                camera.R = rotation;
+                camera.C = -rotation.transpose() * translation;
+                break;
+            case PoseFormat::RcTw: // xc = Rc^T * (Xw - tw)
+                camera.R = rotation.transpose();
+                camera.C = translation;
+                break;
+            case PoseFormat::RcTc: // xc = Rc^T * Xw + tc
+                camera.R = rotation.transpose();
+                camera.C = -rotation * translation;
+                break;
+            default:
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Flattened observations of all tracks (SoA) | 全部轨迹的展平观测（SoA）
+         * @details Track t owns [offset[t], offset[t+1]); weight 0 marks observations without a pose/camera.
+         *          轨迹t占用[offset[t], offset[t+1])；weight为0的观测无位姿/相机。
+         */
+        struct ObservationArrays
+        {
+            std::vector<size_t> offset;
+            std::vector<double> nx, ny;     // normalized image coordinates | 归一化图像坐标
+            std::vector<double> dx, dy, dz; // unit ray direction in world frame | 世界系单位射线方向
+            std::vector<double> cx, cy, cz; // camera centre | 相机中心
+            std::vector<double> weight;     // 1 = usable, 0 = skipped | 1可用，0跳过
+            std::vector<uint32_t> view;     // index into the view camera table | 视图相机表下标
+
+            void Resize(size_t n)
+            {
+                for (auto *array : {&nx, &ny, &dx, &dy, &dz, &cx, &cy, &cz, &weight})
+                    array->assign(n, 0.0);
+                view.assign(n, 0);
+            }
+        };
+
+        /// Midpoint: minimise sum_k w_k |(I - d_k d_k^T)(X - C_k)|^2 | 中点法：最小化加权射线距离平方和
+        bool SolveMidpoint(const ObservationArrays &obs, const double *w, size_t begin, size_t end, Vector3d &X)
+        {
+            double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+            double b0 = 0, b1 = 0, b2 = 0;
+            for (size_t k = begin; k < end; ++k)
+            {
+                const double wk = w[k];
+                const double x = obs.dx[k], y = obs.dy[k], z = obs.dz[k];
+                const double p00 = wk * (1.0 - x * x), p01 = -wk * x * y, p02 = -wk * x * z;
+                const double p11 = wk * (1.0 - y * y), p12 = -wk * y * z, p22 = wk * (1.0 - z * z);
+                a00 += p00;
+                a01 += p01;
+                a02 += p02;
+                a11 += p11;
+                a12 += p12;
+                a22 += p22;
+                b0 += p00 * obs.cx[k] + p01 * obs.cy[k] + p02 * obs.cz[k];
+                b1 += p01 * obs.cx[k] + p11 * obs.cy[k] + p12 * obs.cz[k];
+                b2 += p02 * obs.cx[k] + p12 * obs.cy[k] + p22 * obs.cz[k];
+            }
+            Matrix3d A;
+            A << a00, a01, a02, a01, a11, a12, a02, a12, a22;
+            const Eigen::LDLT<Matrix3d> ldlt(A);
+            if (ldlt.info() != Eigen::Success || !(ldlt.vectorD().minCoeff() > 1e-12 * std::max(1.0, A.trace())))
+                return false;
+            X = ldlt.solve(Vector3d(b0, b1, b2));
+            return X.allFinite();
+        }
+
+        /// DLT: rows x*P3 - P1, y*P3 - P2 with P = [R | -R C], null vector of A^T A | DLT：A^T A的零空间向量
+        bool SolveDLT(const ObservationArrays &obs, const std::vector<ViewCamera> &cameras,
+                      const double *w, size_t begin, size_t end, Vector3d &X)
+        {
+            Eigen::Matrix4d AtA = Eigen::Matrix4d::Zero();
+            for (size_t k = begin; k < end; ++k)
+            {
+                if (w[k] == 0.0)
+                    continue;
+                const ViewCamera &camera = cameras[obs.view[k]];
+                const Vector3d t = -camera.R * camera.C;
+                Eigen::Matrix<double, 2, 4> rows;
+                rows.block<1, 3>(0, 0) = obs.nx[k] * camera.R.row(2) - camera.R.row(0);
+                rows.block<1, 3>(1, 0) = obs.ny[k] * camera.R.row(2) - camera.R.row(1);
+                rows(0, 3) = obs.nx[k] * t(2) - t(0);
+                rows(1, 3) = obs.ny[k] * t(2) - t(1);
+                AtA.noalias() += w[k] * rows.transpose() * rows;
+            }
+            const Eigen::SelfAdjointEigenSolver<Eigen::Matrix4d> eigen(AtA);
+            if (eigen.info() != Eigen::Success)
+                return false;
+            const Eigen::Vector4d h = eigen.eigenvectors().col(0);
+            if (!(std::abs(h(3)) > 1e-12 * h.head<3>().norm()))
+                return false;
+            X = h.head<3>() / h(3);
+            return X.allFinite();
+        }
+
+        /// Largest angle between any two weighted rays, as its cosine | 任意两条加权射线间的最大夹角（余弦）
+        double MinRayCosine(const ObservationArrays &obs, const double *w, size_t begin, size_t end)
+        {
+            double min_cos = 1.0;
+            for (size_t a = begin; a < end; ++a)
+            {
+                if (w[a] == 0.0)
+                    continue;
+                for (size_t b = a + 1; b < end; ++b)
+                {
+                    const double c = obs.dx[a] * obs.dx[b] + obs.dy[a] * obs.dy[b] + obs.dz[a] * obs.dz[b];
+                    min_cos = std::min(min_cos, w[b] != 0.0 ? c : 1.0);
+                }
+            }
+            return min_cos;
+        }
+
+        enum class TrackOutcome
+        {
+            Triangulated,
+            TooFewObservations,
+            RejectedAngle,
+            RejectedCheirality,
+            RejectedReprojection
+        };
+    } // namespace
+
+    bool ParseTriangulationKernel(const std::string &name, TriangulationKernel &kernel)
+    {
+        std::string lower = name;
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+                       [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        if (lower == "midpoint")
+            kernel = TriangulationKernel::Midpoint;
+        else if (lower == "dlt")
+            kernel = TriangulationKernel::DLT;
+        else
+            return false;
+        return true;
+    }
+
+    bool TriangulateTracks(const Tracks &tracks,
+                           const GlobalPoses &poses,
+                           const CameraModels &cameras,
+                           const TrackTriangulationOptions &options,
+                           WorldPointInfo &points,
+                           TrackTriangulationStats *stats)
+    {
+        const auto start = Clock::now();
+        const size_t num_tracks = tracks.size();
+        points.resize(num_tracks);
+        if (cameras.empty())
+            return false;
+
+        // 1. View table: pose convention and focal length resolved once per view | 视图表：每个视图只解析一次位姿约定和焦距
+        std::vector<ViewCamera> view_cameras(poses.Size());
+        for (size_t view = 0; view < view_cameras.size(); ++view)
+        {
+            const CameraModel *camera = cameras[static_cast<ViewId>(view)];
+            if (!camera)
+                continue;
+            ViewCamera &entry = view_cameras[view];
+            entry.valid = ToViewCamera(poses.GetRotation(static_cast<ViewId>(view)),
+                                       poses.GetTranslation(static_cast<ViewId>(view)),
+                                       poses.GetPoseFormat(), entry);
+            const auto &intrinsics = camera->GetIntrinsics();
+            entry.focal = 0.5 * (intrinsics.GetFx() + intrinsics.GetFy());
+            if (!(entry.focal > 0.0))
+                entry.focal = 1.0;
+        }
+
+        // 2. Flatten observations into SoA arrays | 将观测展平为SoA数组
+        ObservationArrays obs;
+        obs.offset.resize(num_tracks + 1, 0);
+        for (size_t t = 0; t < num_tracks; ++t)
+            obs.offset[t + 1] = obs.offset[t] + tracks.GetTrack(t).GetObservationCount();
+        obs.Resize(obs.offset.back());
+
+        const int num_threads = ResolveThreads(options.num_threads);
+        const size_t block_size = std::max<size_t>(1, options.block_size);
+        const long long num_blocks = static_cast<long long>((num_tracks + block_size - 1) / block_size);
+        const bool normalized = tracks.IsNormalized();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads) if (num_blocks > 1)
+#endif
+        for (long long block = 0; block < num_blocks; ++block)
+        {
+            const size_t first = static_cast<size_t>(block) * block_size;
+            const size_t last = std::min(num_tracks, first + block_size);
+            for (size_t t = first; t < last; ++t)
+            {
+                const TrackInfo &track = tracks.GetTrack(t);
+                if (!track.IsUsed())
+                    continue;
+                for (size_t j = 0; j < track.GetObservationCount(); ++j)
+                {
+                    const ObsInfo &ob = track.GetObservation(static_cast<IndexT>(j));
+                    const ViewId view = ob.GetViewId();
+                    if (!ob.IsUsed() || view >= view_cameras.size() || !view_cameras[view].valid)
+                        continue;
+                    const ViewCamera &camera = view_cameras[view];
+                    const Vector2d n = normalized ? ob.GetCoord() : cameras[view]->PixelToNormalized(ob.GetCoord());
+                    const Vector3d d = (camera.R.transpose() * Vector3d(n.x(), n.y(), 1.0)).normalized();
+                    const size_t k = obs.offset[t] + j;
+                    obs.nx[k] = n.x();
+                    obs.ny[k] = n.y();
+                    obs.dx[k] = d.x();
+                    obs.dy[k] = d.y();
+                    obs.dz[k] = d.z();
+                    obs.cx[k] = camera.C.x();
+                    obs.cy[k] = camera.C.y();
+                    obs.cz[k] = camera.C.z();
+                    obs.weight[k] = 1.0;
+                    obs.view[k] = static_cast<uint32_t>(view);
+                }
+            }
+        }
+
+        // 3. Triangulate, then cheirality and reprojection checks per track | 逐轨迹三角化，再做正深度与重投影检查
+        Points3d solved = Points3d::Zero(3, static_cast<Eigen::Index>(num_tracks));
+        std::vector<TrackOutcome> outcomes(num_tracks, TrackOutcome::TooFewObservations);
+        std::vector<double> inlier_mask(obs.weight.size(), 0.0);
+        std::vector<double> active_weight = obs.weight;
+        const double min_cos = std::cos(options.min_angle_deg * EIGEN_PI / 180.0);
+        const size_t min_observations = std::max<size_t>(2, options.min_observations);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads) if (num_blocks > 1)
+#endif
+        for (long long block = 0; block < num_blocks; ++block)
+        {
+            const size_t first = static_cast<size_t>(block) * block_size;
+            const size_t last = std::min(num_tracks, first + block_size);
+            for (size_t t = first; t < last; ++t)
+            {
+                const size_t begin = obs.offset[t], end = obs.offset[t + 1];
+                double *mask = inlier_mask.data();
+
+                const auto solve = [&](const double *w, Vector3d &X)
+                {
+                    if (MinRayCosine(obs, w, begin, end) > min_cos)
+                        return false;
+                    return options.kernel == TriangulationKernel::DLT
+                               ? SolveDLT(obs, view_cameras, w, begin, end, X)
+                               : SolveMidpoint(obs, w, begin, end, X);
+                };
+                // Classify the observations of weight w against X: fills mask, returns the inlier count,
+                // the in-front count and the observation with the largest error
+                // 按权重w对观测分类：填写掩码，返回内点数、正深度观测数及误差最大的观测
+                const auto check = [&](const Vector3d &X, const double *w, size_t &in_front, size_t &worst)
+                {
+                    size_t inliers = 0;
+                    double worst_error = -1.0;
+                    in_front = 0;
+                    worst = end;
+                    for (size_t k = begin; k < end; ++k)
+                    {
+                        mask[k] = 0.0;
+                        if (w[k] == 0.0)
+                            continue;
+                        const ViewCamera &camera = view_cameras[obs.view[k]];
+                        const Vector3d p = camera.R * (X - camera.C);
+                        double error = std::numeric_limits<double>::infinity();
+                        if (p.z() > 1e-9 * (X - camera.C).norm())
+                        {
+                            ++in_front;
+                            const double ex = p.x() / p.z() - obs.nx[k];
+                            const double ey = p.y() / p.z() - obs.ny[k];
+                            error = camera.focal * std::sqrt(ex * ex + ey * ey);
+                            if (error <= options.max_reprojection_error)
+                            {
+                                mask[k] = 1.0;
+                                ++inliers;
+                            }
+                        }
+                        if (error > worst_error)
+                        {
+                            worst_error = error;
+                            worst = k;
+                        }
+                    }
+                    return inliers;
+                };
+
+                size_t usable = 0;
+                for (size_t k = begin; k < end; ++k)
+                    usable += obs.weight[k] != 0.0;
+                if (usable < min_observations)
+                    continue;
+
+                // Drop the worst observation until min_observations agree, then refit once on the inliers
+                // 逐次剔除误差最大的观测直到至少min_observations个观测一致，再用内点重新三角化一次
+                double *active = active_weight.data();
+                size_t active_count = usable;
+                Vector3d X, candidate;
+                bool has_solution = false;
+                size_t in_front = 0, worst = end;
+                while (solve(active, candidate))
+                {
+                    X = candidate;
+                    has_solution = true;
+                    const size_t inliers = check(X, active, in_front, worst);
+                    if (inliers == active_count)
+                        break;
+                    if (inliers >= min_observations)
+                    {
+                        if (options.refine_with_inliers && solve(mask, candidate) &&
+                            check(candidate, active, in_front, worst) >= inliers)
+                            X = candidate;
+                        break;
+                    }
+                    if (active_count <= min_observations || worst == end)
+                        break;
+                    active[worst] = 0.0;
+                    --active_count;
+                }
+                if (!has_solution)
+                {
+                    outcomes[t] = TrackOutcome::RejectedAngle;
+                    continue;
+                }
+
+                // Final classification against all usable observations | 针对全部可用观测做最终分类
+                const size_t inliers = check(X, obs.weight.data(), in_front, worst);
+                if (in_front < min_observations)
+                    outcomes[t] = TrackOutcome::RejectedCheirality;
+                else if (inliers < min_observations)
+                    outcomes[t] = TrackOutcome::RejectedReprojection;
+                else if (MinRayCosine(obs, mask, begin, end) > min_cos)
+                    outcomes[t] = TrackOutcome::RejectedAngle;
+                else
+                {
+                    outcomes[t] = TrackOutcome::Triangulated;
+                    solved.col(static_cast<Eigen::Index>(t)) = X;
+                }
+            }
+        }
+
+        // 4. Write points (ids_used is a bit vector, so written serially) | 写出点（ids_used为位向量，串行写入）
+        TrackTriangulationStats local;
+        local.tracks = num_tracks;
+        bool any_color = false;
+        for (size_t t = 0; t < num_tracks; ++t)
+        {
+            const bool ok = outcomes[t] == TrackOutcome::Triangulated;
+            points.setPoint(t, solved.col(static_cast<Eigen::Index>(t)));
+            points.setUsed(t, ok);
+            switch (outcomes[t])
+            {
+            case TrackOutcome::Triangulated:
+                ++local.triangulated;
+                break;
+            case TrackOutcome::TooFewObservations:
+                ++local.too_few_observations;
+                break;
+            case TrackOutcome::RejectedAngle:
+                ++local.rejected_angle;
+                break;
+            case TrackOutcome::RejectedCheirality:
+                ++local.rejected_cheirality;
+                break;
+            case TrackOutcome::RejectedReprojection:
+                ++local.rejected_reprojection;
+                break;
+            }
+            if (!ok)
+                continue;
+
+            // Average colour of the inlier observations | 内点观测的平均颜色
+            const TrackInfo &track = tracks.GetTrack(t);
+            std::array<double, 3> sum = {0.0, 0.0, 0.0};
+            size_t colored = 0;
+            for (size_t j = 0; j < track.GetObservationCount(); ++j)
+            {
+                const ObsInfo &ob = track.GetObservation(static_cast<IndexT>(j));
+                if (inlier_mask[obs.offset[t] + j] == 0.0 || !ob.HasColor())
+                    continue;
+                for (int c = 0; c < 3; ++c)
+                    sum[c] += ob.GetColorRGB()[c];
+                ++colored;
+            }
+            if (colored == 0)
+                continue;
+            if (!any_color)
+            {
+                points.InitializeColors();
+                any_color = true;
+            }
+            points.SetColorRGB(t, static_cast<uint8_t>(std::lround(sum[0] / colored)),
+                               static_cast<uint8_t>(std::lround(sum[1] / colored)),
+                               static_cast<uint8_t>(std::lround(sum[2] / colored)));
+        }
+
+        if (stats)
+        {
+            for (const double w : obs.weight)
+                local.observations += w != 0.0;
+            local.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            *stats = local;
+        }
+        return true;
+    }
+
+} // namespace common
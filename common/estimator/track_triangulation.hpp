@@ -0,0 +1,80 @@
+/**
+ * @file track_triangulation.hpp
+ * @brief Parallel batch triangulation of feature tracks | 特征轨迹的并行批量三角化
+ * @details Observations of all tracks are flattened once into SoA arrays (world ray direction,
+ *          camera centre, world-to-camera rotation, focal length, normalized coordinates), so the
+ *          midpoint/DLT accumulation, cheirality and reprojection checks run as contiguous loops
+ *          that the compiler vectorises. Tracks are processed in blocks on OpenMP threads.
+ *          所有轨迹的观测先一次性展平为SoA数组（世界系射线方向、相机中心、世界到相机旋转、焦距、
+ *          归一化坐标），中点/DLT累加、正深度和重投影检查均为可向量化的连续循环；轨迹按块在
+ *          OpenMP线程上处理。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <po_core/types.hpp>
+#include <cstddef>
+#include <string>
+
+namespace common
+{
+    /**
+     * @brief Triangulation kernel | 三角化核
+     */
+    enum class TriangulationKernel
+    {
+        Midpoint, ///< Multi-view midpoint: min sum of squared ray distances (3x3 solve) | 多视图中点：射线距离平方和最小（3x3求解）
+        DLT       ///< Homogeneous DLT on normalized coordinates (4x4 eigen) | 归一化坐标上的齐次DLT（4x4特征分解）
+    };
+
+    /**
+     * @brief Parse "midpoint"/"dlt" (case-insensitive) | 解析"midpoint"/"dlt"（不区分大小写）
+     * @return false for an unknown name | 未知名称返回false
+     */
+    bool ParseTriangulationKernel(const std::string &name, TriangulationKernel &kernel);
+
+    struct TrackTriangulationOptions
+    {
+        TriangulationKernel kernel = TriangulationKernel::Midpoint;
+        double max_reprojection_error = 4.0; ///< Pixels | 像素
+        double min_angle_deg = 1.0;          ///< Minimum max-pairwise ray angle of a point | 点的最大射线夹角下限
+        size_t min_observations = 2;         ///< Inlier observations required per point | 每个点所需的内点观测数
+        bool refine_with_inliers = true;     ///< Re-triangulate once from the inlier observations | 用内点观测重新三角化一次
+        int num_threads = 0;                 ///< 0 = OpenMP default | 0表示OpenMP默认线程数
+        size_t block_size = 4096;            ///< Tracks per parallel work item | 每个并行任务的轨迹数
+    };
+
+    struct TrackTriangulationStats
+    {
+        size_t tracks = 0;
+        size_t observations = 0;           ///< Observations with a pose and camera | 有位姿和相机的观测数
+        size_t triangulated = 0;           ///< Points marked used in the output | 输出中标记为使用的点
+        size_t too_few_observations = 0;   ///< Fewer than min_observations posed views | 有位姿视图不足
+        size_t rejected_angle = 0;         ///< Triangulation angle below min_angle_deg | 三角化角度不足
+        size_t rejected_cheirality = 0;    ///< Too few observations in front of the camera | 相机前方观测不足
+        size_t rejected_reprojection = 0;  ///< Too few observations within the reprojection threshold | 重投影误差内观测不足
+        double seconds = 0.0;
+    };
+
+    /**
+     * @brief Triangulate every track from global poses | 由全局位姿三角化全部轨迹
+     * @param tracks Tracks, in pixel or normalized coordinates (Tracks::IsNormalized()) | 轨迹（像素或归一化坐标）
+     * @param poses Global poses in any PoseFormat | 任意PoseFormat的全局位姿
+     * @param cameras Camera models (pixel -> normalized, focal length for the pixel threshold) | 相机模型
+     * @param options Kernel and checks | 三角化核与检查
+     * @param points Output, one point per track (index = track id); failed tracks are marked unused.
+     *               Observation colours, when present, are averaged into the point colour.
+     *               输出，每条轨迹一个点（下标即轨迹ID），失败轨迹标记为未使用；观测带颜色时取平均作为点颜色
+     * @param stats Optional statistics | 可选统计
+     * @return false if the inputs are inconsistent (e.g. no camera model) | 输入不一致（如无相机模型）时返回false
+     */
+    bool TriangulateTracks(const PoSDK::types::Tracks &tracks,
+                           const PoSDK::types::GlobalPoses &poses,
+                           const PoSDK::types::CameraModels &cameras,
+                           const TrackTriangulationOptions &options,
+                           PoSDK::types::WorldPointInfo &points,
+                           TrackTriangulationStats *stats = nullptr);
+
+} // namespace common
@@ -0,0 +1,8 @@
+#include "two_view_batch.hpp"
+
+namespace common
+{
+    // Key function, see TypedViewPairTarget (option_schema.cpp)
+    TwoViewBatchEstimator::~TwoViewBatchEstimator() = default;
+
+} // namespace common
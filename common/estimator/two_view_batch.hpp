@@ -0,0 +1,91 @@
+/**
+ * @file two_view_batch.hpp
+ * @brief Batched two-view estimation interface | 批量双视图估计接口
+ * @details Estimator plugins that can process many view pairs per call implement
+ *          TwoViewBatchEstimator in addition to MethodPreset. TwoViewEstimator
+ *          detects it with dynamic_cast and falls back to per-pair Build() otherwise.
+ *          可一次处理多个视图对的估计器插件在MethodPreset之外实现TwoViewBatchEstimator，
+ *          TwoViewEstimator通过dynamic_cast检测，不支持时回退到逐对Build()。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <common/estimator/ransac_budget.hpp>
+#include <po_core/types.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace common
+{
+    /**
+     * @brief One view pair of a batch | 批次中的一个视图对
+     * @note Buffers are borrowed from the caller and must outlive EstimateBatch()
+     *       缓冲区由调用方持有，需在EstimateBatch()期间保持有效
+     */
+    struct TwoViewBatchItem
+    {
+        // View pair (i, j) | 视图对(i, j)
+        PoSDK::types::ViewPair view_pair;
+        // Preconverted bearing pairs, one per match | 预转换的射线对，与匹配一一对应
+        const PoSDK::types::BearingPairs *bearing_pairs = nullptr;
+        // Per-pair RANSAC budget (iteration cap, confidence), nullptr keeps the estimator options
+        // 逐对RANSAC预算（迭代上限、置信度），为空时沿用估计器选项
+        const RansacBudget *budget = nullptr;
+    };
+
+    /**
+     * @brief Estimation result of one batch item | 批次单项的估计结果
+     */
+    struct TwoViewBatchResult
+    {
+        // Whether a valid model was found | 是否得到有效模型
+        bool success = false;
+        // Relative pose in the estimator's internal convention (same as per-pair Build())
+        // 估计器内部约定下的相对位姿（与逐对Build()一致）
+        PoSDK::types::RelativePose pose;
+        // Inlier bitset aligned with bearing_pairs | 与bearing_pairs对齐的内点位集
+        std::vector<bool> inliers;
+        // Realised RANSAC iterations, 0 if not reported | 实际RANSAC迭代次数，未上报时为0
+        size_t iterations = 0;
+    };
+
+    /**
+     * @brief Non-owning view over contiguous batch items (C++17 stand-in for std::span)
+     *        连续批次元素的非拥有视图（C++17下代替std::span）
+     */
+    struct TwoViewBatchSpan
+    {
+        const TwoViewBatchItem *data = nullptr;
+        size_t size = 0;
+
+        const TwoViewBatchItem &operator[](size_t i) const { return data[i]; }
+        bool empty() const { return size == 0; }
+    };
+
+    /**
+     * @brief Batch estimation capability of a two-view estimator | 双视图估计器的批量估计能力
+     */
+    class TwoViewBatchEstimator
+    {
+    public:
+        virtual ~TwoViewBatchEstimator();
+
+        /**
+         * @brief Whether the current options can be served by EstimateBatch()
+         *        当前配置是否可由EstimateBatch()处理
+         * @details e.g. algorithms that need per-pair priors return false | 例如需要逐对先验的算法返回false
+         */
+        virtual bool SupportsBatchEstimation() = 0;
+
+        /**
+         * @brief Estimate relative poses for all items | 批量估计相对位姿
+         * @param items Batch items | 批次元素
+         * @param[out] results One result per item, same order | 与items同序的结果
+         */
+        virtual void EstimateBatch(const TwoViewBatchSpan &items,
+                                   std::vector<TwoViewBatchResult> &results) = 0;
+    };
+
+} // namespace common
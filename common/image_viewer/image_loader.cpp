@@ -0,0 +1,55 @@
+#include "image_loader.hpp"
+#include <opencv2/imgcodecs.hpp>
+
+namespace common
+{
+
+    int ImageLoader::NormalizeReduceFactor(int reduce_factor)
+    {
+        if (reduce_factor >= 8)
+            return 8;
+        if (reduce_factor >= 4)
+            return 4;
+        if (reduce_factor >= 2)
+            return 2;
+        return 1;
+    }
+
+    int ImageLoader::GetReadFlag(int reduce_factor, bool color)
+    {
+        switch (NormalizeReduceFactor(reduce_factor))
+        {
+        case 2:
+            return color ? cv::IMREAD_REDUCED_COLOR_2 : cv::IMREAD_REDUCED_GRAYSCALE_2;
+        case 4:
+            return color ? cv::IMREAD_REDUCED_COLOR_4 : cv::IMREAD_REDUCED_GRAYSCALE_4;
+        case 8:
+            return color ? cv::IMREAD_REDUCED_COLOR_8 : cv::IMREAD_REDUCED_GRAYSCALE_8;
+        default:
+            return color ? cv::IMREAD_COLOR : cv::IMREAD_GRAYSCALE;
+        }
+    }
+
+    ImageLoader::ReducedImage ImageLoader::Load(const std::string &path, int reduce_factor, bool color)
+    {
+        ReducedImage result;
+        result.reduce_factor = NormalizeReduceFactor(reduce_factor);
+        result.scale = 1.0 / static_cast<double>(result.reduce_factor);
+        result.image = cv::imread(path, GetReadFlag(result.reduce_factor, color));
+        return result;
+    }
+
+    void ImageLoader::ScaleKeyPoints(std::vector<cv::KeyPoint> &keypoints, double scale)
+    {
+        if (scale == 1.0)
+            return;
+
+        for (auto &kp : keypoints)
+        {
+            kp.pt.x = static_cast<float>(kp.pt.x * scale);
+            kp.pt.y = static_cast<float>(kp.pt.y * scale);
+            kp.size = static_cast<float>(kp.size * scale);
+        }
+    }
+
+} // namespace common
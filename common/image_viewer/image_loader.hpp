@@ -0,0 +1,66 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <opencv2/features2d.hpp>
+#include <string>
+#include <vector>
+
+namespace common
+{
+
+    /**
+     * @brief Reduced-resolution image loading service | 低分辨率图像加载服务
+     *
+     * Maps a requested downscale factor to the decoder's native reduced modes
+     * (cv::IMREAD_REDUCED_{GRAYSCALE,COLOR}_{2,4,8}). For JPEG the DCT is decoded
+     * at reduced size directly, so preview/visualisation stages never materialise
+     * the full-resolution frame.
+     * 将降采样因子映射到解码器原生的降分辨率模式，JPEG可在DCT阶段直接按缩小尺寸解码，
+     * 预览/可视化阶段无需生成全分辨率图像。
+     */
+    class ImageLoader
+    {
+    public:
+        // Decoded image together with the applied scale | 解码图像及实际缩放比例
+        struct ReducedImage
+        {
+            // Decoded pixels | 解码后的图像
+            cv::Mat image;
+            // Applied native reduce factor (1, 2, 4 or 8) | 实际使用的原生降采样因子
+            int reduce_factor = 1;
+            // Scale from full-resolution coordinates to image coordinates | 全分辨率坐标到当前图像坐标的缩放
+            double scale = 1.0;
+        };
+
+        /**
+         * @brief Clamp an arbitrary factor to the largest native one not above it | 将任意因子归一到不超过它的最大原生因子
+         * @param reduce_factor Requested factor | 请求的因子
+         * @return 1, 2, 4 or 8
+         */
+        static int NormalizeReduceFactor(int reduce_factor);
+
+        /**
+         * @brief cv::imread flag for a reduce factor | 获取降采样因子对应的cv::imread标志
+         * @param reduce_factor Native factor (normalized internally) | 原生因子（内部归一化）
+         * @param color Decode as BGR instead of grayscale | 是否按彩色解码
+         */
+        static int GetReadFlag(int reduce_factor, bool color);
+
+        /**
+         * @brief Decode an image at a native reduced resolution | 按原生降分辨率解码图像
+         * @param path Image file path | 图像路径
+         * @param reduce_factor Requested factor, 1 keeps full resolution | 请求的因子，1为全分辨率
+         * @param color Decode as BGR instead of grayscale | 是否按彩色解码
+         * @return Decoded image (empty on failure) with applied factor | 解码结果（失败时image为空）
+         */
+        static ReducedImage Load(const std::string &path, int reduce_factor, bool color = true);
+
+        /**
+         * @brief Bring full-resolution keypoints into reduced image coordinates | 将全分辨率特征点转换到降分辨率坐标
+         * @param keypoints Keypoints in full-resolution coordinates | 全分辨率坐标下的特征点
+         * @param scale Scale returned by Load() | Load()返回的缩放比例
+         */
+        static void ScaleKeyPoints(std::vector<cv::KeyPoint> &keypoints, double scale);
+    };
+
+} // namespace common
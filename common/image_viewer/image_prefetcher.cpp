@@ -0,0 +1,397 @@
+#include "image_prefetcher.hpp"
+#include <opencv2/imgcodecs.hpp>
+#include <po_core/po_logger.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#ifdef USE_LIBURING
+#include <fcntl.h>
+#include <liburing.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace common
+{
+    namespace
+    {
+        // Synchronous whole-file read used by the thread-pool backend | 线程池后端使用的同步整文件读取
+        std::string ReadFileBytes(const std::string &path, std::vector<uchar> &data)
+        {
+            std::FILE *file = std::fopen(path.c_str(), "rb");
+            if (!file)
+            {
+                return "cannot open: " + std::string(std::strerror(errno));
+            }
+
+            std::string error;
+            long size = -1;
+            if (std::fseek(file, 0, SEEK_END) == 0)
+            {
+                size = std::ftell(file);
+            }
+            if (size <= 0 || std::fseek(file, 0, SEEK_SET) != 0)
+            {
+                error = "empty or unreadable file";
+            }
+            else
+            {
+                data.resize(static_cast<size_t>(size));
+                if (std::fread(data.data(), 1, data.size(), file) != data.size())
+                {
+                    error = "short read";
+                }
+            }
+            std::fclose(file);
+            return error;
+        }
+    } // namespace
+
+    PrefetchingImageReader::PrefetchingImageReader(std::vector<std::string> paths, std::vector<int> decode_flags,
+                                                   const Options &options)
+        : paths_(std::move(paths)), decode_flags_(std::move(decode_flags)), options_(options), backend_("thread_pool")
+    {
+        if (paths_.empty())
+        {
+            return;
+        }
+
+        const size_t depth = std::min(std::max<size_t>(1, options_.prefetch_depth), paths_.size());
+        slots_.resize(depth);
+        for (size_t i = 0; i < depth; ++i)
+        {
+            slots_[i].index = i;
+        }
+
+        if (options_.use_io_uring && StartIoUring())
+        {
+            backend_ = "io_uring";
+            return;
+        }
+
+        const size_t num_threads = std::min(std::max<size_t>(1, options_.num_io_threads), depth);
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            io_threads_.emplace_back(&PrefetchingImageReader::ThreadPoolLoop, this);
+        }
+    }
+
+    PrefetchingImageReader::~PrefetchingImageReader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        slot_free_.notify_all();
+        slot_ready_.notify_all();
+        for (auto &thread : io_threads_)
+        {
+            thread.join();
+        }
+
+#ifdef USE_LIBURING
+        if (ring_)
+        {
+            auto *ring = static_cast<io_uring *>(ring_);
+            io_uring_queue_exit(ring);
+            delete ring;
+        }
+#endif
+    }
+
+    bool PrefetchingImageReader::IsIoUringCompiled()
+    {
+#ifdef USE_LIBURING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    PrefetchingImageReader::Image PrefetchingImageReader::Take(size_t index)
+    {
+        Image image;
+        image.index = index;
+        if (index >= paths_.size())
+        {
+            image.error = "index out of range";
+            return image;
+        }
+        image.path = paths_[index];
+
+        Slot &slot = slots_[index % slots_.size()];
+        std::unique_lock<std::mutex> lock(mutex_);
+        slot_ready_.wait(lock, [&]
+                         { return stopping_ || (slot.index == index && slot.state == SlotState::READY); });
+        if (slot.index != index || slot.state != SlotState::READY)
+        {
+            image.error = "reader stopped";
+            return image;
+        }
+        image.error = slot.error;
+        lock.unlock();
+
+        // Decode outside the lock; the slot stays READY for this index until released below
+        // 在锁外解码；释放前该槽位对此索引保持READY状态
+        if (image.Ok())
+        {
+            image.decoded.reserve(decode_flags_.size());
+            for (int flag : decode_flags_)
+            {
+                cv::Mat decoded = cv::imdecode(slot.data, flag);
+                if (decoded.empty())
+                {
+                    image.error = "cv::imdecode failed (flag " + std::to_string(flag) + ")";
+                }
+                image.decoded.push_back(std::move(decoded));
+            }
+        }
+
+        lock.lock();
+        slot.data.clear(); // Keeps capacity for the next image | 保留容量供下一张图像复用
+        slot.error.clear();
+        slot.index = index + slots_.size();
+        slot.state = slot.index < paths_.size() ? SlotState::FREE : SlotState::DONE;
+        lock.unlock();
+        slot_free_.notify_all();
+        return image;
+    }
+
+    bool PrefetchingImageReader::Next(Image &image)
+    {
+        size_t index;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (next_take_ >= paths_.size())
+            {
+                return false;
+            }
+            index = next_take_++;
+        }
+        image = Take(index);
+        return true;
+    }
+
+    bool PrefetchingImageReader::ClaimNextLoad(size_t &index, bool wait)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto claimable = [this]
+        {
+            if (next_load_ >= paths_.size())
+                return false;
+            const Slot &slot = slots_[next_load_ % slots_.size()];
+            return slot.state == SlotState::FREE && slot.index == next_load_;
+        };
+
+        if (wait)
+        {
+            slot_free_.wait(lock, [&]
+                            { return stopping_ || next_load_ >= paths_.size() || claimable(); });
+        }
+        if (stopping_ || !claimable())
+        {
+            return false;
+        }
+
+        index = next_load_++;
+        slots_[index % slots_.size()].state = SlotState::LOADING;
+        return true;
+    }
+
+    void PrefetchingImageReader::PublishLoad(size_t index, std::string error)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Slot &slot = slots_[index % slots_.size()];
+            slot.error = std::move(error);
+            slot.state = SlotState::READY;
+        }
+        slot_ready_.notify_all();
+    }
+
+    void PrefetchingImageReader::ThreadPoolLoop()
+    {
+        size_t index;
+        while (ClaimNextLoad(index, true))
+        {
+            // LOADING slots are only touched by the claiming thread | LOADING状态的槽位只由认领线程访问
+            Slot &slot = slots_[index % slots_.size()];
+            PublishLoad(index, ReadFileBytes(paths_[index], slot.data));
+        }
+    }
+
+#ifdef USE_LIBURING
+    bool PrefetchingImageReader::StartIoUring()
+    {
+        auto *ring = new io_uring;
+        const int ret = io_uring_queue_init(static_cast<unsigned>(slots_.size()), ring, 0);
+        if (ret < 0)
+        {
+            // Typically blocked by seccomp or an old kernel | 通常是被seccomp拦截或内核过旧
+            LOG_DEBUG_ZH << "[PrefetchingImageReader] io_uring不可用 (" << std::strerror(-ret) << ")，使用线程池读取";
+            LOG_DEBUG_EN << "[PrefetchingImageReader] io_uring unavailable (" << std::strerror(-ret) << "), using thread-pool reads";
+            delete ring;
+            return false;
+        }
+
+        ring_ = ring;
+        io_threads_.emplace_back(&PrefetchingImageReader::IoUringLoop, this);
+        return true;
+    }
+
+    void PrefetchingImageReader::IoUringLoop()
+    {
+        struct ReadOp
+        {
+            size_t index = 0;
+            int fd = -1;
+            size_t offset = 0;
+            size_t size = 0;
+        };
+
+        auto *ring = static_cast<io_uring *>(ring_);
+        std::vector<ReadOp> ops(slots_.size());
+        size_t in_flight = 0;
+
+        auto submit_read = [&](size_t slot_id)
+        {
+            io_uring_sqe *sqe = io_uring_get_sqe(ring);
+            if (!sqe)
+                return false;
+            ReadOp &op = ops[slot_id];
+            io_uring_prep_read(sqe, op.fd, slots_[slot_id].data.data() + op.offset,
+                               static_cast<unsigned>(op.size - op.offset), op.offset);
+            io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(slot_id));
+            ++in_flight;
+            return true;
+        };
+
+        auto finish = [&](size_t slot_id, std::string error)
+        {
+            ReadOp &op = ops[slot_id];
+            if (op.fd >= 0)
+            {
+                ::close(op.fd);
+                op.fd = -1;
+            }
+            PublishLoad(op.index, std::move(error));
+        };
+
+        while (true)
+        {
+            // Block for a free slot only when nothing is in flight | 仅在没有在途读取时阻塞等待空闲槽位
+            size_t index;
+            bool submitted = false;
+            while (ClaimNextLoad(index, in_flight == 0 && !submitted))
+            {
+                const size_t slot_id = index % slots_.size();
+                ReadOp &op = ops[slot_id];
+                op = ReadOp{};
+                op.index = index;
+                op.fd = ::open(paths_[index].c_str(), O_RDONLY | O_CLOEXEC);
+                if (op.fd < 0)
+                {
+                    finish(slot_id, "cannot open: " + std::string(std::strerror(errno)));
+                    continue;
+                }
+
+                struct stat st;
+                if (::fstat(op.fd, &st) != 0 || st.st_size <= 0)
+                {
+                    finish(slot_id, "empty or unreadable file");
+                    continue;
+                }
+                op.size = static_cast<size_t>(st.st_size);
+                slots_[slot_id].data.resize(op.size);
+
+                if (!submit_read(slot_id))
+                {
+                    finish(slot_id, ReadFileBytes(paths_[index], slots_[slot_id].data));
+                    continue;
+                }
+                submitted = true;
+            }
+
+            if (in_flight == 0)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stopping_ || next_load_ >= paths_.size())
+                    break;
+                continue;
+            }
+
+            io_uring_submit(ring);
+            io_uring_cqe *cqe = nullptr;
+            const int ret = io_uring_wait_cqe(ring, &cqe);
+            if (ret == -EINTR)
+            {
+                continue;
+            }
+            if (ret < 0)
+            {
+                // Ring failure: finish in-flight reads synchronously and continue on this thread
+                // 队列故障：同步完成在途读取，并在当前线程继续读取
+                LOG_WARNING_ZH << "[PrefetchingImageReader] io_uring等待失败 (" << std::strerror(-ret) << ")，回退到同步读取";
+                LOG_WARNING_EN << "[PrefetchingImageReader] io_uring wait failed (" << std::strerror(-ret) << "), falling back to synchronous reads";
+                for (size_t slot_id = 0; slot_id < ops.size(); ++slot_id)
+                {
+                    if (ops[slot_id].fd >= 0)
+                    {
+                        finish(slot_id, ReadFileBytes(paths_[ops[slot_id].index], slots_[slot_id].data));
+                    }
+                }
+                ThreadPoolLoop();
+                return;
+            }
+
+            unsigned head;
+            unsigned completed = 0;
+            io_uring_for_each_cqe(ring, head, cqe)
+            {
+                ++completed;
+                --in_flight;
+                const size_t slot_id = reinterpret_cast<size_t>(io_uring_cqe_get_data(cqe));
+                ReadOp &op = ops[slot_id];
+                if (cqe->res < 0)
+                {
+                    finish(slot_id, "read failed: " + std::string(std::strerror(-cqe->res)));
+                }
+                else if (cqe->res == 0)
+                {
+                    finish(slot_id, "unexpected end of file");
+                }
+                else
+                {
+                    op.offset += static_cast<size_t>(cqe->res);
+                    if (op.offset < op.size)
+                    {
+                        // Short read: queue the remainder | 短读：提交剩余部分
+                        if (!submit_read(slot_id))
+                        {
+                            finish(slot_id, ReadFileBytes(paths_[op.index], slots_[slot_id].data));
+                        }
+                    }
+                    else
+                    {
+                        finish(slot_id, std::string());
+                    }
+                }
+            }
+            io_uring_cq_advance(ring, completed);
+        }
+    }
+#else
+    bool PrefetchingImageReader::StartIoUring()
+    {
+        return false;
+    }
+
+    void PrefetchingImageReader::IoUringLoop()
+    {
+    }
+#endif
+
+} // namespace common
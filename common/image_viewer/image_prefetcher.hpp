@@ -0,0 +1,136 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+
+    /**
+     * @brief Prefetching image reader for ingest-heavy stages | 面向读图密集阶段的预取图像读取器
+     *
+     * Reads the encoded bytes of the next prefetch_depth images ahead of the consumers
+     * into a ring of reused buffers, using io_uring when available (POMVG_USE_IO_URING)
+     * and a small I/O thread pool otherwise. Take() decodes from memory with cv::imdecode
+     * on the calling thread, so decoding and feature extraction overlap with storage latency.
+     * 使用io_uring（可用时）或小型I/O线程池，将后续prefetch_depth张图像的编码字节预读到复用的
+     * 环形缓冲区中。Take()在调用线程上用cv::imdecode从内存解码，使解码与特征提取和存储延迟重叠。
+     *
+     * Every index must be taken exactly once, in roughly ascending order across threads
+     * (an OpenMP loop over the indices, or Next()). Buffer i % depth is reused for image i + depth.
+     * 每个索引必须且只能被Take()一次，且各线程整体按升序获取（如对索引的OpenMP循环或Next()）。
+     * 第i % depth个缓冲区会在图像i之后复用给图像i + depth。
+     */
+    class PrefetchingImageReader
+    {
+    public:
+        struct Options
+        {
+            // Images read ahead of the consumers, also the number of pooled buffers | 预读图像数，也是缓冲区池大小
+            size_t prefetch_depth = 8;
+            // Reader threads of the thread-pool backend | 线程池后端的读取线程数
+            size_t num_io_threads = 2;
+            // Prefer io_uring when compiled in and supported by the kernel | 编译支持且内核可用时优先使用io_uring
+            bool use_io_uring = true;
+        };
+
+        // One decoded image | 单张解码结果
+        struct Image
+        {
+            size_t index = 0;
+            std::string path;
+            // One Mat per decode flag, in constructor order | 每个解码标志对应一个Mat，顺序同构造参数
+            std::vector<cv::Mat> decoded;
+            // Empty on success | 成功时为空
+            std::string error;
+
+            bool Ok() const { return error.empty(); }
+        };
+
+        /**
+         * @param paths Image paths, index i of Take() refers to paths[i] | 图像路径，Take()的索引i对应paths[i]
+         * @param decode_flags cv::imread flags decoded from the same bytes, e.g. {IMREAD_GRAYSCALE, IMREAD_COLOR}
+         *                     从同一份字节解码的cv::imread标志
+         * @param options Prefetch options | 预取参数
+         */
+        PrefetchingImageReader(std::vector<std::string> paths, std::vector<int> decode_flags,
+                               const Options &options);
+        ~PrefetchingImageReader();
+
+        PrefetchingImageReader(const PrefetchingImageReader &) = delete;
+        PrefetchingImageReader &operator=(const PrefetchingImageReader &) = delete;
+
+        size_t Size() const { return paths_.size(); }
+
+        /**
+         * @brief Wait for image index, decode it and recycle its buffer | 等待指定图像读取完成，解码并回收缓冲区
+         * @note Thread-safe | 线程安全
+         */
+        Image Take(size_t index);
+
+        /**
+         * @brief Take the next index not yet taken by Next() | 获取Next()尚未获取的下一张图像
+         * @return false when all images were returned | 全部返回后为false
+         * @note Do not mix with Take() on the same reader | 同一读取器不要与Take()混用
+         */
+        bool Next(Image &image);
+
+        /**
+         * @brief "io_uring" or "thread_pool" | 实际使用的后端
+         */
+        const std::string &BackendName() const { return backend_; }
+
+        /**
+         * @brief Whether io_uring support was compiled in | 是否编译了io_uring支持
+         */
+        static bool IsIoUringCompiled();
+
+    private:
+        enum class SlotState
+        {
+            FREE,    // Waiting to load slot.index | 等待加载slot.index
+            LOADING, // Read in progress | 正在读取
+            READY,   // Bytes (or error) available | 字节（或错误）可用
+            DONE     // No more images map to this slot | 不再有图像映射到该槽位
+        };
+
+        struct Slot
+        {
+            std::vector<uchar> data;
+            size_t index = 0;
+            SlotState state = SlotState::FREE;
+            std::string error;
+        };
+
+        bool ClaimNextLoad(size_t &index, bool wait);
+        void PublishLoad(size_t index, std::string error);
+        void ThreadPoolLoop();
+        bool StartIoUring();
+        void IoUringLoop();
+
+        std::vector<std::string> paths_;
+        std::vector<int> decode_flags_;
+        Options options_;
+        std::string backend_;
+
+        std::vector<Slot> slots_;
+        size_t next_load_ = 0;
+        size_t next_take_ = 0;
+        bool stopping_ = false;
+
+        std::mutex mutex_;
+        std::condition_variable slot_ready_;
+        std::condition_variable slot_free_;
+        std::vector<std::thread> io_threads_;
+
+        // io_uring instance (struct io_uring), kept opaque to avoid leaking liburing headers
+        // io_uring实例（struct io_uring），保持不透明以免暴露liburing头文件
+        void *ring_ = nullptr;
+    };
+
+} // namespace common
@@ -0,0 +1,656 @@
+#include "artifact_compression.hpp"
+#include <po_core/po_logger.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace common
+{
+    namespace
+    {
+        const char kHeaderMagic[8] = {'P', 'O', 'S', 'D', 'K', 'Z', 'A', '1'};
+        const char kFooterMagic[8] = {'P', 'O', 'S', 'D', 'K', 'Z', 'I', 'X'};
+        const uint32_t kFormatVersion = 1;
+        const uint64_t kHeaderSize = sizeof(kHeaderMagic) + sizeof(uint32_t);
+        const uint64_t kFooterSize = sizeof(uint64_t) + sizeof(kFooterMagic);
+
+        using Clock = std::chrono::steady_clock;
+
+        double SecondsSince(const Clock::time_point &start)
+        {
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        int ResolveThreads(int num_threads)
+        {
+            if (num_threads > 0)
+                return num_threads;
+            return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+
+        template <typename T>
+        void WritePod(std::ostream &out, const T &value)
+        {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        bool ReadPod(std::istream &in, T &value)
+        {
+            return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+        }
+
+        /**
+         * @brief Compress one frame, falling back to STORED if zstd is missing or not beneficial
+         *        压缩单帧，无zstd或压缩无收益时回退为原样存储
+         * @param frame_threads zstd worker threads inside this frame | 帧内zstd工作线程数
+         */
+        void CompressFrame(const std::string &raw, int level, int frame_threads,
+                           std::string &stored, ArtifactCodec &codec)
+        {
+#ifdef USE_ZSTD
+            if (!raw.empty())
+            {
+                ZSTD_CCtx *cctx = ZSTD_createCCtx();
+                if (cctx)
+                {
+                    ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+                    ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1);
+                    if (frame_threads > 1)
+                    {
+                        // Ignored when libzstd is built without ZSTD_MULTITHREAD | libzstd未启用多线程时忽略
+                        ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, frame_threads);
+                    }
+                    stored.resize(ZSTD_compressBound(raw.size()));
+                    const size_t written = ZSTD_compress2(cctx, stored.data(), stored.size(), raw.data(), raw.size());
+                    ZSTD_freeCCtx(cctx);
+                    if (!ZSTD_isError(written) && written < raw.size())
+                    {
+                        stored.resize(written);
+                        codec = ArtifactCodec::ZSTD;
+                        return;
+                    }
+                }
+            }
+#else
+            (void)level;
+            (void)frame_threads;
+#endif
+            stored = raw;
+            codec = ArtifactCodec::STORED;
+        }
+
+        bool DecompressFrame(const ArtifactFrameInfo &frame, const std::string &stored, char *raw)
+        {
+            if (frame.codec == ArtifactCodec::STORED)
+            {
+                if (stored.size() != frame.raw_size)
+                    return false;
+                std::memcpy(raw, stored.data(), stored.size());
+                return true;
+            }
+#ifdef USE_ZSTD
+            if (frame.codec == ArtifactCodec::ZSTD)
+            {
+                const size_t written = ZSTD_decompress(raw, frame.raw_size, stored.data(), stored.size());
+                return !ZSTD_isError(written) && written == frame.raw_size;
+            }
+#endif
+            return false;
+        }
+
+        bool ReadStoredFrame(const std::string &path, const ArtifactFrameInfo &frame, std::string &stored)
+        {
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+                return false;
+            in.seekg(static_cast<std::streamoff>(frame.stored_offset));
+            stored.resize(frame.stored_size);
+            return frame.stored_size == 0 ||
+                   static_cast<bool>(in.read(stored.data(), static_cast<std::streamsize>(frame.stored_size)));
+        }
+    } // namespace
+
+    // ==================== SeekableArtifactWriter ====================
+
+    SeekableArtifactWriter::SeekableArtifactWriter(const ArtifactCompressionOptions &options)
+        : options_(options)
+    {
+        options_.num_threads = ResolveThreads(options_.num_threads);
+    }
+
+    SeekableArtifactWriter::~SeekableArtifactWriter()
+    {
+        if (open_)
+        {
+            Finish();
+        }
+    }
+
+    bool SeekableArtifactWriter::Open(const std::string &path)
+    {
+        out_.open(path, std::ios::binary | std::ios::trunc);
+        if (!out_)
+        {
+            return false;
+        }
+        out_.write(kHeaderMagic, sizeof(kHeaderMagic));
+        WritePod(out_, kFormatVersion);
+
+        pending_.clear();
+        frames_.clear();
+        raw_offset_ = 0;
+        stored_offset_ = kHeaderSize;
+        seconds_ = 0.0;
+        open_ = static_cast<bool>(out_);
+        return open_;
+    }
+
+    bool SeekableArtifactWriter::AddFrame(const std::string &key, std::string data)
+    {
+        if (!open_)
+        {
+            return false;
+        }
+        pending_.emplace_back(key, std::move(data));
+        if (pending_.size() >= static_cast<size_t>(options_.num_threads))
+        {
+            return FlushPending();
+        }
+        return true;
+    }
+
+    bool SeekableArtifactWriter::FlushPending()
+    {
+        if (pending_.empty())
+        {
+            return true;
+        }
+
+        const auto start = Clock::now();
+        const int num_frames = static_cast<int>(pending_.size());
+        // A lone frame uses zstd workers inside the frame; a batch is parallel across frames
+        // 单帧时在帧内使用zstd工作线程；多帧时按帧并行
+        const int frame_threads = num_frames == 1 ? options_.num_threads : 1;
+
+        std::vector<std::string> stored(num_frames);
+        std::vector<ArtifactCodec> codecs(num_frames, ArtifactCodec::STORED);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(options_.num_threads) if (num_frames > 1)
+#endif
+        for (int k = 0; k < num_frames; ++k)
+        {
+            CompressFrame(pending_[k].second, options_.level, frame_threads, stored[k], codecs[k]);
+        }
+
+        for (int k = 0; k < num_frames; ++k)
+        {
+            ArtifactFrameInfo frame;
+            frame.key = pending_[k].first;
+            frame.raw_offset = raw_offset_;
+            frame.raw_size = pending_[k].second.size();
+            frame.stored_offset = stored_offset_;
+            frame.stored_size = stored[k].size();
+            frame.codec = codecs[k];
+
+            out_.write(stored[k].data(), static_cast<std::streamsize>(stored[k].size()));
+            raw_offset_ += frame.raw_size;
+            stored_offset_ += frame.stored_size;
+            frames_.push_back(std::move(frame));
+        }
+
+        pending_.clear();
+        seconds_ += SecondsSince(start);
+        return static_cast<bool>(out_);
+    }
+
+    bool SeekableArtifactWriter::Finish(ArtifactCompressionStats *stats)
+    {
+        if (!open_)
+        {
+            return false;
+        }
+        open_ = false;
+
+        bool ok = FlushPending();
+
+        const uint64_t index_offset = stored_offset_;
+        WritePod(out_, static_cast<uint64_t>(frames_.size()));
+        for (const auto &frame : frames_)
+        {
+            WritePod(out_, static_cast<uint32_t>(frame.key.size()));
+            out_.write(frame.key.data(), static_cast<std::streamsize>(frame.key.size()));
+            WritePod(out_, frame.raw_offset);
+            WritePod(out_, frame.raw_size);
+            WritePod(out_, frame.stored_offset);
+            WritePod(out_, frame.stored_size);
+            WritePod(out_, static_cast<uint32_t>(frame.codec));
+        }
+        WritePod(out_, index_offset);
+        out_.write(kFooterMagic, sizeof(kFooterMagic));
+        ok = ok && static_cast<bool>(out_);
+        out_.close();
+
+        if (stats)
+        {
+            stats->raw_bytes = raw_offset_;
+            stats->stored_bytes = stored_offset_ - kHeaderSize;
+            stats->num_frames = frames_.size();
+            stats->seconds = seconds_;
+        }
+        return ok;
+    }
+
+    // ==================== SeekableArtifactReader ====================
+
+    bool SeekableArtifactReader::Open(const std::string &path)
+    {
+        path_ = path;
+        frames_.clear();
+        raw_size_ = 0;
+
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+        {
+            return false;
+        }
+        const uint64_t file_size = static_cast<uint64_t>(in.tellg());
+        if (file_size < kHeaderSize + sizeof(uint64_t) + kFooterSize)
+        {
+            return false;
+        }
+
+        char magic[8];
+        in.seekg(0);
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kHeaderMagic, sizeof(magic)) != 0)
+        {
+            return false;
+        }
+
+        uint64_t index_offset = 0;
+        in.seekg(static_cast<std::streamoff>(file_size - kFooterSize));
+        if (!ReadPod(in, index_offset) || !in.read(magic, sizeof(magic)) ||
+            std::memcmp(magic, kFooterMagic, sizeof(magic)) != 0 ||
+            index_offset < kHeaderSize || index_offset >= file_size - kFooterSize)
+        {
+            return false;
+        }
+
+        in.seekg(static_cast<std::streamoff>(index_offset));
+        uint64_t frame_count = 0;
+        if (!ReadPod(in, frame_count))
+        {
+            return false;
+        }
+
+        // Every index entry takes at least kMinEntrySize bytes, which bounds frame_count by the file
+        // 每个索引项至少占kMinEntrySize字节，据此由文件大小约束frame_count
+        const uint64_t index_end = file_size - kFooterSize;
+        const uint64_t kMinEntrySize = sizeof(uint32_t) + 4 * sizeof(uint64_t) + sizeof(uint32_t);
+        if (frame_count > (index_end - index_offset) / kMinEntrySize)
+        {
+            return false;
+        }
+
+        // Frames must tile the raw stream without gaps or overlaps and lie inside the payload area,
+        // so RawSize() and ReadAll() can trust raw_offset/raw_size
+        // 帧必须无间隙、无重叠地拼接出原始数据流并位于负载区内，RawSize()和ReadAll()才能信任raw_offset/raw_size
+        uint64_t raw_end = 0;
+        uint64_t stored_end = kHeaderSize;
+        std::vector<ArtifactFrameInfo> frames;
+        frames.reserve(static_cast<size_t>(frame_count));
+        for (uint64_t k = 0; k < frame_count; ++k)
+        {
+            ArtifactFrameInfo frame;
+            uint32_t key_size = 0;
+            uint32_t codec = 0;
+            if (!ReadPod(in, key_size) || key_size > index_end - index_offset)
+            {
+                return false;
+            }
+            frame.key.resize(key_size);
+            if ((key_size > 0 && !in.read(frame.key.data(), key_size)) ||
+                !ReadPod(in, frame.raw_offset) || !ReadPod(in, frame.raw_size) ||
+                !ReadPod(in, frame.stored_offset) || !ReadPod(in, frame.stored_size) ||
+                !ReadPod(in, codec))
+            {
+                return false;
+            }
+            if (frame.raw_offset != raw_end ||
+                frame.raw_size > std::numeric_limits<uint64_t>::max() - raw_end ||
+                frame.stored_offset != stored_end ||
+                frame.stored_size > index_offset - stored_end ||
+                (codec != static_cast<uint32_t>(ArtifactCodec::STORED) &&
+                 codec != static_cast<uint32_t>(ArtifactCodec::ZSTD)) ||
+                (codec == static_cast<uint32_t>(ArtifactCodec::STORED) && frame.raw_size != frame.stored_size))
+            {
+                return false;
+            }
+            frame.codec = static_cast<ArtifactCodec>(codec);
+            raw_end += frame.raw_size;
+            stored_end += frame.stored_size;
+            frames.push_back(std::move(frame));
+        }
+        if (raw_end > static_cast<uint64_t>(std::numeric_limits<size_t>::max()) ||
+            raw_end > static_cast<uint64_t>(std::string().max_size()))
+        {
+            return false;
+        }
+
+        frames_ = std::move(frames);
+        raw_size_ = raw_end;
+        return true;
+    }
+
+    bool SeekableArtifactReader::ReadFrame(size_t index, std::string &data) const
+    {
+        if (index >= frames_.size())
+        {
+            return false;
+        }
+        const auto &frame = frames_[index];
+        std::string stored;
+        if (!ReadStoredFrame(path_, frame, stored))
+        {
+            return false;
+        }
+        data.resize(frame.raw_size);
+        return DecompressFrame(frame, stored, data.data());
+    }
+
+    bool SeekableArtifactReader::ReadAllFrames(std::vector<std::string> &frames, int num_threads) const
+    {
+        num_threads = ResolveThreads(num_threads);
+        frames.assign(frames_.size(), std::string());
+
+        bool ok = true;
+        const int num_frames = static_cast<int>(frames_.size());
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads) reduction(&& : ok)
+#endif
+        for (int k = 0; k < num_frames; ++k)
+        {
+            ok = ReadFrame(static_cast<size_t>(k), frames[k]) && ok;
+        }
+        return ok;
+    }
+
+    bool SeekableArtifactReader::ReadAll(std::string &data, int num_threads, ArtifactCompressionStats *stats) const
+    {
+        const auto start = Clock::now();
+        num_threads = ResolveThreads(num_threads);
+        data.resize(static_cast<size_t>(raw_size_));
+
+        bool ok = true;
+        const int num_frames = static_cast<int>(frames_.size());
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads) reduction(&& : ok)
+#endif
+        for (int k = 0; k < num_frames; ++k)
+        {
+            const auto &frame = frames_[k];
+            std::string stored;
+            ok = ReadStoredFrame(path_, frame, stored) &&
+                 DecompressFrame(frame, stored, data.data() + frame.raw_offset) && ok;
+        }
+
+        if (stats)
+        {
+            stats->raw_bytes = raw_size_;
+            stats->stored_bytes = 0;
+            for (const auto &frame : frames_)
+                stats->stored_bytes += frame.stored_size;
+            stats->num_frames = frames_.size();
+            stats->seconds = SecondsSince(start);
+        }
+        return ok;
+    }
+
+    // ==================== File helpers ====================
+
+    bool IsArtifactCompressionAvailable()
+    {
+#ifdef USE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    const std::string &CompressedArtifactSuffix()
+    {
+        static const std::string suffix = ".pozst";
+        return suffix;
+    }
+
+    bool IsCompressedArtifact(const std::string &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        char magic[8];
+        return in.read(magic, sizeof(magic)) && std::memcmp(magic, kHeaderMagic, sizeof(magic)) == 0;
+    }
+
+    std::string ArtifactViewKey(uint64_t view_id)
+    {
+        return "view:" + std::to_string(view_id);
+    }
+
+    bool CompressFile(const std::string &src, const std::string &dst,
+                      const ArtifactCompressionOptions &options, ArtifactCompressionStats *stats)
+    {
+        const auto start = Clock::now();
+        std::ifstream in(src, std::ios::binary);
+        if (!in)
+        {
+            return false;
+        }
+
+        SeekableArtifactWriter writer(options);
+        if (!writer.Open(dst))
+        {
+            return false;
+        }
+
+        const size_t frame_size = std::max<size_t>(options.frame_size, 64u << 10);
+        bool ok = true;
+        while (ok && in)
+        {
+            std::string chunk(frame_size, '\0');
+            in.read(chunk.data(), static_cast<std::streamsize>(frame_size));
+            chunk.resize(static_cast<size_t>(in.gcount()));
+            if (chunk.empty())
+                break;
+            ok = writer.AddFrame(std::string(), std::move(chunk));
+        }
+
+        ArtifactCompressionStats local_stats;
+        ok = writer.Finish(&local_stats) && ok && !in.bad();
+        local_stats.seconds = SecondsSince(start);
+        if (stats)
+        {
+            *stats = local_stats;
+        }
+
+        if (!ok)
+        {
+            std::error_code ec;
+            std::filesystem::remove(dst, ec);
+            return false;
+        }
+        if (options.remove_source)
+        {
+            std::error_code ec;
+            std::filesystem::remove(src, ec);
+        }
+        return true;
+    }
+
+    bool CompressTextFile(const std::string &src, const std::string &dst, const ArtifactLineKey &line_key,
+                          const ArtifactCompressionOptions &options, ArtifactCompressionStats *stats)
+    {
+        const auto start = Clock::now();
+        std::ifstream in(src, std::ios::binary);
+        if (!in)
+        {
+            return false;
+        }
+
+        SeekableArtifactWriter writer(options);
+        if (!writer.Open(dst))
+        {
+            return false;
+        }
+
+        const size_t frame_size = std::max<size_t>(options.frame_size, 64u << 10);
+        bool ok = true;
+        std::string frame_key;
+        std::string frame;
+        std::string line;
+        while (ok && std::getline(in, line))
+        {
+            const std::string key = line_key(line);
+            if (!in.eof())
+            {
+                line.push_back('\n');
+            }
+            // Keyed runs stay whole so a lookup returns every line of the key; unkeyed lines are chunked
+            // 有键的连续行保持完整，查找时可取回该键的全部行；无键的行按大小分块
+            if (!frame.empty() && (key != frame_key || (key.empty() && frame.size() >= frame_size)))
+            {
+                ok = writer.AddFrame(frame_key, std::move(frame));
+                frame.clear();
+            }
+            frame_key = key;
+            frame += line;
+        }
+        if (ok && !frame.empty())
+        {
+            ok = writer.AddFrame(frame_key, std::move(frame));
+        }
+
+        ArtifactCompressionStats local_stats;
+        ok = writer.Finish(&local_stats) && ok && !in.bad();
+        local_stats.seconds = SecondsSince(start);
+        if (stats)
+        {
+            *stats = local_stats;
+        }
+
+        if (!ok)
+        {
+            std::error_code ec;
+            std::filesystem::remove(dst, ec);
+            return false;
+        }
+        if (options.remove_source)
+        {
+            std::error_code ec;
+            std::filesystem::remove(src, ec);
+        }
+        return true;
+    }
+
+    std::string G2OLineViewKey(const std::string &line)
+    {
+        std::istringstream stream(line);
+        std::string tag;
+        uint64_t view_id = 0;
+        if (!(stream >> tag) || tag.rfind("EDGE", 0) != 0 || !(stream >> view_id))
+        {
+            return std::string();
+        }
+        return ArtifactViewKey(view_id);
+    }
+
+    bool DecompressFile(const std::string &src, const std::string &dst,
+                        int num_threads, ArtifactCompressionStats *stats)
+    {
+        const auto start = Clock::now();
+        SeekableArtifactReader reader;
+        if (!reader.Open(src))
+        {
+            return false;
+        }
+
+        std::string data;
+        ArtifactCompressionStats local_stats;
+        if (!reader.ReadAll(data, num_threads, &local_stats))
+        {
+            return false;
+        }
+
+        // Write through a temporary name so a partial file is never picked up | 先写临时文件，避免读到不完整文件
+        const std::string tmp_path = dst + ".tmp";
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!out || !out.write(data.data(), static_cast<std::streamsize>(data.size())))
+            {
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, dst, ec);
+        if (ec)
+        {
+            std::filesystem::remove(tmp_path, ec);
+            return false;
+        }
+
+        local_stats.seconds = SecondsSince(start);
+        if (stats)
+        {
+            *stats = local_stats;
+        }
+        return true;
+    }
+
+    bool EnsureArtifactDecompressed(const std::string &path, int num_threads)
+    {
+        if (std::filesystem::exists(path))
+        {
+            return true;
+        }
+
+        const std::string compressed_path = path + CompressedArtifactSuffix();
+        if (!std::filesystem::exists(compressed_path))
+        {
+            return false;
+        }
+
+        ArtifactCompressionStats stats;
+        if (!DecompressFile(compressed_path, path, num_threads, &stats))
+        {
+            LOG_ERROR_ZH << "解压失败: " << compressed_path;
+            LOG_ERROR_EN << "Failed to decompress: " << compressed_path;
+            return false;
+        }
+        LogArtifactCompressionStats("decompress " + std::filesystem::path(path).filename().string(), stats);
+        return true;
+    }
+
+    void LogArtifactCompressionStats(const std::string &label, const ArtifactCompressionStats &stats)
+    {
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(2)
+             << stats.raw_bytes / (1024.0 * 1024.0) << " MB -> " << stats.stored_bytes / (1024.0 * 1024.0)
+             << " MB, ratio " << stats.Ratio() << "x, " << stats.num_frames << " frames, "
+             << stats.ThroughputMBps() << " MB/s";
+        LOG_INFO_ZH << "[压缩] " << label << ": " << line.str();
+        LOG_INFO_EN << "[Compression] " << label << ": " << line.str();
+    }
+
+} // namespace common
@@ -0,0 +1,231 @@
+/**
+ * @file artifact_compression.hpp
+ * @brief Seekable compressed storage for work_dir artifacts | work_dir导出文件的可随机访问压缩存储
+ * @details A container of independently compressed frames (zstd when available, stored otherwise)
+ *          followed by a frame index, so a reader can decompress all frames in parallel. Frames may
+ *          carry a key (e.g. the view they hold) that is kept in the index.
+ *          由独立压缩的帧（有zstd时使用zstd，否则原样存储）和帧索引组成的容器，读取端可并行解压全部帧。
+ *          帧可带有键（如所含视图），键保存在索引中。
+ *
+ *          Layout | 布局:
+ *          [magic "POSDKZA1"][u32 version][frame payloads...][index][u64 index_offset][magic "POSDKZIX"]
+ *          index = u64 frame_count, then per frame: u32 key_len, key, u64 raw_offset, u64 raw_size,
+ *                  u64 stored_offset, u64 stored_size, u32 codec
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace common
+{
+    /**
+     * @brief Frame codec | 帧编码
+     */
+    enum class ArtifactCodec : uint32_t
+    {
+        STORED = 0, // Uncompressed (zstd unavailable or not beneficial) | 未压缩（无zstd或压缩无收益）
+        ZSTD = 1
+    };
+
+    /**
+     * @brief Compression options | 压缩参数
+     */
+    struct ArtifactCompressionOptions
+    {
+        bool enable = false;
+        // zstd level, 1 (fast) .. 19 (small) | zstd压缩级别
+        int level = 3;
+        // Worker threads, 0 = hardware concurrency | 工作线程数，0表示硬件并发数
+        int num_threads = 0;
+        // Size of frames without a view key | 无视图键的帧大小
+        size_t frame_size = 4u << 20;
+        // Remove the uncompressed file after CompressFile() succeeds | CompressFile()成功后删除原文件
+        bool remove_source = true;
+    };
+
+    /**
+     * @brief Ratio and throughput of one compression/decompression run | 单次压缩/解压的压缩比与吞吐量
+     */
+    struct ArtifactCompressionStats
+    {
+        uint64_t raw_bytes = 0;
+        uint64_t stored_bytes = 0;
+        size_t num_frames = 0;
+        double seconds = 0.0;
+
+        double Ratio() const { return stored_bytes > 0 ? static_cast<double>(raw_bytes) / stored_bytes : 0.0; }
+        double ThroughputMBps() const { return seconds > 0.0 ? raw_bytes / (1024.0 * 1024.0) / seconds : 0.0; }
+
+        void Accumulate(const ArtifactCompressionStats &other)
+        {
+            raw_bytes += other.raw_bytes;
+            stored_bytes += other.stored_bytes;
+            num_frames += other.num_frames;
+            seconds += other.seconds;
+        }
+    };
+
+    /**
+     * @brief Index entry of one frame | 单帧索引项
+     */
+    struct ArtifactFrameInfo
+    {
+        std::string key;
+        uint64_t raw_offset = 0;
+        uint64_t raw_size = 0;
+        uint64_t stored_offset = 0;
+        uint64_t stored_size = 0;
+        ArtifactCodec codec = ArtifactCodec::STORED;
+    };
+
+    /**
+     * @brief Writer of seekable compressed artifacts | 可随机访问压缩文件写入器
+     * @details Frames are buffered and compressed in parallel batches of num_threads frames.
+     *          帧先缓存，按num_threads帧为一批并行压缩。
+     */
+    class SeekableArtifactWriter
+    {
+    public:
+        explicit SeekableArtifactWriter(const ArtifactCompressionOptions &options);
+        ~SeekableArtifactWriter();
+
+        SeekableArtifactWriter(const SeekableArtifactWriter &) = delete;
+        SeekableArtifactWriter &operator=(const SeekableArtifactWriter &) = delete;
+
+        bool Open(const std::string &path);
+
+        /**
+         * @brief Append one frame (e.g. the matches of one view) | 追加一帧（如一个视图的匹配）
+         * @param key Frame key stored in the index, may be empty for plain chunks | 写入索引的帧键，普通分块可为空
+         */
+        bool AddFrame(const std::string &key, std::string data);
+
+        /**
+         * @brief Flush pending frames and write the index | 写出剩余帧和索引
+         */
+        bool Finish(ArtifactCompressionStats *stats = nullptr);
+
+    private:
+        bool FlushPending();
+
+        ArtifactCompressionOptions options_;
+        std::ofstream out_;
+        std::vector<std::pair<std::string, std::string>> pending_;
+        std::vector<ArtifactFrameInfo> frames_;
+        uint64_t raw_offset_ = 0;
+        uint64_t stored_offset_ = 0;
+        double seconds_ = 0.0;
+        bool open_ = false;
+    };
+
+    /**
+     * @brief Reader of seekable compressed artifacts | 可随机访问压缩文件读取器
+     * @note Read calls open their own stream and are safe to call concurrently | 读取调用各自打开文件流，可并发调用
+     */
+    class SeekableArtifactReader
+    {
+    public:
+
+        /**
+         * @brief Open and validate the index | 打开并校验索引
+         * @details Rejects frames that do not tile the raw stream contiguously (raw_offset must equal
+         *          the end of the previous frame), stored ranges outside the payload area, and sizes
+         *          that overflow.
+         *          帧必须连续拼接原始数据流（raw_offset等于前一帧末尾），存储区间须在负载区内且大小不溢出，否则拒绝。
+         */
+        bool Open(const std::string &path);
+
+        const std::vector<ArtifactFrameInfo> &Frames() const { return frames_; }
+        uint64_t RawSize() const { return raw_size_; }
+
+        bool ReadFrame(size_t index, std::string &data) const;
+
+        /**
+         * @brief Decompress all frames in parallel, one buffer per frame | 并行解压全部帧，每帧一个缓冲区
+         */
+        bool ReadAllFrames(std::vector<std::string> &frames, int num_threads = 0) const;
+
+        /**
+         * @brief Decompress all frames in parallel and concatenate them | 并行解压全部帧并按序拼接
+         */
+        bool ReadAll(std::string &data, int num_threads = 0, ArtifactCompressionStats *stats = nullptr) const;
+
+    private:
+        std::string path_;
+        std::vector<ArtifactFrameInfo> frames_;
+        uint64_t raw_size_ = 0;
+    };
+
+    /**
+     * @brief Whether zstd was compiled in (otherwise frames are stored) | 是否编译了zstd（否则帧原样存储）
+     */
+    bool IsArtifactCompressionAvailable();
+
+    /**
+     * @brief Suffix appended to compressed artifacts | 压缩文件追加的后缀
+     */
+    const std::string &CompressedArtifactSuffix();
+
+    /**
+     * @brief Whether the file starts with the container magic | 文件是否以容器魔数开头
+     */
+    bool IsCompressedArtifact(const std::string &path);
+
+    /**
+     * @brief Frame key of one view, e.g. "view:12" | 单个视图的帧键，如"view:12"
+     */
+    std::string ArtifactViewKey(uint64_t view_id);
+
+    /**
+     * @brief Maps one text line to its frame key, empty for lines that need no lookup | 将一行文本映射到帧键，无需查找的行返回空
+     */
+    using ArtifactLineKey = std::function<std::string(const std::string &line)>;
+
+    /**
+     * @brief Compress a file into frames of options.frame_size | 将文件按options.frame_size分帧压缩
+     */
+    bool CompressFile(const std::string &src, const std::string &dst,
+                      const ArtifactCompressionOptions &options, ArtifactCompressionStats *stats = nullptr);
+
+    /**
+     * @brief Compress a line-oriented file with one frame per run of lines sharing a key | 按键分帧压缩按行组织的文件
+     * @details A new frame starts whenever the key changes; unkeyed lines are packed into plain
+     *          chunks of up to options.frame_size. Decompression restores the file byte for byte.
+     *          键变化时开始新帧；无键的行按options.frame_size打包为普通分块。解压后与原文件逐字节一致。
+     */
+    bool CompressTextFile(const std::string &src, const std::string &dst, const ArtifactLineKey &line_key,
+                          const ArtifactCompressionOptions &options, ArtifactCompressionStats *stats = nullptr);
+
+    /**
+     * @brief Frame key of a g2o line: the first view of an edge, empty for vertices and headers
+     *        g2o行的帧键：边的第一个视图，顶点和头部行为空
+     */
+    std::string G2OLineViewKey(const std::string &line);
+
+    /**
+     * @brief Decompress a container back into a plain file | 将压缩容器解压回普通文件
+     */
+    bool DecompressFile(const std::string &src, const std::string &dst,
+                        int num_threads = 0, ArtifactCompressionStats *stats = nullptr);
+
+    /**
+     * @brief Make a plain file readable for importers | 为导入方准备可读取的普通文件
+     * @details Returns true if path exists, or if path + suffix exists and was decompressed to path.
+     *          path存在，或path+后缀存在且已解压到path时返回true。
+     */
+    bool EnsureArtifactDecompressed(const std::string &path, int num_threads = 0);
+
+    /**
+     * @brief Log ratio and throughput | 记录压缩比与吞吐量
+     */
+    void LogArtifactCompressionStats(const std::string &label, const ArtifactCompressionStats &stats);
+
+} // namespace common
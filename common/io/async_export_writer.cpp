@@ -0,0 +1,147 @@
+/**
+ * @file async_export_writer.cpp
+ * @brief Bounded background writer for pipeline exports | 流水线导出的有界后台写入器
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#include "async_export_writer.hpp"
+#include "metrics_exporter.hpp"
+#include <po_core/po_logger.hpp>
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace common
+{
+    AsyncExportWriter::AsyncExportWriter(const AsyncExportOptions &options)
+        : options_(options), queue_depth_(MetricQueueDepth("async_export"))
+    {
+        options_.max_pending = std::max<size_t>(1, options_.max_pending);
+        if (!options_.enable || options_.num_workers == 0)
+        {
+            return;
+        }
+
+        workers_.reserve(options_.num_workers);
+        for (size_t i = 0; i < options_.num_workers; ++i)
+        {
+            workers_.emplace_back(&AsyncExportWriter::WorkerLoop, this);
+        }
+    }
+
+    AsyncExportWriter::~AsyncExportWriter()
+    {
+        const auto failures = Flush();
+        for (const auto &failure : failures)
+        {
+            LOG_ERROR_ZH << "[AsyncExportWriter] 导出失败（析构时未被读取）: " << failure.label << " - " << failure.message;
+            LOG_ERROR_EN << "[AsyncExportWriter] Export failed (not collected before destruction): " << failure.label << " - " << failure.message;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        task_ready_.notify_all();
+        for (auto &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void AsyncExportWriter::Submit(const std::string &label, Task task)
+    {
+        if (!task)
+        {
+            return;
+        }
+
+        if (workers_.empty())
+        {
+            Execute(PendingTask{label, std::move(task)});
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            slot_free_.wait(lock, [this]
+                            { return queue_.size() < options_.max_pending; });
+            queue_.push_back(PendingTask{label, std::move(task)});
+            queue_depth_.store(static_cast<double>(queue_.size()), std::memory_order_relaxed);
+        }
+        task_ready_.notify_one();
+    }
+
+    std::vector<ExportFailure> AsyncExportWriter::Flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this]
+                   { return queue_.empty() && in_flight_ == 0; });
+
+        std::vector<ExportFailure> failures;
+        failures.swap(failures_);
+        return failures;
+    }
+
+    void AsyncExportWriter::WorkerLoop()
+    {
+        while (true)
+        {
+            PendingTask pending;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                task_ready_.wait(lock, [this]
+                                 { return stopping_ || !queue_.empty(); });
+                if (queue_.empty())
+                {
+                    return;
+                }
+                pending = std::move(queue_.front());
+                queue_.pop_front();
+                queue_depth_.store(static_cast<double>(queue_.size()), std::memory_order_relaxed);
+                ++in_flight_;
+            }
+            slot_free_.notify_one();
+
+            Execute(pending);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --in_flight_;
+                if (queue_.empty() && in_flight_ == 0)
+                {
+                    idle_.notify_all();
+                }
+            }
+        }
+    }
+
+    void AsyncExportWriter::Execute(const PendingTask &pending)
+    {
+        std::string message;
+        bool ok = false;
+        try
+        {
+            ok = pending.task();
+            if (!ok)
+            {
+                message = "export returned false";
+            }
+        }
+        catch (const std::exception &e)
+        {
+            message = e.what();
+        }
+        catch (...)
+        {
+            message = "unknown exception";
+        }
+
+        if (!ok)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            failures_.push_back(ExportFailure{pending.label, message});
+        }
+    }
+
+} // namespace common
@@ -0,0 +1,109 @@
+/**
+ * @file async_export_writer.hpp
+ * @brief Bounded background writer for pipeline exports | 流水线导出的有界后台写入器
+ * @details Stages hand an export task (capturing reference-counted data or an immutable
+ *          snapshot) to a small worker pool and continue immediately. Submit() blocks only
+ *          when max_pending tasks are already queued, so memory held by snapshots stays bounded.
+ *          Flush() is the barrier: it waits for every submitted task and returns the failures
+ *          collected since the previous Flush().
+ *          各阶段将导出任务（捕获引用计数数据或不可变快照）交给小型工作线程池后立即继续。
+ *          仅当已有max_pending个任务排队时Submit()才会阻塞，因此快照占用的内存有上限。
+ *          Flush()为屏障：等待所有已提交任务完成，并返回自上次Flush()以来收集的失败项。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+    /**
+     * @brief Writer options | 写入器参数
+     */
+    struct AsyncExportOptions
+    {
+        // false: tasks run inline on the submitting thread | false时任务在提交线程上同步执行
+        bool enable = true;
+        size_t num_workers = 2;
+        // Queued (not yet started) tasks before Submit() blocks | Submit()阻塞前允许排队（未开始）的任务数
+        size_t max_pending = 8;
+    };
+
+    /**
+     * @brief One failed export | 一次失败的导出
+     */
+    struct ExportFailure
+    {
+        std::string label;
+        std::string message;
+    };
+
+    class AsyncExportWriter
+    {
+    public:
+        /**
+         * @brief Export task, returns false on failure (exceptions are also caught)
+         *        导出任务，失败时返回false（异常同样会被捕获）
+         */
+        using Task = std::function<bool()>;
+
+        explicit AsyncExportWriter(const AsyncExportOptions &options);
+
+        /**
+         * @brief Flushes outstanding tasks and joins the workers | 完成剩余任务并回收工作线程
+         */
+        ~AsyncExportWriter();
+
+        AsyncExportWriter(const AsyncExportWriter &) = delete;
+        AsyncExportWriter &operator=(const AsyncExportWriter &) = delete;
+
+        /**
+         * @brief Queue an export | 提交一个导出任务
+         * @param label Shown in the failure report, e.g. "dataset/meshlab" | 失败报告中显示的标签
+         */
+        void Submit(const std::string &label, Task task);
+
+        /**
+         * @brief Wait for all submitted tasks | 等待所有已提交任务完成
+         * @return Failures since the previous Flush() | 自上次Flush()以来的失败项
+         */
+        std::vector<ExportFailure> Flush();
+
+        bool IsAsync() const { return !workers_.empty(); }
+
+    private:
+        struct PendingTask
+        {
+            std::string label;
+            Task task;
+        };
+
+        void WorkerLoop();
+        void Execute(const PendingTask &pending);
+
+        AsyncExportOptions options_;
+        std::vector<std::thread> workers_;
+        std::deque<PendingTask> queue_;
+        std::vector<ExportFailure> failures_;
+        size_t in_flight_ = 0;
+        bool stopping_ = false;
+        // Exported as posdk_queue_depth{queue="async_export"} | 导出为posdk_queue_depth{queue="async_export"}
+        std::atomic<double> &queue_depth_;
+
+        std::mutex mutex_;
+        std::condition_variable task_ready_;
+        std::condition_variable slot_free_;
+        std::condition_variable idle_;
+    };
+
+} // namespace common
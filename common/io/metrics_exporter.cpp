@@ -0,0 +1,476 @@
+/**
+ * @file metrics_exporter.cpp
+ * @brief Live Prometheus metrics of long-running pipeline jobs | 长时间流水线任务的实时Prometheus指标
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#include "metrics_exporter.hpp"
+#include "../parallel/memory_governor.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace common
+{
+    namespace
+    {
+        // Throughput rates cover the last rate window | 吞吐率覆盖最近一个速率窗口
+        constexpr double kRateWindowSeconds = 10.0;
+
+        std::string Label(const std::string &key, const std::string &value)
+        {
+            std::string escaped;
+            for (char c : value)
+            {
+                if (c == '\\' || c == '"')
+                    escaped += '\\';
+                escaped += (c == '\n') ? 'n' : c;
+            }
+            return key + "=\"" + escaped + "\"";
+        }
+
+        std::string SeriesName(const std::string &name, const std::string &labels)
+        {
+            return labels.empty() ? name : name + "{" + labels + "}";
+        }
+
+        double Seconds(std::chrono::steady_clock::duration duration)
+        {
+            return std::chrono::duration<double>(duration).count();
+        }
+
+        bool SendAll(int fd, const std::string &data)
+        {
+#ifdef MSG_NOSIGNAL
+            const int flags = MSG_NOSIGNAL;
+#else
+            const int flags = 0;
+#endif
+            size_t sent = 0;
+            while (sent < data.size())
+            {
+                const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, flags);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return false;
+                sent += static_cast<size_t>(n);
+            }
+            return true;
+        }
+    } // namespace
+
+    // ==================== MetricsRegistry ====================
+
+    MetricsRegistry &MetricsRegistry::Instance()
+    {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    MetricsRegistry::MetricsRegistry()
+        : start_time_(std::chrono::steady_clock::now())
+    {
+    }
+
+    MetricsRegistry::Series &MetricsRegistry::FindOrCreate(const std::string &name, const std::string &type,
+                                                           const std::string &labels, const std::string &help,
+                                                           const std::string &rate_name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Family &family = families_[name];
+        if (family.type.empty())
+        {
+            family.type = type;
+            family.help = help;
+            family.rate_name = rate_name;
+        }
+        std::unique_ptr<Series> &series = family.series[labels];
+        if (!series)
+        {
+            series = std::make_unique<Series>();
+            series->labels = labels;
+        }
+        return *series;
+    }
+
+    std::atomic<uint64_t> &MetricsRegistry::Counter(const std::string &name, const std::string &labels,
+                                                    const std::string &help, const std::string &rate_name)
+    {
+        return FindOrCreate(name, "counter", labels, help, rate_name).counter;
+    }
+
+    std::atomic<double> &MetricsRegistry::Gauge(const std::string &name, const std::string &labels, const std::string &help)
+    {
+        return FindOrCreate(name, "gauge", labels, help, "").gauge;
+    }
+
+    void MetricsRegistry::CloseStageLocked(std::chrono::steady_clock::time_point now)
+    {
+        if (current_stage_.empty())
+            return;
+        stage_seconds_[current_stage_] += Seconds(now - stage_start_);
+        current_stage_.clear();
+    }
+
+    void MetricsRegistry::BeginStage(const std::string &stage)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        CloseStageLocked(now);
+        current_stage_ = stage;
+        stage_start_ = now;
+    }
+
+    void MetricsRegistry::EndStage()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        CloseStageLocked(now);
+    }
+
+    void MetricsRegistry::SampleRates()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &[name, family] : families_)
+        {
+            if (family.rate_name.empty())
+                continue;
+            for (auto &[labels, series] : family.series)
+            {
+                auto &samples = series->samples;
+                samples.emplace_back(now, series->counter.load(std::memory_order_relaxed));
+                // Keep the newest sample that is at least one window old as the rate base
+                // 保留至少早于一个窗口的最新采样作为速率基准
+                while (samples.size() > 1 && Seconds(now - samples[1].first) >= kRateWindowSeconds)
+                    samples.pop_front();
+            }
+        }
+    }
+
+    std::string MetricsRegistry::Render()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        std::ostringstream out;
+        out.precision(10);
+
+        out << "# HELP posdk_uptime_seconds Seconds since the metrics registry was created\n"
+            << "# TYPE posdk_uptime_seconds gauge\n"
+            << "posdk_uptime_seconds " << Seconds(now - start_time_) << "\n";
+        out << "# HELP posdk_resident_memory_bytes Resident set size of the process\n"
+            << "# TYPE posdk_resident_memory_bytes gauge\n"
+            << "posdk_resident_memory_bytes " << CurrentRSSBytes() << "\n";
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Current stage and elapsed time per stage (the running stage counts up live)
+        // 当前阶段及各阶段用时（运行中的阶段实时累加）
+        out << "# HELP posdk_stage_info Pipeline stage currently running (value 1)\n"
+            << "# TYPE posdk_stage_info gauge\n";
+        if (!current_stage_.empty())
+            out << SeriesName("posdk_stage_info", Label("stage", current_stage_)) << " 1\n";
+        std::map<std::string, double> stage_seconds = stage_seconds_;
+        if (!current_stage_.empty())
+            stage_seconds[current_stage_] += Seconds(now - stage_start_);
+        out << "# HELP posdk_stage_elapsed_seconds Wall time spent per pipeline stage\n"
+            << "# TYPE posdk_stage_elapsed_seconds gauge\n";
+        for (const auto &[stage, seconds] : stage_seconds)
+            out << SeriesName("posdk_stage_elapsed_seconds", Label("stage", stage)) << " " << seconds << "\n";
+
+        for (const auto &[name, family] : families_)
+        {
+            out << "# HELP " << name << " " << family.help << "\n"
+                << "# TYPE " << name << " " << family.type << "\n";
+            for (const auto &[labels, series] : family.series)
+            {
+                out << SeriesName(name, labels) << " ";
+                if (family.type == "counter")
+                    out << series->counter.load(std::memory_order_relaxed) << "\n";
+                else
+                    out << series->gauge.load(std::memory_order_relaxed) << "\n";
+            }
+
+            if (family.rate_name.empty())
+                continue;
+            out << "# HELP " << family.rate_name << " Per-second rate of " << name << " over the last "
+                << kRateWindowSeconds << " s\n"
+                << "# TYPE " << family.rate_name << " gauge\n";
+            for (const auto &[labels, series] : family.series)
+            {
+                double rate = 0.0;
+                if (!series->samples.empty())
+                {
+                    const auto &[base_time, base_value] = series->samples.front();
+                    const double dt = Seconds(now - base_time);
+                    const uint64_t value = series->counter.load(std::memory_order_relaxed);
+                    if (dt > 0.0 && value >= base_value)
+                        rate = static_cast<double>(value - base_value) / dt;
+                }
+                out << SeriesName(family.rate_name, labels) << " " << rate << "\n";
+            }
+        }
+
+        // Hit ratio of every cache with lookups | 各有查询记录的缓存的命中率
+        const auto hits = families_.find("posdk_cache_hits_total");
+        const auto misses = families_.find("posdk_cache_misses_total");
+        if (hits != families_.end())
+        {
+            out << "# HELP posdk_cache_hit_ratio Hits / (hits + misses) per cache\n"
+                << "# TYPE posdk_cache_hit_ratio gauge\n";
+            for (const auto &[labels, series] : hits->second.series)
+            {
+                const double hit_count = static_cast<double>(series->counter.load(std::memory_order_relaxed));
+                double miss_count = 0.0;
+                if (misses != families_.end())
+                {
+                    const auto miss_series = misses->second.series.find(labels);
+                    if (miss_series != misses->second.series.end())
+                        miss_count = static_cast<double>(miss_series->second->counter.load(std::memory_order_relaxed));
+                }
+                const double total = hit_count + miss_count;
+                out << SeriesName("posdk_cache_hit_ratio", labels) << " " << (total > 0.0 ? hit_count / total : 0.0) << "\n";
+            }
+        }
+        return out.str();
+    }
+
+    std::atomic<uint64_t> &MetricPairsProcessed(const std::string &stage)
+    {
+        return MetricsRegistry::Instance().Counter("posdk_pairs_processed_total", Label("stage", stage),
+                                                   "View pairs finished per stage", "posdk_pairs_per_second");
+    }
+
+    std::atomic<uint64_t> &MetricImagesProcessed(const std::string &stage)
+    {
+        return MetricsRegistry::Instance().Counter("posdk_images_processed_total", Label("stage", stage),
+                                                   "Images finished per stage", "posdk_images_per_second");
+    }
+
+    std::atomic<uint64_t> &MetricIterations(const std::string &stage)
+    {
+        return MetricsRegistry::Instance().Counter("posdk_solver_iterations_total", Label("stage", stage),
+                                                   "Solver iterations per stage", "posdk_solver_iterations_per_second");
+    }
+
+    std::atomic<double> &MetricQueueDepth(const std::string &queue)
+    {
+        return MetricsRegistry::Instance().Gauge("posdk_queue_depth", Label("queue", queue),
+                                                 "Items waiting in a queue");
+    }
+
+    std::atomic<uint64_t> &MetricCacheLookups(const std::string &cache, bool hit)
+    {
+        if (hit)
+            return MetricsRegistry::Instance().Counter("posdk_cache_hits_total", Label("cache", cache), "Cache hits per cache");
+        return MetricsRegistry::Instance().Counter("posdk_cache_misses_total", Label("cache", cache), "Cache misses per cache");
+    }
+
+    // ==================== MetricsServer ====================
+
+    MetricsServer::MetricsServer(const MetricsServerOptions &options)
+        : options_(options)
+    {
+    }
+
+    MetricsServer::~MetricsServer()
+    {
+        Stop();
+    }
+
+    bool MetricsServer::Start(std::string &error)
+    {
+        if (options_.port > 0)
+        {
+            tcp_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+            const int reuse = 1;
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(static_cast<uint16_t>(options_.port));
+            if (tcp_fd_ < 0 ||
+                ::setsockopt(tcp_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+                ::inet_pton(AF_INET, options_.bind_address.c_str(), &address.sin_addr) != 1 ||
+                ::bind(tcp_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+                ::listen(tcp_fd_, 8) != 0)
+            {
+                error = "cannot listen on " + options_.bind_address + ":" + std::to_string(options_.port) + ": " + std::strerror(errno);
+                Stop();
+                return false;
+            }
+        }
+
+        if (!options_.socket_path.empty())
+        {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            if (options_.socket_path.size() >= sizeof(address.sun_path))
+            {
+                error = "unix socket path too long: " + options_.socket_path;
+                Stop();
+                return false;
+            }
+            std::strncpy(address.sun_path, options_.socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+            // A stale socket of a previous run blocks bind(); other files are left alone
+            // 上次运行遗留的套接字会阻止bind()；其他类型的文件不做处理
+            struct stat info;
+            if (::stat(options_.socket_path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+                ::unlink(options_.socket_path.c_str());
+
+            unix_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (unix_fd_ < 0 ||
+                ::bind(unix_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+                ::listen(unix_fd_, 8) != 0)
+            {
+                error = "cannot listen on unix socket " + options_.socket_path + ": " + std::strerror(errno);
+                Stop();
+                return false;
+            }
+        }
+
+        if (tcp_fd_ < 0 && unix_fd_ < 0)
+        {
+            error = "neither a port nor a socket path is configured";
+            return false;
+        }
+
+        stopping_ = false;
+        thread_ = std::thread(&MetricsServer::ServeLoop, this);
+        return true;
+    }
+
+    void MetricsServer::Stop()
+    {
+        stopping_ = true;
+        if (thread_.joinable())
+            thread_.join();
+        if (tcp_fd_ >= 0)
+        {
+            ::close(tcp_fd_);
+            tcp_fd_ = -1;
+        }
+        if (unix_fd_ >= 0)
+        {
+            ::close(unix_fd_);
+            unix_fd_ = -1;
+            ::unlink(options_.socket_path.c_str());
+        }
+    }
+
+    std::string MetricsServer::Endpoint() const
+    {
+        std::string endpoint;
+        if (tcp_fd_ >= 0)
+            endpoint = "http://" + options_.bind_address + ":" + std::to_string(options_.port) + "/metrics";
+        if (unix_fd_ >= 0)
+            endpoint += (endpoint.empty() ? "" : ", ") + std::string("unix:") + options_.socket_path;
+        return endpoint;
+    }
+
+    void MetricsServer::ServeLoop()
+    {
+        MetricsRegistry &registry = MetricsRegistry::Instance();
+        auto last_sample = std::chrono::steady_clock::now();
+        registry.SampleRates();
+
+        std::vector<pollfd> fds;
+        for (int fd : {tcp_fd_, unix_fd_})
+        {
+            if (fd >= 0)
+                fds.push_back(pollfd{fd, POLLIN, 0});
+        }
+
+        // Short poll timeout: Stop() is noticed quickly and rates are sampled about once per second
+        // 较短的poll超时：能及时察觉Stop()，并约每秒采样一次速率
+        while (!stopping_)
+        {
+            const int ready = ::poll(fds.data(), fds.size(), 250);
+            const auto now = std::chrono::steady_clock::now();
+            if (Seconds(now - last_sample) >= 1.0)
+            {
+                registry.SampleRates();
+                last_sample = now;
+            }
+            if (ready <= 0)
+                continue;
+            for (auto &entry : fds)
+            {
+                if (!(entry.revents & POLLIN))
+                    continue;
+                const int client = ::accept(entry.fd, nullptr, nullptr);
+                if (client >= 0)
+                {
+                    HandleConnection(client);
+                    ::close(client);
+                }
+            }
+        }
+    }
+
+    void MetricsServer::HandleConnection(int fd)
+    {
+        // A stuck client must not block the serving thread | 卡住的客户端不能阻塞服务线程
+        timeval timeout{2, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+        const int no_sigpipe = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+
+        // Read the request head only, the body (if any) is ignored | 只读取请求头，忽略请求体
+        std::string request;
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192)
+        {
+            const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                break;
+            request.append(buffer, static_cast<size_t>(n));
+        }
+
+        std::istringstream line(request.substr(0, request.find("\r\n")));
+        std::string method, target;
+        line >> method >> target;
+        const std::string path = target.substr(0, target.find('?'));
+
+        std::string status = "200 OK";
+        std::string content_type = "text/plain; version=0.0.4; charset=utf-8";
+        std::string body;
+        if (method != "GET" && method != "HEAD")
+        {
+            status = "405 Method Not Allowed";
+            content_type = "text/plain";
+            body = "only GET is supported\n";
+        }
+        else if (path != "/metrics" && path != "/")
+        {
+            status = "404 Not Found";
+            content_type = "text/plain";
+            body = "metrics are served at /metrics\n";
+        }
+        else
+        {
+            body = MetricsRegistry::Instance().Render();
+        }
+
+        std::string response = "HTTP/1.0 " + status + "\r\n" +
+                               "Content-Type: " + content_type + "\r\n" +
+                               "Content-Length: " + std::to_string(body.size()) + "\r\n" +
+                               "Connection: close\r\n\r\n";
+        if (method != "HEAD")
+            response += body;
+        SendAll(fd, response);
+    }
+
+} // namespace common
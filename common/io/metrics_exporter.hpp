@@ -0,0 +1,188 @@
+/**
+ * @file metrics_exporter.hpp
+ * @brief Live Prometheus metrics of long-running pipeline jobs | 长时间流水线任务的实时Prometheus指标
+ * @details Stages publish progress into a process-wide registry of atomic counters and gauges (pairs
+ *          matched / estimated, images extracted, solver iterations, queue depths, cache lookups) and mark
+ *          the current stage. MetricsServer serves the registry in the Prometheus text format on a local
+ *          TCP port or a Unix socket from one background thread, so a monitoring system can alert on
+ *          stalls (throughput rate at 0) and throughput regressions during multi-hour runs.
+ *          各阶段将进度发布到进程级的原子计数器/仪表注册表（匹配/估计的视图对、提取的图像、求解器迭代、
+ *          队列深度、缓存查询）并标记当前阶段。MetricsServer在后台线程中通过本地TCP端口或Unix套接字以
+ *          Prometheus文本格式提供这些指标，使监控系统能在数小时的运行中对停滞（吞吐率为0）和吞吐回退告警。
+ *
+ *          Hot loops look a series up once and then only do a relaxed fetch_add; the registry lives in
+ *          pomvg_common, so every plugin of the process writes to the same series. External shard workers
+ *          are separate processes and export their own series.
+ *          热循环只查找一次序列，之后仅做relaxed fetch_add；注册表位于pomvg_common中，进程内所有插件写入同一组序列。
+ *          外部分片工作进程是独立进程，各自导出自己的序列。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace common
+{
+    /**
+     * @brief Process-wide metric series | 进程级指标序列
+     * @note Thread-safe; references returned by Counter()/Gauge() stay valid for the process lifetime
+     *       线程安全；Counter()/Gauge()返回的引用在进程生命周期内有效
+     */
+    class MetricsRegistry
+    {
+    public:
+        static MetricsRegistry &Instance();
+
+        /**
+         * @brief Monotonic counter series, created on first use | 单调计数器序列，首次使用时创建
+         * @param name Metric name, e.g. "posdk_pairs_processed_total" | 指标名
+         * @param labels Label set without braces, e.g. "stage=\"matching\"" | 不含花括号的标签集
+         * @param help HELP text of the family | 指标族的HELP说明
+         * @param rate_name If set, a gauge of this name publishes the per-second rate of the series
+         *                  over the last rate window | 设置时以该名称的仪表发布该序列在最近速率窗口内的每秒速率
+         */
+        std::atomic<uint64_t> &Counter(const std::string &name, const std::string &labels,
+                                       const std::string &help, const std::string &rate_name = "");
+
+        /**
+         * @brief Gauge series, created on first use | 仪表序列，首次使用时创建
+         */
+        std::atomic<double> &Gauge(const std::string &name, const std::string &labels, const std::string &help);
+
+        /**
+         * @brief Enter a pipeline stage; the previous stage's elapsed time is closed | 进入流水线阶段，结束上一阶段的计时
+         */
+        void BeginStage(const std::string &stage);
+
+        /**
+         * @brief Leave the current stage (no stage is current afterwards) | 离开当前阶段（之后无当前阶段）
+         */
+        void EndStage();
+
+        /**
+         * @brief Take a throughput sample of every rate series (called about once per second by the server)
+         *        对所有速率序列采样（服务器约每秒调用一次）
+         */
+        void SampleRates();
+
+        /**
+         * @brief Registry in the Prometheus text exposition format (version 0.0.4) | Prometheus文本格式（0.0.4版）的注册表
+         */
+        std::string Render();
+
+    private:
+        MetricsRegistry();
+
+        struct Series
+        {
+            std::string labels;
+            std::atomic<uint64_t> counter{0};
+            std::atomic<double> gauge{0.0};
+            // (time, value) samples of the rate window | 速率窗口内的（时间，值）采样
+            std::deque<std::pair<std::chrono::steady_clock::time_point, uint64_t>> samples;
+        };
+
+        struct Family
+        {
+            std::string type; // "counter" | "gauge"
+            std::string help;
+            std::string rate_name;
+            std::map<std::string, std::unique_ptr<Series>> series; // keyed by labels | 以标签为键
+        };
+
+        Series &FindOrCreate(const std::string &name, const std::string &type, const std::string &labels,
+                             const std::string &help, const std::string &rate_name);
+        void CloseStageLocked(std::chrono::steady_clock::time_point now);
+
+        std::mutex mutex_;
+        std::map<std::string, Family> families_;
+        const std::chrono::steady_clock::time_point start_time_;
+
+        std::string current_stage_;
+        std::chrono::steady_clock::time_point stage_start_;
+        std::map<std::string, double> stage_seconds_; // Finished time per stage | 各阶段已结束的用时
+    };
+
+    /// View pairs finished by a pair-level stage ("matching", "two_view"), with a pairs/sec rate | 视图对级阶段完成的视图对数，附带每秒速率
+    std::atomic<uint64_t> &MetricPairsProcessed(const std::string &stage);
+
+    /// Images finished by an image-level stage ("feature_extraction"), with an images/sec rate | 图像级阶段完成的图像数，附带每秒速率
+    std::atomic<uint64_t> &MetricImagesProcessed(const std::string &stage);
+
+    /// Solver iterations of an iterative stage ("rotation_averaging") | 迭代阶段的求解器迭代次数
+    std::atomic<uint64_t> &MetricIterations(const std::string &stage);
+
+    /// Items waiting in a queue ("async_export", "memory_governor") | 队列中等待的项数
+    std::atomic<double> &MetricQueueDepth(const std::string &queue);
+
+    /// Hits or misses of a cache; the exporter derives posdk_cache_hit_ratio | 缓存命中或未命中次数，导出时计算posdk_cache_hit_ratio
+    std::atomic<uint64_t> &MetricCacheLookups(const std::string &cache, bool hit);
+
+    /**
+     * @brief Metrics endpoint options | 指标端点参数
+     */
+    struct MetricsServerOptions
+    {
+        // TCP port on bind_address, 0 disables TCP | bind_address上的TCP端口，0表示不监听TCP
+        int port = 0;
+        // Loopback by default: the endpoint has no authentication | 默认仅回环地址：端点无认证
+        std::string bind_address = "127.0.0.1";
+        // Unix socket path, empty disables | Unix套接字路径，为空表示不启用
+        std::string socket_path;
+
+        bool Enabled() const { return port > 0 || !socket_path.empty(); }
+    };
+
+    /**
+     * @brief Serves GET /metrics from MetricsRegistry::Instance() on a background thread
+     *        在后台线程上基于MetricsRegistry::Instance()提供GET /metrics
+     */
+    class MetricsServer
+    {
+    public:
+        explicit MetricsServer(const MetricsServerOptions &options);
+
+        /**
+         * @brief Stops serving and removes the Unix socket | 停止服务并删除Unix套接字
+         */
+        ~MetricsServer();
+
+        MetricsServer(const MetricsServer &) = delete;
+        MetricsServer &operator=(const MetricsServer &) = delete;
+
+        /**
+         * @brief Open the listening sockets and start the serving thread | 打开监听套接字并启动服务线程
+         * @param error Output: failure reason | 输出：失败原因
+         */
+        bool Start(std::string &error);
+
+        void Stop();
+
+        /**
+         * @brief "http://127.0.0.1:9464/metrics" and/or "unix:/path" | 监听地址描述
+         */
+        std::string Endpoint() const;
+
+    private:
+        void ServeLoop();
+        void HandleConnection(int fd);
+
+        MetricsServerOptions options_;
+        int tcp_fd_ = -1;
+        int unix_fd_ = -1;
+        std::atomic<bool> stopping_{false};
+        std::thread thread_;
+    };
+
+} // namespace common
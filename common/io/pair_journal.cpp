@@ -0,0 +1,241 @@
+/**
+ * @file pair_journal.cpp
+ * @brief Append-only journal of completed view pairs | 已完成视图对的追加式日志
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#include "pair_journal.hpp"
+#include "../parallel/pair_shards.hpp"
+#include <po_core/po_logger.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace common
+{
+    using namespace PoSDK::types;
+
+    namespace
+    {
+        constexpr char kJournalMagic[8] = {'P', 'O', 'J', 'R', 'N', 'L', '0', '1'};
+        constexpr uint32_t kEndianMarker = 0x01020304u;
+        constexpr uint32_t kJournalVersion = 1;
+        constexpr size_t kHeaderSize = sizeof(kJournalMagic) + 2 * sizeof(uint32_t) + sizeof(uint64_t);
+        constexpr size_t kRecordHeaderSize = 3 * sizeof(uint32_t) + sizeof(uint64_t);
+
+        uint64_t RecordChecksum(uint32_t view_i, uint32_t view_j, const char *payload, size_t size)
+        {
+            ShardFingerprint checksum;
+            checksum.Add(view_i).Add(view_j).Add(std::string(payload, size));
+            return checksum.Value();
+        }
+
+        void AppendRecord(std::string &buffer, uint32_t view_i, uint32_t view_j, const std::string &payload)
+        {
+            ShardPayloadWriter writer(buffer);
+            writer.Put(view_i);
+            writer.Put(view_j);
+            writer.Put(static_cast<uint32_t>(payload.size()));
+            writer.Put(RecordChecksum(view_i, view_j, payload.data(), payload.size()));
+            buffer.append(payload);
+        }
+    } // namespace
+
+    PairJournal::PairJournal(const PairJournalOptions &options)
+        : options_(options)
+    {
+        if (options_.flush_pairs == 0)
+        {
+            options_.flush_pairs = 1;
+        }
+    }
+
+    PairJournal::~PairJournal()
+    {
+        Flush();
+        if (file_)
+        {
+            std::fclose(file_);
+        }
+    }
+
+    bool PairJournal::Open(uint64_t fingerprint, std::string &error)
+    {
+        namespace fs = std::filesystem;
+        replayed_.clear();
+
+        std::error_code ec;
+        const fs::path path(options_.path);
+        if (path.has_parent_path())
+        {
+            fs::create_directories(path.parent_path(), ec);
+        }
+
+        // Stream the existing journal record by record, keeping the longest valid prefix; only the
+        // replayed payloads are held in memory
+        // 逐条流式读取已有日志，保留最长的有效前缀；内存中只保留回放的负载
+        size_t valid_size = 0;
+        if (fs::exists(path, ec))
+        {
+            const uintmax_t file_size = fs::file_size(path, ec);
+            std::ifstream in(options_.path, std::ios::binary);
+
+            std::string header(kHeaderSize, '\0');
+            uint32_t endian = 0, version = 0;
+            uint64_t stored_fingerprint = 0;
+            bool header_ok = !ec && file_size >= kHeaderSize && in.read(&header[0], kHeaderSize);
+            if (header_ok)
+            {
+                std::string header_fields = header.substr(sizeof(kJournalMagic));
+                ShardPayloadReader header_reader(header_fields);
+                header_reader.Get(endian);
+                header_reader.Get(version);
+                header_reader.Get(stored_fingerprint);
+                header_ok = std::memcmp(header.data(), kJournalMagic, sizeof(kJournalMagic)) == 0 &&
+                            endian == kEndianMarker && version == kJournalVersion;
+            }
+
+            if (!header_ok || stored_fingerprint != fingerprint)
+            {
+                LOG_WARNING_ZH << "[PairJournal] 日志与当前输入不匹配，重新开始: " << options_.path;
+                LOG_WARNING_EN << "[PairJournal] Journal does not match the current input, starting over: " << options_.path;
+            }
+            else
+            {
+                valid_size = kHeaderSize;
+                char record_header[kRecordHeaderSize];
+                std::string payload;
+                while (file_size - valid_size >= kRecordHeaderSize && in.read(record_header, kRecordHeaderSize))
+                {
+                    uint32_t view_i = 0, view_j = 0, size = 0;
+                    uint64_t checksum = 0;
+                    std::memcpy(&view_i, record_header, sizeof(uint32_t));
+                    std::memcpy(&view_j, record_header + 4, sizeof(uint32_t));
+                    std::memcpy(&size, record_header + 8, sizeof(uint32_t));
+                    std::memcpy(&checksum, record_header + 12, sizeof(uint64_t));
+
+                    // A torn size field must not trigger a huge allocation | 残缺的长度字段不能导致超大分配
+                    if (file_size - valid_size - kRecordHeaderSize < size)
+                    {
+                        break;
+                    }
+                    payload.resize(size);
+                    if (size > 0 && !in.read(&payload[0], size))
+                    {
+                        break;
+                    }
+                    if (RecordChecksum(view_i, view_j, payload.data(), size) != checksum)
+                    {
+                        break;
+                    }
+                    replayed_[PairKey(view_i, view_j)] = payload;
+                    valid_size += kRecordHeaderSize + size;
+                }
+
+                if (valid_size < file_size)
+                {
+                    LOG_WARNING_ZH << "[PairJournal] 截断不完整的日志尾部 (" << file_size - valid_size << " 字节): " << options_.path;
+                    LOG_WARNING_EN << "[PairJournal] Truncating torn journal tail (" << file_size - valid_size << " bytes): " << options_.path;
+                }
+            }
+        }
+
+        if (valid_size > 0)
+        {
+            fs::resize_file(path, valid_size, ec);
+            if (ec)
+            {
+                error = "cannot truncate " + options_.path + ": " + ec.message();
+                replayed_.clear();
+                return false;
+            }
+            file_ = std::fopen(options_.path.c_str(), "ab");
+        }
+        else
+        {
+            file_ = std::fopen(options_.path.c_str(), "wb");
+            if (file_)
+            {
+                std::string header(kJournalMagic, sizeof(kJournalMagic));
+                ShardPayloadWriter writer(header);
+                writer.Put(kEndianMarker);
+                writer.Put(kJournalVersion);
+                writer.Put(fingerprint);
+                if (std::fwrite(header.data(), 1, header.size(), file_) != header.size() || std::fflush(file_) != 0)
+                {
+                    std::fclose(file_);
+                    file_ = nullptr;
+                }
+            }
+        }
+
+        if (!file_)
+        {
+            error = "cannot open " + options_.path + " for writing";
+            replayed_.clear();
+            return false;
+        }
+        return true;
+    }
+
+    const std::string *PairJournal::Find(IndexT view_i, IndexT view_j) const
+    {
+        auto it = replayed_.find(PairKey(view_i, view_j));
+        return it == replayed_.end() ? nullptr : &it->second;
+    }
+
+    void PairJournal::Append(IndexT view_i, IndexT view_j, const std::string &payload)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!file_ || write_failed_)
+        {
+            return;
+        }
+        AppendRecord(pending_, static_cast<uint32_t>(view_i), static_cast<uint32_t>(view_j), payload);
+        if (++pending_pairs_ >= options_.flush_pairs)
+        {
+            FlushLocked();
+        }
+    }
+
+    bool PairJournal::Flush()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return FlushLocked();
+    }
+
+    bool PairJournal::FlushLocked()
+    {
+        if (!file_ || write_failed_)
+        {
+            return !write_failed_;
+        }
+        if (pending_.empty())
+        {
+            return true;
+        }
+
+        bool ok = std::fwrite(pending_.data(), 1, pending_.size(), file_) == pending_.size() &&
+                  std::fflush(file_) == 0;
+#ifndef _WIN32
+        ok = ok && ::fsync(::fileno(file_)) == 0;
+#endif
+        pending_.clear();
+        pending_pairs_ = 0;
+
+        if (!ok)
+        {
+            // Results stay in memory; only resumability is lost | 结果仍在内存中，只是无法断点续算
+            write_failed_ = true;
+            LOG_WARNING_ZH << "[PairJournal] 写入日志失败，停止记录: " << options_.path;
+            LOG_WARNING_EN << "[PairJournal] Failed to write journal, stopping journaling: " << options_.path;
+        }
+        return ok;
+    }
+
+} // namespace common
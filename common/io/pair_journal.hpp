@@ -0,0 +1,107 @@
+/**
+ * @file pair_journal.hpp
+ * @brief Append-only journal of completed view pairs | 已完成视图对的追加式日志
+ * @details Long pair-level stages (feature matching, two-view estimation) append the result of
+ *          every finished view pair to a journal file, flushed to disk in batches. After a crash or
+ *          preemption the stage reopens the journal, replays the journaled pairs and only computes
+ *          the missing ones, so the final output equals that of an uninterrupted run.
+ *          长时间的视图对级阶段（特征匹配、双视图估计）将每个完成视图对的结果追加写入日志文件，并分批
+ *          刷盘。崩溃或抢占后重新打开日志，回放已记录的视图对，只计算缺失部分，最终结果与未中断运行一致。
+ *
+ *          File layout | 文件格式:
+ *          header : magic "POJRNL01", endian marker, version, input fingerprint
+ *          record : view_i, view_j, payload size, checksum, payload
+ *
+ *          A record torn by a crash fails its checksum and is truncated on reopen; a journal written
+ *          for different input (fingerprint mismatch) is discarded.
+ *          崩溃导致的残缺记录校验失败，重新打开时被截断；输入不同（指纹不匹配）的日志会被丢弃。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <po_core/types.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace common
+{
+    /**
+     * @brief Pair journal options | 视图对日志参数
+     */
+    struct PairJournalOptions
+    {
+        // Journal file, empty disables journaling | 日志文件，为空表示不记录
+        std::string path;
+        // Pairs buffered in memory before a write + fsync | 写入并fsync前在内存中缓冲的视图对数
+        size_t flush_pairs = 256;
+
+        bool Enabled() const { return !path.empty(); }
+    };
+
+    /**
+     * @brief Append-only, checksummed journal keyed by view pair | 以视图对为键、带校验的追加式日志
+     * @note Append() is thread-safe | Append()线程安全
+     */
+    class PairJournal
+    {
+    public:
+        using PairKey = std::pair<PoSDK::types::IndexT, PoSDK::types::IndexT>;
+
+        explicit PairJournal(const PairJournalOptions &options);
+        ~PairJournal();
+
+        PairJournal(const PairJournal &) = delete;
+        PairJournal &operator=(const PairJournal &) = delete;
+
+        /**
+         * @brief Open the journal and load the valid records | 打开日志并加载有效记录
+         * @param fingerprint Fingerprint of the stage input | 阶段输入指纹
+         * @param error Output: failure reason | 输出：失败原因
+         */
+        bool Open(uint64_t fingerprint, std::string &error);
+
+        /**
+         * @brief Journaled payload of a view pair, nullptr if not completed | 视图对的日志负载，未完成时为nullptr
+         */
+        const std::string *Find(PoSDK::types::IndexT view_i, PoSDK::types::IndexT view_j) const;
+
+        size_t NumReplayed() const { return replayed_.size(); }
+
+        /**
+         * @brief Release the replayed payloads once they were applied | 回放完成后释放负载
+         */
+        void ReleaseReplayed() { replayed_.clear(); }
+
+        /**
+         * @brief Record a completed view pair | 记录一个已完成的视图对
+         */
+        void Append(PoSDK::types::IndexT view_i, PoSDK::types::IndexT view_j, const std::string &payload);
+
+        /**
+         * @brief Write buffered records and sync them to disk | 写出缓冲记录并同步到磁盘
+         */
+        bool Flush();
+
+        const std::string &Path() const { return options_.path; }
+
+    private:
+        bool FlushLocked();
+
+        PairJournalOptions options_;
+        std::map<PairKey, std::string> replayed_;
+
+        std::mutex mutex_;
+        std::FILE *file_ = nullptr;
+        std::string pending_;
+        size_t pending_pairs_ = 0;
+        bool write_failed_ = false;
+    };
+
+} // namespace common
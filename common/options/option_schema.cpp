@@ -0,0 +1,9 @@
+#include "option_schema.hpp"
+
+namespace common
+{
+    // Out-of-line key function: keeps a single typeinfo in pomvg_common so that
+    // dynamic_cast works across separately loaded plugins
+    TypedViewPairTarget::~TypedViewPairTarget() = default;
+
+} // namespace common
@@ -0,0 +1,348 @@
+/**
+ * @file option_schema.hpp
+ * @brief Typed option schema for method plugins | 方法插件的类型化选项模式
+ * @details Each option is declared once (key, typed member, default, optional validator).
+ *          The string option map is compiled into a plain struct once per Build()/Run(),
+ *          after which estimators and pipelines read typed fields without map lookups.
+ *          每个选项只声明一次（键、类型化成员、默认值、可选校验器）。字符串选项表在每次
+ *          Build()/Run()时编译一次为普通结构体，之后估计器和流水线直接读取类型化字段，无需查表。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <po_core/types.hpp>
+#include <po_core/po_logger.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace common
+{
+    namespace option_detail
+    {
+        inline std::string Trim(const std::string &text)
+        {
+            const auto begin = text.find_first_not_of(" \t\r\n");
+            if (begin == std::string::npos)
+                return std::string();
+            const auto end = text.find_last_not_of(" \t\r\n");
+            return text.substr(begin, end - begin + 1);
+        }
+
+        // Blocks template deduction so that T is taken from the member pointer only
+        // 阻止模板推导，使T仅由成员指针确定
+        template <typename T>
+        struct NonDeduced
+        {
+            using type = T;
+        };
+
+        inline bool ParseValue(const std::string &text, std::string &value)
+        {
+            value = text;
+            return true;
+        }
+
+        inline bool ParseValue(const std::string &text, bool &value)
+        {
+            std::string lower = Trim(text);
+            std::transform(lower.begin(), lower.end(), lower.begin(),
+                           [](unsigned char c)
+                           { return static_cast<char>(std::tolower(c)); });
+            if (lower == "true" || lower == "1" || lower == "yes" || lower == "on")
+            {
+                value = true;
+                return true;
+            }
+            if (lower == "false" || lower == "0" || lower == "no" || lower == "off")
+            {
+                value = false;
+                return true;
+            }
+            return false;
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, bool>
+        ParseValue(const std::string &text, T &value)
+        {
+            const std::string trimmed = Trim(text);
+            if (trimmed.empty())
+                return false;
+
+            char *end = nullptr;
+            errno = 0;
+            if constexpr (std::is_signed_v<T>)
+            {
+                const long long parsed = std::strtoll(trimmed.c_str(), &end, 10);
+                if (errno != 0 || *end != '\0' ||
+                    parsed < static_cast<long long>(std::numeric_limits<T>::min()) ||
+                    parsed > static_cast<long long>(std::numeric_limits<T>::max()))
+                    return false;
+                value = static_cast<T>(parsed);
+            }
+            else
+            {
+                if (trimmed[0] == '-')
+                    return false;
+                const unsigned long long parsed = std::strtoull(trimmed.c_str(), &end, 10);
+                if (errno != 0 || *end != '\0' ||
+                    parsed > static_cast<unsigned long long>(std::numeric_limits<T>::max()))
+                    return false;
+                value = static_cast<T>(parsed);
+            }
+            return true;
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_floating_point_v<T>, bool>
+        ParseValue(const std::string &text, T &value)
+        {
+            const std::string trimmed = Trim(text);
+            if (trimmed.empty())
+                return false;
+
+            char *end = nullptr;
+            errno = 0;
+            const double parsed = std::strtod(trimmed.c_str(), &end);
+            if (errno != 0 || *end != '\0')
+                return false;
+            value = static_cast<T>(parsed);
+            return true;
+        }
+
+        inline std::string FormatValue(const std::string &value) { return value; }
+        inline std::string FormatValue(bool value) { return value ? "true" : "false"; }
+
+        template <typename T>
+        std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, std::string>
+        FormatValue(T value)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                std::ostringstream stream;
+                stream.precision(std::numeric_limits<T>::max_digits10);
+                stream << value;
+                return stream.str();
+            }
+            else
+            {
+                return std::to_string(value);
+            }
+        }
+    } // namespace option_detail
+
+    /**
+     * @brief Typed option schema bound to a params struct | 绑定到参数结构体的类型化选项模式
+     * @tparam Params Plain struct holding the compiled options | 存放编译后选项的普通结构体
+     *
+     * Usage | 用法:
+     * @code
+     * struct Options { IndexT view_i = 0; std::string algorithm; double threshold = 1.0; };
+     * static const auto schema = common::OptionSchema<Options>()
+     *     .Add("view_i", &Options::view_i, 0)
+     *     .Add("algorithm", &Options::algorithm, "magsac")
+     *     .Add("ransac_threshold", &Options::threshold, 1.0, [](const double &v) { return v > 0.0; });
+     * schema.Compile(GetMethodOptions(), options_);
+     * @endcode
+     */
+    template <typename Params>
+    class OptionSchema
+    {
+    public:
+        /**
+         * @brief Declare one option | 声明一个选项
+         * @param key Option key in the string map | 字符串选项表中的键
+         * @param member Typed member of Params | Params中的类型化成员
+         * @param default_value Value used when the key is missing or invalid | 键缺失或非法时使用的值
+         * @param validator Optional check on the parsed value | 可选的解析值校验
+         */
+        template <typename T>
+        OptionSchema &Add(const std::string &key, T Params::*member,
+                          typename option_detail::NonDeduced<T>::type default_value,
+                          std::function<bool(const typename option_detail::NonDeduced<T>::type &)> validator = nullptr)
+        {
+            Entry entry;
+            entry.key = key;
+            entry.apply = [key, member, default_value, validator](const std::string *text, Params &params, std::string &error)
+            {
+                params.*member = default_value;
+                if (!text)
+                    return true;
+
+                T value{};
+                if (!option_detail::ParseValue(*text, value))
+                {
+                    error = "cannot parse '" + *text + "'";
+                    return false;
+                }
+                if (validator && !validator(value))
+                {
+                    error = "value '" + *text + "' rejected by validator";
+                    return false;
+                }
+                params.*member = value;
+                return true;
+            };
+            entry.format = [member](const Params &params)
+            { return option_detail::FormatValue(params.*member); };
+            entries_.push_back(std::move(entry));
+            return *this;
+        }
+
+        /**
+         * @brief Parse the string option map into params | 将字符串选项表解析为参数结构体
+         * @param options String option map (e.g. MethodOptions) | 字符串选项表（如MethodOptions）
+         * @param params Output; every declared member is assigned | 输出，所有声明的成员都会被赋值
+         * @param errors Optional "key: reason" list of rejected values | 可选的被拒绝值列表（"键: 原因"）
+         * @return false if any present value was rejected (its default is kept) | 任一值被拒绝时返回false（保留默认值）
+         */
+        template <typename OptionMap>
+        bool Compile(const OptionMap &options, Params &params, std::vector<std::string> *errors = nullptr) const
+        {
+            bool ok = true;
+            std::string error;
+            for (const auto &entry : entries_)
+            {
+                auto it = options.find(entry.key);
+                const std::string *text = it != options.end() ? &it->second : nullptr;
+                if (!entry.apply(text, params, error))
+                {
+                    ok = false;
+                    if (errors)
+                        errors->push_back(entry.key + ": " + error);
+                }
+            }
+            return ok;
+        }
+
+        /**
+         * @brief Compile() and log every rejected value as a warning | 调用Compile()并将被拒绝的值记录为警告
+         * @param owner Plugin name shown in the log | 日志中显示的插件名
+         */
+        template <typename OptionMap>
+        bool CompileWithWarnings(const OptionMap &options, Params &params, const std::string &owner) const
+        {
+            std::vector<std::string> errors;
+            const bool ok = Compile(options, params, &errors);
+            for (const auto &error : errors)
+            {
+                LOG_WARNING_ZH << "[" << owner << "] 选项无效，使用默认值: " << error;
+                LOG_WARNING_EN << "[" << owner << "] Invalid option, default used: " << error;
+            }
+            return ok;
+        }
+
+        /**
+         * @brief CompileWithWarnings() only if the map differs from the last compiled one | 仅当选项表与上次编译的不同时调用CompileWithWarnings()
+         * @details Lets a reused estimator instance skip parsing (and repeated warnings) on every
+         *          Run() while its options stay the same.
+         *          复用的估计器实例在选项不变时，每次Run()无需重新解析（也不重复告警）。
+         * @param compiled_from Copy of the last compiled map, updated here | 上次编译的选项表副本，在此更新
+         * @return true if params were recompiled | 重新编译时返回true
+         */
+        template <typename OptionMap>
+        bool CompileIfChanged(const OptionMap &options, Params &params, const std::string &owner,
+                              std::optional<OptionMap> &compiled_from) const
+        {
+            if (compiled_from && *compiled_from == options)
+                return false;
+            CompileWithWarnings(options, params, owner);
+            compiled_from = options;
+            return true;
+        }
+
+        /**
+         * @brief Write typed params back into a string option map | 将类型化参数写回字符串选项表
+         */
+        template <typename OptionMap>
+        void Export(const Params &params, OptionMap &options) const
+        {
+            for (const auto &entry : entries_)
+            {
+                options[entry.key] = entry.format(params);
+            }
+        }
+
+        /**
+         * @brief Declared keys in declaration order | 按声明顺序排列的键
+         */
+        std::vector<std::string> Keys() const
+        {
+            std::vector<std::string> keys;
+            keys.reserve(entries_.size());
+            for (const auto &entry : entries_)
+                keys.push_back(entry.key);
+            return keys;
+        }
+
+    private:
+        struct Entry
+        {
+            std::string key;
+            std::function<bool(const std::string *, Params &, std::string &)> apply;
+            std::function<std::string(const Params &)> format;
+        };
+
+        std::vector<Entry> entries_;
+    };
+
+    /**
+     * @brief Typed view-pair channel of a two-view estimator | 双视图估计器的类型化视图对通道
+     * @details Callers that drive an estimator per view pair detect this interface with
+     *          dynamic_cast and pass the pair directly instead of writing "view_i"/"view_j"
+     *          strings into the option map. Estimators fall back to the string options when
+     *          no typed pair has been set. Estimators also report the RANSAC iterations of the
+     *          last Run() back through it.
+     *          逐视图对驱动估计器的调用方通过dynamic_cast检测该接口，直接传入视图对，而不是向
+     *          选项表写入"view_i"/"view_j"字符串。未设置类型化视图对时估计器回退到字符串选项。
+     *          估计器也通过该接口回报上次Run()实际的RANSAC迭代次数。
+     */
+    class TypedViewPairTarget
+    {
+    public:
+        virtual ~TypedViewPairTarget();
+
+        void SetTypedViewPair(const PoSDK::types::ViewPair &view_pair)
+        {
+            typed_view_pair_ = view_pair;
+            has_typed_view_pair_ = true;
+        }
+
+        void ClearTypedViewPair() { has_typed_view_pair_ = false; }
+
+        /**
+         * @brief RANSAC iterations realised by the last Run(), 0 if not reported | 上次Run()实际的RANSAC迭代次数，未上报时为0
+         */
+        size_t LastRansacIterations() const { return last_ransac_iterations_; }
+
+    protected:
+        void ReportRansacIterations(size_t iterations) { last_ransac_iterations_ = iterations; }
+
+        /**
+         * @brief Typed pair if set, otherwise the pair compiled from the string options
+         *        已设置时返回类型化视图对，否则返回由字符串选项编译得到的视图对
+         */
+        PoSDK::types::ViewPair ResolveViewPair(PoSDK::types::IndexT view_i, PoSDK::types::IndexT view_j) const
+        {
+            return has_typed_view_pair_ ? typed_view_pair_ : PoSDK::types::ViewPair(view_i, view_j);
+        }
+
+    private:
+        PoSDK::types::ViewPair typed_view_pair_;
+        bool has_typed_view_pair_ = false;
+        size_t last_ransac_iterations_ = 0;
+    };
+
+} // namespace common
@@ -0,0 +1,244 @@
+/**
+ * @file memory_governor.cpp
+ * @brief Memory-pressure-aware limit on concurrently active parallel tasks | 感知内存压力的并行任务并发上限
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#include "memory_governor.hpp"
+#include "../io/metrics_exporter.hpp"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace common
+{
+    namespace
+    {
+        /// Read a cgroup limit file: a byte count, or "max" / unlimited sentinel = 0 | 读取cgroup限制文件：字节数，"max"或无限制标记返回0
+        uint64_t ReadCgroupLimit(const std::string &path)
+        {
+            std::ifstream file(path);
+            std::string value;
+            if (!(file >> value) || value == "max")
+                return 0;
+            try
+            {
+                const uint64_t bytes = std::stoull(value);
+                // cgroup v1 reports "unlimited" as a page-aligned value near 2^63 | cgroup v1以接近2^63的值表示不限制
+                return bytes >= (uint64_t(1) << 62) ? 0 : bytes;
+            }
+            catch (...)
+            {
+                return 0;
+            }
+        }
+
+        /// cgroup v2 path of this process ("0::/path" in /proc/self/cgroup) | 本进程的cgroup v2路径
+        std::string CgroupV2Path()
+        {
+            std::ifstream file("/proc/self/cgroup");
+            std::string line;
+            while (std::getline(file, line))
+            {
+                if (line.rfind("0::", 0) == 0)
+                    return line.substr(3);
+            }
+            return "";
+        }
+    } // namespace
+
+    uint64_t CurrentRSSBytes()
+    {
+#ifdef __APPLE__
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+            return 0;
+        return static_cast<uint64_t>(info.resident_size);
+#else
+        // statm: size resident shared ... (pages) | statm：size resident shared ...（页）
+        std::ifstream statm("/proc/self/statm");
+        uint64_t size_pages = 0, resident_pages = 0;
+        if (!(statm >> size_pages >> resident_pages))
+            return 0;
+        const long page_size = sysconf(_SC_PAGESIZE);
+        return resident_pages * static_cast<uint64_t>(page_size > 0 ? page_size : 4096);
+#endif
+    }
+
+    uint64_t DetectMemoryLimitBytes()
+    {
+        uint64_t limit = 0;
+        const long pages = sysconf(_SC_PHYS_PAGES);
+        const long page_size = sysconf(_SC_PAGESIZE);
+        if (pages > 0 && page_size > 0)
+            limit = static_cast<uint64_t>(pages) * static_cast<uint64_t>(page_size);
+
+        // cgroup v2 (own cgroup, then root), then cgroup v1 | 先cgroup v2（自身cgroup，再根），再cgroup v1
+        uint64_t cgroup_limit = 0;
+        const std::string v2_path = CgroupV2Path();
+        if (!v2_path.empty() && v2_path != "/")
+            cgroup_limit = ReadCgroupLimit("/sys/fs/cgroup" + v2_path + "/memory.max");
+        if (cgroup_limit == 0)
+            cgroup_limit = ReadCgroupLimit("/sys/fs/cgroup/memory.max");
+        if (cgroup_limit == 0)
+            cgroup_limit = ReadCgroupLimit("/sys/fs/cgroup/memory/memory.limit_in_bytes");
+
+        if (cgroup_limit > 0)
+            limit = limit > 0 ? std::min(limit, cgroup_limit) : cgroup_limit;
+        return limit;
+    }
+
+    uint64_t PeakRSSBytes()
+    {
+#ifdef __APPLE__
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+            return 0;
+        return static_cast<uint64_t>(info.resident_size_max);
+#else
+        // "VmHWM:   123456 kB" | 峰值常驻内存
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.rfind("VmHWM:", 0) == 0)
+            {
+                try
+                {
+                    return std::stoull(line.substr(6)) * 1024;
+                }
+                catch (...)
+                {
+                    return 0;
+                }
+            }
+        }
+        return 0;
+#endif
+    }
+
+    bool ResetPeakRSS()
+    {
+#ifdef __linux__
+        // Writing 5 resets VmHWM to the current RSS (Linux 4.0+) | 写入5将VmHWM重置为当前RSS（Linux 4.0+）
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        return static_cast<bool>(clear_refs << "5" << std::flush);
+#else
+        return false;
+#endif
+    }
+
+    void TrimFreedMemory()
+    {
+#ifdef __GLIBC__
+        malloc_trim(0);
+#endif
+    }
+
+    MemoryGovernor::MemoryGovernor(const MemoryGovernorOptions &options)
+        : options_(options), waiting_metric_(MetricQueueDepth("memory_governor"))
+    {
+        options_.max_active = std::max<size_t>(1, options_.max_active);
+        options_.min_active = std::clamp<size_t>(options_.min_active, 1, options_.max_active);
+        active_limit_ = options_.max_active;
+
+        if (options_.high_watermark <= 0.0 || options_.max_active <= options_.min_active)
+            return;
+        stats_.limit_bytes = options_.limit_bytes > 0 ? options_.limit_bytes : DetectMemoryLimitBytes();
+        baseline_rss_ = CurrentRSSBytes();
+        if (stats_.limit_bytes == 0 || baseline_rss_ == 0)
+            return;
+
+        const double high = std::min(options_.high_watermark, 1.0);
+        const double low = options_.low_watermark > 0.0 ? std::min(options_.low_watermark, high) : std::max(0.0, high - 0.1);
+        high_bytes_ = static_cast<uint64_t>(high * static_cast<double>(stats_.limit_bytes));
+        low_bytes_ = static_cast<uint64_t>(low * static_cast<double>(stats_.limit_bytes));
+        // Slow start: the per-task size is unknown until tasks run, so slots open one per sample
+        // 慢启动：任务运行前单任务大小未知，槽位每次采样开放一个
+        active_limit_ = options_.min_active;
+        enabled_ = true;
+    }
+
+    void MemoryGovernor::UpdateLimitLocked()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_sample_ < std::chrono::duration<double>(options_.poll_interval_s))
+            return;
+        last_sample_ = now;
+
+        const uint64_t rss = CurrentRSSBytes();
+        stats_.peak_rss_bytes = std::max(stats_.peak_rss_bytes, rss);
+        // Working set per running task from the growth over the RSS at construction. Only the first round of
+        // tasks is used (later the outputs of finished tasks dominate the growth); the largest estimate is kept
+        // because freshly started tasks have not allocated yet and pull the average down
+        // 由相对构造时RSS的增长估计每个运行任务的工作集。只使用第一轮任务（之后已完成任务的输出占据增长的主体）；
+        // 保留最大估计，因为刚启动的任务尚未分配内存，会拉低平均值
+        if (active_ > 0 && rss > baseline_rss_ && finished_ < options_.max_active)
+            task_bytes_ = std::max(task_bytes_, (rss - baseline_rss_) / active_);
+
+        // One more task would cross the high watermark: hold at the running count | 再启动一个任务会越过高水位：保持在当前运行数
+        if (rss >= high_bytes_ || rss + task_bytes_ >= high_bytes_)
+        {
+            // Keep the running tasks, start no new ones; the limit follows them down as they finish
+            // 保留正在运行的任务，不再启动新任务；任务结束时上限随之降低
+            active_limit_ = std::max(options_.min_active, std::min(active_limit_, active_));
+        }
+        else if (rss + task_bytes_ < low_bytes_ && active_limit_ < options_.max_active)
+        {
+            ++active_limit_;
+        }
+    }
+
+    void MemoryGovernor::Acquire()
+    {
+        if (!enabled_)
+            return;
+        std::unique_lock<std::mutex> lock(mutex_);
+        UpdateLimitLocked();
+        if (active_ >= active_limit_)
+        {
+            ++stats_.throttled_waits;
+            waiting_metric_.store(static_cast<double>(++waiting_), std::memory_order_relaxed);
+            while (active_ >= active_limit_)
+            {
+                // Timed wait: freed memory is noticed even when no task finishes | 定时等待：即使没有任务结束也能察觉内存释放
+                slot_freed_.wait_for(lock, std::chrono::duration<double>(options_.poll_interval_s));
+                UpdateLimitLocked();
+            }
+            waiting_metric_.store(static_cast<double>(--waiting_), std::memory_order_relaxed);
+        }
+        ++active_;
+        stats_.peak_active = std::max(stats_.peak_active, active_);
+    }
+
+    void MemoryGovernor::Release()
+    {
+        if (!enabled_)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --active_;
+            ++finished_;
+            UpdateLimitLocked();
+        }
+        slot_freed_.notify_all();
+    }
+
+    MemoryGovernorStats MemoryGovernor::Stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+} // namespace common
@@ -0,0 +1,129 @@
+/**
+ * @file memory_governor.hpp
+ * @brief Memory-pressure-aware limit on concurrently active parallel tasks | 感知内存压力的并行任务并发上限
+ * @details Parallel stages (feature extraction, pairwise matching, two-view estimation) hold a per-task
+ *          working set (images, FLANN indexes, estimator buffers), so peak memory grows with the number of
+ *          tasks running at once. Each task acquires a slot before it starts; while the process RSS is above
+ *          the high watermark of the memory limit (cgroup limit or physical memory), or one more task of the
+ *          observed per-task size would cross it, no new slot is granted and the slot count follows the running
+ *          tasks down as they finish. Below the low watermark the slot count grows one per sample (also from the
+ *          start, since the per-task size is unknown until tasks run). Threads stay alive and only wait, so a
+ *          run under memory pressure finishes slower instead of being killed.
+ *          并行阶段（特征提取、成对匹配、双视图估计）的每个任务持有各自的工作集（图像、FLANN索引、估计器缓冲），
+ *          峰值内存随同时运行的任务数增长。任务开始前申请一个槽位；进程RSS高于内存上限（cgroup限制或物理内存）的
+ *          高水位，或按观测到的单任务大小再启动一个任务就会越过高水位时，不再发放新槽位，槽位数随任务结束而降低；
+ *          低于低水位时槽位数每次采样增加一个（开始时同样如此，因为任务运行前单任务大小未知）。
+ *          线程不会退出，只会等待，因此内存紧张时运行变慢而不是被杀死。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace common
+{
+    struct MemoryGovernorOptions
+    {
+        double high_watermark = 0.0;  ///< Fraction of the limit that throttles, <= 0 disables | 开始限流的上限比例，<= 0表示不启用
+        double low_watermark = 0.0;   ///< Fraction below which slots are restored, 0 = high - 0.1 | 恢复槽位的比例，0表示high - 0.1
+        uint64_t limit_bytes = 0;     ///< Memory limit, 0 = cgroup limit or physical memory | 内存上限，0表示cgroup限制或物理内存
+        size_t max_active = 1;        ///< Slots without pressure (usually the thread count) | 无压力时的槽位数（通常为线程数）
+        size_t min_active = 1;        ///< Slots never go below this | 槽位数下限
+        double poll_interval_s = 0.2; ///< Memory sampling interval | 内存采样间隔
+    };
+
+    struct MemoryGovernorStats
+    {
+        uint64_t limit_bytes = 0;
+        uint64_t peak_rss_bytes = 0;
+        size_t peak_active = 0;         ///< Most tasks running at once | 同时运行的最多任务数
+        size_t throttled_waits = 0;     ///< Acquisitions that had to wait | 需要等待的申请次数
+    };
+
+    /**
+     * @brief Resident set size of this process in bytes, 0 if unknown | 本进程的常驻内存（字节），未知时为0
+     */
+    uint64_t CurrentRSSBytes();
+
+    /**
+     * @brief Memory available to this process: min(cgroup v2/v1 limit, physical memory), 0 if unknown
+     *        本进程可用内存：min(cgroup v2/v1限制, 物理内存)，未知时为0
+     */
+    uint64_t DetectMemoryLimitBytes();
+
+    /**
+     * @brief Peak resident set size in bytes since start or the last ResetPeakRSS(), 0 if unknown
+     *        自启动或上次ResetPeakRSS()以来的峰值常驻内存（字节），未知时为0
+     */
+    uint64_t PeakRSSBytes();
+
+    /**
+     * @brief Restart peak RSS tracking (Linux /proc/self/clear_refs), false if unsupported
+     *        重新开始峰值RSS统计（Linux /proc/self/clear_refs），不支持时返回false
+     */
+    bool ResetPeakRSS();
+
+    /**
+     * @brief Return freed heap pages to the OS so RSS reflects released data (glibc only)
+     *        将已释放的堆页归还操作系统，使RSS反映数据释放（仅glibc）
+     */
+    void TrimFreedMemory();
+
+    class MemoryGovernor
+    {
+    public:
+        explicit MemoryGovernor(const MemoryGovernorOptions &options);
+
+        /// Governor has a watermark and a known limit | 设置了水位且上限已知
+        bool Enabled() const { return enabled_; }
+
+        /// Block until a slot is free (no-op when disabled) | 阻塞直到有空闲槽位（未启用时直接返回）
+        void Acquire();
+        void Release();
+
+        MemoryGovernorStats Stats() const;
+
+        /// RAII slot for one task | 单个任务的RAII槽位
+        class Slot
+        {
+        public:
+            explicit Slot(MemoryGovernor &governor) : governor_(governor) { governor_.Acquire(); }
+            ~Slot() { governor_.Release(); }
+            Slot(const Slot &) = delete;
+            Slot &operator=(const Slot &) = delete;
+
+        private:
+            MemoryGovernor &governor_;
+        };
+
+    private:
+        /// Re-sample RSS if the last sample is older than the poll interval (mutex held) | 上次采样过期时重新采样RSS（持有互斥锁）
+        void UpdateLimitLocked();
+
+        MemoryGovernorOptions options_;
+        bool enabled_ = false;
+        uint64_t high_bytes_ = 0;
+        uint64_t low_bytes_ = 0;
+        uint64_t baseline_rss_ = 0; ///< RSS when the stage started | 阶段开始时的RSS
+        uint64_t task_bytes_ = 0;   ///< Estimated working set of one task | 单个任务的工作集估计
+
+        mutable std::mutex mutex_;
+        std::condition_variable slot_freed_;
+        size_t active_ = 0;
+        size_t finished_ = 0;
+        size_t active_limit_ = 1;
+        size_t waiting_ = 0;
+        // Exported as posdk_queue_depth{queue="memory_governor"} | 导出为posdk_queue_depth{queue="memory_governor"}
+        std::atomic<double> &waiting_metric_;
+        std::chrono::steady_clock::time_point last_sample_;
+        MemoryGovernorStats stats_;
+    };
+
+} // namespace common
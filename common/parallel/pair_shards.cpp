@@ -0,0 +1,578 @@
+/**
+ * @file pair_shards.cpp
+ * @brief Sharded multi-process execution over view pairs | 基于视图对的分片多进程执行
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#include "pair_shards.hpp"
+#include <po_core/po_logger.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace common
+{
+    using namespace PoSDK::types;
+
+    namespace
+    {
+        constexpr char kShardMagic[8] = {'P', 'O', 'S', 'H', 'A', 'R', 'D', '1'};
+        constexpr uint32_t kEndianMarker = 0x01020304u;
+        constexpr uint32_t kShardVersion = 1;
+        // Wait for merge acknowledgements when shard_wait_timeout is 0 | shard_wait_timeout为0时等待合并确认的秒数
+        constexpr double kAckTimeoutS = 600.0;
+
+        uint64_t SplitMix64(uint64_t x)
+        {
+            x += 0x9e3779b97f4a7c15ull;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+            return x ^ (x >> 31);
+        }
+
+        uint64_t PayloadChecksum(const std::string &payload)
+        {
+            ShardFingerprint checksum;
+            checksum.Add(payload);
+            return checksum.Value();
+        }
+
+        // The run id keeps files of an earlier run on the same input from being merged
+        // 运行ID保证相同输入的之前运行留下的文件不会被合并
+        std::string ShardFilePath(const ShardOptions &options, const std::string &phase, size_t shard_index)
+        {
+            return (std::filesystem::path(options.shard_dir) /
+                    (phase + "." + options.run_id + ".shard-" + std::to_string(shard_index) + "-of-" +
+                     std::to_string(options.shard_count) + ".bin"))
+                .string();
+        }
+
+        // Written by every worker once it holds all payloads | 每个工作进程取得全部负载后写出
+        std::string ShardAckPath(const ShardOptions &options, const std::string &phase, size_t shard_index)
+        {
+            return (std::filesystem::path(options.shard_dir) /
+                    (phase + "." + options.run_id + ".merged-" + std::to_string(shard_index)))
+                .string();
+        }
+
+        // Write to a private temporary file, then rename so readers never see partial files
+        // 先写入私有临时文件再重命名，读取方不会看到不完整的文件
+        bool WriteShardFile(const std::string &path, const std::string &phase, size_t shard_index,
+                            size_t shard_count, uint64_t fingerprint, const std::string &payload,
+                            std::string &error)
+        {
+#ifndef _WIN32
+            const std::string tmp_path = path + ".tmp." + std::to_string(::getpid());
+#else
+            const std::string tmp_path = path + ".tmp";
+#endif
+            {
+                std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+                if (!out)
+                {
+                    error = "cannot create " + tmp_path;
+                    return false;
+                }
+
+                std::string header;
+                ShardPayloadWriter writer(header);
+                header.append(kShardMagic, sizeof(kShardMagic));
+                writer.Put(kEndianMarker);
+                writer.Put(kShardVersion);
+                writer.Put(static_cast<uint32_t>(shard_index));
+                writer.Put(static_cast<uint32_t>(shard_count));
+                writer.Put(fingerprint);
+                writer.Put(static_cast<uint32_t>(phase.size()));
+                header.append(phase);
+                writer.Put(static_cast<uint64_t>(payload.size()));
+                writer.Put(PayloadChecksum(payload));
+
+                out.write(header.data(), static_cast<std::streamsize>(header.size()));
+                out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+                if (!out.flush())
+                {
+                    error = "write failed: " + tmp_path;
+                    return false;
+                }
+            }
+
+            std::error_code ec;
+            std::filesystem::rename(tmp_path, path, ec);
+            if (ec)
+            {
+                error = "cannot publish " + path + ": " + ec.message();
+                std::filesystem::remove(tmp_path, ec);
+                return false;
+            }
+            return true;
+        }
+
+        // Returns false if the file is missing, stale (other fingerprint) or damaged
+        // 文件缺失、过期（指纹不同）或损坏时返回false
+        bool ReadShardFile(const std::string &path, const std::string &phase, size_t shard_index,
+                           size_t shard_count, uint64_t fingerprint, std::string &payload,
+                           std::string &reason)
+        {
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+            {
+                reason = "missing";
+                return false;
+            }
+            const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+            if (content.size() < sizeof(kShardMagic) || content.compare(0, sizeof(kShardMagic), kShardMagic, sizeof(kShardMagic)) != 0)
+            {
+                reason = "not a shard file";
+                return false;
+            }
+            const std::string body = content.substr(sizeof(kShardMagic));
+            ShardPayloadReader reader(body);
+
+            uint32_t endian = 0, version = 0, index = 0, count = 0, phase_size = 0;
+            uint64_t file_fingerprint = 0;
+            if (!reader.Get(endian) || !reader.Get(version) || !reader.Get(index) || !reader.Get(count) ||
+                !reader.Get(file_fingerprint) || !reader.Get(phase_size))
+            {
+                reason = "truncated header";
+                return false;
+            }
+            if (endian != kEndianMarker || version != kShardVersion)
+            {
+                reason = "incompatible format (endianness or version)";
+                return false;
+            }
+            if (index != shard_index || count != shard_count || file_fingerprint != fingerprint)
+            {
+                reason = "stale (different input or shard layout)";
+                return false;
+            }
+
+            std::string file_phase(phase_size, '\0');
+            for (char &c : file_phase)
+            {
+                if (!reader.Get(c))
+                {
+                    reason = "truncated header";
+                    return false;
+                }
+            }
+            uint64_t payload_size = 0, checksum = 0;
+            if (file_phase != phase || !reader.Get(payload_size) || !reader.Get(checksum))
+            {
+                reason = "phase mismatch";
+                return false;
+            }
+
+            const size_t header_size = sizeof(kShardMagic) + 5 * sizeof(uint32_t) + 3 * sizeof(uint64_t) + phase_size;
+            if (content.size() != header_size + payload_size)
+            {
+                reason = "size mismatch";
+                return false;
+            }
+            payload = content.substr(header_size);
+            if (PayloadChecksum(payload) != checksum)
+            {
+                reason = "checksum mismatch";
+                return false;
+            }
+            return true;
+        }
+
+        bool RunTask(const ShardTask &task, size_t shard_index, std::string &payload, std::string &error)
+        {
+            payload.clear();
+            try
+            {
+                if (!task(shard_index, payload))
+                {
+                    error = "shard " + std::to_string(shard_index) + " task failed";
+                    return false;
+                }
+            }
+            catch (const std::exception &e)
+            {
+                error = "shard " + std::to_string(shard_index) + " task threw: " + e.what();
+                return false;
+            }
+            return true;
+        }
+
+        bool RunTaskToFile(const ShardOptions &options, const std::string &phase, uint64_t fingerprint,
+                           const ShardTask &task, size_t shard_index, std::string &error)
+        {
+            std::string payload;
+            if (!RunTask(task, shard_index, payload, error))
+            {
+                return false;
+            }
+            return WriteShardFile(ShardFilePath(options, phase, shard_index), phase, shard_index,
+                                  options.shard_count, fingerprint, payload, error);
+        }
+
+        // Shard 0 deletes the shard files once every worker has merged them; a worker that never
+        // acknowledges leaves the files in place
+        // 所有工作进程合并完成后由分片0删除分片文件；若有工作进程未确认则保留文件
+        void RemoveMergedShardFiles(const ShardOptions &options, const std::string &phase, bool remove_dir)
+        {
+            // Workers acknowledge right after their own merge, so a short bounded wait is enough
+            // 工作进程在各自合并后立即确认，有限等待即可
+            const double ack_timeout_s = options.wait_timeout_s > 0.0 ? options.wait_timeout_s : kAckTimeoutS;
+            const auto start = std::chrono::steady_clock::now();
+            std::error_code ec;
+            for (size_t k = 0; k < options.shard_count; ++k)
+            {
+                while (!std::filesystem::exists(ShardAckPath(options, phase, k), ec))
+                {
+                    const double waited = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    if (waited > ack_timeout_s)
+                    {
+                        LOG_WARNING_ZH << "[PairShards] 分片 " << k << " 未确认合并，保留分片文件: " << options.shard_dir;
+                        LOG_WARNING_EN << "[PairShards] Shard " << k << " did not acknowledge the merge, keeping shard files: " << options.shard_dir;
+                        return;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                }
+            }
+            for (size_t k = 0; k < options.shard_count; ++k)
+            {
+                std::filesystem::remove(ShardFilePath(options, phase, k), ec);
+                std::filesystem::remove(ShardAckPath(options, phase, k), ec);
+            }
+            if (remove_dir && std::filesystem::is_empty(options.shard_dir, ec) && !ec)
+            {
+                std::filesystem::remove(options.shard_dir, ec);
+            }
+        }
+
+        bool CollectShardFiles(const ShardOptions &options, const std::string &phase, uint64_t fingerprint,
+                               std::vector<std::string> &payloads, std::string &error)
+        {
+            payloads.assign(options.shard_count, std::string());
+            std::vector<bool> loaded(options.shard_count, false);
+            size_t num_loaded = 0;
+
+            const auto start = std::chrono::steady_clock::now();
+            auto last_report = start;
+            while (true)
+            {
+                std::string reason;
+                for (size_t k = 0; k < options.shard_count; ++k)
+                {
+                    if (!loaded[k] &&
+                        ReadShardFile(ShardFilePath(options, phase, k), phase, k, options.shard_count,
+                                      fingerprint, payloads[k], reason))
+                    {
+                        loaded[k] = true;
+                        ++num_loaded;
+                    }
+                }
+                if (num_loaded == options.shard_count)
+                {
+                    return true;
+                }
+
+                const auto now = std::chrono::steady_clock::now();
+                const double waited = std::chrono::duration<double>(now - start).count();
+                if (options.wait_timeout_s > 0.0 && waited > options.wait_timeout_s)
+                {
+                    error = "timed out waiting for " + std::to_string(options.shard_count - num_loaded) +
+                            " shard(s) of phase '" + phase + "' in " + options.shard_dir;
+                    return false;
+                }
+                if (std::chrono::duration<double>(now - last_report).count() > 30.0)
+                {
+                    LOG_INFO_ZH << "[PairShards] 等待分片 (" << phase << "): " << num_loaded << "/" << options.shard_count;
+                    LOG_INFO_EN << "[PairShards] Waiting for shards (" << phase << "): " << num_loaded << "/" << options.shard_count;
+                    last_report = now;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            }
+        }
+    } // namespace
+
+    size_t ShardOfPair(IndexT i, IndexT j, size_t shard_count)
+    {
+        if (shard_count <= 1)
+            return 0;
+        const uint64_t key = (static_cast<uint64_t>(i) << 32) | static_cast<uint64_t>(j);
+        return static_cast<size_t>(SplitMix64(key) % shard_count);
+    }
+
+    ShardFingerprint &ShardFingerprint::Add(uint64_t value)
+    {
+        for (int byte = 0; byte < 8; ++byte)
+        {
+            hash_ ^= (value >> (8 * byte)) & 0xffu;
+            hash_ *= 1099511628211ull;
+        }
+        return *this;
+    }
+
+    ShardFingerprint &ShardFingerprint::Add(const std::string &text)
+    {
+        return Add(text.data(), text.size());
+    }
+
+    ShardFingerprint &ShardFingerprint::Add(const void *data, size_t size)
+    {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        for (size_t k = 0; k < size; ++k)
+        {
+            hash_ ^= bytes[k];
+            hash_ *= 1099511628211ull;
+        }
+        return Add(static_cast<uint64_t>(size));
+    }
+
+    bool RunShardedPhase(const ShardOptions &options,
+                         const std::string &phase,
+                         uint64_t fingerprint,
+                         const ShardTask &task,
+                         std::vector<std::string> &payloads,
+                         std::string &error)
+    {
+        payloads.clear();
+        if (!options.Enabled())
+        {
+            error = "sharding needs shard_count > 1 and a shard_index";
+            return false;
+        }
+        if (options.run_id.empty())
+        {
+            error = "shard run id is empty; every worker of one run must pass the same run id";
+            return false;
+        }
+
+        // Compute our shard, then join the others through the shared directory
+        // 计算本分片，然后通过共享目录汇合其他分片
+        const size_t shard_index = static_cast<size_t>(options.shard_index);
+        if (shard_index >= options.shard_count)
+        {
+            error = "shard_index " + std::to_string(shard_index) + " out of range for shard_count " +
+                    std::to_string(options.shard_count);
+            return false;
+        }
+
+        // Without shard_dir, workers of the same input meet in a temp directory named after the fingerprint,
+        // so concurrent jobs on other inputs never share files
+        // 未指定shard_dir时，相同输入的工作进程在以指纹命名的临时目录中汇合，不同输入的并发任务不会共用文件
+        ShardOptions resolved = options;
+        const bool temp_dir = resolved.shard_dir.empty();
+        if (temp_dir)
+        {
+            char fingerprint_hex[17];
+            std::snprintf(fingerprint_hex, sizeof(fingerprint_hex), "%016llx", static_cast<unsigned long long>(fingerprint));
+            resolved.shard_dir = (std::filesystem::temp_directory_path() / "posdk_shards" / (phase + "-" + fingerprint_hex)).string();
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(resolved.shard_dir, ec);
+        if (ec)
+        {
+            error = "cannot create shard_dir " + resolved.shard_dir + ": " + ec.message();
+            return false;
+        }
+
+        LOG_INFO_ZH << "[PairShards] 计算分片 " << shard_index << "/" << resolved.shard_count << " (" << phase << "), 目录: " << resolved.shard_dir;
+        LOG_INFO_EN << "[PairShards] Computing shard " << shard_index << "/" << resolved.shard_count << " (" << phase << "), directory: " << resolved.shard_dir;
+        // The run id is part of the fingerprint too, so a renamed leftover is still rejected
+        // 运行ID也计入指纹，即使遗留文件被改名也会被拒绝
+        fingerprint = ShardFingerprint().Add(fingerprint).Add(resolved.run_id).Value();
+        if (!RunTaskToFile(resolved, phase, fingerprint, task, shard_index, error) ||
+            !CollectShardFiles(resolved, phase, fingerprint, payloads, error))
+        {
+            return false;
+        }
+
+        std::string ack_error;
+        if (!WriteShardFile(ShardAckPath(resolved, phase, shard_index), phase, shard_index, resolved.shard_count,
+                            fingerprint, std::string(), ack_error))
+        {
+            LOG_WARNING_ZH << "[PairShards] 无法写出合并确认，分片文件将保留: " << ack_error;
+            LOG_WARNING_EN << "[PairShards] Cannot write the merge acknowledgement, shard files are kept: " << ack_error;
+        }
+        else if (shard_index == 0)
+        {
+            RemoveMergedShardFiles(resolved, phase, temp_dir);
+        }
+        return true;
+    }
+
+    // ==================== Payload codecs | 负载编解码 ====================
+
+    namespace
+    {
+        void PutIdMatches(ShardPayloadWriter &writer, const ViewPair &view_pair, const IdMatches &id_matches)
+        {
+            writer.Put(static_cast<uint32_t>(view_pair.first));
+            writer.Put(static_cast<uint32_t>(view_pair.second));
+            writer.Put(static_cast<uint64_t>(id_matches.size()));
+            for (const auto &match : id_matches)
+            {
+                writer.Put(static_cast<uint32_t>(match.i));
+                writer.Put(static_cast<uint32_t>(match.j));
+                writer.Put(static_cast<uint8_t>(match.is_inlier ? 1 : 0));
+            }
+        }
+    } // namespace
+
+    void EncodeMatches(const Matches &matches, std::string &payload)
+    {
+        ShardPayloadWriter writer(payload);
+        writer.Put(static_cast<uint64_t>(matches.size()));
+        for (const auto &[view_pair, id_matches] : matches)
+        {
+            PutIdMatches(writer, view_pair, id_matches);
+        }
+    }
+
+    void EncodeMatchesByView(const Matches &matches, std::vector<std::pair<IndexT, std::string>> &frames)
+    {
+        std::map<IndexT, std::vector<const Matches::value_type *>> by_view;
+        for (const auto &entry : matches)
+        {
+            by_view[entry.first.first].push_back(&entry);
+        }
+
+        frames.clear();
+        frames.reserve(by_view.size());
+        for (const auto &[view_id, entries] : by_view)
+        {
+            frames.emplace_back(view_id, std::string());
+            ShardPayloadWriter writer(frames.back().second);
+            writer.Put(static_cast<uint64_t>(entries.size()));
+            for (const auto *entry : entries)
+            {
+                PutIdMatches(writer, entry->first, entry->second);
+            }
+        }
+    }
+
+    bool DecodeMatches(const std::string &payload, Matches &matches)
+    {
+        ShardPayloadReader reader(payload);
+        uint64_t num_pairs = 0;
+        if (!reader.Get(num_pairs))
+            return false;
+
+        for (uint64_t p = 0; p < num_pairs; ++p)
+        {
+            uint32_t view_i = 0, view_j = 0;
+            uint64_t num_matches = 0;
+            if (!reader.Get(view_i) || !reader.Get(view_j) || !reader.Get(num_matches))
+                return false;
+
+            IdMatches id_matches;
+            id_matches.reserve(static_cast<size_t>(num_matches));
+            for (uint64_t m = 0; m < num_matches; ++m)
+            {
+                uint32_t feature_i = 0, feature_j = 0;
+                uint8_t inlier = 0;
+                if (!reader.Get(feature_i) || !reader.Get(feature_j) || !reader.Get(inlier))
+                    return false;
+                IdMatch match;
+                match.i = feature_i;
+                match.j = feature_j;
+                match.is_inlier = inlier != 0;
+                id_matches.push_back(match);
+            }
+            if (!matches.emplace(ViewPair(view_i, view_j), std::move(id_matches)).second)
+                return false; // A pair belongs to exactly one shard | 每个视图对只属于一个分片
+        }
+        return reader.AtEnd();
+    }
+
+    void EncodeTwoViewShard(const std::vector<RelativePose> &poses, const Matches &shard_matches, std::string &payload)
+    {
+        ShardPayloadWriter writer(payload);
+        writer.Put(static_cast<uint64_t>(poses.size()));
+        for (const auto &pose : poses)
+        {
+            writer.Put(static_cast<uint32_t>(pose.GetViewIdI()));
+            writer.Put(static_cast<uint32_t>(pose.GetViewIdJ()));
+            const Matrix3d &R = pose.GetRotation();
+            const Vector3d &t = pose.GetTranslation();
+            for (int r = 0; r < 3; ++r)
+                for (int c = 0; c < 3; ++c)
+                    writer.Put(R(r, c));
+            for (int r = 0; r < 3; ++r)
+                writer.Put(t(r));
+            writer.Put(static_cast<float>(pose.GetWeight()));
+        }
+
+        // Inlier flags only; the feature ids are already known to the reader | 仅内点标记，特征ID读取方已知
+        writer.Put(static_cast<uint64_t>(shard_matches.size()));
+        for (const auto &[view_pair, id_matches] : shard_matches)
+        {
+            writer.Put(static_cast<uint32_t>(view_pair.first));
+            writer.Put(static_cast<uint32_t>(view_pair.second));
+            writer.Put(static_cast<uint64_t>(id_matches.size()));
+            for (const auto &match : id_matches)
+            {
+                writer.Put(static_cast<uint8_t>(match.is_inlier ? 1 : 0));
+            }
+        }
+    }
+
+    bool DecodeTwoViewShard(const std::string &payload, std::vector<RelativePose> &poses, Matches &matches)
+    {
+        ShardPayloadReader reader(payload);
+        uint64_t num_poses = 0;
+        if (!reader.Get(num_poses))
+            return false;
+
+        for (uint64_t p = 0; p < num_poses; ++p)
+        {
+            uint32_t view_i = 0, view_j = 0;
+            Matrix3d R;
+            Vector3d t;
+            float weight = 1.0f;
+            if (!reader.Get(view_i) || !reader.Get(view_j))
+                return false;
+            for (int r = 0; r < 3; ++r)
+                for (int c = 0; c < 3; ++c)
+                    if (!reader.Get(R(r, c)))
+                        return false;
+            for (int r = 0; r < 3; ++r)
+                if (!reader.Get(t(r)))
+                    return false;
+            if (!reader.Get(weight))
+                return false;
+            poses.emplace_back(view_i, view_j, R, t, weight);
+        }
+
+        uint64_t num_pairs = 0;
+        if (!reader.Get(num_pairs))
+            return false;
+        for (uint64_t p = 0; p < num_pairs; ++p)
+        {
+            uint32_t view_i = 0, view_j = 0;
+            uint64_t num_flags = 0;
+            if (!reader.Get(view_i) || !reader.Get(view_j) || !reader.Get(num_flags))
+                return false;
+
+            auto it = matches.find(ViewPair(view_i, view_j));
+            if (it == matches.end() || it->second.size() != num_flags)
+                return false; // Shard computed from different matches | 分片来自不同的匹配
+            for (auto &match : it->second)
+            {
+                uint8_t inlier = 0;
+                if (!reader.Get(inlier))
+                    return false;
+                match.is_inlier = inlier != 0;
+            }
+        }
+        return reader.AtEnd();
+    }
+
+} // namespace common
@@ -0,0 +1,188 @@
+/**
+ * @file pair_shards.hpp
+ * @brief Sharded multi-process execution over view pairs | 基于视图对的分片多进程执行
+ * @details A pair-level phase (feature matching, two-view estimation) is split into K shards by a
+ *          hash of the view pair, so the assignment does not depend on container order or thread
+ *          count. The shard payloads are merged in shard order and sorted by view pair, so the
+ *          result is identical for any K.
+ *          将视图对级阶段（特征匹配、双视图估计）按视图对哈希划分为K个分片，分配与容器顺序和线程数
+ *          无关。分片负载按分片顺序读取并按视图对排序合并，因此对任意K结果一致。
+ *
+ *          Each of K processes (one per node, or posdk_globalsfm --shard_launch=spawn on one machine)
+ *          computes shard k only, writes one binary shard file into shard_dir and waits for the other
+ *          shard files there (e.g. on NFS). Running the shards in one process would gain nothing over
+ *          the unsharded path, so sharding needs a shard_index.
+ *          K个进程（每节点一个，或在单机上使用posdk_globalsfm --shard_launch=spawn）各自只计算分片k，
+ *          在shard_dir中写入一个二进制分片文件并在其中等待其他分片文件（如NFS）。在单进程内运行各分片
+ *          相比不分片没有收益，因此分片需要shard_index。
+ *
+ *          Files are published by atomic rename and named after a run id shared by the workers of
+ *          one run; the run id is also part of the fingerprint. Partial files and leftovers of an
+ *          earlier run are never merged. Shard 0 deletes the files after every worker has merged them.
+ *          文件通过原子重命名发布，并以同一次运行的所有工作进程共享的运行ID命名，运行ID也计入指纹，
+ *          不会合并不完整文件或之前运行的遗留文件。所有工作进程合并后由分片0删除这些文件。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <po_core/types.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace common
+{
+    /**
+     * @brief Shard options | 分片参数
+     */
+    struct ShardOptions
+    {
+        // Number of shards, 0 or 1 disables sharding | 分片数，0或1表示不分片
+        size_t shard_count = 0;
+        // Shard computed by this process, -1 disables sharding | 本进程计算的分片，-1表示不分片
+        int shard_index = -1;
+        // Directory holding the shard files, shared between nodes; empty uses a temp directory
+        // named after the input fingerprint
+        // 存放分片文件的目录，需在节点间共享；为空时使用以输入指纹命名的临时目录
+        std::string shard_dir;
+        // Identical in every worker of one run and unique per run | 同一次运行的所有工作进程相同，每次运行唯一
+        std::string run_id;
+        // Seconds to wait for the other shards, 0 waits forever | 等待其他分片的秒数，0表示一直等待
+        double wait_timeout_s = 0.0;
+
+        bool Enabled() const { return shard_count > 1 && shard_index >= 0; }
+    };
+
+    /**
+     * @brief Shard owning a view pair, stable across runs and machines | 视图对所属分片，跨运行和机器稳定
+     */
+    size_t ShardOfPair(PoSDK::types::IndexT i, PoSDK::types::IndexT j, size_t shard_count);
+
+    /**
+     * @brief 64-bit FNV-1a fingerprint of the phase input | 阶段输入的64位FNV-1a指纹
+     */
+    class ShardFingerprint
+    {
+    public:
+        ShardFingerprint &Add(uint64_t value);
+        ShardFingerprint &Add(const std::string &text);
+        ShardFingerprint &Add(const void *data, size_t size); // raw bytes followed by their size | 原始字节及其长度
+        uint64_t Value() const { return hash_; }
+
+    private:
+        uint64_t hash_ = 1469598103934665603ull;
+    };
+
+    /**
+     * @brief Appends trivially copyable values to a shard payload | 向分片负载追加平凡可复制值
+     */
+    class ShardPayloadWriter
+    {
+    public:
+        explicit ShardPayloadWriter(std::string &payload) : payload_(payload) {}
+
+        template <typename T>
+        void Put(const T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "shard payload values must be trivially copyable");
+            payload_.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+    private:
+        std::string &payload_;
+    };
+
+    /**
+     * @brief Reads values back from a shard payload | 从分片负载中读取值
+     */
+    class ShardPayloadReader
+    {
+    public:
+        explicit ShardPayloadReader(const std::string &payload) : payload_(payload) {}
+
+        template <typename T>
+        bool Get(T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "shard payload values must be trivially copyable");
+            if (payload_.size() - offset_ < sizeof(T))
+                return false;
+            std::memcpy(&value, payload_.data() + offset_, sizeof(T));
+            offset_ += sizeof(T);
+            return true;
+        }
+
+        bool AtEnd() const { return offset_ == payload_.size(); }
+
+    private:
+        const std::string &payload_;
+        size_t offset_ = 0;
+    };
+
+    /**
+     * @brief Computes the payload of one shard | 计算一个分片的负载
+     * @return false on failure | 失败时返回false
+     * @note Only the payload reaches the other workers | 只有payload会传给其他工作进程
+     */
+    using ShardTask = std::function<bool(size_t shard_index, std::string &payload)>;
+
+    /**
+     * @brief Compute this process's shard, then collect every shard's payload | 计算本进程的分片并收集所有分片负载
+     * @param options Shard options | 分片参数
+     * @param phase Phase name, part of the file name, e.g. "matches" | 阶段名，用作文件名的一部分
+     * @param fingerprint Fingerprint of the phase input | 阶段输入指纹
+     * @param task Shard computation | 分片计算
+     * @param payloads Output: payloads in shard order | 输出：按分片顺序排列的负载
+     * @param error Output: failure reason | 输出：失败原因
+     */
+    bool RunShardedPhase(const ShardOptions &options,
+                         const std::string &phase,
+                         uint64_t fingerprint,
+                         const ShardTask &task,
+                         std::vector<std::string> &payloads,
+                         std::string &error);
+
+    // ==================== Payload codecs | 负载编解码 ====================
+
+    /**
+     * @brief Encode view-pair matches (including inlier flags) | 编码视图对匹配（含内点标记）
+     */
+    void EncodeMatches(const PoSDK::types::Matches &matches, std::string &payload);
+
+    /**
+     * @brief Encode matches as one payload per first view, each decodable by DecodeMatches()
+     *        按第一个视图将匹配编码为多个负载，每个负载均可由DecodeMatches()解码
+     */
+    void EncodeMatchesByView(const PoSDK::types::Matches &matches,
+                             std::vector<std::pair<PoSDK::types::IndexT, std::string>> &frames);
+
+    /**
+     * @brief Decode matches and insert them into the output map | 解码匹配并插入输出映射
+     * @return false on malformed payload or duplicated view pair | 负载格式错误或视图对重复时返回false
+     */
+    bool DecodeMatches(const std::string &payload, PoSDK::types::Matches &matches);
+
+    /**
+     * @brief Encode relative poses plus the inlier flags of the shard's view pairs
+     *        编码相对位姿以及分片内视图对的内点标记
+     */
+    void EncodeTwoViewShard(const std::vector<PoSDK::types::RelativePose> &poses,
+                            const PoSDK::types::Matches &shard_matches,
+                            std::string &payload);
+
+    /**
+     * @brief Decode a two-view shard | 解码双视图分片
+     * @param poses Output: poses are appended | 输出：追加位姿
+     * @param matches In/out: inlier flags are written back to matching view pairs | 输入输出：内点标记写回对应视图对
+     */
+    bool DecodeTwoViewShard(const std::string &payload,
+                            std::vector<PoSDK::types::RelativePose> &poses,
+                            PoSDK::types::Matches &matches);
+
+} // namespace common
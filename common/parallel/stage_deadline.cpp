@@ -0,0 +1,71 @@
+/**
+ * @file stage_deadline.cpp
+ * @brief Time budget of a pipeline stage for deadline ("anytime") execution | 截止时间（anytime）执行的阶段时间预算
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#include "stage_deadline.hpp"
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace common
+{
+    using namespace PoSDK::types;
+
+    StageDeadline::StageDeadline(double budget_s)
+        : enabled_(budget_s > 0.0),
+          budget_s_(budget_s > 0.0 ? budget_s : 0.0)
+    {
+        end_ = start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double>(budget_s_));
+    }
+
+    bool StageDeadline::Expired() const
+    {
+        return enabled_ && std::chrono::steady_clock::now() >= end_;
+    }
+
+    double StageDeadline::ElapsedSeconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    double StageDeadline::RemainingSeconds() const
+    {
+        if (!enabled_)
+            return std::numeric_limits<double>::max();
+        const double remaining = std::chrono::duration<double>(end_ - std::chrono::steady_clock::now()).count();
+        return remaining > 0.0 ? remaining : 0.0;
+    }
+
+    bool WritePairList(const std::string &path, const std::vector<ViewPair> &pairs)
+    {
+        std::error_code ec;
+        if (pairs.empty())
+        {
+            std::filesystem::remove(path, ec);
+            return true;
+        }
+        const std::filesystem::path file_path(path);
+        if (file_path.has_parent_path())
+            std::filesystem::create_directories(file_path.parent_path(), ec);
+        std::ofstream file(file_path);
+        if (!file.is_open())
+            return false;
+        for (const auto &pair : pairs)
+            file << pair.first << " " << pair.second << "\n";
+        return static_cast<bool>(file);
+    }
+
+    std::vector<ViewPair> ReadPairList(const std::string &path)
+    {
+        std::vector<ViewPair> pairs;
+        std::ifstream file(path);
+        IndexT i = 0, j = 0;
+        while (file >> i >> j)
+            pairs.emplace_back(i, j);
+        return pairs;
+    }
+
+} // namespace common
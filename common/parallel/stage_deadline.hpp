@@ -0,0 +1,62 @@
+/**
+ * @file stage_deadline.hpp
+ * @brief Time budget of a pipeline stage for deadline ("anytime") execution | 截止时间（anytime）执行的阶段时间预算
+ * @details A stage that supports deadline mode orders its work items by priority (strongest view pairs
+ *          first) and stops starting new items once its budget has expired; items already started finish,
+ *          so the stage returns the best result reachable within the budget. The pairs that were not
+ *          processed are written to a plain text file ("i j" per line) for the pipeline report.
+ *          支持截止时间模式的阶段按优先级（最强视图对优先）处理工作项，预算耗尽后不再启动新工作项；已开始的
+ *          工作项正常完成，因此阶段返回预算内可得到的最佳结果。未处理的视图对写入文本文件（每行"i j"）供
+ *          流水线报告使用。
+ *
+ * @copyright Copyright (c) 2024 PoSDK Project
+ */
+
+#pragma once
+
+#include <po_core/types.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace common
+{
+    /**
+     * @brief Wall-clock budget started at construction, safe to query from worker threads
+     *        构造时开始计时的墙钟预算，可在工作线程中查询
+     */
+    class StageDeadline
+    {
+    public:
+        /// No deadline: never expires | 无截止时间：永不过期
+        StageDeadline() = default;
+
+        /// @param budget_s Budget in seconds, <= 0 disables | 预算（秒），<= 0表示不启用
+        explicit StageDeadline(double budget_s);
+
+        bool Enabled() const { return enabled_; }
+        bool Expired() const;
+        double BudgetSeconds() const { return budget_s_; }
+        double ElapsedSeconds() const;
+        /// Seconds left, 0 once expired; a large value when disabled | 剩余秒数，过期后为0；未启用时为极大值
+        double RemainingSeconds() const;
+
+    private:
+        bool enabled_ = false;
+        double budget_s_ = 0.0;
+        std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point end_ = start_;
+    };
+
+    /**
+     * @brief Write view pairs as "i j" lines (empty list removes the file) | 以"i j"行写出视图对（列表为空时删除文件）
+     * @return false if the file could not be written | 无法写入时返回false
+     */
+    bool WritePairList(const std::string &path, const std::vector<PoSDK::types::ViewPair> &pairs);
+
+    /**
+     * @brief Read a pair list written by WritePairList (missing file = empty list) | 读取WritePairList写出的视图对列表（文件不存在视为空）
+     */
+    std::vector<PoSDK::types::ViewPair> ReadPairList(const std::string &path);
+
+} // namespace common
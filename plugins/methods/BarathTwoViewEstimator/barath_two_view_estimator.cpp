@@ -56,9 +56,43 @@ namespace PluginMethods
     using namespace types;
     using namespace Eigen;
 
+    const common::OptionSchema<BarathTwoViewEstimator::EstimatorOptions> &BarathTwoViewEstimator::GetOptionSchema()
+    {
+        // Defaults follow the Barath Python bindings | 默认值与Barath Python接口一致
+        static const auto schema = common::OptionSchema<EstimatorOptions>()
+                                       .Add("view_i", &EstimatorOptions::view_i, 0)
+                                       .Add("view_j", &EstimatorOptions::view_j, 1)
+                                       .Add("algorithm", &EstimatorOptions::algorithm, "magsac")
+                                       .Add("confidence", &EstimatorOptions::confidence, 0.99,
+                                            [](const double &value)
+                                            { return value > 0.0 && value <= 1.0; })
+                                       .Add("ransac_threshold", &EstimatorOptions::ransac_threshold, 1.0,
+                                            [](const double &value)
+                                            { return value > 0.0; })
+                                       .Add("max_iterations", &EstimatorOptions::max_iterations, 1000)
+                                       .Add("min_iterations", &EstimatorOptions::min_iterations, 50)
+                                       .Add("partition_num", &EstimatorOptions::partition_num, 5)
+                                       .Add("core_number", &EstimatorOptions::core_number, 1)
+                                       .Add("sampler_id", &EstimatorOptions::sampler_id, 4)
+                                       .Add("image_width", &EstimatorOptions::image_width, 640.0)
+                                       .Add("image_height", &EstimatorOptions::image_height, 480.0)
+                                       .Add("pnapsac_layers", &EstimatorOptions::pnapsac_layers, 4)
+                                       .Add("pnapsac_blend_ratio", &EstimatorOptions::pnapsac_blend_ratio, 0.5)
+                                       .Add("ar_variance", &EstimatorOptions::ar_variance, 0.1)
+                                       .Add("enable_bundle_adjustment", &EstimatorOptions::enable_bundle_adjustment, true)
+                                       .Add("ba_min_inliers", &EstimatorOptions::ba_min_inliers, 6)
+                                       .Add("ba_max_iterations", &EstimatorOptions::ba_max_iterations, 100)
+                                       .Add("enable_adaptive_inlier_selection", &EstimatorOptions::enable_adaptive_inlier_selection, false)
+                                       .Add("adaptive_max_threshold", &EstimatorOptions::adaptive_max_threshold, 10.0)
+                                       .Add("adaptive_min_inliers", &EstimatorOptions::adaptive_min_inliers, 20);
+        return schema;
+    }
+
     DataPtr BarathTwoViewEstimator::Run()
     {
         DisplayConfigInfo();
+        // Compile options once; the rest of Run() reads typed fields | 编译一次选项，Run()其余部分读取类型化字段
+        GetOptionSchema().CompileWithWarnings(GetMethodOptions(), options_, GetType());
 
         // 1. Get input data | 1. 获取输入数据
         auto sample_ptr = CastToSample<IdMatches>(required_package_["data_sample"]);
@@ -72,15 +106,13 @@ namespace PluginMethods
             return nullptr;
         }
 
-        // 2. Get view pair information from method_options_ | 2. 从method_options_获取视图对信息
-        ViewPair view_pair(
-            GetOptionAsIndexT("view_i", 0),
-            GetOptionAsIndexT("view_j", 1));
+        // 2. Get view pair (typed pair first, else method_options_) | 2. 获取视图对信息（类型化视图对优先，否则取自method_options_）
+        ViewPair view_pair = ResolveViewPair(options_.view_i, options_.view_j);
         ViewId view_id1 = view_pair.first;
         ViewId view_id2 = view_pair.second;
 
         // 3. Determine the algorithm to use | 3. 确定要使用的算法
-        const std::string algorithm_str = GetOptionAsString("algorithm", "magsac");
+        const std::string &algorithm_str = options_.algorithm;
         Algorithm algorithm = CreateAlgorithmFromString(algorithm_str);
 
         // Get camera intrinsics - using overloaded operator[] for smart camera model access | 获取相机内参 - 使用重载的operator[]支持智能相机模型访问
@@ -248,12 +280,12 @@ namespace PluginMethods
         cv::Mat &E,
         cv::Mat &inliers_mask)
     {
-        double prob = GetOptionAsDouble("confidence", 0.99);           // Barath Python默认: 0.99
-        double threshold = GetOptionAsDouble("ransac_threshold", 1.0); // Barath Python默认: sigma_th=1.0
-        int max_iters = GetOptionAsIndexT("max_iterations", 1000);     // Barath Python默认: 1000
-        int min_iters = GetOptionAsIndexT("min_iterations", 50);       // Barath Python默认: 50
-        int partition_num = GetOptionAsIndexT("partition_num", 5);     // Barath默认: 5
-        int core_number = GetOptionAsIndexT("core_number", 1);         // Barath默认: 1
+        double prob = options_.confidence;
+        double threshold = options_.ransac_threshold;
+        int max_iters = static_cast<int>(options_.max_iterations);
+        int min_iters = static_cast<int>(options_.min_iterations);
+        int partition_num = static_cast<int>(options_.partition_num);
+        int core_number = static_cast<int>(options_.core_number);
 
         if (algorithm == Algorithm::MAGSAC || algorithm == Algorithm::SUPERANSAC)
         {
@@ -340,17 +372,17 @@ namespace PluginMethods
             }
 
             // 5. Sampler setup
-            int sampler_id = GetOptionAsIndexT("sampler_id", 4); // Barath Python默认: 4 (AR-Sampler)
+            int sampler_id = static_cast<int>(options_.sampler_id); // Barath Python默认: 4 (AR-Sampler)
             std::unique_ptr<gcransac::sampler::Sampler<cv::Mat, size_t>> main_sampler;
-            double imageWidth = GetOptionAsDouble("image_width", 640.0);
-            double imageHeight = GetOptionAsDouble("image_height", 480.0);
+            double imageWidth = options_.image_width;
+            double imageHeight = options_.image_height;
 
             // P-NAPSAC parameters
-            int pnapsac_layers = GetOptionAsIndexT("pnapsac_layers", 4);
-            double pnapsac_blend_ratio = GetOptionAsDouble("pnapsac_blend_ratio", 0.5);
+            int pnapsac_layers = static_cast<int>(options_.pnapsac_layers);
+            double pnapsac_blend_ratio = options_.pnapsac_blend_ratio;
 
             // AR-Sampler parameters
-            double ar_variance = GetOptionAsDouble("ar_variance", 0.1);
+            double ar_variance = options_.ar_variance;
 
             if (sampler_id == 0) // Uniform sampler (均匀采样)
             {
@@ -485,9 +517,9 @@ namespace PluginMethods
             }
 
             // 8. Bundle Adjustment (可配置)
-            bool enable_ba = GetOptionAsBool("enable_bundle_adjustment", true);
-            int ba_min_inliers = GetOptionAsIndexT("ba_min_inliers", 6);
-            int ba_max_iterations = GetOptionAsIndexT("ba_max_iterations", 100);
+            bool enable_ba = options_.enable_bundle_adjustment;
+            int ba_min_inliers = static_cast<int>(options_.ba_min_inliers);
+            int ba_max_iterations = static_cast<int>(options_.ba_max_iterations);
 
             if (enable_ba && inlier_count >= ba_min_inliers)
             {
@@ -551,11 +583,11 @@ namespace PluginMethods
             }
 
             // 9. Adaptive Inlier Selection (可选后处理)
-            bool enable_adaptive = GetOptionAsBool("enable_adaptive_inlier_selection", false);
+            bool enable_adaptive = options_.enable_adaptive_inlier_selection;
             if (enable_adaptive && inlier_count > 5)
             {
-                double adaptive_max_threshold = GetOptionAsDouble("adaptive_max_threshold", 10.0);
-                int adaptive_min_inliers = GetOptionAsIndexT("adaptive_min_inliers", 20);
+                double adaptive_max_threshold = options_.adaptive_max_threshold;
+                int adaptive_min_inliers = static_cast<int>(options_.adaptive_min_inliers);
 
                 LOG_INFO_ZH << "应用自适应内点选择，max_threshold=" << adaptive_max_threshold << ", min_inliers=" << adaptive_min_inliers;
                 LOG_INFO_EN << "Applying adaptive inlier selection with max_threshold=" << adaptive_max_threshold << ", min_inliers=" << adaptive_min_inliers;
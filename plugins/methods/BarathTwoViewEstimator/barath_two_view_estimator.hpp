@@ -9,6 +9,7 @@
 
 #include <po_core.hpp>
 #include <common/converter/converter_opencv.hpp>
+#include <common/options/option_schema.hpp>
 #include <opencv2/calib3d.hpp>
 #include <opencv2/core.hpp>
 #include <po_core/po_logger.hpp>
@@ -25,7 +26,8 @@ namespace PluginMethods
     using namespace Converter;
     using namespace types;
 
-    class BarathTwoViewEstimator : public MethodPresetProfiler
+    class BarathTwoViewEstimator : public MethodPresetProfiler,
+                                   public common::TypedViewPairTarget
     {
     public:
         BarathTwoViewEstimator()
@@ -47,6 +49,39 @@ namespace PluginMethods
         const std::string &GetType() const override;
 
     private:
+        /**
+         * @brief Options compiled once per Run() | 每次Run()编译一次的选项
+         */
+        struct EstimatorOptions
+        {
+            IndexT view_i = 0;
+            IndexT view_j = 1;
+            std::string algorithm = "magsac";
+            double confidence = 0.99;
+            double ransac_threshold = 1.0;
+            IndexT max_iterations = 1000;
+            IndexT min_iterations = 50;
+            IndexT partition_num = 5;
+            IndexT core_number = 1;
+            // Sampler: 0 uniform, 1 PROSAC, 2 P-NAPSAC, 3 NG-RANSAC, 4 AR-Sampler | 采样器
+            IndexT sampler_id = 4;
+            double image_width = 640.0;
+            double image_height = 480.0;
+            IndexT pnapsac_layers = 4;
+            double pnapsac_blend_ratio = 0.5;
+            double ar_variance = 0.1;
+            bool enable_bundle_adjustment = true;
+            IndexT ba_min_inliers = 6;
+            IndexT ba_max_iterations = 100;
+            bool enable_adaptive_inlier_selection = false;
+            double adaptive_max_threshold = 10.0;
+            IndexT adaptive_min_inliers = 20;
+        };
+
+        static const common::OptionSchema<EstimatorOptions> &GetOptionSchema();
+
+        EstimatorOptions options_;
+
         enum class Algorithm
         {
             MAGSAC,
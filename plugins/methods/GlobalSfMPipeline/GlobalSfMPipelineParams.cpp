@@ -32,10 +32,14 @@ namespace PluginMethods
         base.enable_3d_points_output = config_loader->GetOptionAsBool("enable_3d_points_output", false);
         base.enable_iter_evaluation = config_loader->GetOptionAsBool("enable_iter_evaluation", false);
         base.enable_meshlab_export = config_loader->GetOptionAsBool("enable_meshlab_export", false);
+        base.enable_parallel_triangulation = config_loader->GetOptionAsBool("enable_parallel_triangulation", true);
         base.enable_features_info_print = config_loader->GetOptionAsBool("enable_features_info_print", false);
         base.enable_data_statistics = config_loader->GetOptionAsBool("enable_data_statistics", false);
         base.evaluation_print_mode = config_loader->GetOptionAsString("evaluation_print_mode", "summary");
         base.compared_pipelines = config_loader->GetOptionAsString("compared_pipelines", "");
+        base.enable_async_export = config_loader->GetOptionAsBool("enable_async_export", true);
+        base.async_export_threads = config_loader->GetOptionAsIndexT("async_export_threads", 2);
+        base.async_export_queue = std::max<size_t>(1, config_loader->GetOptionAsIndexT("async_export_queue", 8));
 
         // Load preprocessing type - use boost library for case-insensitive comparison
         // 加载预处理类型 - 使用boost库兼容大小写的方式
@@ -70,6 +74,97 @@ namespace PluginMethods
 
         base.profile_commit = config_loader->GetOptionAsString("ProfileCommit", "GlobalSfM Pipeline");
 
+        // Load match graph pruning parameters | 加载匹配图剪枝参数
+        match_graph_pruning.enable = config_loader->GetOptionAsBool("enable_match_graph_pruning", false);
+        match_graph_pruning.keep_largest_component = config_loader->GetOptionAsBool("prune_keep_largest_component", true);
+        match_graph_pruning.min_view_degree = static_cast<int>(config_loader->GetOptionAsIndexT("prune_min_view_degree", 0));
+        match_graph_pruning.min_pair_matches = config_loader->GetOptionAsIndexT("prune_min_pair_matches", 0);
+
+        // Load track subsampling parameters | 加载轨迹子采样参数
+        track_subsampling.enable = config_loader->GetOptionAsBool("enable_track_subsampling", false);
+        track_subsampling.target_observations = config_loader->GetOptionAsIndexT("track_subsampling_target_observations", 0);
+        track_subsampling.grid_cols = std::max(1, static_cast<int>(config_loader->GetOptionAsIndexT("track_subsampling_grid_cols", 8)));
+        track_subsampling.grid_rows = std::max(1, static_cast<int>(config_loader->GetOptionAsIndexT("track_subsampling_grid_rows", 6)));
+        track_subsampling.length_exponent = config_loader->GetOptionAsDouble("track_subsampling_length_exponent", 1.0);
+        track_subsampling.consistency_sigma = config_loader->GetOptionAsDouble("track_subsampling_consistency_sigma", 2.0);
+        std::string budget_sweep_str = config_loader->GetOptionAsString("track_subsampling_budget_sweep", "");
+        track_subsampling.budget_sweep.clear();
+        std::vector<std::string> budget_tokens;
+        boost::split(budget_tokens, budget_sweep_str, boost::is_any_of(","));
+        for (auto &token : budget_tokens)
+        {
+            boost::trim(token);
+            if (token.empty())
+                continue;
+            try
+            {
+                track_subsampling.budget_sweep.push_back(static_cast<size_t>(std::stoull(token)));
+            }
+            catch (const std::exception &)
+            {
+                LOG_WARNING_ZH << "忽略无效的track_subsampling_budget_sweep项: " << token;
+                LOG_WARNING_EN << "Ignoring invalid track_subsampling_budget_sweep entry: " << token;
+            }
+        }
+
+        // Load artifact compression parameters | 加载导出文件压缩参数
+        artifact_compression.enable = config_loader->GetOptionAsBool("enable_artifact_compression", false);
+        artifact_compression.level = std::clamp(static_cast<int>(config_loader->GetOptionAsIndexT("artifact_compression_level", 3)), 1, 19);
+        artifact_compression.num_threads = static_cast<int>(config_loader->GetOptionAsIndexT("artifact_compression_threads", 0));
+        artifact_compression.frame_size_mb = std::max<size_t>(1, config_loader->GetOptionAsIndexT("artifact_compression_frame_mb", 4));
+        std::string extensions_str = config_loader->GetOptionAsString("artifact_compression_extensions", ".bin,.g2o,.ply");
+        artifact_compression.extensions.clear();
+        boost::split(artifact_compression.extensions, extensions_str, boost::is_any_of(","));
+        for (auto &extension : artifact_compression.extensions)
+        {
+            boost::trim(extension);
+        }
+        artifact_compression.extensions.erase(std::remove(artifact_compression.extensions.begin(),
+                                                          artifact_compression.extensions.end(), std::string()),
+                                              artifact_compression.extensions.end());
+
+        // Load sharding parameters | 加载分片参数
+        sharding.shard_count = config_loader->GetOptionAsIndexT("shard_count", 0);
+        sharding.shard_index = config_loader->GetOptionAsIndexT("shard_index", 0);
+        sharding.shard_dir = config_loader->GetOptionAsString("shard_dir", "");
+        sharding.run_id = config_loader->GetOptionAsString("shard_run_id", "");
+        sharding.wait_timeout_s = config_loader->GetOptionAsDouble("shard_wait_timeout", 0.0);
+
+        // Load resume parameters | 加载断点续算参数
+        resume.enable_pair_journal = config_loader->GetOptionAsBool("enable_pair_journal", false);
+        resume.journal_flush_pairs = config_loader->GetOptionAsIndexT("journal_flush_pairs", 256);
+
+        // Load deadline parameters | 加载截止时间参数
+        deadline.enable = config_loader->GetOptionAsBool("enable_deadline_mode", false);
+        deadline.total_s = std::max(0.0, config_loader->GetOptionAsDouble("deadline_total_s", 0.0));
+        deadline.matching_s = std::max(0.0, config_loader->GetOptionAsDouble("deadline_matching_s", 0.0));
+        deadline.two_view_s = std::max(0.0, config_loader->GetOptionAsDouble("deadline_two_view_s", 0.0));
+        deadline.min_pairs = config_loader->GetOptionAsIndexT("deadline_min_pairs", 0);
+
+        // Load memory governor parameters | 加载内存压力控制参数
+        memory_governor.high_watermark = std::clamp(config_loader->GetOptionAsDouble("memory_high_watermark", 0.0), 0.0, 1.0);
+        memory_governor.low_watermark = std::clamp(config_loader->GetOptionAsDouble("memory_low_watermark", 0.0), 0.0, 1.0);
+        memory_governor.limit_mb = config_loader->GetOptionAsIndexT("memory_limit_mb", 0);
+
+        // Load data lifetime parameters | 加载数据生命周期参数
+        data_lifetime.enable_release = config_loader->GetOptionAsBool("enable_data_release", false);
+        data_lifetime.enable_spill = config_loader->GetOptionAsBool("enable_data_spill", false);
+        data_lifetime.enable_memory_report = config_loader->GetOptionAsBool("enable_memory_report", false);
+
+        // Load metrics endpoint parameters | 加载指标端点参数
+        const size_t metrics_port = config_loader->GetOptionAsIndexT("metrics_port", 0);
+        if (metrics_port > 65535)
+        {
+            LOG_WARNING_ZH << "无效的metrics_port: " << metrics_port << "，不启用TCP指标端点";
+            LOG_WARNING_EN << "Invalid metrics_port: " << metrics_port << ", TCP metrics endpoint disabled";
+        }
+        else
+        {
+            metrics.port = static_cast<int>(metrics_port);
+        }
+        metrics.bind_address = config_loader->GetOptionAsString("metrics_bind_address", "127.0.0.1");
+        metrics.socket_path = config_loader->GetOptionAsString("metrics_socket", "");
+
         // Load OpenMVG parameters - use default values, actual parameters passed through PassingMethodOptions
         // 加载OpenMVG参数 - 使用默认值，实际参数通过PassingMethodOptions传递
         // Note: These parameters are now defined in [openmvg_pipeline] section, automatically passed through PassingMethodOptions
@@ -147,6 +242,13 @@ namespace PluginMethods
             return false;
         }
 
+        if (sharding.Enabled() && (sharding.shard_index >= sharding.shard_count || sharding.run_id.empty()))
+        {
+            LOG_ERROR_ZH << "分片需要shard_index < shard_count以及所有工作进程相同的shard_run_id（posdk_globalsfm --shard_launch=spawn会自动设置）";
+            LOG_ERROR_EN << "Sharding needs shard_index < shard_count and a shard_run_id shared by all workers (set automatically by posdk_globalsfm --shard_launch=spawn)";
+            return false;
+        }
+
         return true;
     }
 
@@ -54,8 +54,12 @@ namespace PluginMethods
         bool enable_3d_points_output = false;                   // Output 3D points in final results (default only output poses) | 是否在最终结果中输出3D点（默认只输出位姿）
         bool enable_iter_evaluation = false;                    // Enable accuracy evaluation during iterative optimization process | 是否启用迭代优化过程中的精度评估
         bool enable_meshlab_export = false;                     // Enable Meshlab project file export (includes pose + 3D point visualization) | 是否启用Meshlab工程文件导出（包含位姿+3D点可视化）
+        bool enable_parallel_triangulation = true;              // Triangulate output 3D points with method_triangulation from final poses + tracks | 由最终位姿和轨迹经method_triangulation三角化输出3D点
         bool enable_features_info_print = false;                // Enable feature information printing after preprocessing (display image ID, path, number of feature points) | 是否启用预处理后特征信息打印（显示图像ID、路径、特征点数量）
         bool enable_data_statistics = false;                    // Enable pipeline data statistics function | 是否启用流水线数据统计功能
+        bool enable_async_export = true;                        // Write Meshlab/Colmap/CSV exports on background threads | 在后台线程写出Meshlab/Colmap/CSV导出
+        size_t async_export_threads = 2;                        // Background export threads | 后台导出线程数
+        size_t async_export_queue = 8;                          // Queued exports before the pipeline waits | 流水线等待前允许排队的导出数
         std::string evaluation_print_mode = "summary";          // Evaluation result print mode: "none", "summary", "detailed", "comparison" | 评估结果打印模式："none", "summary", "detailed", "comparison"
         std::string compared_pipelines = "";                    // Comparison pipeline list (comma separated): "openmvg", "colmap", "glomap" - Complete pipelines for performance comparison | 对比流水线列表（逗号分隔）："openmvg", "colmap", "glomap" - 用于性能对比的完整流水线
                                                                 // NOTE: Different from preprocess_type (which is for main preprocessing) | 注意：不同于preprocess_type（用于主预处理）
@@ -132,6 +136,110 @@ namespace PluginMethods
         std::string profile_commit = "GlobalSfM pipeline track building";
     };
 
+    /**
+     * @brief Match graph pruning parameters (before Step 2) | 匹配图剪枝参数（步骤2之前）
+     */
+    struct MatchGraphPruningParameters
+    {
+        bool enable = false;                // Enable match graph pruning | 是否启用匹配图剪枝
+        bool keep_largest_component = true; // Keep only the largest connected component | 仅保留最大连通分量
+        int min_view_degree = 0;            // Iteratively drop views with fewer neighbours, 0 disables | 迭代剔除邻居数不足的视图，0表示不启用
+        size_t min_pair_matches = 0;        // Pairs with fewer matches do not count as edges | 匹配数不足的视图对不计为边
+    };
+
+    /**
+     * @brief Track subsampling parameters (between Step 4 and the engine) | 轨迹子采样参数（步骤4与核心引擎之间）
+     */
+    struct TrackSubsamplingParameters
+    {
+        bool enable = false;               // Feed a track subset to PoGlobalSfMEngine | 向PoGlobalSfMEngine输入轨迹子集
+        size_t target_observations = 0;    // Observation budget, 0 = keep all | 观测预算，0表示全部保留
+        int grid_cols = 8;                 // Grid columns per image | 每幅图像的网格列数
+        int grid_rows = 6;                 // Grid rows per image | 每幅图像的网格行数
+        double length_exponent = 1.0;      // Score ~ track_length^exponent | 分数与轨迹长度的幂次关系
+        double consistency_sigma = 2.0;    // Epipolar consistency scale in pixels | 对极一致性尺度（像素）
+        std::vector<size_t> budget_sweep;  // Extra budgets evaluated against GT (engine rerun per budget) | 额外对比真值评估的预算（每个预算重跑引擎）
+    };
+
+    /**
+     * @brief work_dir artifact compression parameters (at write time, and per dataset once it finishes) | work_dir导出文件压缩参数（写出时，以及每个数据集完成后）
+     */
+    struct ArtifactCompressionParameters
+    {
+        bool enable = false;      // Compress artifacts as they are written | 写出时压缩导出文件
+        int level = 3;            // zstd level 1..19 | zstd压缩级别1..19
+        int num_threads = 0;      // Worker threads, 0 = hardware concurrency | 工作线程数，0表示硬件并发数
+        size_t frame_size_mb = 4; // Size in MB of unkeyed frames | 无键帧大小（MB）
+        std::vector<std::string> extensions = {".bin", ".g2o", ".ply"}; // File extensions to compress | 需压缩的文件扩展名
+    };
+
+    /**
+     * @brief Sharded multi-process matching and two-view estimation | 分片多进程匹配与双视图估计
+     */
+    struct ShardingParameters
+    {
+        size_t shard_count = 0;        // Number of shards, 0/1 disables | 分片数，0/1表示不分片
+        size_t shard_index = 0;        // Shard computed by this process, one process per shard | 本进程计算的分片，每个分片一个进程
+        std::string shard_dir;         // Shard file directory, empty = work_dir/dataset_name/shards | 分片文件目录，空表示work_dir/dataset_name/shards
+        std::string run_id;            // Shared by the workers of one run, new for each run | 同一次运行的工作进程共享，每次运行不同
+        double wait_timeout_s = 0.0;   // Wait for other shards, 0 = forever | 等待其他分片的秒数，0表示一直等待
+
+        bool Enabled() const { return shard_count > 1; }
+        // Workers other than shard 0 stop after the sharded steps | 除分片0外的工作进程在分片步骤后停止
+        bool IsSecondaryWorker() const { return Enabled() && shard_index > 0; }
+    };
+
+    /**
+     * @brief Resumable matching and two-view estimation | 可断点续算的匹配与双视图估计
+     */
+    struct ResumeParameters
+    {
+        bool enable_pair_journal = false; // Journal completed pairs to work_dir/dataset_name/journal | 将已完成视图对记录到work_dir/dataset_name/journal
+        size_t journal_flush_pairs = 256; // Pairs per batched write + fsync | 每次批量写入并fsync的视图对数
+    };
+
+    /**
+     * @brief Deadline-bounded (anytime) execution | 截止时间（anytime）执行
+     */
+    struct DeadlineParameters
+    {
+        bool enable = false;       // Bound the run of each dataset by a time budget | 以时间预算限制每个数据集的运行
+        double total_s = 0.0;      // Budget of the whole dataset, 0 = unbounded | 整个数据集的预算，0表示不限
+        double matching_s = 0.0;   // Matching budget (opencv preprocessing), 0 = remaining total | 匹配预算（opencv预处理），0表示剩余总预算
+        double two_view_s = 0.0;   // Two-view estimation budget, 0 = remaining total | 双视图估计预算，0表示剩余总预算
+        size_t min_pairs = 0;      // Pairs always processed per stage, 0 = number of views | 每阶段必定处理的视图对数，0表示视图数
+    };
+
+    /**
+     * @brief Memory-pressure governor of the parallel pair-level stages | 视图对级并行阶段的内存压力控制
+     */
+    struct MemoryGovernorParameters
+    {
+        double high_watermark = 0.0; // Fraction of the memory limit that throttles active tasks, 0 disables | 开始限制并发任务的内存上限比例，0表示不启用
+        double low_watermark = 0.0;  // Fraction below which concurrency is restored, 0 = high - 0.1 | 低于该比例时恢复并发，0表示高水位-0.1
+        size_t limit_mb = 0;         // Memory limit in MB, 0 = cgroup limit or physical memory | 内存上限（MB），0表示cgroup限制或物理内存
+    };
+
+    /**
+     * @brief Release of stage data after its last consumer | 在最后一个消费者之后释放阶段数据
+     */
+    struct DataLifetimeParameters
+    {
+        bool enable_release = false;       // Free match lists and features once no later step reads them | 后续步骤不再读取时释放匹配列表和特征
+        bool enable_spill = false;         // Spill match lists to disk while the steps in between run | 中间步骤运行期间将匹配列表落盘
+        bool enable_memory_report = false; // RSS before/peak/after per step in work_dir/dataset_name/memory_report.txt | 各步骤的RSS（开始/峰值/结束）写入work_dir/dataset_name/memory_report.txt
+    };
+
+    /**
+     * @brief Live Prometheus metrics endpoint | 实时Prometheus指标端点
+     */
+    struct MetricsParameters
+    {
+        int port = 0;                           // TCP port of GET /metrics, 0 disables | GET /metrics的TCP端口，0表示不启用
+        std::string bind_address = "127.0.0.1"; // Address the port listens on | 端口监听地址
+        std::string socket_path;                // Unix socket of GET /metrics, empty disables | GET /metrics的Unix套接字，为空表示不启用
+    };
+
     /**
      * @brief Overall pipeline parameter container | 总的流水线参数容器
      */
@@ -141,6 +249,15 @@ namespace PluginMethods
         OpenMVGParameters openmvg;
         RotationAveragingParameters rotation_averaging;
         TrackBuildingParameters track_building;
+        MatchGraphPruningParameters match_graph_pruning;
+        TrackSubsamplingParameters track_subsampling;
+        ArtifactCompressionParameters artifact_compression;
+        ShardingParameters sharding;
+        ResumeParameters resume;
+        DeadlineParameters deadline;
+        MemoryGovernorParameters memory_governor;
+        MetricsParameters metrics;
+        DataLifetimeParameters data_lifetime;
 
         /**
          * @brief Load parameters from configuration file | 从配置文件加载参数
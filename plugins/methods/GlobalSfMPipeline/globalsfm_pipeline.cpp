@@ -11,6 +11,9 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <common/converter/converter_colmap_file.hpp>
+#include <common/estimator/track_selection.hpp>
+#include <common/parallel/memory_governor.hpp>
+#include <common/parallel/pair_shards.hpp>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -20,6 +23,10 @@
 #include <cstdlib>
 #include <chrono>
 #include <filesystem>
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <po_core/po_logger.hpp>
 
 namespace PluginMethods
@@ -81,9 +88,53 @@ namespace PluginMethods
         // Print parameter summary | 打印参数摘要
         params_.PrintSummary(this);
 
+        // Shard files live under the shared work_dir even when this process works elsewhere | 即使本进程在其他目录工作，分片文件仍位于共享work_dir下
+        shared_work_dir_ = params_.base.work_dir;
+        const bool secondary_worker = params_.sharding.IsSecondaryWorker();
+        if (secondary_worker)
+        {
+            ConfineSecondaryShardWorker();
+        }
+
         // Parse compared pipeline configuration | 解析对比流水线配置
         ParseComparedPipelines();
 
+        // Background export writer shared by all datasets | 所有数据集共用的后台导出写入器
+        common::AsyncExportOptions export_options;
+        export_options.enable = params_.base.enable_async_export;
+        export_options.num_workers = params_.base.async_export_threads;
+        export_options.max_pending = params_.base.async_export_queue;
+        export_writer_ = std::make_unique<common::AsyncExportWriter>(export_options);
+        export_failures_.clear();
+        artifact_compression_stats_ = common::ArtifactCompressionStats();
+        num_compressed_artifacts_ = 0;
+
+        // Live metrics endpoint for monitoring long runs; the pipeline continues without it if it cannot listen
+        // 用于监控长时间运行的实时指标端点；无法监听时流水线照常运行
+        metrics_server_.reset();
+        common::MetricsServerOptions metrics_options;
+        metrics_options.port = params_.metrics.port;
+        metrics_options.bind_address = params_.metrics.bind_address;
+        metrics_options.socket_path = params_.metrics.socket_path;
+        if (metrics_options.Enabled())
+        {
+            auto metrics_server = std::make_unique<common::MetricsServer>(metrics_options);
+            std::string metrics_error;
+            if (metrics_server->Start(metrics_error))
+            {
+                metrics_server_ = std::move(metrics_server);
+                LOG_INFO_ZH << "实时指标端点: " << metrics_server_->Endpoint();
+                LOG_INFO_EN << "Live metrics endpoint: " << metrics_server_->Endpoint();
+            }
+            else
+            {
+                LOG_WARNING_ZH << "无法启动指标端点，继续执行: " << metrics_error;
+                LOG_WARNING_EN << "Cannot start metrics endpoint, continuing without it: " << metrics_error;
+            }
+        }
+        std::atomic<uint64_t> &datasets_metric = common::MetricsRegistry::Instance().Counter(
+            "posdk_datasets_processed_total", "", "Datasets finished by the pipeline");
+
         // If unified table feature is enabled, prepare to collect dataset names
         // 如果启用了统一制表功能，准备收集数据集名称
         std::vector<std::string> processed_dataset_names;
@@ -173,13 +224,20 @@ namespace PluginMethods
             // 为当前数据集创建独立的工作目录结构
             std::string dataset_work_dir = params_.base.work_dir + "/" + dataset_name;
 
-            // Clean current dataset's working directory (ensure work_dir is clean)
-            // 清理当前数据集的工作目录（保证work_dir的干净）
+            // Clean current dataset's working directory (ensure work_dir is clean); shard files another worker
+            // may already have published and the pair journals a resumed run replays are kept
+            // 清理当前数据集的工作目录（保证work_dir的干净）；保留其他工作进程可能已发布的分片文件以及续算回放的视图对日志
             if (std::filesystem::exists(dataset_work_dir))
             {
                 try
                 {
-                    std::filesystem::remove_all(dataset_work_dir);
+                    for (const auto &entry : std::filesystem::directory_iterator(dataset_work_dir))
+                    {
+                        if (entry.path().filename() != "shards" && entry.path().filename() != "journal")
+                        {
+                            std::filesystem::remove_all(entry.path());
+                        }
+                    }
                     LOG_INFO_ZH << "清理数据集工作目录: " << dataset_work_dir;
                     LOG_INFO_EN << "Cleaning dataset working directory: " << dataset_work_dir;
                 }
@@ -243,6 +301,10 @@ namespace PluginMethods
             // Record dataset start time (for total time calculation) | 记录数据集开始时间（用于总时间计算）
             dataset_start_time_ = std::chrono::high_resolution_clock::now();
 
+            // Deadline mode: the total budget starts with the dataset | 截止时间模式：总预算随数据集开始计时
+            run_deadline_ = common::StageDeadline(params_.deadline.enable ? params_.deadline.total_s : 0.0);
+            deadline_records_.clear();
+
             try
             {
                 LOG_INFO_ZH << "开始执行GlobalSfMPipeline流水线 [" << dataset_name << "]...";
@@ -257,15 +319,56 @@ namespace PluginMethods
                 }
 
                 final_result = RunPoSDKPipeline();
-                RunComparedPipelinesIfNeeded();
 
-                // Finalize data statistics (if enabled) | 完成数据统计（如果启用）
-                if (params_.base.enable_data_statistics)
+                // Secondary shard workers only produce their shard files; comparisons and reports belong to shard 0
+                // 次级分片工作进程只产出分片文件；对比与报告由分片0负责
+                if (!secondary_worker)
                 {
-                    FinalizeDataStatistics();
+                    // Comparison pipelines are optional work, skipped once the budget is spent | 对比流水线属于可选工作，预算耗尽后跳过
+                    if (DeadlineExpired())
+                    {
+                        RecordDeadlineStage("compared_pipelines", 0.0, 0.0, "skipped", params_.base.compared_pipelines);
+                    }
+                    else
+                    {
+                        RunComparedPipelinesIfNeeded();
+                    }
+
+                    // Finalize data statistics (if enabled) | 完成数据统计（如果启用）
+                    if (params_.base.enable_data_statistics)
+                    {
+                        FinalizeDataStatistics();
+                    }
+                    PrintRelativePosesAccuracy();
+                    PrintGlobalPosesAccuracy();
+
+                    if (params_.deadline.enable)
+                    {
+                        WriteDeadlineReport(dataset_name);
+                    }
+                    if (params_.data_lifetime.enable_memory_report)
+                    {
+                        WriteMemoryReport(dataset_name);
+                    }
+                }
+
+                // Exports of this dataset must be on disk before the next dataset clears its state
+                // 下一个数据集清理状态前，本数据集的导出必须写完
+                common::MetricsRegistry::Instance().BeginStage("export_flush");
+                FlushExports(dataset_name);
+                common::MetricsRegistry::Instance().EndStage();
+                datasets_metric.fetch_add(1, std::memory_order_relaxed);
+
+                // Artifacts written by po_core/OpenMVG (not hookable at write time) are compressed in the
+                // background while the next dataset runs; the next barrier waits for them
+                // po_core/OpenMVG写出的文件（无法在写出时接管）在下一个数据集运行期间后台压缩，由下一个屏障等待
+                if (params_.artifact_compression.enable)
+                {
+                    SubmitExport(dataset_name + "/artifact_compression", [this, dataset_work_dir]()
+                                 {
+                                     CompressExportedArtifacts(dataset_work_dir);
+                                     return true; });
                 }
-                PrintRelativePosesAccuracy();
-                PrintGlobalPosesAccuracy();
 
                 LOG_INFO_ZH << "=== 数据集 [" << dataset_name << "] 处理完成 ===";
                 LOG_INFO_EN << "=== Dataset [" << dataset_name << "] processing completed ===";
@@ -277,6 +380,9 @@ namespace PluginMethods
                 LOG_ERROR_ZH << "数据集 [" << dataset_name << "] 处理过程中发生异常: " << e.what();
                 LOG_ERROR_EN << "Exception occurred during dataset [" << dataset_name << "] processing: " << e.what();
 
+                FlushExports(dataset_name);
+                common::MetricsRegistry::Instance().EndStage();
+
                 // Finalize data statistics even if exception occurs (if enabled) | 即使异常也要完成数据统计（如果启用）
                 if (params_.base.enable_data_statistics)
                 {
@@ -290,6 +396,24 @@ namespace PluginMethods
             }
         }
 
+        if (export_writer_)
+        {
+            // Collects the failures of tasks submitted after the last dataset barrier | 收集最后一个数据集屏障之后提交的任务失败项
+            FlushExports("artifact_compression");
+        }
+        if (!secondary_worker)
+        {
+            ReportExportFailures();
+        }
+        export_writer_.reset();
+
+        if (secondary_worker)
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(params_.base.work_dir, ec);
+            params_.base.work_dir = shared_work_dir_;
+        }
+
         // Batch processing complete | 批处理完成
         if (dataset_list.size() > 1)
         {
@@ -321,6 +445,15 @@ namespace PluginMethods
             LOG_WARNING_EN << "Unified table feature enabled, but no datasets were processed";
         }
 
+        if (params_.artifact_compression.enable)
+        {
+            std::lock_guard<std::mutex> lock(artifact_compression_mutex_);
+            LOG_INFO_ZH << "已压缩 " << num_compressed_artifacts_ << " 个导出文件";
+            LOG_INFO_EN << "Compressed " << num_compressed_artifacts_ << " exported artifacts";
+            common::LogArtifactCompressionStats("work_dir artifacts", artifact_compression_stats_);
+        }
+        metrics_server_.reset();
+
         // Complete total time statistics (for logging in batch mode) | 完成总时间统计（批处理模式下用于日志）
         auto total_end_time = std::chrono::high_resolution_clock::now();
         total_pipeline_time_ = std::chrono::duration_cast<std::chrono::milliseconds>(total_end_time - total_start_time).count();
@@ -410,6 +543,7 @@ namespace PluginMethods
     // Step 1: Image preprocessing | 步骤1：图像预处理
     DataPtr GlobalSfMPipeline::Step1_ImagePreprocessing()
     {
+        common::MetricsRegistry::Instance().BeginStage("image_preprocessing");
 
         LOG_INFO_ZH << "使用预处理类型: " << GetPreprocessTypeStr();
         LOG_INFO_EN << "Using preprocessing type: " << GetPreprocessTypeStr();
@@ -558,8 +692,9 @@ namespace PluginMethods
             LOG_INFO_ZH << "从OpenMVG导出的相对位姿文件读取数据: " << export_relative_poses_file;
             LOG_INFO_EN << "Loading relative poses from OpenMVG exported file: " << export_relative_poses_file;
 
-            // Check if the relative poses file exists | 检查相对位姿文件是否存在
-            if (!std::filesystem::exists(export_relative_poses_file))
+            // Check if the relative poses file exists (decompress it if only the compressed copy is left)
+            // 检查相对位姿文件是否存在（仅剩压缩文件时先解压）
+            if (!common::EnsureArtifactDecompressed(export_relative_poses_file, params_.artifact_compression.num_threads))
             {
                 LOG_WARNING_ZH << "OpenMVG相对位姿文件不存在: " << export_relative_poses_file;
                 LOG_WARNING_EN << "OpenMVG relative poses file does not exist: " << export_relative_poses_file;
@@ -577,7 +712,10 @@ namespace PluginMethods
                 {
                     // Load relative poses from G2O file (reference test_Strecha.cpp implementation)
                     // 从G2O文件加载相对位姿（参考test_Strecha.cpp实现）
-                    if (!openmvg_relative_poses_data->Load(export_relative_poses_file, "g2o"))
+                    const bool loaded = openmvg_relative_poses_data->Load(export_relative_poses_file, "g2o");
+                    // Consumed: keep it compressed with one frame per view | 已读取：按视图分帧压缩保存
+                    CompressExportedArtifacts(export_relative_poses_file);
+                    if (!loaded)
                     {
                         LOG_ERROR_ZH << "无法从G2O文件加载OpenMVG相对位姿数据: " << export_relative_poses_file;
                         LOG_ERROR_EN << "Cannot load OpenMVG relative poses from G2O file: " << export_relative_poses_file;
@@ -649,7 +787,11 @@ namespace PluginMethods
             SetProfilerLabels({{"pipeline", "PoSDK"}, {"dataset", current_dataset_name_}});
             // Start profiling for current dataset processing (after comparison pipelines) | 开始对当前数据集处理进行性能分析（在对比流水线之后）
 
+            data_lifetime_.clear();
+            memory_records_.clear();
+
             // Step 1: Image preprocessing and feature extraction | 步骤1: 图像预处理和特征提取
+            BeginDataStep("image_preprocessing");
             auto preprocess_result = Step1_ImagePreprocessing();
             if (!preprocess_result)
             {
@@ -658,6 +800,24 @@ namespace PluginMethods
                 return nullptr;
             }
 
+            // Steps that still read the match lists and features; the exporter keeps the features until it runs
+            // 仍读取匹配列表和特征的步骤；导出器在运行前一直保留特征
+            if (auto package = std::dynamic_pointer_cast<DataPackage>(preprocess_result))
+            {
+                std::vector<std::string> matches_consumers = {"two_view_estimation", "track_building"};
+                if (params_.match_graph_pruning.enable)
+                {
+                    matches_consumers.insert(matches_consumers.begin(), "match_graph_pruning");
+                }
+                std::vector<std::string> features_consumers = {"two_view_estimation", "track_building"};
+                if (GetOptionAsBool("enable_posdk2colmap_export", false))
+                {
+                    features_consumers.push_back("posdk2colmap_export");
+                }
+                DeclareDataConsumers("data_matches", package->GetData("data_matches"), matches_consumers);
+                DeclareDataConsumers("data_features", package->GetData("data_features"), features_consumers);
+            }
+
             // Note: Step 1 core time is now managed by Profiler system | 注意：步骤1的核心时间现在由Profiler系统管理
 
             // Add Step 1 data statistics | 添加步骤1数据统计
@@ -741,9 +901,26 @@ namespace PluginMethods
                 }
             }
 
+            EndDataStep("image_preprocessing", params_.match_graph_pruning.enable ? "match_graph_pruning" : "two_view_estimation");
+
+            // Step 1.5: Match graph pruning (optional) | 步骤1.5: 匹配图剪枝（可选）
+            if (params_.match_graph_pruning.enable)
+            {
+                LOG_INFO_ZH << "=== 步骤1.5: 匹配图剪枝 ===";
+                LOG_INFO_EN << "=== Step 1.5: Match graph pruning ===";
+                BeginDataStep("match_graph_pruning");
+                if (!Step1_5_MatchGraphPruning(preprocess_result))
+                {
+                    LOG_WARNING_ZH << "匹配图剪枝失败，使用完整匹配图继续";
+                    LOG_WARNING_EN << "Match graph pruning failed, continuing with the full match graph";
+                }
+                EndDataStep("match_graph_pruning", "two_view_estimation");
+            }
+
             // Step 2: Two-view pose estimation | 步骤2: 双视图位姿估计
             LOG_INFO_ZH << "=== 步骤2: 双视图位姿估计 ===";
             LOG_INFO_EN << "=== Step 2: Two-view pose estimation ===";
+            BeginDataStep("two_view_estimation");
             auto relative_poses_result = Step2_TwoViewEstimation(preprocess_result);
             if (!relative_poses_result)
             {
@@ -751,6 +928,16 @@ namespace PluginMethods
                 LOG_ERROR_EN << "Two-view pose estimation failed";
                 return nullptr;
             }
+            EndDataStep("two_view_estimation", "rotation_averaging");
+
+            // External shard workers other than shard 0 are done once their shards are merged
+            // 除分片0外的external分片工作进程在分片合并后即完成
+            if (params_.sharding.IsSecondaryWorker())
+            {
+                LOG_INFO_ZH << "分片工作进程 " << params_.sharding.shard_index << " 已完成，后续步骤由分片0执行";
+                LOG_INFO_EN << "Shard worker " << params_.sharding.shard_index << " finished, shard 0 runs the remaining steps";
+                return relative_poses_result;
+            }
 
             // Note: Step 2 core time is now managed by Profiler system | 注意：步骤2的核心时间现在由Profiler系统管理
 
@@ -796,6 +983,7 @@ namespace PluginMethods
             // Step 3: Rotation averaging | 步骤3: 旋转平均
             LOG_INFO_ZH << "=== 步骤3: 旋转平均 ===";
             LOG_INFO_EN << "=== Step 3: Rotation averaging ===";
+            BeginDataStep("rotation_averaging");
             auto rotation_result = Step3_RotationAveraging(relative_poses_result, camera_models);
             if (!rotation_result)
             {
@@ -803,6 +991,7 @@ namespace PluginMethods
                 LOG_ERROR_EN << "Rotation averaging failed";
                 return nullptr;
             }
+            EndDataStep("rotation_averaging", "track_building");
 
             // Note: Step 3 core time is now managed by Profiler system | 注意：步骤3的核心时间现在由Profiler系统管理
 
@@ -818,14 +1007,15 @@ namespace PluginMethods
             // Step 4: Feature track building | 步骤4: 特征轨迹构建
             LOG_INFO_ZH << "=== 步骤4: 特征轨迹构建 ===";
             LOG_INFO_EN << "=== Step 4: Feature track building ===";
+            BeginDataStep("track_building");
             auto tracks_result = Step4_TrackBuilding(matches_data, features_data);
-            auto initial_tracks_result = tracks_result->CopyData(); // Keep initial tracks for coordinate change comparison | 保存初始轨迹用于坐标变化比较
             if (!tracks_result)
             {
                 LOG_ERROR_ZH << "特征轨迹构建失败";
                 LOG_ERROR_EN << "Feature track building failed";
                 return nullptr;
             }
+            EndDataStep("track_building", "");
 
             // Note: Step 4 core time is now managed by Profiler system | 注意：步骤4的核心时间现在由Profiler系统管理
 
@@ -838,30 +1028,54 @@ namespace PluginMethods
                                           "Feature track building: building multi-view feature correspondences into 3D feature tracks"));
             }
 
-            // Step 5-7: 使用PoSDK Global SfM核心引擎 | Use PoSDK Global SfM Core Engine
-            LOG_INFO_ZH << "=== 步骤5-7: PoSDK Global SfM核心引擎 ===";
-            LOG_INFO_EN << "=== Step 5-7: PoSDK Global SfM Core Engine ===";
-
-            // 创建并配置核心引擎 | Create and configure core engine
-            auto global_sfm_engine = CreateAndConfigureSubMethod("PoGlobalSfMEngine");
-            if (!global_sfm_engine)
+            // Step 4.5: Track subsampling (optional) | 步骤4.5: 轨迹子采样（可选）
+            // The engine sees the subset, Step 8 triangulates the full set | 引擎使用子集，步骤8三角化完整轨迹
+            DataPtr full_tracks_result = tracks_result;
+            bool tracks_subsampled = false;
+            if (params_.track_subsampling.enable)
             {
-                LOG_ERROR_ZH << "无法创建PoGlobalSfMEngine";
-                LOG_ERROR_EN << "Failed to create PoGlobalSfMEngine";
-                return nullptr;
+                LOG_INFO_ZH << "=== 步骤4.5: 轨迹子采样 ===";
+                LOG_INFO_EN << "=== Step 4.5: Track subsampling ===";
+                BeginDataStep("track_subsampling");
+                if (!params_.track_subsampling.budget_sweep.empty())
+                {
+                    if (DeadlineExpired())
+                    {
+                        RecordDeadlineStage("track_subsampling_sweep", 0.0, 0.0, "skipped");
+                    }
+                    else
+                    {
+                        TrackSubsamplingBudgetSweep(tracks_result, relative_poses_result, rotation_result, camera_models);
+                    }
+                }
+                auto subset_tracks = Step4_5_TrackSubsampling(tracks_result, relative_poses_result, camera_models,
+                                                              params_.track_subsampling.target_observations, true);
+                if (!subset_tracks)
+                {
+                    LOG_WARNING_ZH << "轨迹子采样失败，使用完整轨迹";
+                    LOG_WARNING_EN << "Track subsampling failed, using the full tracks";
+                }
+                else if (subset_tracks != tracks_result)
+                {
+                    tracks_result = subset_tracks;
+                    tracks_subsampled = true;
+                }
+                EndDataStep("track_subsampling", "");
             }
 
-            // 设置输入数据 | Set input data
-            global_sfm_engine->SetRequiredData(tracks_result);   // data_tracks
-            global_sfm_engine->SetRequiredData(rotation_result); // data_global_poses (initial from rotation averaging)
-            global_sfm_engine->SetRequiredData(camera_models);   // data_camera_models
+            // Step 5-7: 使用PoSDK Global SfM核心引擎 | Use PoSDK Global SfM Core Engine
+            LOG_INFO_ZH << "=== 步骤5-7: PoSDK Global SfM核心引擎 ===";
+            LOG_INFO_EN << "=== Step 5-7: PoSDK Global SfM Core Engine ===";
 
-            // 执行核心引擎 | Execute core engine
-            auto engine_result = global_sfm_engine->Build();
+            // The engine iterations run inside po_core and cannot be stopped early | 引擎迭代在po_core内部执行，无法提前停止
+            const auto engine_start = std::chrono::steady_clock::now();
+            BeginDataStep("global_sfm_engine");
+            auto engine_result = RunGlobalSfMEngine(tracks_result, rotation_result, camera_models);
+            EndDataStep("global_sfm_engine", "");
+            RecordDeadlineStage("engine", 0.0, std::chrono::duration<double>(std::chrono::steady_clock::now() - engine_start).count(),
+                                "not_interruptible", DeadlineExpired() ? "total budget exceeded" : "");
             if (!engine_result)
             {
-                LOG_ERROR_ZH << "PoGlobalSfMEngine执行失败";
-                LOG_ERROR_EN << "PoGlobalSfMEngine execution failed";
                 return nullptr;
             }
 
@@ -901,6 +1115,33 @@ namespace PluginMethods
             // Evaluate global pose accuracy | 评估全局位姿精度
             EvaluatePoseAccuracy(final_global_poses, "global");
 
+            // Step 8: Triangulate the output points in parallel from the final poses | 步骤8: 由最终位姿并行三角化输出点
+            // Falls back to the engine points if triangulation fails or the budget is spent | 三角化失败或预算耗尽时回退到引擎输出的点
+            if (params_.base.enable_3d_points_output && params_.base.enable_parallel_triangulation && DeadlineExpired())
+            {
+                RecordDeadlineStage("step8_triangulation", 0.0, 0.0, "skipped", "engine points used");
+            }
+            else if (params_.base.enable_3d_points_output && params_.base.enable_parallel_triangulation)
+            {
+                LOG_INFO_ZH << "=== 步骤8: 并行三角化3D点 ===";
+                LOG_INFO_EN << "=== Step 8: Parallel 3D point triangulation ===";
+                // Points are indexed by track, so the exported tracks follow the triangulated set | 点按轨迹索引，导出轨迹随三角化的轨迹集合
+                DataPtr triangulation_tracks = tracks_subsampled ? full_tracks_result : tracks_result;
+                BeginDataStep("triangulation");
+                auto triangulated = Step8_Triangulation(final_global_poses, triangulation_tracks, camera_models);
+                EndDataStep("triangulation", "");
+                if (triangulated)
+                {
+                    reconstruction_result = triangulated;
+                    tracks_result = triangulation_tracks;
+                }
+                else if (reconstruction_result)
+                {
+                    LOG_WARNING_ZH << "并行三角化失败，使用PoGlobalSfMEngine输出的3D点";
+                    LOG_WARNING_EN << "Parallel triangulation failed, using 3D points from PoGlobalSfMEngine";
+                }
+            }
+
             // Determine final output content based on configuration | 根据配置决定最终输出内容
             DataPtr dataset_final_result = nullptr;
 
@@ -915,8 +1156,14 @@ namespace PluginMethods
                 LOG_INFO_ZH << "最终结果: 全局位姿 + 3D点重建";
                 LOG_INFO_EN << "Final result: Global poses + 3D point reconstruction";
 
-                // Export Meshlab project file (if enabled) | 导出Meshlab工程文件（如果启用）
-                ExportMeshlabProject(final_global_poses, reconstruction_result, camera_models, images_data, current_dataset_name_);
+                // Export Meshlab project file (if enabled) in the background | 后台导出Meshlab工程文件（如果启用）
+                if (params_.base.enable_meshlab_export)
+                {
+                    const std::string dataset_name = current_dataset_name_;
+                    SubmitExport(dataset_name + "/meshlab",
+                                 [this, final_global_poses, reconstruction_result, camera_models, images_data, dataset_name]()
+                                 { return ExportMeshlabProject(final_global_poses, reconstruction_result, camera_models, images_data, dataset_name); });
+                }
             }
             else
             {
@@ -934,8 +1181,14 @@ namespace PluginMethods
                 }
             }
 
-            // Export PoSDK2Colmap (if enabled) | 导出PoSDK2Colmap（如果启用）
-            ExportPoSDK2Colmap(final_global_poses, camera_models, features_data, tracks_result, reconstruction_result, current_dataset_name_);
+            // Export PoSDK2Colmap (if enabled) in the background | 后台导出PoSDK2Colmap（如果启用）
+            if (GetOptionAsBool("enable_posdk2colmap_export", false))
+            {
+                const std::string dataset_name = current_dataset_name_;
+                SubmitExport(dataset_name + "/posdk2colmap",
+                             [this, final_global_poses, camera_models, features_data, tracks_result, reconstruction_result, dataset_name]()
+                             { return ExportPoSDK2Colmap(final_global_poses, camera_models, features_data, tracks_result, reconstruction_result, dataset_name); });
+            }
 
             // Save current dataset result as final result (result of last dataset) | 保存当前数据集的结果作为最终结果（最后一个数据集的结果）
             return dataset_final_result;
@@ -955,6 +1208,7 @@ namespace PluginMethods
     // Check and run comparison pipelines if needed | 检查并运行对比流水线（如果需要）
     void GlobalSfMPipeline::RunComparedPipelinesIfNeeded()
     {
+        common::MetricsRegistry::Instance().BeginStage("compared_pipelines");
         LOG_INFO_ALL << " ";
 
         LOG_INFO_ZH << "=== 检查对比流水线需求 ===";
@@ -1128,8 +1382,9 @@ namespace PluginMethods
                 LOG_INFO_ZH << "[对比运行] 从OpenMVG导出的相对位姿文件读取数据: " << export_relative_poses_file;
                 LOG_INFO_EN << "[Comparison Run] Loading relative poses from OpenMVG exported file: " << export_relative_poses_file;
 
-                // Check if the relative poses file exists | 检查相对位姿文件是否存在
-                if (!std::filesystem::exists(export_relative_poses_file))
+                // Check if the relative poses file exists (decompress it if only the compressed copy is left)
+                // 检查相对位姿文件是否存在（仅剩压缩文件时先解压）
+                if (!common::EnsureArtifactDecompressed(export_relative_poses_file, params_.artifact_compression.num_threads))
                 {
                     LOG_WARNING_ZH << "[对比运行] OpenMVG相对位姿文件不存在: " << export_relative_poses_file;
                     LOG_WARNING_EN << "[Comparison Run] OpenMVG relative poses file does not exist: " << export_relative_poses_file;
@@ -1147,7 +1402,10 @@ namespace PluginMethods
                     {
                         // Load relative poses from G2O file (reference test_Strecha.cpp implementation)
                         // 从G2O文件加载相对位姿（参考test_Strecha.cpp实现）
-                        if (!openmvg_relative_poses_data->Load(export_relative_poses_file, "g2o"))
+                        const bool loaded = openmvg_relative_poses_data->Load(export_relative_poses_file, "g2o");
+                        // Consumed: keep it compressed with one frame per view | 已读取：按视图分帧压缩保存
+                        CompressExportedArtifacts(export_relative_poses_file);
+                        if (!loaded)
                         {
                             LOG_ERROR_ZH << "[对比运行] 无法从G2O文件加载OpenMVG相对位姿数据: " << export_relative_poses_file;
                             LOG_ERROR_EN << "[Comparison Run] Cannot load OpenMVG relative poses from G2O file: " << export_relative_poses_file;
@@ -1541,6 +1799,17 @@ namespace PluginMethods
 
                                         {"ProfileCommit", "GlobalSfM pipeline PoSDK integrated feature extraction and matching (OpenMVG aligned)"}});
 
+        // Sharded and resumable matching are implemented by method_img2matches | 分片匹配和断点续算由method_img2matches实现
+        if (params_.base.preprocess_type == PreprocessType::OpenCV)
+        {
+            ApplyShardingOptions(img2matches_);
+            ApplyJournalOptions(img2matches_, "matches");
+            ApplyMemoryGovernorOptions(img2matches_);
+        }
+        const double matching_budget = params_.base.preprocess_type == PreprocessType::OpenCV
+                                           ? ApplyDeadlineOptions(img2matches_, "matching", params_.deadline.matching_s, "overlap")
+                                           : 0.0;
+
         // Set image data as input | 设置图像数据作为输入
         img2matches_->SetRequiredData(images_data);
 
@@ -1557,75 +1826,715 @@ namespace PluginMethods
             LOG_WARNING_EN << "Camera model data unavailable, " << matcher_plugin_name << " may not compute bearing pairs";
         }
 
-        // Execute integrated feature extraction + matching | 执行一体化特征提取+匹配
-        img2matches_->SetProfilerLabels({{"pipeline", "PoSDK"}, {"dataset", current_dataset_name_}});
-
-        auto features_matches_result = img2matches_->Build();
-
-        if (!features_matches_result)
+        // Execute integrated feature extraction + matching | 执行一体化特征提取+匹配
+        img2matches_->SetProfilerLabels({{"pipeline", "PoSDK"}, {"dataset", current_dataset_name_}});
+
+        const auto matching_start = std::chrono::steady_clock::now();
+        auto features_matches_result = img2matches_->Build();
+        if (params_.base.preprocess_type == PreprocessType::OpenCV)
+        {
+            RecordDeadlinePairStage("matching", matching_budget,
+                                    std::chrono::duration<double>(std::chrono::steady_clock::now() - matching_start).count());
+        }
+
+        if (!features_matches_result)
+        {
+            LOG_ERROR_ZH << "PoSDK一体化特征提取+匹配失败";
+            LOG_ERROR_EN << "PoSDK integrated feature extraction + matching failed";
+            return nullptr;
+        }
+
+        // Convert result to DataPackage and add image data | 将结果转换为DataPackage，并添加图像数据
+        auto result_package_ptr = std::dynamic_pointer_cast<DataPackage>(features_matches_result);
+        if (!result_package_ptr)
+        {
+            LOG_ERROR_ZH << "无法转换特征匹配结果为DataPackage";
+            LOG_ERROR_EN << "Failed to convert feature matching result to DataPackage";
+            return nullptr;
+        }
+
+        // Add image data to result package | 添加图像数据到结果包中
+        result_package_ptr->AddData(images_data);
+
+        return std::static_pointer_cast<DataIO>(result_package_ptr);
+    }
+
+    std::string GlobalSfMPipeline::GetPreprocessTypeStr() const
+    {
+        switch (params_.base.preprocess_type)
+        {
+        case PreprocessType::OpenMVG:
+            return "OpenMVG";
+        case PreprocessType::OpenCV:
+            return "OpenCV (method_img2matches)";
+        case PreprocessType::PoSDK:
+            return "PoSDK (posdk_preprocessor)";
+        default:
+            return "Unknown";
+        }
+    }
+
+    MethodPresetProfilerPtr GlobalSfMPipeline::CreateAndConfigureSubMethod(const std::string &method_type)
+    {
+        auto method = FactoryMethod::Create(method_type);
+        if (!method)
+        {
+            LOG_ERROR_ZH << "无法创建方法: " << method_type;
+            LOG_ERROR_EN << "Failed to create method: " << method_type;
+            return nullptr;
+        }
+
+        // Try to convert to MethodPresetProfiler type | 尝试转换为MethodPresetProfiler类型
+        auto method_preset_profiler = std::dynamic_pointer_cast<MethodPresetProfiler>(method);
+        if (!method_preset_profiler)
+        {
+            LOG_ERROR_ZH << "方法 " << method_type << " 不是MethodPresetProfiler类型";
+            LOG_ERROR_EN << "Method " << method_type << " is not MethodPresetProfiler type";
+            return nullptr;
+        }
+
+        // Pass parameters using PassingMethodOptions | 使用PassingMethodOptions传递参数
+        PassingMethodOptions(method_preset_profiler);
+
+        return method_preset_profiler;
+    }
+
+    void GlobalSfMPipeline::ApplyShardingOptions(const MethodPresetProfilerPtr &method)
+    {
+        const auto &sharding = params_.sharding;
+        if (!method || !sharding.Enabled())
+        {
+            return;
+        }
+
+        // One shard directory per dataset so shard files of different datasets never mix
+        // 每个数据集一个分片目录，不同数据集的分片文件不会混用
+        const std::string shard_dir = sharding.shard_dir.empty()
+                                          ? shared_work_dir_ + "/" + current_dataset_name_ + "/shards"
+                                          : sharding.shard_dir + "/" + current_dataset_name_;
+
+        method->SetMethodOptions({{"shard_count", std::to_string(sharding.shard_count)},
+                                  {"shard_index", std::to_string(sharding.shard_index)},
+                                  {"shard_dir", shard_dir},
+                                  {"shard_run_id", sharding.run_id},
+                                  {"shard_wait_timeout", std::to_string(sharding.wait_timeout_s)}});
+
+        LOG_INFO_ZH << "分片执行: " << sharding.shard_count << " 个分片, 本进程分片=" << sharding.shard_index
+                    << ", 运行ID=" << sharding.run_id << ", 目录=" << shard_dir;
+        LOG_INFO_EN << "Sharded execution: " << sharding.shard_count << " shards, this shard=" << sharding.shard_index
+                    << ", run id=" << sharding.run_id << ", dir=" << shard_dir;
+    }
+
+    void GlobalSfMPipeline::ConfineSecondaryShardWorker()
+    {
+        params_.base.work_dir = shared_work_dir_ + "/.shard_worker_" + std::to_string(params_.sharding.shard_index);
+        params_.base.enable_summary_table = false;
+        params_.base.enable_meshlab_export = false;
+        params_.base.enable_data_statistics = false;
+        params_.data_lifetime.enable_memory_report = false;
+        params_.artifact_compression.enable = false;
+        SetMethodOptions({{"enable_posdk2colmap_export", "false"}});
+
+        LOG_INFO_ZH << "分片工作进程 " << params_.sharding.shard_index << " 使用临时目录 " << params_.base.work_dir
+                    << "，不执行导出、报告和对比";
+        LOG_INFO_EN << "Shard worker " << params_.sharding.shard_index << " uses scratch dir " << params_.base.work_dir
+                    << ", exports, reports and comparisons are skipped";
+    }
+
+    void GlobalSfMPipeline::ApplyJournalOptions(const MethodPresetProfilerPtr &method, const std::string &journal_name)
+    {
+        if (!method || !params_.resume.enable_pair_journal)
+        {
+            return;
+        }
+
+        const std::string journal_path = params_.base.work_dir + "/" + current_dataset_name_ + "/journal/" + journal_name + ".journal";
+        method->SetMethodOptions({{"journal_path", journal_path},
+                                  {"journal_flush_pairs", std::to_string(params_.resume.journal_flush_pairs)}});
+
+        LOG_DEBUG_ZH << "视图对日志: " << journal_path;
+        LOG_DEBUG_EN << "Pair journal: " << journal_path;
+    }
+
+    void GlobalSfMPipeline::ApplyMemoryGovernorOptions(const MethodPresetProfilerPtr &method)
+    {
+        const auto &governor = params_.memory_governor;
+        if (!method || governor.high_watermark <= 0.0)
+        {
+            return;
+        }
+        method->SetMethodOptions({{"memory_high_watermark", std::to_string(governor.high_watermark)},
+                                  {"memory_low_watermark", std::to_string(governor.low_watermark)},
+                                  {"memory_limit_mb", std::to_string(governor.limit_mb)}});
+    }
+
+    std::string GlobalSfMPipeline::DeadlineSkippedPairsPath(const std::string &stage) const
+    {
+        return params_.base.work_dir + "/" + current_dataset_name_ + "/deadline/" + stage + "_skipped_pairs.txt";
+    }
+
+    double GlobalSfMPipeline::ApplyDeadlineOptions(const MethodPresetProfilerPtr &method, const std::string &stage,
+                                                   double stage_budget_s, const std::string &pair_priority)
+    {
+        if (!method || !params_.deadline.enable)
+        {
+            return 0.0;
+        }
+
+        // Stage budget is capped by what is left of the total; a spent total still lets min_pairs run
+        // 阶段预算不超过剩余总预算；总预算耗尽时仍处理min_pairs个视图对
+        double budget_s = stage_budget_s;
+        if (run_deadline_.Enabled())
+        {
+            const double remaining_s = std::max(run_deadline_.RemainingSeconds(), 1e-3);
+            budget_s = budget_s > 0.0 ? std::min(budget_s, remaining_s) : remaining_s;
+        }
+
+        // Lists of an earlier run must not be counted for this one | 不得统计之前运行留下的列表
+        const std::string skipped_path = DeadlineSkippedPairsPath(stage);
+        std::error_code ec;
+        std::filesystem::remove(skipped_path, ec);
+        for (size_t k = 0; k < params_.sharding.shard_count; ++k)
+        {
+            std::filesystem::remove(skipped_path + ".shard-" + std::to_string(k), ec);
+        }
+
+        method->SetMethodOptions({{"time_budget_s", std::to_string(budget_s)},
+                                  {"time_budget_min_pairs", std::to_string(params_.deadline.min_pairs)},
+                                  {"pair_priority", pair_priority},
+                                  {"skipped_pairs_path", skipped_path}});
+
+        LOG_INFO_ZH << "截止时间模式 [" << stage << "]: 预算 " << std::fixed << std::setprecision(2) << budget_s
+                    << "s (0表示不限), 优先级=" << pair_priority;
+        LOG_INFO_EN << "Deadline mode [" << stage << "]: budget " << std::fixed << std::setprecision(2) << budget_s
+                    << "s (0 = unbounded), priority=" << pair_priority;
+        return budget_s;
+    }
+
+    void GlobalSfMPipeline::RecordDeadlineStage(const std::string &stage, double budget_s, double elapsed_s,
+                                                const std::string &status, const std::string &detail)
+    {
+        if (!params_.deadline.enable)
+        {
+            return;
+        }
+        deadline_records_.push_back({stage, budget_s, elapsed_s, status, detail});
+        if (status == "skipped" || status == "partial")
+        {
+            LOG_WARNING_ZH << "截止时间模式: 阶段 " << stage << " " << (status == "skipped" ? "已跳过" : "未完成")
+                           << (detail.empty() ? std::string() : " (" + detail + ")");
+            LOG_WARNING_EN << "Deadline mode: stage " << stage << " " << status
+                           << (detail.empty() ? std::string() : " (" + detail + ")");
+        }
+    }
+
+    void GlobalSfMPipeline::RecordDeadlinePairStage(const std::string &stage, double budget_s, double elapsed_s)
+    {
+        if (!params_.deadline.enable)
+        {
+            return;
+        }
+        const std::string skipped_path = DeadlineSkippedPairsPath(stage);
+        size_t skipped_pairs = common::ReadPairList(skipped_path).size();
+        for (size_t k = 0; k < params_.sharding.shard_count; ++k)
+        {
+            skipped_pairs += common::ReadPairList(skipped_path + ".shard-" + std::to_string(k)).size();
+        }
+        RecordDeadlineStage(stage, budget_s, elapsed_s, skipped_pairs > 0 ? "partial" : "completed",
+                            "skipped_pairs=" + std::to_string(skipped_pairs));
+    }
+
+    void GlobalSfMPipeline::WriteDeadlineReport(const std::string &dataset_name)
+    {
+        std::filesystem::path report_path = std::filesystem::path(params_.base.work_dir) / dataset_name / "deadline_report.txt";
+        std::error_code ec;
+        std::filesystem::create_directories(report_path.parent_path(), ec);
+        std::ofstream report_file(report_path);
+        if (!report_file.is_open())
+        {
+            LOG_WARNING_ZH << "无法写入截止时间报告: " << report_path.string();
+            LOG_WARNING_EN << "Unable to write deadline report: " << report_path.string();
+            return;
+        }
+
+        report_file << "# Deadline report | 截止时间报告\n";
+        report_file << "dataset=" << dataset_name << "\n";
+        report_file << "total_budget_s=" << params_.deadline.total_s << "\n";
+        report_file << "elapsed_s=" << run_deadline_.ElapsedSeconds() << "\n";
+        report_file << "expired=" << (run_deadline_.Expired() ? "true" : "false") << "\n";
+        report_file << "# stage,budget_s,elapsed_s,status,detail (budget 0 = unbounded | 预算0表示不限)\n";
+        for (const auto &record : deadline_records_)
+        {
+            report_file << record.stage << "," << record.budget_s << "," << record.elapsed_s << ","
+                        << record.status << "," << record.detail << "\n";
+        }
+
+        const size_t incomplete = std::count_if(deadline_records_.begin(), deadline_records_.end(),
+                                                [](const DeadlineStageRecord &record)
+                                                { return record.status == "skipped" || record.status == "partial"; });
+        LOG_INFO_ZH << "截止时间模式: 用时 " << std::fixed << std::setprecision(2) << run_deadline_.ElapsedSeconds()
+                    << "s，未完成/跳过的阶段 " << incomplete << "/" << deadline_records_.size() << "，报告: " << report_path.string();
+        LOG_INFO_EN << "Deadline mode: " << std::fixed << std::setprecision(2) << run_deadline_.ElapsedSeconds()
+                    << "s, incomplete/skipped stages " << incomplete << "/" << deadline_records_.size() << ", report: " << report_path.string();
+    }
+
+    void GlobalSfMPipeline::DeclareDataConsumers(const std::string &key, DataPtr data, const std::vector<std::string> &consumers)
+    {
+        if (!data)
+        {
+            return;
+        }
+        DataLifetimeEntry entry;
+        entry.key = key;
+        entry.data = data;
+        entry.consumers.assign(consumers.begin(), consumers.end());
+        data_lifetime_.push_back(std::move(entry));
+    }
+
+    void GlobalSfMPipeline::BeginDataStep(const std::string &step)
+    {
+        // Spilled data comes back before the step that reads it | 落盘数据在读取它的步骤之前重新加载
+        for (auto &entry : data_lifetime_)
+        {
+            if (entry.spill_path.empty() || entry.consumers.empty() || entry.consumers.front() != step)
+            {
+                continue;
+            }
+            auto matches_ptr = GetDataPtr<Matches>(entry.data);
+            bool reloaded = false;
+            if (matches_ptr && common::IsCompressedArtifact(entry.spill_path))
+            {
+                // One frame per first view, decompressed in parallel | 每个首视图一帧，并行解压
+                common::SeekableArtifactReader reader;
+                std::vector<std::string> frames;
+                reloaded = reader.Open(entry.spill_path) &&
+                           reader.ReadAllFrames(frames, params_.artifact_compression.num_threads);
+                for (size_t k = 0; reloaded && k < frames.size(); ++k)
+                {
+                    reloaded = common::DecodeMatches(frames[k], *matches_ptr);
+                }
+            }
+            else if (matches_ptr)
+            {
+                std::ifstream spill_file(entry.spill_path, std::ios::binary);
+                std::string payload;
+                if (spill_file.is_open())
+                {
+                    payload.assign(std::istreambuf_iterator<char>(spill_file), std::istreambuf_iterator<char>());
+                }
+                reloaded = spill_file.is_open() && common::DecodeMatches(payload, *matches_ptr);
+            }
+            if (!reloaded)
+            {
+                LOG_ERROR_ZH << "无法重新加载落盘数据 " << entry.key << ": " << entry.spill_path;
+                LOG_ERROR_EN << "Unable to reload spilled data " << entry.key << ": " << entry.spill_path;
+                throw std::runtime_error("failed to reload spilled " + entry.key);
+            }
+            std::error_code ec;
+            std::filesystem::remove(entry.spill_path, ec);
+            entry.spill_path.clear();
+            LOG_DEBUG_ZH << "已重新加载落盘数据 " << entry.key << "（步骤 " << step << "）";
+            LOG_DEBUG_EN << "Reloaded spilled data " << entry.key << " for step " << step;
+        }
+
+        StageMemoryRecord record;
+        record.step = step;
+        peak_rss_per_step_ = common::ResetPeakRSS();
+        record.rss_before = common::CurrentRSSBytes();
+        memory_records_.push_back(std::move(record));
+    }
+
+    void GlobalSfMPipeline::EndDataStep(const std::string &step, const std::string &next_step)
+    {
+        if (memory_records_.empty() || memory_records_.back().step != step)
+        {
+            BeginDataStep(step);
+        }
+        auto &record = memory_records_.back();
+        record.rss_end = common::CurrentRSSBytes();
+        record.peak_rss = std::max(common::PeakRSSBytes(), record.rss_end);
+
+        const auto &lifetime = params_.data_lifetime;
+        // Secondary shard workers exit after two-view estimation and would all write the same spill file
+        // 次级分片工作进程在双视图估计后退出，且会写同一个落盘文件，因此不落盘
+        const bool can_spill = lifetime.enable_spill && !params_.sharding.IsSecondaryWorker();
+        std::vector<std::string> actions;
+        for (auto &entry : data_lifetime_)
+        {
+            auto it = std::find(entry.consumers.begin(), entry.consumers.end(), step);
+            if (it != entry.consumers.end())
+            {
+                entry.consumers.erase(it);
+            }
+            if (entry.released || !entry.spill_path.empty())
+            {
+                continue;
+            }
+
+            if (entry.consumers.empty())
+            {
+                if (!lifetime.enable_release)
+                {
+                    continue;
+                }
+                // Released in place: every DataPtr of the item sees the empty container | 原地释放：该数据项的所有DataPtr都看到空容器
+                if (entry.key == "data_matches")
+                {
+                    auto matches_ptr = GetDataPtr<Matches>(entry.data);
+                    if (!matches_ptr)
+                    {
+                        continue;
+                    }
+                    *matches_ptr = Matches();
+                }
+                else if (entry.key == "data_features")
+                {
+                    auto features_ptr = GetDataPtr<FeaturesInfo>(entry.data);
+                    if (!features_ptr)
+                    {
+                        continue;
+                    }
+                    *features_ptr = FeaturesInfo();
+                }
+                else
+                {
+                    continue;
+                }
+                entry.released = true;
+                entry.data.reset();
+                actions.push_back("released " + entry.key);
+            }
+            else if (can_spill && entry.key == "data_matches" && entry.consumers.front() != next_step)
+            {
+                auto matches_ptr = GetDataPtr<Matches>(entry.data);
+                if (!matches_ptr)
+                {
+                    continue;
+                }
+                std::filesystem::path spill_path = std::filesystem::path(params_.base.work_dir) / current_dataset_name_ / "spill" / (entry.key + ".bin");
+                std::error_code ec;
+                std::filesystem::create_directories(spill_path.parent_path(), ec);
+                bool spilled = false;
+                if (params_.artifact_compression.enable)
+                {
+                    // Compressed on write, one frame per first view | 写出时压缩，每个首视图一帧
+                    spill_path += common::CompressedArtifactSuffix();
+                    std::vector<std::pair<IndexT, std::string>> frames;
+                    common::EncodeMatchesByView(*matches_ptr, frames);
+                    common::SeekableArtifactWriter writer(BuildArtifactCompressionOptions());
+                    spilled = writer.Open(spill_path.string());
+                    for (auto &[view_id, frame] : frames)
+                    {
+                        spilled = spilled && writer.AddFrame(common::ArtifactViewKey(view_id), std::move(frame));
+                    }
+                    common::ArtifactCompressionStats spill_stats;
+                    spilled = writer.Finish(&spill_stats) && spilled;
+                    if (spilled)
+                    {
+                        common::LogArtifactCompressionStats("spill " + entry.key, spill_stats);
+                    }
+                }
+                else
+                {
+                    std::string payload;
+                    common::EncodeMatches(*matches_ptr, payload);
+                    std::ofstream spill_file(spill_path, std::ios::binary | std::ios::trunc);
+                    spill_file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+                    spill_file.close();
+                    spilled = static_cast<bool>(spill_file);
+                }
+                if (!spilled)
+                {
+                    LOG_WARNING_ZH << "无法落盘 " << entry.key << "，保留在内存中: " << spill_path.string();
+                    LOG_WARNING_EN << "Unable to spill " << entry.key << ", keeping it in memory: " << spill_path.string();
+                    std::filesystem::remove(spill_path, ec);
+                    continue;
+                }
+                *matches_ptr = Matches();
+                entry.spill_path = spill_path.string();
+                actions.push_back("spilled " + entry.key + " until " + entry.consumers.front());
+            }
+        }
+
+        if (!actions.empty())
+        {
+            common::TrimFreedMemory();
+            record.actions = boost::algorithm::join(actions, ";");
+        }
+        record.rss_after_release = common::CurrentRSSBytes();
+
+        if (!actions.empty())
+        {
+            const double freed_mb = record.rss_end > record.rss_after_release
+                                        ? static_cast<double>(record.rss_end - record.rss_after_release) / (1024.0 * 1024.0)
+                                        : 0.0;
+            LOG_INFO_ZH << "数据生命周期: 步骤 " << step << " 之后 " << record.actions << "，RSS减少 "
+                        << std::fixed << std::setprecision(1) << freed_mb << " MB";
+            LOG_INFO_EN << "Data lifetime: after step " << step << ": " << record.actions << ", RSS down by "
+                        << std::fixed << std::setprecision(1) << freed_mb << " MB";
+        }
+    }
+
+    void GlobalSfMPipeline::WriteMemoryReport(const std::string &dataset_name)
+    {
+        std::filesystem::path report_path = std::filesystem::path(params_.base.work_dir) / dataset_name / "memory_report.txt";
+        std::error_code ec;
+        std::filesystem::create_directories(report_path.parent_path(), ec);
+        std::ofstream report_file(report_path);
+        if (!report_file.is_open())
+        {
+            LOG_WARNING_ZH << "无法写入内存报告: " << report_path.string();
+            LOG_WARNING_EN << "Unable to write memory report: " << report_path.string();
+            return;
+        }
+
+        const auto to_mb = [](uint64_t bytes)
+        { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+        const StageMemoryRecord *largest = nullptr;
+        for (const auto &record : memory_records_)
+        {
+            if (!largest || record.peak_rss > largest->peak_rss)
+            {
+                largest = &record;
+            }
+        }
+
+        report_file << "# Memory report | 内存报告\n";
+        report_file << "dataset=" << dataset_name << "\n";
+        report_file << "release=" << (params_.data_lifetime.enable_release ? "true" : "false") << "\n";
+        report_file << "spill=" << (params_.data_lifetime.enable_spill ? "true" : "false") << "\n";
+        report_file << "peak_scope=" << (peak_rss_per_step_ ? "step" : "process") << "\n";
+        report_file << "# step,rss_before_mb,peak_rss_mb,rss_end_mb,rss_after_release_mb,actions\n";
+        report_file << std::fixed << std::setprecision(1);
+        for (const auto &record : memory_records_)
+        {
+            report_file << record.step << "," << to_mb(record.rss_before) << "," << to_mb(record.peak_rss) << ","
+                        << to_mb(record.rss_end) << "," << to_mb(record.rss_after_release) << "," << record.actions << "\n";
+        }
+
+        if (largest)
+        {
+            LOG_INFO_ZH << "内存报告: 峰值RSS " << std::fixed << std::setprecision(1) << to_mb(largest->peak_rss)
+                        << " MB（步骤 " << largest->step << "），报告: " << report_path.string();
+            LOG_INFO_EN << "Memory report: peak RSS " << std::fixed << std::setprecision(1) << to_mb(largest->peak_rss)
+                        << " MB (step " << largest->step << "), report: " << report_path.string();
+        }
+    }
+
+    bool GlobalSfMPipeline::Step1_5_MatchGraphPruning(DataPtr preprocess_result)
+    {
+        common::MetricsRegistry::Instance().BeginStage("match_graph_pruning");
+        auto preprocess_package = std::dynamic_pointer_cast<DataPackage>(preprocess_result);
+        if (!preprocess_package)
+        {
+            LOG_ERROR_ZH << "预处理结果不是DataPackage类型";
+            LOG_ERROR_EN << "Preprocessing result is not DataPackage type";
+            return false;
+        }
+
+        auto matches_ptr = GetDataPtr<Matches>(preprocess_package->GetData("data_matches"));
+        if (!matches_ptr)
+        {
+            LOG_ERROR_ZH << "预处理结果中缺少data_matches";
+            LOG_ERROR_EN << "Missing data_matches in preprocessing result";
+            return false;
+        }
+
+        const auto &pruning = params_.match_graph_pruning;
+        const size_t pairs_before = matches_ptr->size();
+
+        // 1. Collect edges (pairs with enough matches) | 收集边（匹配数足够的视图对）
+        std::vector<ViewPair> edges;
+        edges.reserve(pairs_before);
+        std::unordered_map<IndexT, size_t> degree;
+        for (const auto &[view_pair, id_matches] : *matches_ptr)
+        {
+            degree.emplace(view_pair.first, 0);
+            degree.emplace(view_pair.second, 0);
+            if (!id_matches.empty() && id_matches.size() >= pruning.min_pair_matches)
+            {
+                edges.push_back(view_pair);
+                ++degree[view_pair.first];
+                ++degree[view_pair.second];
+            }
+        }
+        const size_t views_before = degree.size();
+        const size_t weak_pairs = pairs_before - edges.size();
+
+        // 2. Iteratively remove low-degree views (k-core peeling) | 迭代剔除低度数视图（k-core剥离）
+        std::unordered_set<IndexT> removed_views;
+        if (pruning.min_view_degree > 0)
+        {
+            bool changed = true;
+            while (changed)
+            {
+                changed = false;
+                for (auto &[view_id, view_degree] : degree)
+                {
+                    if (!removed_views.count(view_id) && view_degree < static_cast<size_t>(pruning.min_view_degree))
+                    {
+                        removed_views.insert(view_id);
+                        changed = true;
+                    }
+                }
+                if (!changed)
+                    break;
+
+                auto new_end = std::remove_if(edges.begin(), edges.end(), [&](const ViewPair &e)
+                                              { return removed_views.count(e.first) || removed_views.count(e.second); });
+                for (auto &entry : degree)
+                    entry.second = 0;
+                edges.erase(new_end, edges.end());
+                for (const auto &e : edges)
+                {
+                    ++degree[e.first];
+                    ++degree[e.second];
+                }
+            }
+        }
+        const size_t degree_removed_views = removed_views.size();
+
+        // 3. Connected components via union-find | 并查集计算连通分量
+        std::unordered_map<IndexT, IndexT> parent;
+        std::function<IndexT(IndexT)> find_root = [&](IndexT v) -> IndexT
+        {
+            IndexT root = v;
+            while (parent[root] != root)
+                root = parent[root];
+            while (parent[v] != root)
+            {
+                IndexT next = parent[v];
+                parent[v] = root;
+                v = next;
+            }
+            return root;
+        };
+        for (const auto &e : edges)
+        {
+            parent.emplace(e.first, e.first);
+            parent.emplace(e.second, e.second);
+        }
+        for (const auto &e : edges)
+        {
+            IndexT a = find_root(e.first);
+            IndexT b = find_root(e.second);
+            if (a != b)
+                parent[std::max(a, b)] = std::min(a, b);
+        }
+
+        std::unordered_map<IndexT, size_t> component_sizes;
+        for (const auto &entry : parent)
         {
-            LOG_ERROR_ZH << "PoSDK一体化特征提取+匹配失败";
-            LOG_ERROR_EN << "PoSDK integrated feature extraction + matching failed";
-            return nullptr;
+            ++component_sizes[find_root(entry.first)];
         }
 
-        // Convert result to DataPackage and add image data | 将结果转换为DataPackage，并添加图像数据
-        auto result_package_ptr = std::dynamic_pointer_cast<DataPackage>(features_matches_result);
-        if (!result_package_ptr)
+        IndexT largest_root = 0;
+        size_t largest_size = 0;
+        for (const auto &[root, size] : component_sizes)
         {
-            LOG_ERROR_ZH << "无法转换特征匹配结果为DataPackage";
-            LOG_ERROR_EN << "Failed to convert feature matching result to DataPackage";
-            return nullptr;
+            // Tie-break on the smaller root id for determinism | 相同大小时取较小根ID保证确定性
+            if (size > largest_size || (size == largest_size && root < largest_root))
+            {
+                largest_root = root;
+                largest_size = size;
+            }
         }
 
-        // Add image data to result package | 添加图像数据到结果包中
-        result_package_ptr->AddData(images_data);
-
-        return std::static_pointer_cast<DataIO>(result_package_ptr);
-    }
-
-    std::string GlobalSfMPipeline::GetPreprocessTypeStr() const
-    {
-        switch (params_.base.preprocess_type)
+        // 4. Decide which pairs survive | 确定保留的视图对
+        std::set<ViewPair> kept_pairs;
+        for (const auto &e : edges)
         {
-        case PreprocessType::OpenMVG:
-            return "OpenMVG";
-        case PreprocessType::OpenCV:
-            return "OpenCV (method_img2matches)";
-        case PreprocessType::PoSDK:
-            return "PoSDK (posdk_preprocessor)";
-        default:
-            return "Unknown";
+            if (!pruning.keep_largest_component || find_root(e.first) == largest_root)
+                kept_pairs.insert(e);
         }
-    }
 
-    MethodPresetProfilerPtr GlobalSfMPipeline::CreateAndConfigureSubMethod(const std::string &method_type)
-    {
-        auto method = FactoryMethod::Create(method_type);
-        if (!method)
+        std::set<IndexT> kept_views;
+        for (const auto &e : kept_pairs)
         {
-            LOG_ERROR_ZH << "无法创建方法: " << method_type;
-            LOG_ERROR_EN << "Failed to create method: " << method_type;
-            return nullptr;
+            kept_views.insert(e.first);
+            kept_views.insert(e.second);
         }
 
-        // Try to convert to MethodPresetProfiler type | 尝试转换为MethodPresetProfiler类型
-        auto method_preset_profiler = std::dynamic_pointer_cast<MethodPresetProfiler>(method);
-        if (!method_preset_profiler)
+        std::vector<ViewPair> pruned_pairs;
+        for (auto it = matches_ptr->begin(); it != matches_ptr->end();)
         {
-            LOG_ERROR_ZH << "方法 " << method_type << " 不是MethodPresetProfiler类型";
-            LOG_ERROR_EN << "Method " << method_type << " is not MethodPresetProfiler type";
-            return nullptr;
+            if (kept_pairs.count(it->first))
+            {
+                ++it;
+            }
+            else
+            {
+                pruned_pairs.push_back(it->first);
+                it = matches_ptr->erase(it);
+            }
+        }
+
+        std::set<IndexT> pruned_views;
+        for (const auto &entry : degree)
+        {
+            if (!kept_views.count(entry.first))
+                pruned_views.insert(entry.first);
+        }
+
+        // 5. Report | 报告
+        LOG_INFO_ZH << "[匹配图剪枝] 连通分量: " << component_sizes.size()
+                    << ", 最大分量视图数: " << largest_size;
+        LOG_INFO_EN << "[MatchGraphPruning] Connected components: " << component_sizes.size()
+                    << ", largest component views: " << largest_size;
+        LOG_INFO_ZH << "[匹配图剪枝] 视图: " << views_before << " -> " << kept_views.size()
+                    << " (度数剔除: " << degree_removed_views << ")";
+        LOG_INFO_EN << "[MatchGraphPruning] Views: " << views_before << " -> " << kept_views.size()
+                    << " (removed by degree: " << degree_removed_views << ")";
+        LOG_INFO_ZH << "[匹配图剪枝] 视图对: " << pairs_before << " -> " << matches_ptr->size()
+                    << " (匹配不足: " << weak_pairs << ")";
+        LOG_INFO_EN << "[MatchGraphPruning] View pairs: " << pairs_before << " -> " << matches_ptr->size()
+                    << " (too few matches: " << weak_pairs << ")";
+
+        std::filesystem::path report_path = std::filesystem::path(params_.base.work_dir) /
+                                            GetCurrentDatasetName() / "match_graph_pruning_report.txt";
+        std::error_code ec;
+        std::filesystem::create_directories(report_path.parent_path(), ec);
+        std::ofstream report_file(report_path);
+        if (report_file.is_open())
+        {
+            report_file << "# Match graph pruning report | 匹配图剪枝报告\n";
+            report_file << "dataset=" << GetCurrentDatasetName() << "\n";
+            report_file << "keep_largest_component=" << (pruning.keep_largest_component ? "true" : "false") << "\n";
+            report_file << "min_view_degree=" << pruning.min_view_degree << "\n";
+            report_file << "min_pair_matches=" << pruning.min_pair_matches << "\n";
+            report_file << "components=" << component_sizes.size() << "\n";
+            report_file << "largest_component_views=" << largest_size << "\n";
+            report_file << "views_before=" << views_before << "\n";
+            report_file << "views_after=" << kept_views.size() << "\n";
+            report_file << "pairs_before=" << pairs_before << "\n";
+            report_file << "pairs_after=" << matches_ptr->size() << "\n";
+            report_file << "pruned_views=";
+            for (auto it = pruned_views.begin(); it != pruned_views.end(); ++it)
+            {
+                report_file << (it == pruned_views.begin() ? "" : ",") << *it;
+            }
+            report_file << "\n";
+            report_file << "pruned_pairs=";
+            for (size_t i = 0; i < pruned_pairs.size(); ++i)
+            {
+                report_file << (i == 0 ? "" : ",") << pruned_pairs[i].first << "-" << pruned_pairs[i].second;
+            }
+            report_file << "\n";
+            LOG_DEBUG_ZH << "[匹配图剪枝] 报告已写入: " << report_path.string();
+            LOG_DEBUG_EN << "[MatchGraphPruning] Report written to: " << report_path.string();
+        }
+        else
+        {
+            LOG_WARNING_ZH << "[匹配图剪枝] 无法写入报告: " << report_path.string();
+            LOG_WARNING_EN << "[MatchGraphPruning] Unable to write report: " << report_path.string();
         }
 
-        // Pass parameters using PassingMethodOptions | 使用PassingMethodOptions传递参数
-        PassingMethodOptions(method_preset_profiler);
-
-        return method_preset_profiler;
+        return true;
     }
 
     DataPtr GlobalSfMPipeline::Step2_TwoViewEstimation(DataPtr preprocess_result)
     {
+        common::MetricsRegistry::Instance().BeginStage("two_view_estimation");
         // Executing two-view pose estimation | 执行双视图位姿估计
         LOG_INFO_ZH << "=== 执行双视图位姿估计 ===";
         LOG_INFO_EN << "=== Executing Two-View Pose Estimation ===";
@@ -1636,6 +2545,10 @@ namespace PluginMethods
         {
             return nullptr;
         }
+        ApplyShardingOptions(two_view_estimator_);
+        ApplyJournalOptions(two_view_estimator_, "two_view");
+        ApplyMemoryGovernorOptions(two_view_estimator_);
+        const double two_view_budget = ApplyDeadlineOptions(two_view_estimator_, "two_view", params_.deadline.two_view_s, "matches");
 
         // Set input data | 设置输入数据
         auto data_package = std::dynamic_pointer_cast<DataPackage>(preprocess_result);
@@ -1737,8 +2650,11 @@ namespace PluginMethods
         PROFILER_START_AUTO(true);
         PROFILER_STAGE("step2_two_view_estimation"); // Mark Step 2 stage | 标记步骤2阶段
         // Execute two-view estimation | 执行双视图估计
+        const auto two_view_start = std::chrono::steady_clock::now();
         auto result = two_view_estimator_->Build();
         PROFILER_END();
+        RecordDeadlinePairStage("two_view", two_view_budget,
+                                std::chrono::duration<double>(std::chrono::steady_clock::now() - two_view_start).count());
         if (!result)
         {
             LOG_ERROR_ZH << "双视图位姿估计失败";
@@ -1903,6 +2819,7 @@ namespace PluginMethods
 
     DataPtr GlobalSfMPipeline::Step2_5_RotationRefinement(DataPtr relative_poses_result, DataPtr preprocess_result)
     {
+        common::MetricsRegistry::Instance().BeginStage("rotation_refinement");
         // Create rotation refiner | 创建旋转优化器
         LOG_INFO_ZH << "创建RotationRefineByFeatures方法实例";
         LOG_INFO_EN << "Creating RotationRefineByFeatures method instance";
@@ -2028,6 +2945,7 @@ namespace PluginMethods
 
     DataPtr GlobalSfMPipeline::Step3_RotationAveraging(DataPtr relative_poses_result, DataPtr camera_models)
     {
+        common::MetricsRegistry::Instance().BeginStage("rotation_averaging");
         // Create rotation averager | 创建旋转平均器
         rotation_averager_ = CreateAndConfigureSubMethod("method_rotation_averaging");
         if (!rotation_averager_)
@@ -2082,6 +3000,7 @@ namespace PluginMethods
 
     DataPtr GlobalSfMPipeline::Step4_TrackBuilding(DataPtr matches_data, DataPtr features_data)
     {
+        common::MetricsRegistry::Instance().BeginStage("track_building");
         // Create track builder | 创建轨迹构建器
         track_builder_ = CreateAndConfigureSubMethod("method_matches2tracks");
         if (!track_builder_)
@@ -2112,6 +3031,290 @@ namespace PluginMethods
         return result;
     }
 
+    DataPtr GlobalSfMPipeline::Step4_5_TrackSubsampling(DataPtr tracks_result, DataPtr relative_poses_result, DataPtr camera_models,
+                                                        size_t target_observations, bool write_report)
+    {
+        common::MetricsRegistry::Instance().BeginStage("track_subsampling");
+        auto tracks_ptr = GetDataPtr<Tracks>(tracks_result);
+        auto cameras_ptr = GetDataPtr<CameraModels>(camera_models);
+        if (!tracks_ptr || !cameras_ptr)
+        {
+            LOG_ERROR_ZH << "[轨迹子采样] 缺少data_tracks或data_camera_models";
+            LOG_ERROR_EN << "[TrackSubsampling] Missing data_tracks or data_camera_models";
+            return nullptr;
+        }
+
+        // Relative poses are optional: without them tracks are scored by length only
+        // 相对位姿可选：缺少时仅按长度评分
+        const RelativePoses *relative_poses = nullptr;
+        if (relative_poses_result)
+        {
+            auto relative_poses_ptr = GetDataPtr<RelativePoses>(relative_poses_result, "data_relative_poses");
+            if (!relative_poses_ptr)
+            {
+                relative_poses_ptr = GetDataPtr<RelativePoses>(relative_poses_result);
+            }
+            if (relative_poses_ptr)
+            {
+                relative_poses = &*relative_poses_ptr;
+            }
+        }
+
+        const auto &subsampling = params_.track_subsampling;
+        common::TrackSelectionOptions options;
+        options.target_observations = target_observations;
+        options.grid_cols = subsampling.grid_cols;
+        options.grid_rows = subsampling.grid_rows;
+        options.length_exponent = subsampling.length_exponent;
+        options.consistency_sigma = subsampling.consistency_sigma;
+        options.min_track_length = static_cast<size_t>(std::max(2, params_.track_building.min_track_length));
+
+        common::TrackSelectionResult selection;
+        common::SelectTracks(*tracks_ptr, *cameras_ptr, relative_poses, options, selection);
+
+        const double observation_ratio = selection.total_observations > 0
+                                             ? static_cast<double>(selection.selected_observations) / selection.total_observations
+                                             : 1.0;
+        LOG_INFO_ZH << "[轨迹子采样] 轨迹: " << selection.total_tracks << " -> " << selection.selected.size()
+                    << ", 观测: " << selection.total_observations << " -> " << selection.selected_observations
+                    << " (" << std::fixed << std::setprecision(1) << 100.0 * observation_ratio << "%)"
+                    << ", 覆盖视图: " << selection.covered_views << "/" << selection.views
+                    << ", 网格配额: " << selection.final_cell_quota
+                    << ", 耗时: " << std::setprecision(3) << selection.seconds << "s";
+        LOG_INFO_EN << "[TrackSubsampling] Tracks: " << selection.total_tracks << " -> " << selection.selected.size()
+                    << ", observations: " << selection.total_observations << " -> " << selection.selected_observations
+                    << " (" << std::fixed << std::setprecision(1) << 100.0 * observation_ratio << "%)"
+                    << ", covered views: " << selection.covered_views << "/" << selection.views
+                    << ", cell quota: " << selection.final_cell_quota
+                    << ", time: " << std::setprecision(3) << selection.seconds << "s";
+        if (selection.covered_views < selection.views)
+        {
+            LOG_WARNING_ZH << "[轨迹子采样] " << (selection.views - selection.covered_views) << " 个视图失去全部轨迹，请提高观测预算";
+            LOG_WARNING_EN << "[TrackSubsampling] " << (selection.views - selection.covered_views) << " views lost all tracks, consider a larger budget";
+        }
+
+        if (write_report)
+        {
+            std::filesystem::path report_path = std::filesystem::path(params_.base.work_dir) /
+                                                GetCurrentDatasetName() / "track_subsampling_report.txt";
+            std::error_code ec;
+            std::filesystem::create_directories(report_path.parent_path(), ec);
+            std::ofstream report_file(report_path);
+            if (report_file.is_open())
+            {
+                report_file << "# Track subsampling report | 轨迹子采样报告\n";
+                report_file << "dataset=" << GetCurrentDatasetName() << "\n";
+                report_file << "target_observations=" << target_observations << "\n";
+                report_file << "grid=" << options.grid_cols << "x" << options.grid_rows << "\n";
+                report_file << "length_exponent=" << options.length_exponent << "\n";
+                report_file << "consistency_sigma=" << options.consistency_sigma << "\n";
+                report_file << "relative_poses=" << (relative_poses ? relative_poses->size() : 0) << "\n";
+                report_file << "tracks_before=" << selection.total_tracks << "\n";
+                report_file << "tracks_after=" << selection.selected.size() << "\n";
+                report_file << "observations_before=" << selection.total_observations << "\n";
+                report_file << "observations_after=" << selection.selected_observations << "\n";
+                report_file << "views=" << selection.views << "\n";
+                report_file << "covered_views=" << selection.covered_views << "\n";
+                report_file << "final_cell_quota=" << selection.final_cell_quota << "\n";
+                report_file << "seconds=" << selection.seconds << "\n";
+                LOG_DEBUG_ZH << "[轨迹子采样] 报告已写入: " << report_path.string();
+                LOG_DEBUG_EN << "[TrackSubsampling] Report written to: " << report_path.string();
+            }
+            else
+            {
+                LOG_WARNING_ZH << "[轨迹子采样] 无法写入报告: " << report_path.string();
+                LOG_WARNING_EN << "[TrackSubsampling] Unable to write report: " << report_path.string();
+            }
+        }
+
+        if (selection.selected.size() == tracks_ptr->size())
+        {
+            return tracks_result;
+        }
+
+        auto subset_data = tracks_result->CopyData();
+        auto subset_ptr = GetDataPtr<Tracks>(subset_data);
+        if (!subset_ptr)
+        {
+            LOG_ERROR_ZH << "[轨迹子采样] 无法复制data_tracks";
+            LOG_ERROR_EN << "[TrackSubsampling] Unable to copy data_tracks";
+            return nullptr;
+        }
+        common::ExtractTracks(*tracks_ptr, selection.selected, *subset_ptr);
+        return subset_data;
+    }
+
+    void GlobalSfMPipeline::TrackSubsamplingBudgetSweep(DataPtr tracks_result, DataPtr relative_poses_result,
+                                                        DataPtr rotation_result, DataPtr camera_models)
+    {
+        auto gt_poses_ptr = GetDataPtr<GlobalPoses>(GetGTData(), "data_global_poses");
+        if (!gt_poses_ptr || gt_poses_ptr->Size() == 0)
+        {
+            LOG_WARNING_ZH << "[轨迹子采样] 预算扫描需要真值全局位姿，已跳过";
+            LOG_WARNING_EN << "[TrackSubsampling] Budget sweep requires ground truth global poses, skipped";
+            return;
+        }
+
+        struct SweepRow
+        {
+            size_t budget = 0;
+            size_t tracks = 0;
+            size_t observations = 0;
+            double engine_seconds = 0.0;
+            double median_rotation_error = -1.0;
+            double median_position_error = -1.0;
+        };
+        auto median = [](std::vector<double> values)
+        {
+            if (values.empty())
+                return -1.0;
+            auto middle = values.begin() + values.size() / 2;
+            std::nth_element(values.begin(), middle, values.end());
+            return *middle;
+        };
+
+        // 0 is the full track set, the reference row | 0表示完整轨迹集，作为参考行
+        std::vector<size_t> budgets = params_.track_subsampling.budget_sweep;
+        budgets.insert(budgets.begin(), 0);
+        std::sort(budgets.begin(), budgets.end());
+        budgets.erase(std::unique(budgets.begin(), budgets.end()), budgets.end());
+
+        // Deadline mode: stop starting budgets once the total budget is spent | 截止时间模式：总预算耗尽后不再启动新的预算
+        const auto sweep_start = std::chrono::steady_clock::now();
+        std::vector<SweepRow> rows;
+        for (const size_t budget : budgets)
+        {
+            if (DeadlineExpired())
+            {
+                LOG_WARNING_ZH << "[轨迹子采样] 总预算已耗尽，预算扫描提前停止";
+                LOG_WARNING_EN << "[TrackSubsampling] Total budget spent, budget sweep stopped early";
+                break;
+            }
+            SweepRow row;
+            row.budget = budget;
+            auto subset_tracks = Step4_5_TrackSubsampling(tracks_result, relative_poses_result, camera_models, budget, false);
+            if (!subset_tracks)
+                continue;
+            // The engine gets private copies so the main run starts from the same inputs | 引擎使用副本，保证主流程输入不变
+            if (subset_tracks == tracks_result)
+                subset_tracks = tracks_result->CopyData();
+            auto subset_ptr = GetDataPtr<Tracks>(subset_tracks);
+            if (!subset_ptr)
+                continue;
+            row.tracks = subset_ptr->size();
+            for (size_t t = 0; t < subset_ptr->size(); ++t)
+            {
+                const auto &track = subset_ptr->GetTrack(t);
+                for (size_t j = 0; j < track.GetObservationCount(); ++j)
+                    row.observations += track.GetObservation(static_cast<IndexT>(j)).IsUsed();
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            auto engine_result = RunGlobalSfMEngine(subset_tracks, rotation_result->CopyData(), camera_models);
+            row.engine_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (auto engine_package = std::dynamic_pointer_cast<DataPackage>(engine_result))
+            {
+                auto poses_ptr = GetDataPtr<GlobalPoses>(engine_package->GetData("data_global_poses"));
+                std::vector<double> rotation_errors, position_errors;
+                if (poses_ptr && poses_ptr->EvaluateWithSimilarityTransform(*gt_poses_ptr, rotation_errors, position_errors))
+                {
+                    row.median_rotation_error = median(rotation_errors);
+                    row.median_position_error = median(position_errors);
+                }
+            }
+            rows.push_back(row);
+        }
+        RecordDeadlineStage("track_subsampling_sweep", 0.0,
+                            std::chrono::duration<double>(std::chrono::steady_clock::now() - sweep_start).count(),
+                            rows.size() < budgets.size() ? "partial" : "completed",
+                            "budgets=" + std::to_string(rows.size()) + "/" + std::to_string(budgets.size()));
+
+        std::filesystem::path sweep_path = std::filesystem::path(params_.base.work_dir) /
+                                           GetCurrentDatasetName() / "track_subsampling_sweep.csv";
+        std::error_code ec;
+        std::filesystem::create_directories(sweep_path.parent_path(), ec);
+        std::ofstream sweep_file(sweep_path);
+        if (sweep_file.is_open())
+        {
+            sweep_file << "budget,tracks,observations,engine_seconds,median_rotation_error,median_position_error\n";
+        }
+        for (const auto &row : rows)
+        {
+            LOG_INFO_ZH << "[轨迹子采样] 预算 " << (row.budget == 0 ? std::string("全部") : std::to_string(row.budget))
+                        << ": 轨迹 " << row.tracks << ", 观测 " << row.observations
+                        << ", 引擎耗时 " << std::fixed << std::setprecision(3) << row.engine_seconds << "s"
+                        << ", 旋转中位误差 " << std::setprecision(4) << row.median_rotation_error
+                        << ", 位置中位误差 " << row.median_position_error;
+            LOG_INFO_EN << "[TrackSubsampling] Budget " << (row.budget == 0 ? std::string("all") : std::to_string(row.budget))
+                        << ": tracks " << row.tracks << ", observations " << row.observations
+                        << ", engine " << std::fixed << std::setprecision(3) << row.engine_seconds << "s"
+                        << ", median rotation error " << std::setprecision(4) << row.median_rotation_error
+                        << ", median position error " << row.median_position_error;
+            if (sweep_file.is_open())
+            {
+                sweep_file << row.budget << "," << row.tracks << "," << row.observations << ","
+                           << row.engine_seconds << "," << row.median_rotation_error << "," << row.median_position_error << "\n";
+            }
+        }
+    }
+
+    DataPtr GlobalSfMPipeline::RunGlobalSfMEngine(DataPtr tracks, DataPtr initial_global_poses, DataPtr camera_models)
+    {
+        common::MetricsRegistry::Instance().BeginStage("global_sfm_engine");
+        // 创建并配置核心引擎 | Create and configure core engine
+        auto global_sfm_engine = CreateAndConfigureSubMethod("PoGlobalSfMEngine");
+        if (!global_sfm_engine)
+        {
+            LOG_ERROR_ZH << "无法创建PoGlobalSfMEngine";
+            LOG_ERROR_EN << "Failed to create PoGlobalSfMEngine";
+            return nullptr;
+        }
+
+        // 设置输入数据 | Set input data
+        global_sfm_engine->SetRequiredData(tracks);               // data_tracks
+        global_sfm_engine->SetRequiredData(initial_global_poses); // data_global_poses (initial from rotation averaging)
+        global_sfm_engine->SetRequiredData(camera_models);        // data_camera_models
+
+        // 执行核心引擎 | Execute core engine
+        auto engine_result = global_sfm_engine->Build();
+        if (!engine_result)
+        {
+            LOG_ERROR_ZH << "PoGlobalSfMEngine执行失败";
+            LOG_ERROR_EN << "PoGlobalSfMEngine execution failed";
+            return nullptr;
+        }
+        return engine_result;
+    }
+
+    DataPtr GlobalSfMPipeline::Step8_Triangulation(DataPtr global_poses, DataPtr tracks, DataPtr camera_models)
+    {
+        common::MetricsRegistry::Instance().BeginStage("triangulation");
+        auto triangulator = CreateAndConfigureSubMethod("method_triangulation");
+        if (!triangulator)
+        {
+            return nullptr;
+        }
+
+        triangulator->SetMethodOptions({{"ProfileCommit", "GlobalSfM pipeline parallel triangulation"}});
+        triangulator->SetRequiredData(tracks);        // data_tracks
+        triangulator->SetRequiredData(global_poses);  // data_global_poses
+        triangulator->SetRequiredData(camera_models); // data_camera_models
+
+        PROFILER_START_AUTO(true);
+        PROFILER_STAGE("step8_triangulation"); // Mark Step 8 stage | 标记步骤8阶段
+        auto result = triangulator->Build();
+        PROFILER_END();
+        if (!result)
+        {
+            LOG_ERROR_ZH << "并行三角化失败";
+            LOG_ERROR_EN << "Parallel triangulation failed";
+            return nullptr;
+        }
+
+        return result;
+    }
+
     bool GlobalSfMPipeline::LoadGTFiles(const std::string &gt_folder, types::GlobalPoses &global_poses)
     {
         if (!std::filesystem::exists(gt_folder))
@@ -2354,6 +3557,9 @@ namespace PluginMethods
         // 使用EvaluatorManager接口获取评估结果
         const std::string eval_type = "RelativePoses";
 
+        // Scan under the evaluator lock; released before CSV export/printing below | 在评估器锁内扫描；在下方CSV导出/打印前释放
+        std::unique_lock<std::mutex> evaluator_lock(evaluator_mutex_);
+
         // Get all algorithms | 获取所有算法
         auto algorithms = Interface::EvaluatorManager::GetAllAlgorithms(eval_type);
 
@@ -2431,6 +3637,8 @@ namespace PluginMethods
             }
         }
 
+        evaluator_lock.unlock();
+
         // Export CSV results and print evaluation results | 导出CSV结果和打印评估结果
         if (found_results)
         {
@@ -2457,6 +3665,9 @@ namespace PluginMethods
         LOG_INFO_EN << "=== Global Pose Accuracy Evaluation Results Check ===";
         LOG_INFO_EN << "Note: This function only checks if evaluation data exists, detailed statistics are handled by PrintEvaluationResults";
 
+        // Scan under the evaluator lock; released before CSV export/printing below | 在评估器锁内扫描；在下方CSV导出/打印前释放
+        std::unique_lock<std::mutex> evaluator_lock(evaluator_mutex_);
+
         // Get existing evaluation results from GlobalEvaluator | 从GlobalEvaluator获取已有的评估结果
         auto &global_evaluator = Interface::EvaluatorManager::GetGlobalEvaluator();
 
@@ -2512,6 +3723,8 @@ namespace PluginMethods
             }
         }
 
+        evaluator_lock.unlock();
+
         if (!found_results)
         {
             LOG_INFO_ZH << "未找到全局位姿评估结果";
@@ -2595,13 +3808,23 @@ namespace PluginMethods
 
     void GlobalSfMPipeline::ExportSpecificEvaluationToCSV(const std::string &eval_type)
     {
-        // Create CSV export directory | 创建CSV导出目录
         std::string dataset_name = current_dataset_name_;
         if (dataset_name.empty())
         {
             dataset_name = "unknown_dataset";
         }
 
+        // EvaluatorManager is only cleared when the next dataset starts, after the FlushExports() barrier
+        // EvaluatorManager仅在下一个数据集开始时清空，此时已经过FlushExports()屏障
+        SubmitExport(dataset_name + "/csv/" + eval_type, [this, eval_type, dataset_name]()
+                     { return WriteEvaluationCSVFiles(eval_type, dataset_name); });
+    }
+
+    bool GlobalSfMPipeline::WriteEvaluationCSVFiles(const std::string &eval_type, const std::string &dataset_name)
+    {
+        std::lock_guard<std::mutex> evaluator_lock(evaluator_mutex_);
+
+        // Create CSV export directory | 创建CSV导出目录
         std::filesystem::path csv_output_dir = params_.base.work_dir + "/" + dataset_name + "/evaluation_csv";
         std::filesystem::create_directories(csv_output_dir);
 
@@ -2624,14 +3847,17 @@ namespace PluginMethods
         {
             LOG_DEBUG_ZH << "未找到评估类型 " << eval_type << " 的算法数据";
             LOG_DEBUG_EN << "No algorithm data found for evaluation type " << eval_type;
-            return;
+            return true;
         }
 
+        bool all_success = true;
+
         // Export detailed statistics | 导出详细统计
         for (const auto &algorithm : algorithms)
         {
             std::filesystem::path detailed_path = eval_type_dir / (algorithm + "_detailed.csv");
             bool detail_success = Interface::EvaluatorManager::ExportDetailedStatsToCSV(eval_type, algorithm, detailed_path);
+            all_success = all_success && detail_success;
             LOG_DEBUG_ZH << "导出详细统计 " << eval_type << "::" << algorithm << ": "
                          << (detail_success ? "成功" : "失败") << " -> " << detailed_path.filename();
             LOG_DEBUG_EN << "Export detailed statistics " << eval_type << "::" << algorithm << ": "
@@ -2646,6 +3872,7 @@ namespace PluginMethods
             std::filesystem::path comparison_path = eval_type_dir / (metric + "_comparison.csv");
             bool comparison_success = Interface::EvaluatorManager::ExportAlgorithmComparisonToCSV(
                 eval_type, metric, comparison_path, "mean");
+            all_success = all_success && comparison_success;
             LOG_DEBUG_ZH << "导出指标对比 " << eval_type << "::" << metric << ": "
                          << (comparison_success ? "成功" : "失败") << " -> " << comparison_path.filename();
             LOG_DEBUG_EN << "Export metric comparison " << eval_type << "::" << metric << ": "
@@ -2656,6 +3883,7 @@ namespace PluginMethods
 
             bool all_stats_success = Interface::EvaluatorManager::ExportMetricAllStatsToCSV(
                 eval_type, metric, all_stats_path);
+            all_success = all_success && all_stats_success;
 
             // Post-processing: Clean N/A rows in generated CSV files to improve table readability
             // 后处理：清理生成的CSV文件中的N/A行，提高表格可读性
@@ -2674,6 +3902,7 @@ namespace PluginMethods
         // 导出原始评估值到评估类型子目录
         std::filesystem::path raw_values_dir = eval_type_dir / "raw_values";
         bool raw_success = Interface::EvaluatorManager::ExportAllRawValuesToCSV(eval_type, raw_values_dir, "ALL");
+        all_success = all_success && raw_success;
         LOG_DEBUG_ZH << "导出原始评估值 " << eval_type << ": "
                      << (raw_success ? "成功" : "失败") << " -> raw_values/";
         LOG_DEBUG_EN << "Export raw evaluation values " << eval_type << ": "
@@ -2681,7 +3910,9 @@ namespace PluginMethods
 
         LOG_INFO_ZH << eval_type << " CSV导出完成，文件保存在: " << eval_type_dir;
         LOG_INFO_EN << eval_type << " CSV export completed, files saved in: " << eval_type_dir;
+        return all_success;
     }
+
     // Clean CSV file by removing rows with excessive N/A values | 清理CSV文件，移除包含过多N/A值的行
     void GlobalSfMPipeline::CleanCSVFile(const std::filesystem::path &csv_file_path)
     {
@@ -2789,6 +4020,9 @@ namespace PluginMethods
             return;
         }
 
+        // Background CSV export tasks read the same evaluators | 后台CSV导出任务读取同一批评估器
+        std::lock_guard<std::mutex> evaluator_lock(evaluator_mutex_);
+
         LOG_INFO_ZH << "=== 评估结果打印 (模式: " << print_mode << ") ===";
         LOG_INFO_EN << "=== Evaluation Result Printing (mode: " << print_mode << ") ===";
 
@@ -2997,6 +4231,205 @@ namespace PluginMethods
         return camera_model_data;
     }
 
+    // Hand an export to the background writer | 将导出任务交给后台写入器
+    void GlobalSfMPipeline::SubmitExport(const std::string &label, common::AsyncExportWriter::Task task)
+    {
+        if (!export_writer_)
+        {
+            // Called outside Run() (e.g. directly by a test harness): write inline | 在Run()之外调用时同步写出
+            if (!task())
+            {
+                export_failures_.emplace_back(current_dataset_name_, common::ExportFailure{label, "export returned false"});
+            }
+            return;
+        }
+        export_writer_->Submit(label, std::move(task));
+    }
+
+    // Barrier at the end of a dataset | 数据集结束时的屏障
+    void GlobalSfMPipeline::FlushExports(const std::string &dataset_name)
+    {
+        if (!export_writer_)
+        {
+            return;
+        }
+
+        auto flush_start = std::chrono::high_resolution_clock::now();
+        auto failures = export_writer_->Flush();
+        double wait_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - flush_start).count();
+
+        LOG_DEBUG_ZH << "数据集 [" << dataset_name << "] 导出屏障等待 " << std::fixed << std::setprecision(1) << wait_ms << " ms";
+        LOG_DEBUG_EN << "Dataset [" << dataset_name << "] export barrier waited " << std::fixed << std::setprecision(1) << wait_ms << " ms";
+
+        for (auto &failure : failures)
+        {
+            LOG_ERROR_ZH << "数据集 [" << dataset_name << "] 导出失败: " << failure.label << " - " << failure.message;
+            LOG_ERROR_EN << "Dataset [" << dataset_name << "] export failed: " << failure.label << " - " << failure.message;
+            export_failures_.emplace_back(dataset_name, std::move(failure));
+        }
+    }
+
+    // Log export failures and write the report file | 记录导出失败项并写出报告文件
+    void GlobalSfMPipeline::ReportExportFailures()
+    {
+        std::filesystem::path report_path = std::filesystem::path(params_.base.work_dir) / "export_failures.txt";
+        if (export_failures_.empty())
+        {
+            std::error_code ec;
+            std::filesystem::remove(report_path, ec);
+            return;
+        }
+
+        LOG_ERROR_ZH << "=== 导出失败汇总: " << export_failures_.size() << " 项 ===";
+        LOG_ERROR_EN << "=== Export failure summary: " << export_failures_.size() << " item(s) ===";
+
+        std::ofstream report(report_path);
+        if (report.is_open())
+        {
+            report << "# dataset\tlabel\tmessage\n";
+        }
+        for (const auto &[dataset_name, failure] : export_failures_)
+        {
+            LOG_ERROR_ZH << "  [" << dataset_name << "] " << failure.label << ": " << failure.message;
+            LOG_ERROR_EN << "  [" << dataset_name << "] " << failure.label << ": " << failure.message;
+            if (report.is_open())
+            {
+                report << dataset_name << "\t" << failure.label << "\t" << failure.message << "\n";
+            }
+        }
+
+        if (report.is_open())
+        {
+            LOG_INFO_ZH << "导出失败报告已保存: " << report_path;
+            LOG_INFO_EN << "Export failure report saved: " << report_path;
+        }
+    }
+
+    // Compression options shared by exporters and spill files | 导出器与落盘文件共用的压缩参数
+    common::ArtifactCompressionOptions GlobalSfMPipeline::BuildArtifactCompressionOptions() const
+    {
+        const auto &compression = params_.artifact_compression;
+        common::ArtifactCompressionOptions options;
+        options.enable = compression.enable;
+        options.level = compression.level;
+        options.num_threads = compression.num_threads;
+        options.frame_size = compression.frame_size_mb << 20;
+        options.remove_source = true;
+        return options;
+    }
+
+    // Compress freshly written artifacts (one file or every file under a directory) | 压缩刚写出的文件（单个文件或目录下全部文件）
+    size_t GlobalSfMPipeline::CompressExportedArtifacts(const std::string &path)
+    {
+        const auto &compression = params_.artifact_compression;
+        if (!compression.enable)
+        {
+            return 0;
+        }
+
+        // Collect candidates first so the directory is not modified while iterating
+        // 先收集候选文件，避免遍历过程中修改目录
+        std::vector<std::filesystem::path> candidates;
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(path, ec))
+        {
+            candidates.emplace_back(path);
+        }
+        else if (std::filesystem::is_directory(path, ec))
+        {
+            for (auto it = std::filesystem::recursive_directory_iterator(path, ec);
+                 !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+            {
+                if (it->is_regular_file())
+                {
+                    candidates.push_back(it->path());
+                }
+            }
+        }
+
+        // Files referenced by a Meshlab project next to a candidate stay plain so the .mlp still opens
+        // 与候选文件同目录的Meshlab工程所引用的文件保持原样，保证.mlp仍可打开
+        std::set<std::filesystem::path> referenced;
+        std::set<std::filesystem::path> scanned_dirs;
+        for (const auto &candidate : candidates)
+        {
+            const std::filesystem::path dir = candidate.parent_path();
+            if (!scanned_dirs.insert(dir).second)
+            {
+                continue;
+            }
+            for (auto it = std::filesystem::directory_iterator(dir, ec);
+                 !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+            {
+                if (!it->is_regular_file() || !boost::iequals(it->path().extension().string(), ".mlp"))
+                {
+                    continue;
+                }
+                std::ifstream mlp_file(it->path());
+                const std::string content((std::istreambuf_iterator<char>(mlp_file)), std::istreambuf_iterator<char>());
+                const std::string lower = boost::to_lower_copy(content);
+                const std::string attribute = "filename=\"";
+                for (size_t pos = lower.find(attribute); pos != std::string::npos; pos = lower.find(attribute, pos))
+                {
+                    pos += attribute.size();
+                    const size_t end = content.find('"', pos);
+                    if (end == std::string::npos)
+                    {
+                        break;
+                    }
+                    const std::filesystem::path file(content.substr(pos, end - pos));
+                    referenced.insert((file.is_absolute() ? file : dir / file).lexically_normal());
+                    pos = end;
+                }
+            }
+            ec.clear();
+        }
+
+        const auto options = BuildArtifactCompressionOptions();
+        common::ArtifactCompressionStats stats;
+        size_t num_compressed = 0;
+        for (const auto &candidate : candidates)
+        {
+            const std::string extension = candidate.extension().string();
+            const std::string src = candidate.string();
+            if (std::find(compression.extensions.begin(), compression.extensions.end(), extension) ==
+                    compression.extensions.end() ||
+                referenced.count(candidate.lexically_normal()) > 0 ||
+                common::IsCompressedArtifact(src))
+            {
+                continue;
+            }
+
+            // g2o edges are framed by their first view; other files use plain chunks
+            // g2o的边按第一个视图分帧；其他文件使用普通分块
+            const std::string dst = src + common::CompressedArtifactSuffix();
+            common::ArtifactCompressionStats file_stats;
+            const bool ok = extension == ".g2o"
+                                ? common::CompressTextFile(src, dst, common::G2OLineViewKey, options, &file_stats)
+                                : common::CompressFile(src, dst, options, &file_stats);
+            if (ok)
+            {
+                stats.Accumulate(file_stats);
+                ++num_compressed;
+            }
+            else
+            {
+                LOG_WARNING_ZH << "压缩导出文件失败，保留原文件: " << src;
+                LOG_WARNING_EN << "Failed to compress exported artifact, keeping original: " << src;
+            }
+        }
+
+        if (num_compressed > 0)
+        {
+            LOG_DEBUG_ZH << path << " 压缩了 " << num_compressed << " 个文件";
+            LOG_DEBUG_EN << "Compressed " << num_compressed << " files in " << path;
+            std::lock_guard<std::mutex> lock(artifact_compression_mutex_);
+            artifact_compression_stats_.Accumulate(stats);
+            num_compressed_artifacts_ += num_compressed;
+        }
+        return num_compressed;
+    }
+
     // ==================== Unified table generation implementation | 统一制表功能实现 ====================
     // Generate summary table for all datasets | 为所有数据集生成汇总表格
     bool GlobalSfMPipeline::GenerateSummaryTable(const std::vector<std::string> &dataset_names)
@@ -3216,14 +4649,14 @@ namespace PluginMethods
     }
 
     // Export Meshlab project file | 导出Meshlab工程文件
-    void GlobalSfMPipeline::ExportMeshlabProject(DataPtr global_poses_result, DataPtr reconstruction_result,
+    bool GlobalSfMPipeline::ExportMeshlabProject(DataPtr global_poses_result, DataPtr reconstruction_result,
                                                  DataPtr camera_models, DataPtr images_data, const std::string &dataset_name)
     {
         if (!params_.base.enable_meshlab_export)
         {
             LOG_DEBUG_ZH << "Meshlab导出功能已禁用";
             LOG_DEBUG_EN << "Meshlab export function is disabled";
-            return;
+            return true;
         }
 
         LOG_INFO_ZH << "=== [Meshlab导出] 开始导出Meshlab工程文件 ===";
@@ -3264,7 +4697,7 @@ namespace PluginMethods
                 LOG_ERROR_ZH << "  - 缺少图像数据";
                 LOG_ERROR_EN << "  - Missing image data";
             }
-            return;
+            return false;
         }
 
         // Check validity of reconstruction points | 检查重建点的有效性
@@ -3273,7 +4706,7 @@ namespace PluginMethods
         {
             LOG_ERROR_ZH << "[Meshlab导出] 无有效的3D重建点，跳过导出";
             LOG_ERROR_EN << "[Meshlab Export] No valid 3D reconstruction points, skipping export";
-            return;
+            return false;
         }
 
         LOG_INFO_ZH << "准备导出数据：";
@@ -3316,6 +4749,7 @@ namespace PluginMethods
                 LOG_INFO_EN << "  - Project file: " << dataset_name << "_scene.mlp";
                 LOG_INFO_EN << "  - Point cloud file: " << unified_ply_filename;
                 LOG_INFO_EN << "  - Reconstruction points: " << reconstructed_points->getValidPointsCount();
+                return true;
             }
             else
             {
@@ -3328,17 +4762,18 @@ namespace PluginMethods
             LOG_ERROR_ZH << "[Meshlab导出] 异常: " << e.what();
             LOG_ERROR_EN << "[Meshlab Export] Exception: " << e.what();
         }
+        return false;
     }
 
     // Export PoSDK data to Colmap format | 导出PoSDK数据到Colmap格式
-    void GlobalSfMPipeline::ExportPoSDK2Colmap(DataPtr global_poses_result, DataPtr camera_models, DataPtr features_data,
+    bool GlobalSfMPipeline::ExportPoSDK2Colmap(DataPtr global_poses_result, DataPtr camera_models, DataPtr features_data,
                                                DataPtr tracks_result, DataPtr reconstruction_result, const std::string &dataset_name)
     {
         if (!GetOptionAsBool("enable_posdk2colmap_export", false))
         {
             LOG_INFO_ZH << "PoSDK2Colmap导出功能已禁用，跳过导出";
             LOG_INFO_EN << "PoSDK2Colmap export function is disabled, skipping export";
-            return;
+            return true;
         }
 
         LOG_INFO_ZH << "=== [PoSDK2Colmap导出] 开始导出Colmap格式数据 ===";
@@ -3379,7 +4814,7 @@ namespace PluginMethods
                 LOG_ERROR_ZH << "  - 缺少轨迹数据";
                 LOG_ERROR_EN << "  - Missing track data";
             }
-            return;
+            return false;
         }
 
         // Get global pose data and check | 获取全局位姿数据并检查
@@ -3431,15 +4866,18 @@ namespace PluginMethods
                 GetDataPtr<FeaturesInfo>(features_data),
                 GetDataPtr<Tracks>(tracks_result),
                 points_3d_ptr);
+            CompressExportedArtifacts(export_path);
 
             LOG_INFO_ZH << "[PoSDK2Colmap导出] 成功导出到: " << export_path;
             LOG_INFO_EN << "[PoSDK2Colmap Export] Successfully exported to: " << export_path;
+            return true;
         }
         catch (const std::exception &e)
         {
             LOG_ERROR_ZH << "[PoSDK2Colmap导出] 异常: " << e.what();
             LOG_ERROR_EN << "[PoSDK2Colmap Export] Exception: " << e.what();
         }
+        return false;
     }
 
     // Perform manual relative pose evaluation | 执行手动相对位姿评估
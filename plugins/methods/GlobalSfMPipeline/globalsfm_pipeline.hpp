@@ -9,10 +9,16 @@
 #include <po_core.hpp>
 #include <po_core/po_logger.hpp>
 #include <common/converter/converter_openmvg_file.hpp>
+#include <common/io/artifact_compression.hpp>
+#include <common/io/async_export_writer.hpp>
+#include <common/io/metrics_exporter.hpp>
+#include <common/parallel/stage_deadline.hpp>
 #include "GlobalSfMPipelineParams.hpp"
+#include <deque>
 #include <filesystem>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 namespace PluginMethods
 {
@@ -83,6 +89,16 @@ namespace PluginMethods
         void VisualizeMatches(DataPtr data_package, const std::string &stage, const std::string &description);
         std::string GetCurrentDatasetName(); // Get current dataset name | 获取当前处理的数据集名称
 
+        /**
+         * @brief Step 1.5: Match graph pruning before two-view estimation | 步骤1.5: 双视图估计前的匹配图剪枝
+         * @details Computes per-view degree and connected components of the match graph, drops pairs
+         *          outside the largest component or touching low-degree views, and writes a report
+         *          计算匹配图的视图度数和连通分量，剔除最大连通分量之外或涉及低度数视图的视图对，并输出报告
+         * @param preprocess_result Preprocessing result (data_matches is pruned in place) | 预处理结果（原地剪枝data_matches）
+         * @return Whether pruning succeeded | 剪枝是否成功
+         */
+        bool Step1_5_MatchGraphPruning(DataPtr preprocess_result);
+
         /**
          * @brief Step 2: Two-view pose estimation | 步骤2: 双视图位姿估计
          * @param preprocess_result Preprocessing result | 预处理结果
@@ -116,6 +132,48 @@ namespace PluginMethods
          */
         DataPtr Step4_TrackBuilding(DataPtr matches_data, DataPtr features_data);
 
+        /**
+         * @brief Step 4.5: Observation-budgeted track subsampling before the engine | 步骤4.5: 核心引擎前按观测预算子采样轨迹
+         * @details Keeps the best tracks per image grid cell (length x epipolar consistency under the Step 2 relative poses)
+         *          until the observation budget is met; the input tracks are left untouched
+         *          按图像网格单元保留最优轨迹（长度 x 在步骤2相对位姿下的对极一致性）直到满足观测预算；输入轨迹保持不变
+         * @param tracks_result Full tracks from Step 4 | 步骤4的完整轨迹
+         * @param relative_poses_result Relative poses from Step 2 (may be nullptr) | 步骤2的相对位姿（可为nullptr）
+         * @param camera_models Camera models | 相机模型
+         * @param target_observations Observation budget, 0 = keep all | 观测预算，0表示全部保留
+         * @param write_report Write work_dir/dataset_name/track_subsampling_report.txt | 是否写入报告
+         * @return Subset tracks (a copy), tracks_result itself if nothing was dropped, nullptr on failure
+         *         轨迹子集（副本）；未剔除任何轨迹时返回tracks_result本身；失败时为nullptr
+         */
+        DataPtr Step4_5_TrackSubsampling(DataPtr tracks_result, DataPtr relative_poses_result, DataPtr camera_models,
+                                         size_t target_observations, bool write_report);
+
+        /**
+         * @brief Rerun the engine at each track_subsampling_budget_sweep budget and compare with GT
+         *        在track_subsampling_budget_sweep的每个预算下重跑核心引擎并与真值比较
+         * @details Logs engine time and median rotation/position errors per budget and writes
+         *          work_dir/dataset_name/track_subsampling_sweep.csv; the pipeline result is not affected
+         *          记录每个预算的引擎耗时与旋转/位置中位误差并写入track_subsampling_sweep.csv；不影响流水线结果
+         */
+        void TrackSubsamplingBudgetSweep(DataPtr tracks_result, DataPtr relative_poses_result,
+                                         DataPtr rotation_result, DataPtr camera_models);
+
+        /**
+         * @brief Run PoGlobalSfMEngine (Steps 5-7) | 运行PoGlobalSfMEngine（步骤5-7）
+         * @return Engine DataPackage (data_global_poses, data_points_3d, data_tracks), nullptr on failure
+         *         引擎输出的DataPackage，失败时为nullptr
+         */
+        DataPtr RunGlobalSfMEngine(DataPtr tracks, DataPtr initial_global_poses, DataPtr camera_models);
+
+        /**
+         * @brief Step 8: Parallel triangulation of the output 3D points | 步骤8: 输出3D点的并行三角化
+         * @param global_poses Final global poses | 最终全局位姿
+         * @param tracks Tracks (engine output, original pixel coordinates) | 轨迹（引擎输出，原始像素坐标）
+         * @param camera_models Camera models | 相机模型
+         * @return data_points_3d, one point per track; nullptr on failure | data_points_3d（每条轨迹一个点），失败时为nullptr
+         */
+        DataPtr Step8_Triangulation(DataPtr global_poses, DataPtr tracks, DataPtr camera_models);
+
         // Helper functions | 辅助函数
 
         /**
@@ -164,6 +222,92 @@ namespace PluginMethods
          */
         MethodPresetProfilerPtr CreateAndConfigureSubMethod(const std::string &method_type);
 
+        /**
+         * @brief Pass the sharding parameters to a pair-level sub-method | 将分片参数传递给视图对级子方法
+         * @param method Img2Matches or TwoViewEstimator instance | Img2Matches或TwoViewEstimator实例
+         */
+        void ApplyShardingOptions(const MethodPresetProfilerPtr &method);
+
+        /**
+         * @brief Restrict a secondary shard worker to producing its shard files | 将次级分片工作进程限制为只产出分片文件
+         * @details Moves work_dir to a private scratch dir (so the dataset cleanup and intermediate files never
+         *          touch shard 0's outputs) and turns off exports, reports, summary tables and compression.
+         *          将work_dir移到私有临时目录（数据集清理与中间文件不会影响分片0的输出），并关闭导出、报告、汇总表和压缩。
+         */
+        void ConfineSecondaryShardWorker();
+
+        /**
+         * @brief Pass the pair journal path to a pair-level sub-method | 将视图对日志路径传递给视图对级子方法
+         * @param method Img2Matches or TwoViewEstimator instance | Img2Matches或TwoViewEstimator实例
+         * @param journal_name Journal file stem, e.g. "matches" | 日志文件名，如"matches"
+         */
+        void ApplyJournalOptions(const MethodPresetProfilerPtr &method, const std::string &journal_name);
+
+        /**
+         * @brief Pass the memory governor watermarks to a parallel sub-method | 将内存压力控制水位传递给并行子方法
+         * @param method Img2Matches or TwoViewEstimator instance | Img2Matches或TwoViewEstimator实例
+         */
+        void ApplyMemoryGovernorOptions(const MethodPresetProfilerPtr &method);
+
+        /// Skipped-pair list of a stage; shard workers append ".shard-k" | 阶段的跳过视图对列表；分片进程追加".shard-k"
+        std::string DeadlineSkippedPairsPath(const std::string &stage) const;
+
+        /**
+         * @brief Pass the stage budget of deadline mode to a pair-level sub-method | 将截止时间模式的阶段预算传递给视图对级子方法
+         * @param method Img2Matches or TwoViewEstimator instance | Img2Matches或TwoViewEstimator实例
+         * @param stage Stage name, also the stem of the skipped-pair list | 阶段名，同时作为跳过视图对列表的文件名
+         * @param stage_budget_s Configured stage budget, 0 = remaining total | 配置的阶段预算，0表示剩余总预算
+         * @param pair_priority Priority option value of the sub-method | 子方法的优先级选项值
+         * @return Budget applied in seconds, 0 when unbounded | 实际使用的预算（秒），不限时为0
+         */
+        double ApplyDeadlineOptions(const MethodPresetProfilerPtr &method, const std::string &stage,
+                                    double stage_budget_s, const std::string &pair_priority);
+
+        /// Total budget of the current dataset has run out | 当前数据集的总预算已耗尽
+        bool DeadlineExpired() const { return params_.deadline.enable && run_deadline_.Expired(); }
+
+        /**
+         * @brief Record the outcome of a stage for the deadline report | 记录阶段结果用于截止时间报告
+         * @param status completed | partial | skipped | not_interruptible
+         */
+        void RecordDeadlineStage(const std::string &stage, double budget_s, double elapsed_s,
+                                 const std::string &status, const std::string &detail = "");
+
+        /**
+         * @brief Record a pair-level stage from the skipped-pair lists its sub-method wrote | 由子方法写出的跳过视图对列表记录视图对级阶段
+         */
+        void RecordDeadlinePairStage(const std::string &stage, double budget_s, double elapsed_s);
+
+        /**
+         * @brief Write work_dir/dataset_name/deadline_report.txt | 写出work_dir/dataset_name/deadline_report.txt
+         */
+        void WriteDeadlineReport(const std::string &dataset_name);
+
+        /**
+         * @brief Declare the steps that still read a data item, in execution order | 按执行顺序声明仍读取某数据项的步骤
+         * @param key Data key in the preprocessing package ("data_matches", "data_features") | 预处理数据包中的数据键
+         * @param data Data item, released in place after its last consumer | 数据项，在最后一个消费者之后原地释放
+         * @param consumers Step names as passed to BeginDataStep/EndDataStep | 与BeginDataStep/EndDataStep一致的步骤名
+         */
+        void DeclareDataConsumers(const std::string &key, DataPtr data, const std::vector<std::string> &consumers);
+
+        /**
+         * @brief Reload spilled data the step reads and start its RSS record | 重新加载该步骤读取的落盘数据并开始其RSS记录
+         */
+        void BeginDataStep(const std::string &step);
+
+        /**
+         * @brief Close the RSS record of a step, then release data without consumers and spill data
+         *        that next_step does not read | 结束步骤的RSS记录，释放无消费者的数据，并将next_step不读取的数据落盘
+         * @param next_step Step that runs next, "" if it reads no declared data | 下一个运行的步骤，不读取已声明数据时为""
+         */
+        void EndDataStep(const std::string &step, const std::string &next_step);
+
+        /**
+         * @brief Write work_dir/dataset_name/memory_report.txt | 写出work_dir/dataset_name/memory_report.txt
+         */
+        void WriteMemoryReport(const std::string &dataset_name);
+
         /**
          * @brief Evaluate pose accuracy | 评估位姿精度
          * @param estimated_poses Estimated pose data | 估计的位姿数据
@@ -220,8 +364,9 @@ namespace PluginMethods
          * @param camera_models Camera model data | 相机模型数据
          * @param images_data Image data | 图像数据
          * @param dataset_name Dataset name | 数据集名称
+         * @return false if enabled but the export failed | 已启用但导出失败时返回false
          */
-        void ExportMeshlabProject(DataPtr global_poses_result, DataPtr reconstruction_result,
+        bool ExportMeshlabProject(DataPtr global_poses_result, DataPtr reconstruction_result,
                                   DataPtr camera_models, DataPtr images_data, const std::string &dataset_name);
 
         /**
@@ -232,8 +377,9 @@ namespace PluginMethods
          * @param tracks_result Track data | 轨迹数据
          * @param reconstruction_result 3D point reconstruction data (optional) | 3D点重建数据（可选）
          * @param dataset_name Dataset name | 数据集名称
+         * @return false if enabled but the export failed | 已启用但导出失败时返回false
          */
-        void ExportPoSDK2Colmap(DataPtr global_poses_result, DataPtr camera_models, DataPtr features_data,
+        bool ExportPoSDK2Colmap(DataPtr global_poses_result, DataPtr camera_models, DataPtr features_data,
                                 DataPtr tracks_result, DataPtr reconstruction_result, const std::string &dataset_name);
 
         /**
@@ -259,6 +405,35 @@ namespace PluginMethods
          */
         void ExportSpecificEvaluationToCSV(const std::string &eval_type);
 
+        /**
+         * @brief Write the CSV files of one evaluation type (runs on the export writer)
+         * 写出指定评估类型的CSV文件（在导出写入器上执行）
+         * @param eval_type Evaluation type | 评估类型
+         * @param dataset_name Dataset name | 数据集名称
+         * @return Whether all CSV files were written | 是否全部写出成功
+         */
+        bool WriteEvaluationCSVFiles(const std::string &eval_type, const std::string &dataset_name);
+
+        /**
+         * @brief Hand an export to the background writer (inline if async export is disabled)
+         * 将导出任务交给后台写入器（禁用异步导出时同步执行）
+         * @param label Label used in the failure report | 失败报告中使用的标签
+         * @param task Export task; must only capture snapshots or reference-counted data | 导出任务，只能捕获快照或引用计数数据
+         */
+        void SubmitExport(const std::string &label, common::AsyncExportWriter::Task task);
+
+        /**
+         * @brief Barrier at the end of a dataset: wait for its exports and record failures
+         * 数据集结束时的屏障：等待其导出任务完成并记录失败项
+         * @param dataset_name Dataset name | 数据集名称
+         */
+        void FlushExports(const std::string &dataset_name);
+
+        /**
+         * @brief Log export failures and write work_dir/export_failures.txt | 记录导出失败项并写出work_dir/export_failures.txt
+         */
+        void ReportExportFailures();
+
         /**
          * @brief Clean meaningless N/A rows in CSV file | 清理CSV文件中的无意义N/A行
          * @param csv_file_path CSV file path | CSV文件路径
@@ -344,6 +519,22 @@ namespace PluginMethods
                                            const std::vector<std::string> &dataset_names,
                                            const std::string &summary_dir);
 
+        /**
+         * @brief Compression options from artifact_compression params | 由artifact_compression参数构造压缩选项
+         */
+        common::ArtifactCompressionOptions BuildArtifactCompressionOptions() const;
+
+        /**
+         * @brief Compress freshly written artifacts into seekable containers, no-op when disabled
+         * 将刚写出的文件压缩为可随机访问容器，未启用时不做任何事
+         * @details Called by the exporters right after they write, so no extra pass over work_dir is needed.
+         *          Safe to call from export worker threads.
+         *          导出器写出后立即调用，无需再遍历work_dir。可在导出工作线程中调用。
+         * @param path One file or a directory (searched recursively) | 单个文件或目录（递归查找）
+         * @return Number of compressed files | 压缩的文件数
+         */
+        size_t CompressExportedArtifacts(const std::string &path);
+
     private:
         // Parameter container | 参数容器
         PipelineParameters params_;
@@ -379,6 +570,23 @@ namespace PluginMethods
         bool is_compared_colmap_ = false;  // Whether to compare with Colmap | 是否需要对比Colmap
         bool is_compared_glomap_ = false;  // Whether to compare with Glomap | 是否需要对比Glomap
 
+        // work_dir as configured; secondary shard workers move params_.base.work_dir to a scratch dir
+        // 配置的work_dir；次级分片工作进程会将params_.base.work_dir移到临时目录
+        std::string shared_work_dir_;
+
+        // Background export writer and failures collected at dataset barriers | 后台导出写入器及数据集屏障处收集的失败项
+        std::unique_ptr<common::AsyncExportWriter> export_writer_;
+        std::vector<std::pair<std::string, common::ExportFailure>> export_failures_;
+        // Live metrics endpoint, alive for one Run() | 实时指标端点，在一次Run()期间有效
+        std::unique_ptr<common::MetricsServer> metrics_server_;
+        // Serializes EvaluatorManager access between CSV export tasks and result printing
+        // 串行化CSV导出任务与结果打印对EvaluatorManager的访问
+        std::mutex evaluator_mutex_;
+        // Totals of CompressExportedArtifacts(), updated from export workers | CompressExportedArtifacts()的累计量，由导出工作线程更新
+        std::mutex artifact_compression_mutex_;
+        common::ArtifactCompressionStats artifact_compression_stats_;
+        size_t num_compressed_artifacts_ = 0;
+
         // ==================== Data Statistics Functionality | 数据统计功能 ====================
 
         /**
@@ -454,6 +662,40 @@ namespace PluginMethods
         double accumulated_core_time_;                                      // Accumulated core computation time (milliseconds) | 累积核心计算时间（毫秒）
         std::vector<std::pair<std::string, double>> step_core_times_;       // Step core time records | 各步骤核心时间记录
         std::chrono::high_resolution_clock::time_point dataset_start_time_; // Current dataset start time | 当前数据集开始时间
+
+        // Deadline mode state of the current dataset | 当前数据集的截止时间模式状态
+        struct DeadlineStageRecord
+        {
+            std::string stage;
+            double budget_s = 0.0;  // 0 = unbounded | 0表示不限
+            double elapsed_s = 0.0;
+            std::string status;
+            std::string detail;
+        };
+        common::StageDeadline run_deadline_;                 // Total budget, started with the dataset | 总预算，随数据集开始计时
+        std::vector<DeadlineStageRecord> deadline_records_;  // Stage outcomes in execution order | 按执行顺序的阶段结果
+
+        // Data lifetime state of the current dataset | 当前数据集的数据生命周期状态
+        struct DataLifetimeEntry
+        {
+            std::string key;
+            DataPtr data;
+            std::deque<std::string> consumers; // Steps that still read the data | 仍读取该数据的步骤
+            std::string spill_path;            // Non-empty while spilled | 落盘期间非空
+            bool released = false;
+        };
+        struct StageMemoryRecord
+        {
+            std::string step;
+            uint64_t rss_before = 0;
+            uint64_t peak_rss = 0;          // 0 = unknown | 0表示未知
+            uint64_t rss_end = 0;           // Before release | 释放前
+            uint64_t rss_after_release = 0;
+            std::string actions;            // "released data_matches;spilled ..." | 释放/落盘操作
+        };
+        std::vector<DataLifetimeEntry> data_lifetime_;
+        std::vector<StageMemoryRecord> memory_records_; // Steps in execution order | 按执行顺序的步骤
+        bool peak_rss_per_step_ = false;                // Peak RSS restarts per step, otherwise it is the process peak | 峰值RSS按步骤重新统计，否则为进程峰值
     };
 
 } // namespace PluginMethods
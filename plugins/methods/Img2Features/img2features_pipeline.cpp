@@ -11,11 +11,13 @@
 #include <opencv2/highgui.hpp>
 #include <po_core/types.hpp>
 #include <common/image_viewer/image_viewer.hpp>
+#include <common/image_viewer/image_prefetcher.hpp>
 #include <filesystem>
 #include <regex>
 #include <algorithm>
 #include <random>
 #include <fstream>
+#include <memory>
 #include <sstream>
 
 namespace PluginMethods
@@ -288,13 +290,54 @@ namespace PluginMethods
         features_info_ptr->clear();
         features_info_ptr->resize(valid_image_pairs.size());
 
+        // Read the next images while the current one is processed; grayscale and color are decoded from one read
+        // 处理当前图像时预读后续图像；灰度图和彩色图从同一次读取中解码
+        std::unique_ptr<common::PrefetchingImageReader> prefetcher;
+        const size_t prefetch_depth = GetOptionAsIndexT("io_prefetch_depth", 8);
+        if (prefetch_depth > 0 && !valid_image_pairs.empty())
+        {
+            std::vector<std::string> prefetch_paths;
+            prefetch_paths.reserve(valid_image_pairs.size());
+            for (const auto &[filename_number, img_path] : valid_image_pairs)
+            {
+                prefetch_paths.push_back(img_path);
+            }
+
+            common::PrefetchingImageReader::Options prefetch_options;
+            prefetch_options.prefetch_depth = prefetch_depth;
+            prefetch_options.use_io_uring = GetOptionAsBool("use_io_uring", true);
+            prefetcher = std::make_unique<common::PrefetchingImageReader>(
+                std::move(prefetch_paths), std::vector<int>{cv::IMREAD_GRAYSCALE, cv::IMREAD_COLOR}, prefetch_options);
+            LOG_DEBUG_ZH << "图像预读: 深度=" << prefetch_depth << ", 后端=" << prefetcher->BackendName();
+            LOG_DEBUG_EN << "Image prefetch: depth=" << prefetch_depth << ", backend=" << prefetcher->BackendName();
+        }
+
         // Process each image using continuous view_id | 处理每张图像，使用连续的view_id
         for (IndexT view_id = 0; view_id < valid_image_pairs.size(); ++view_id)
         {
             const std::string &img_path = valid_image_pairs[view_id].second;
 
-            // Read image | 读取图像
-            cv::Mat img = cv::imread(img_path, cv::IMREAD_GRAYSCALE);
+            // Read image (color is used for extracting RGB values at feature points)
+            // 读取图像（彩色图像用于提取特征点处的RGB值）
+            cv::Mat img;
+            cv::Mat img_color;
+            if (prefetcher)
+            {
+                auto prefetched = prefetcher->Take(view_id);
+                if (prefetched.Ok())
+                {
+                    img = prefetched.decoded[0];
+                    img_color = prefetched.decoded[1];
+                }
+            }
+            else
+            {
+                img = cv::imread(img_path, cv::IMREAD_GRAYSCALE);
+                if (!img.empty())
+                {
+                    img_color = cv::imread(img_path, cv::IMREAD_COLOR);
+                }
+            }
             if (img.empty())
             {
                 LOG_ERROR_ZH << "加载图像失败: " << img_path;
@@ -302,8 +345,6 @@ namespace PluginMethods
                 continue;
             }
 
-            // Read color image for extracting RGB values at feature points | 读取彩色图像以提取特征点处的RGB值
-            cv::Mat img_color = cv::imread(img_path, cv::IMREAD_COLOR);
             bool has_color_image = !img_color.empty();
 
             // Use shared feature detection function | 使用共用的特征检测函数
@@ -0,0 +1,128 @@
+/**
+ * @file DescriptorPCA.cpp
+ * @brief 描述子PCA降维实现
+ * @copyright Copyright (c) 2024 PoSDK
+ */
+
+#include "DescriptorPCA.hpp"
+#include <algorithm>
+#include <set>
+
+namespace PluginMethods
+{
+    bool DescriptorPCA::Learn(const std::vector<cv::Mat> &all_descriptors, int target_dims, size_t max_samples)
+    {
+        size_t total_rows = 0;
+        int input_dims = 0;
+        for (const auto &desc : all_descriptors)
+        {
+            if (desc.empty())
+                continue;
+            if (desc.type() != CV_32F || (input_dims != 0 && desc.cols != input_dims))
+                return false;
+            input_dims = desc.cols;
+            total_rows += desc.rows;
+        }
+
+        if (total_rows == 0 || target_dims <= 0 || target_dims >= input_dims)
+            return false;
+
+        // 固定步长采样，保证同一数据集多次运行得到相同投影
+        const size_t stride = (max_samples > 0 && total_rows > max_samples)
+                                  ? (total_rows + max_samples - 1) / max_samples
+                                  : 1;
+
+        cv::Mat samples(static_cast<int>((total_rows + stride - 1) / stride), input_dims, CV_32F);
+        int sample_row = 0;
+        size_t global_row = 0;
+        for (const auto &desc : all_descriptors)
+        {
+            for (int r = 0; r < desc.rows; ++r, ++global_row)
+            {
+                if (global_row % stride == 0 && sample_row < samples.rows)
+                {
+                    desc.row(r).copyTo(samples.row(sample_row++));
+                }
+            }
+        }
+        samples = samples.rowRange(0, sample_row);
+
+        if (samples.rows <= target_dims)
+            return false;
+
+        pca_ = cv::PCA(samples, cv::noArray(), cv::PCA::DATA_AS_ROW, target_dims);
+
+        // 统计保留方差比例（需要完整特征值，单独计算一次协方差）
+        cv::Mat covar, mean;
+        cv::calcCovarMatrix(samples, covar, mean, cv::COVAR_NORMAL | cv::COVAR_ROWS | cv::COVAR_SCALE, CV_64F);
+        const double total_variance = cv::trace(covar)[0];
+        const double kept_variance = cv::sum(pca_.eigenvalues)[0];
+        retained_variance_ = total_variance > 0.0 ? kept_variance / total_variance : 0.0;
+
+        return IsReady();
+    }
+
+    bool DescriptorPCA::Load(const std::string &path)
+    {
+        cv::FileStorage fs(path, cv::FileStorage::READ);
+        if (!fs.isOpened())
+            return false;
+
+        pca_.read(fs.root());
+        fs["retained_variance"] >> retained_variance_;
+        return IsReady();
+    }
+
+    bool DescriptorPCA::Save(const std::string &path) const
+    {
+        if (!IsReady())
+            return false;
+
+        cv::FileStorage fs(path, cv::FileStorage::WRITE);
+        if (!fs.isOpened())
+            return false;
+
+        pca_.write(fs);
+        fs << "retained_variance" << retained_variance_;
+        return true;
+    }
+
+    cv::Mat DescriptorPCA::Project(const cv::Mat &descriptors) const
+    {
+        if (!IsReady() || descriptors.empty() ||
+            descriptors.type() != CV_32F || descriptors.cols != GetInputDims())
+        {
+            return cv::Mat();
+        }
+
+        cv::Mat projected;
+        pca_.project(descriptors, projected);
+        if (projected.type() != CV_32F)
+        {
+            projected.convertTo(projected, CV_32F);
+        }
+        return projected.isContinuous() ? projected : projected.clone();
+    }
+
+    double DescriptorPCA::ComputeMatchRecall(const std::vector<cv::DMatch> &reference,
+                                             const std::vector<cv::DMatch> &candidate)
+    {
+        if (reference.empty())
+            return 1.0;
+
+        std::set<std::pair<int, int>> candidate_set;
+        for (const auto &m : candidate)
+        {
+            candidate_set.emplace(m.queryIdx, m.trainIdx);
+        }
+
+        size_t recovered = 0;
+        for (const auto &m : reference)
+        {
+            if (candidate_set.count({m.queryIdx, m.trainIdx}))
+                ++recovered;
+        }
+        return static_cast<double>(recovered) / reference.size();
+    }
+
+} // namespace PluginMethods
@@ -0,0 +1,92 @@
+/**
+ * @file DescriptorPCA.hpp
+ * @brief 描述子PCA降维（RootSIFT之后的后处理阶段）
+ * @copyright Copyright (c) 2024 PoSDK
+ */
+
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <opencv2/features2d.hpp>
+#include <string>
+#include <vector>
+
+namespace PluginMethods
+{
+    /**
+     * @brief 描述子PCA降维器
+     *
+     * 在RootSIFT归一化之后将浮点描述子投影到低维子空间（如128→64/32），
+     * 匹配器（FASTCASCADEHASHINGL2 / FLANN / BF）直接使用降维后的描述子，
+     * 降低内存占用和距离计算代价。投影矩阵可按数据集学习，也可从文件加载。
+     */
+    class DescriptorPCA
+    {
+    public:
+        DescriptorPCA() = default;
+
+        /**
+         * @brief 从一组视图的描述子中学习PCA投影
+         * @param all_descriptors 所有视图的描述子（CV_32F，行为样本）
+         * @param target_dims 目标维度
+         * @param max_samples 最大训练样本数（按固定步长确定性采样）
+         * @return 是否学习成功
+         */
+        bool Learn(const std::vector<cv::Mat> &all_descriptors, int target_dims, size_t max_samples);
+
+        /**
+         * @brief 从文件加载PCA投影（cv::FileStorage格式，yml/xml）
+         * @param path 文件路径
+         * @return 是否加载成功
+         */
+        bool Load(const std::string &path);
+
+        /**
+         * @brief 保存PCA投影到文件
+         * @param path 文件路径
+         * @return 是否保存成功
+         */
+        bool Save(const std::string &path) const;
+
+        /**
+         * @brief 将描述子投影到低维空间
+         * @param descriptors 输入描述子（CV_32F，列数需等于输入维度）
+         * @return 降维后的描述子（CV_32F，连续内存），失败时返回空矩阵
+         */
+        cv::Mat Project(const cv::Mat &descriptors) const;
+
+        /**
+         * @brief 是否已有可用投影
+         */
+        bool IsReady() const { return !pca_.eigenvectors.empty(); }
+
+        /**
+         * @brief 输入维度
+         */
+        int GetInputDims() const { return pca_.eigenvectors.cols; }
+
+        /**
+         * @brief 输出维度
+         */
+        int GetOutputDims() const { return pca_.eigenvectors.rows; }
+
+        /**
+         * @brief 保留的方差比例（仅Learn后有效）
+         */
+        double GetRetainedVariance() const { return retained_variance_; }
+
+        /**
+         * @brief 计算候选匹配相对参考匹配的召回率
+         * @param reference 参考匹配（全维描述子）
+         * @param candidate 候选匹配（降维描述子）
+         * @return 参考匹配中被候选匹配复现的比例，参考为空时返回1
+         */
+        static double ComputeMatchRecall(const std::vector<cv::DMatch> &reference,
+                                         const std::vector<cv::DMatch> &candidate);
+
+    private:
+        cv::PCA pca_;
+        double retained_variance_ = 0.0;
+    };
+
+} // namespace PluginMethods
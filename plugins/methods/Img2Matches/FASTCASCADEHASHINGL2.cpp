@@ -4,30 +4,66 @@
 #include <unordered_set>
 #include <algorithm>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 
 namespace PluginMethods
 {
     // ===== 哈希描述子数据结构 =====
 
     /**
-     * @brief 单个描述子的哈希表示
-     */
-    struct HashedDescription
-    {
-        std::vector<uint64_t> hash_code;  // 哈希码（使用位操作优化）
-        std::vector<uint16_t> bucket_ids; // 每个bucket组中的bucket ID
-    };
-
-    /**
-     * @brief 描述子集合的哈希表示
+     * @brief 描述子集合的哈希表示（扁平存储）
+     *
+     * 所有数据存放在少量连续缓冲区中，避免逐描述子的小块堆分配：
+     * - hash_codes: N × words_per_code 的打包哈希码（每位对应一个主投影符号）
+     * - bucket_ids: N × G 的bucket ID矩阵
+     * - bucket_offsets / bucket_members: 按组的CSR桶成员表（计数排序构建，桶内保持描述子ID升序）
      */
     struct HashedDescriptions
     {
-        std::vector<HashedDescription> hashed_desc; // 哈希描述子列表
+        int num_descriptors = 0;
+        int words_per_code = 0;       // 每个哈希码占用的uint64_t数量
+        int nb_bucket_groups = 0;     // bucket组数量
+        int nb_buckets_per_group = 0; // 每组的bucket数量
+
+        std::vector<uint64_t> hash_codes;
+        std::vector<uint16_t> bucket_ids;
+        // bucket_offsets[g * (nb_buckets_per_group + 1) + b] 为组g中桶b在bucket_members[g * N ...]中的起始位置
+        std::vector<int> bucket_offsets;
+        std::vector<int> bucket_members;
+
+        const uint64_t *HashCode(int desc_idx) const
+        {
+            return hash_codes.data() + static_cast<size_t>(desc_idx) * words_per_code;
+        }
 
-        using Bucket = std::vector<int>;
-        // buckets[bucket_group][bucket_id] = bucket (包含描述子ID的容器)
-        std::vector<std::vector<Bucket>> buckets;
+        uint16_t BucketId(int desc_idx, int group) const
+        {
+            return bucket_ids[static_cast<size_t>(desc_idx) * nb_bucket_groups + group];
+        }
+
+        const int *BucketBegin(int group, uint16_t bucket_id) const
+        {
+            const size_t base = static_cast<size_t>(group) * (nb_buckets_per_group + 1);
+            return bucket_members.data() + static_cast<size_t>(group) * num_descriptors + bucket_offsets[base + bucket_id];
+        }
+
+        const int *BucketEnd(int group, uint16_t bucket_id) const
+        {
+            const size_t base = static_cast<size_t>(group) * (nb_buckets_per_group + 1);
+            return bucket_members.data() + static_cast<size_t>(group) * num_descriptors + bucket_offsets[base + bucket_id + 1];
+        }
     };
 
     // ===== FastCascadeHashingL2Matcher 实现 =====
@@ -51,7 +87,8 @@ namespace PluginMethods
             return false;
         }
 
-        database_descriptors_ = descriptors.clone();
+        // 共享描述子数据（引用计数），不做深拷贝；调用方在匹配期间不应修改该矩阵
+        database_descriptors_ = descriptors;
 
         // 初始化Cascade Hasher (与OpenMVG完全一致的调用方式)
         if (!cascade_hasher_->Init(descriptors.cols))
@@ -86,15 +123,33 @@ namespace PluginMethods
             return false;
         }
 
+        MatchHashed(*cascade_hasher_, *hashed_query, query_descriptors,
+                    *hashed_database_, database_descriptors_,
+                    matches, dist_ratio_, cross_check);
+
+        return true;
+    }
+
+    void FastCascadeHashingL2Matcher::MatchHashed(const CascadeHasher &hasher,
+                                                  const HashedDescriptions &hashed_query,
+                                                  const cv::Mat &query_descriptors,
+                                                  const HashedDescriptions &hashed_database,
+                                                  const cv::Mat &database_descriptors,
+                                                  std::vector<cv::DMatch> &matches,
+                                                  float dist_ratio,
+                                                  bool cross_check)
+    {
+        matches.clear();
+
         // 执行哈希匹配
         std::vector<float> distances;
-        cascade_hasher_->MatchHashedDescriptions(*hashed_database_, database_descriptors_,
-                                                 *hashed_query, query_descriptors,
-                                                 matches, distances, 2);
+        hasher.MatchHashedDescriptions(hashed_database, database_descriptors,
+                                       hashed_query, query_descriptors,
+                                       matches, distances, 2);
 
         // 应用距离比率测试
         std::vector<cv::DMatch> filtered_matches;
-        ApplyDistanceRatioFilter(matches, distances, filtered_matches);
+        ApplyDistanceRatioFilter(matches, distances, dist_ratio, filtered_matches);
 
         // 移除重复匹配
         RemoveDuplicateMatches(filtered_matches);
@@ -102,15 +157,14 @@ namespace PluginMethods
         matches = std::move(filtered_matches);
 
         // 如果启用交叉检查，进行反向匹配验证
+        // 数据库以查询身份参与反向匹配时，其哈希与hashed_database相同（同一零均值向量），直接复用
         if (cross_check && !matches.empty())
         {
             std::vector<cv::DMatch> reverse_matches;
-            auto hashed_database_query = cascade_hasher_->CreateHashedDescriptions(database_descriptors_, zero_mean_descriptor_);
-
             std::vector<float> reverse_distances;
-            cascade_hasher_->MatchHashedDescriptions(*hashed_database_query, query_descriptors,
-                                                     *hashed_database_, database_descriptors_,
-                                                     reverse_matches, reverse_distances, 2);
+            hasher.MatchHashedDescriptions(hashed_query, query_descriptors,
+                                           hashed_database, database_descriptors,
+                                           reverse_matches, reverse_distances, 2);
 
             // 保留双向匹配的结果
             std::vector<cv::DMatch> cross_checked_matches;
@@ -128,8 +182,6 @@ namespace PluginMethods
             }
             matches = std::move(cross_checked_matches);
         }
-
-        return true;
     }
 
     bool FastCascadeHashingL2Matcher::KnnMatch(const cv::Mat &query_descriptors,
@@ -198,6 +250,7 @@ namespace PluginMethods
 
     void FastCascadeHashingL2Matcher::ApplyDistanceRatioFilter(const std::vector<cv::DMatch> &raw_matches,
                                                                const std::vector<float> &distances,
+                                                               float dist_ratio,
                                                                std::vector<cv::DMatch> &filtered_matches)
     {
         filtered_matches.clear();
@@ -217,8 +270,8 @@ namespace PluginMethods
                 float dist1 = distances[i];
                 float dist2 = distances[i + 1];
 
-                // 与OpenMVG一致的比率测试：dist1 < dist_ratio_ * dist2
-                if (dist1 < dist_ratio_ * dist2)
+                // 与OpenMVG一致的比率测试：dist1 < dist_ratio * dist2
+                if (dist1 < dist_ratio * dist2)
                 {
                     ratio_ok_indices.push_back(static_cast<int>(i / NN));
                 }
@@ -339,7 +392,10 @@ namespace PluginMethods
         }
 
         auto hashed_desc = std::make_unique<HashedDescriptions>();
-        hashed_desc->hashed_desc.resize(descriptors.rows);
+        hashed_desc->num_descriptors = descriptors.rows;
+        hashed_desc->words_per_code = (nb_hash_code_ + 63) / 64;
+        hashed_desc->nb_bucket_groups = nb_bucket_groups_;
+        hashed_desc->nb_buckets_per_group = nb_buckets_per_group_;
 
         // 计算每个描述子的哈希码
         ComputeHashCodes(descriptors, zero_mean_descriptor, *hashed_desc);
@@ -354,55 +410,73 @@ namespace PluginMethods
                                          const cv::Mat &zero_mean_descriptor,
                                          HashedDescriptions &hashed_desc)
     {
-        for (int desc_idx = 0; desc_idx < descriptors.rows; ++desc_idx)
+        const int num_desc = descriptors.rows;
+        const int words_per_code = hashed_desc.words_per_code;
+        hashed_desc.hash_codes.assign(static_cast<size_t>(num_desc) * words_per_code, 0);
+        hashed_desc.bucket_ids.assign(static_cast<size_t>(num_desc) * nb_bucket_groups_, 0);
+
+        // 复用中间缓冲区；gemm(..., GEMM_2_T)与表达式 P * desc.t() 的计算完全相同
+        cv::Mat desc, primary_hash, secondary_hash;
+        for (int desc_idx = 0; desc_idx < num_desc; ++desc_idx)
         {
-            cv::Mat desc = descriptors.row(desc_idx) - zero_mean_descriptor;
-            HashedDescription &hash_desc = hashed_desc.hashed_desc[desc_idx];
-
-            // 计算主要哈希码 (与OpenMVG算法完全一致)
-            cv::Mat primary_hash = primary_hash_projection_ * desc.t();
-
-            // 与OpenMVG完全一致的哈希码存储方式
-            hash_desc.hash_code.resize(nb_hash_code_);
+            cv::subtract(descriptors.row(desc_idx), zero_mean_descriptor, desc);
 
+            // 计算主要哈希码 (与OpenMVG算法完全一致)，按位打包
+            cv::gemm(primary_hash_projection_, desc, 1.0, cv::noArray(), 0.0, primary_hash, cv::GEMM_2_T);
+            uint64_t *code = hashed_desc.hash_codes.data() + static_cast<size_t>(desc_idx) * words_per_code;
+            const float *primary_ptr = primary_hash.ptr<float>();
             for (int i = 0; i < nb_hash_code_; ++i)
             {
-                hash_desc.hash_code[i] = primary_hash.at<float>(i, 0) > 0.0f; // 与OpenMVG逻辑完全一致
+                if (primary_ptr[i] > 0.0f)
+                {
+                    code[i >> 6] |= (uint64_t(1) << (i & 63));
+                }
             }
 
             // 计算bucket ID (与OpenMVG算法完全一致)
-            hash_desc.bucket_ids.resize(nb_bucket_groups_);
+            uint16_t *bucket_ids = hashed_desc.bucket_ids.data() + static_cast<size_t>(desc_idx) * nb_bucket_groups_;
             for (int g = 0; g < nb_bucket_groups_; ++g)
             {
-                cv::Mat secondary_hash = secondary_hash_projection_[g] * desc.t();
+                cv::gemm(secondary_hash_projection_[g], desc, 1.0, cv::noArray(), 0.0, secondary_hash, cv::GEMM_2_T);
+                const float *secondary_ptr = secondary_hash.ptr<float>();
                 uint16_t bucket_id = 0;
 
                 // 使用左移位操作构建bucket_id (与OpenMVG一致)
                 for (int b = 0; b < nb_bits_per_bucket_; ++b)
                 {
-                    bucket_id = (bucket_id << 1) + (secondary_hash.at<float>(b, 0) > 0.0f ? 1 : 0);
+                    bucket_id = (bucket_id << 1) + (secondary_ptr[b] > 0.0f ? 1 : 0);
                 }
-                hash_desc.bucket_ids[g] = bucket_id;
+                bucket_ids[g] = bucket_id;
             }
         }
     }
 
     void CascadeHasher::BuildBuckets(HashedDescriptions &hashed_desc)
     {
-        hashed_desc.buckets.resize(nb_bucket_groups_);
+        const int num_desc = hashed_desc.num_descriptors;
+        const int offsets_per_group = nb_buckets_per_group_ + 1;
+        hashed_desc.bucket_offsets.assign(static_cast<size_t>(nb_bucket_groups_) * offsets_per_group, 0);
+        hashed_desc.bucket_members.resize(static_cast<size_t>(nb_bucket_groups_) * num_desc);
+
+        // 计数排序：统计 -> 前缀和 -> 按描述子ID升序填充（与逐个push_back的桶内顺序一致）
+        std::vector<int> cursor(nb_buckets_per_group_);
         for (int g = 0; g < nb_bucket_groups_; ++g)
         {
-            hashed_desc.buckets[g].resize(nb_buckets_per_group_);
-        }
+            int *offsets = hashed_desc.bucket_offsets.data() + static_cast<size_t>(g) * offsets_per_group;
+            for (int desc_idx = 0; desc_idx < num_desc; ++desc_idx)
+            {
+                ++offsets[hashed_desc.BucketId(desc_idx, g) + 1];
+            }
+            for (int b = 0; b < nb_buckets_per_group_; ++b)
+            {
+                offsets[b + 1] += offsets[b];
+            }
 
-        // 将描述子分配到相应的bucket中
-        for (int desc_idx = 0; desc_idx < hashed_desc.hashed_desc.size(); ++desc_idx)
-        {
-            const HashedDescription &hash_desc = hashed_desc.hashed_desc[desc_idx];
-            for (int g = 0; g < nb_bucket_groups_; ++g)
+            std::copy(offsets, offsets + nb_buckets_per_group_, cursor.begin());
+            int *members = hashed_desc.bucket_members.data() + static_cast<size_t>(g) * num_desc;
+            for (int desc_idx = 0; desc_idx < num_desc; ++desc_idx)
             {
-                uint16_t bucket_id = hash_desc.bucket_ids[g];
-                hashed_desc.buckets[g][bucket_id].push_back(desc_idx);
+                members[cursor[hashed_desc.BucketId(desc_idx, g)]++] = desc_idx;
             }
         }
     }
@@ -414,33 +488,36 @@ namespace PluginMethods
         const cv::Mat &query_descriptors,
         std::vector<cv::DMatch> &matches,
         std::vector<float> &distances,
-        int NN)
+        int NN) const
     {
         matches.clear();
         distances.clear();
 
-        for (int query_idx = 0; query_idx < hashed_query.hashed_desc.size(); ++query_idx)
+        const int num_database = hashed_database.num_descriptors;
+        const int words_per_code = hashed_query.words_per_code;
+
+        // 查询间复用的缓冲区（替代原先函数内static的used_descriptor，保证线程安全）
+        std::vector<int> candidate_descriptors;
+        candidate_descriptors.reserve(num_database);
+        std::vector<char> used_descriptor(num_database, 0);
+        std::vector<std::pair<int, int>> hamming_candidates; // <hamming_distance, candidate_idx>
+        hamming_candidates.reserve(num_database);
+        std::vector<std::pair<float, int>> candidate_euclidean_distances;
+        cv::Mat diff;
+
+        for (int query_idx = 0; query_idx < hashed_query.num_descriptors; ++query_idx)
         {
-            const HashedDescription &query_hash = hashed_query.hashed_desc[query_idx];
+            const uint64_t *query_code = hashed_query.HashCode(query_idx);
             cv::Mat query_desc = query_descriptors.row(query_idx);
 
             // 收集候选描述子 (与OpenMVG一致的逻辑)
-            std::vector<int> candidate_descriptors;
-            candidate_descriptors.reserve(hashed_database.hashed_desc.size());
-
-            // 使用used_descriptor来避免重复候选者 (与OpenMVG一致)
-            static std::vector<bool> used_descriptor;
-            used_descriptor.assign(hashed_database.hashed_desc.size(), false);
-
+            candidate_descriptors.clear();
             for (int g = 0; g < nb_bucket_groups_; ++g)
             {
-                uint16_t bucket_id = query_hash.bucket_ids[g];
-                const auto &bucket = hashed_database.buckets[g][bucket_id];
-                for (int desc_idx : bucket)
-                {
-                    candidate_descriptors.push_back(desc_idx);
-                    used_descriptor[desc_idx] = false;
-                }
+                const uint16_t bucket_id = hashed_query.BucketId(query_idx, g);
+                candidate_descriptors.insert(candidate_descriptors.end(),
+                                             hashed_database.BucketBegin(g, bucket_id),
+                                             hashed_database.BucketEnd(g, bucket_id));
             }
 
             // 跳过匹配如果候选数量不足 (与OpenMVG逻辑一致)
@@ -451,28 +528,28 @@ namespace PluginMethods
             }
 
             // 1. 使用汉明距离进行快速候选过滤 (与OpenMVG完全一致)
-            std::vector<std::pair<int, int>> hamming_candidates; // <hamming_distance, candidate_idx>
+            hamming_candidates.clear();
             for (int candidate_idx : candidate_descriptors)
             {
                 // 避免选择同一候选者多次 (与OpenMVG一致)
                 if (!used_descriptor[candidate_idx])
                 {
-                    used_descriptor[candidate_idx] = true;
-
-                    const HashedDescription &candidate_hash = hashed_database.hashed_desc[candidate_idx];
+                    used_descriptor[candidate_idx] = 1;
 
-                    // 计算汉明距离 (与OpenMVG的实现完全一致)
+                    // 打包哈希码的汉明距离：XOR后按字计数
+                    const uint64_t *candidate_code = hashed_database.HashCode(candidate_idx);
                     int hamming_distance = 0;
-                    for (size_t i = 0; i < query_hash.hash_code.size(); ++i)
+                    for (int w = 0; w < words_per_code; ++w)
                     {
-                        if (query_hash.hash_code[i] != candidate_hash.hash_code[i])
-                        {
-                            hamming_distance++;
-                        }
+                        hamming_distance += static_cast<int>(std::bitset<64>(query_code[w] ^ candidate_code[w]).count());
                     }
                     hamming_candidates.push_back({hamming_distance, candidate_idx});
                 }
             }
+            for (int candidate_idx : candidate_descriptors)
+            {
+                used_descriptor[candidate_idx] = 0;
+            }
 
             // 按汉明距离排序，只保留前kNumTopCandidates个候选者
             static const int kNumTopCandidates = 10; // 与OpenMVG一致
@@ -480,15 +557,13 @@ namespace PluginMethods
             int num_hamming_candidates = std::min(kNumTopCandidates, static_cast<int>(hamming_candidates.size()));
 
             // 2. 对过滤后的候选者使用L2距离进行精确匹配 (与OpenMVG完全一致)
-            std::vector<std::pair<float, int>> candidate_euclidean_distances;
-            candidate_euclidean_distances.reserve(kNumTopCandidates);
+            candidate_euclidean_distances.clear();
 
             for (int i = 0; i < num_hamming_candidates; ++i)
             {
                 int candidate_idx = hamming_candidates[i].second;
-                cv::Mat candidate_desc = database_descriptors.row(candidate_idx);
-                cv::Mat diff = query_desc - candidate_desc;
-                float distance = cv::norm(diff, cv::NORM_L2);
+                cv::subtract(query_desc, database_descriptors.row(candidate_idx), diff);
+                float distance = static_cast<float>(cv::norm(diff, cv::NORM_L2));
                 candidate_euclidean_distances.push_back({distance, candidate_idx});
             }
 
@@ -511,4 +586,250 @@ namespace PluginMethods
         }
     }
 
+    // ===== CascadeHashingSession 实现 =====
+
+    namespace
+    {
+        template <typename T>
+        void WriteVector(std::ofstream &out, const std::vector<T> &values)
+        {
+            const uint64_t count = values.size();
+            out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+            out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+
+        template <typename T>
+        bool ReadVector(std::ifstream &in, std::vector<T> &values)
+        {
+            uint64_t count = 0;
+            if (!in.read(reinterpret_cast<char *>(&count), sizeof(count)))
+                return false;
+            values.resize(count);
+            return static_cast<bool>(in.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(count * sizeof(T))));
+        }
+
+        bool SaveHashedDescriptions(const HashedDescriptions &hashed, const std::string &path)
+        {
+            std::ofstream out(path, std::ios::binary);
+            if (!out.is_open())
+                return false;
+            const int header[4] = {hashed.num_descriptors, hashed.words_per_code,
+                                   hashed.nb_bucket_groups, hashed.nb_buckets_per_group};
+            out.write(reinterpret_cast<const char *>(header), sizeof(header));
+            WriteVector(out, hashed.hash_codes);
+            WriteVector(out, hashed.bucket_ids);
+            WriteVector(out, hashed.bucket_offsets);
+            WriteVector(out, hashed.bucket_members);
+            return static_cast<bool>(out);
+        }
+
+        std::shared_ptr<HashedDescriptions> LoadHashedDescriptions(const std::string &path)
+        {
+            std::ifstream in(path, std::ios::binary);
+            if (!in.is_open())
+                return nullptr;
+            auto hashed = std::make_shared<HashedDescriptions>();
+            int header[4] = {0, 0, 0, 0};
+            if (!in.read(reinterpret_cast<char *>(header), sizeof(header)))
+                return nullptr;
+            hashed->num_descriptors = header[0];
+            hashed->words_per_code = header[1];
+            hashed->nb_bucket_groups = header[2];
+            hashed->nb_buckets_per_group = header[3];
+            if (!ReadVector(in, hashed->hash_codes) || !ReadVector(in, hashed->bucket_ids) ||
+                !ReadVector(in, hashed->bucket_offsets) || !ReadVector(in, hashed->bucket_members))
+            {
+                return nullptr;
+            }
+            return hashed;
+        }
+    } // namespace
+
+    CascadeHashingSession::CascadeHashingSession(float dist_ratio)
+        : dist_ratio_(dist_ratio), hasher_(std::make_unique<CascadeHasher>())
+    {
+    }
+
+    CascadeHashingSession::~CascadeHashingSession()
+    {
+        RemoveSessionDir();
+    }
+
+    void CascadeHashingSession::RemoveSessionDir()
+    {
+        // 只删除本会话创建的目录，同一spill_dir下其他进程/会话的文件不受影响
+        if (!session_dir_.empty())
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(session_dir_, ec);
+            session_dir_.clear();
+        }
+    }
+
+    bool CascadeHashingSession::Build(const std::vector<cv::Mat> &all_descriptors,
+                                      int num_threads,
+                                      const std::string &spill_dir)
+    {
+        descriptors_ = all_descriptors; // 共享矩阵头，不拷贝数据
+        hashed_views_.assign(descriptors_.size(), nullptr);
+        spill_files_.clear();
+        RemoveSessionDir();
+        num_hashed_views_ = 0;
+        cache_.clear();
+        // 每个线程同时使用两个视图，按块调度时查询视图在连续视图对间保持不变
+        cache_capacity_ = 4 * static_cast<size_t>(std::max(1, num_threads));
+
+        // 1. 确定描述子维度（取第一个兼容视图），维度不一致的视图不参与会话
+        int descriptor_length = 0;
+        for (const auto &desc : descriptors_)
+        {
+            if (FastCascadeHashingL2Matcher::IsCompatible(desc))
+            {
+                descriptor_length = desc.cols;
+                break;
+            }
+        }
+        if (descriptor_length == 0 || !hasher_->Init(descriptor_length))
+        {
+            return false;
+        }
+
+        // 2. 数据集全局零均值（与OpenMVG一致：所有视图所有描述子的列均值）
+        cv::Mat sum = cv::Mat::zeros(1, descriptor_length, CV_64F);
+        size_t total_rows = 0;
+        cv::Mat row_sum;
+        for (const auto &desc : descriptors_)
+        {
+            if (!FastCascadeHashingL2Matcher::IsCompatible(desc) || desc.cols != descriptor_length)
+                continue;
+            cv::reduce(desc, row_sum, 0, cv::REDUCE_SUM, CV_64F);
+            sum += row_sum;
+            total_rows += desc.rows;
+        }
+        if (total_rows == 0)
+        {
+            return false;
+        }
+        sum /= static_cast<double>(total_rows);
+        sum.convertTo(zero_mean_descriptor_, CV_32F);
+
+        // 3. 每个视图只哈希一次（并行）
+        // 落盘模式：每个会话使用spill_dir下唯一的子目录（进程号+随机后缀），并发任务不会覆盖彼此的文件
+        const bool spill = !spill_dir.empty();
+        if (spill)
+        {
+#ifdef _WIN32
+            const long pid = static_cast<long>(::_getpid());
+#else
+            const long pid = static_cast<long>(::getpid());
+#endif
+            std::ostringstream session_name;
+            session_name << "cascade_session_" << pid << "_" << std::hex << std::random_device{}();
+            std::error_code ec;
+            session_dir_ = (std::filesystem::path(spill_dir) / session_name.str()).string();
+            if (!std::filesystem::create_directories(session_dir_, ec))
+            {
+                // 目录已存在（后缀冲突）或无法创建时不落盘，避免与其他会话共用文件
+                session_dir_.clear();
+                return false;
+            }
+            spill_files_.assign(descriptors_.size(), "");
+        }
+
+        const int num_views = static_cast<int>(descriptors_.size());
+        std::vector<char> hashed_ok(num_views, 0);
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(1, num_threads))
+#endif
+        for (int v = 0; v < num_views; ++v)
+        {
+            const cv::Mat &desc = descriptors_[v];
+            if (!FastCascadeHashingL2Matcher::IsCompatible(desc) || desc.cols != descriptor_length)
+                continue;
+
+            std::shared_ptr<const HashedDescriptions> hashed(hasher_->CreateHashedDescriptions(desc, zero_mean_descriptor_));
+            if (!hashed)
+                continue;
+
+            if (spill)
+            {
+                const std::string path = (std::filesystem::path(session_dir_) /
+                                          ("cascade_view_" + std::to_string(v) + ".bin"))
+                                             .string();
+                if (!SaveHashedDescriptions(*hashed, path))
+                    continue;
+                spill_files_[v] = path;
+            }
+            else
+            {
+                hashed_views_[v] = std::move(hashed);
+            }
+            hashed_ok[v] = 1;
+        }
+
+        num_hashed_views_ = static_cast<size_t>(std::count(hashed_ok.begin(), hashed_ok.end(), 1));
+        return num_hashed_views_ > 0;
+    }
+
+    std::shared_ptr<const HashedDescriptions> CascadeHashingSession::AcquireView(size_t idx) const
+    {
+        if (idx >= descriptors_.size())
+            return nullptr;
+        if (spill_files_.empty())
+        {
+            return hashed_views_[idx];
+        }
+        if (spill_files_[idx].empty())
+            return nullptr;
+
+        const auto find_cached = [this, idx]() -> std::shared_ptr<const HashedDescriptions>
+        {
+            for (auto it = cache_.begin(); it != cache_.end(); ++it)
+            {
+                if (it->first == idx)
+                {
+                    cache_.splice(cache_.begin(), cache_, it);
+                    return it->second;
+                }
+            }
+            return nullptr;
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            if (auto cached = find_cached())
+                return cached;
+        }
+
+        // 在锁外加载，另一线程可能同时加载同一视图，插入前再检查一次
+        std::shared_ptr<const HashedDescriptions> loaded = LoadHashedDescriptions(spill_files_[idx]);
+        if (!loaded)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        if (auto cached = find_cached())
+            return cached;
+        cache_.emplace_front(idx, loaded);
+        if (cache_.size() > cache_capacity_)
+            cache_.pop_back();
+        return loaded;
+    }
+
+    bool CascadeHashingSession::MatchPair(size_t i, size_t j,
+                                          std::vector<cv::DMatch> &matches,
+                                          bool cross_check) const
+    {
+        auto hashed_query = AcquireView(i);
+        auto hashed_database = AcquireView(j);
+        if (!hashed_query || !hashed_database)
+        {
+            return false;
+        }
+
+        FastCascadeHashingL2Matcher::MatchHashed(*hasher_, *hashed_query, descriptors_[i],
+                                                 *hashed_database, descriptors_[j],
+                                                 matches, dist_ratio_, cross_check);
+        return true;
+    }
+
 } // namespace PluginMethods
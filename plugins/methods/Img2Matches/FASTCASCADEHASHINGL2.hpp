@@ -3,14 +3,17 @@
 #include <opencv2/opencv.hpp>
 #include <opencv2/features2d.hpp>
 #include <vector>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <string>
 
 namespace PluginMethods
 {
     // Forward declarations
-    struct HashedDescription;
     struct HashedDescriptions;
     class CascadeHasher;
+    class CascadeHashingSession;
 
     /**
      * @brief FAST CASCADE HASHING L2匹配器
@@ -88,11 +91,31 @@ namespace PluginMethods
          */
         static bool IsCompatible(const cv::Mat &descriptors);
 
+        /**
+         * @brief 对已哈希的两组描述子执行匹配（比率测试、去重、可选交叉检查）
+         * @param hasher 生成两组哈希时使用的哈希器
+         * @param hashed_query 哈希化的查询描述子
+         * @param query_descriptors 原始查询描述子
+         * @param hashed_database 哈希化的数据库描述子
+         * @param database_descriptors 原始数据库描述子
+         * @param matches 输出匹配结果
+         * @param dist_ratio 距离比率阈值
+         * @param cross_check 是否启用交叉检查
+         */
+        static void MatchHashed(const CascadeHasher &hasher,
+                                const HashedDescriptions &hashed_query,
+                                const cv::Mat &query_descriptors,
+                                const HashedDescriptions &hashed_database,
+                                const cv::Mat &database_descriptors,
+                                std::vector<cv::DMatch> &matches,
+                                float dist_ratio,
+                                bool cross_check);
+
     private:
         float dist_ratio_;                                    // 距离比率阈值
         std::unique_ptr<CascadeHasher> cascade_hasher_;       // Cascade Hashing核心算法
         std::unique_ptr<HashedDescriptions> hashed_database_; // 哈希化的数据库描述子
-        cv::Mat database_descriptors_;                        // 原始数据库描述子
+        cv::Mat database_descriptors_;                        // 原始数据库描述子（共享数据，不拷贝）
         cv::Mat zero_mean_descriptor_;                        // 零均值描述子
 
         /**
@@ -106,17 +129,19 @@ namespace PluginMethods
          * @brief 应用距离比率测试过滤匹配
          * @param raw_matches 原始匹配结果
          * @param distances 对应的距离
+         * @param dist_ratio 距离比率阈值
          * @param filtered_matches 过滤后的匹配结果
          */
-        void ApplyDistanceRatioFilter(const std::vector<cv::DMatch> &raw_matches,
-                                      const std::vector<float> &distances,
-                                      std::vector<cv::DMatch> &filtered_matches);
+        static void ApplyDistanceRatioFilter(const std::vector<cv::DMatch> &raw_matches,
+                                             const std::vector<float> &distances,
+                                             float dist_ratio,
+                                             std::vector<cv::DMatch> &filtered_matches);
 
         /**
          * @brief 移除重复的匹配
          * @param matches 输入输出匹配结果
          */
-        void RemoveDuplicateMatches(std::vector<cv::DMatch> &matches);
+        static void RemoveDuplicateMatches(std::vector<cv::DMatch> &matches);
     };
 
     /**
@@ -174,7 +199,7 @@ namespace PluginMethods
             const cv::Mat &query_descriptors,
             std::vector<cv::DMatch> &matches,
             std::vector<float> &distances,
-            int NN = 2);
+            int NN = 2) const;
 
         /**
          * @brief 计算零均值描述子
@@ -202,4 +227,72 @@ namespace PluginMethods
         void BuildBuckets(HashedDescriptions &hashed_desc);
     };
 
+    /**
+     * @brief 数据集级Cascade Hashing会话
+     *
+     * 与OpenMVG一致：在整个数据集上计算一次零均值向量，每个视图只哈希一次，
+     * 之后所有视图对直接使用预哈希结果匹配（避免每对重复计算均值和哈希）。
+     * 哈希结果默认常驻内存，也可写入磁盘目录并在匹配时按需加载；落盘模式下最近使用的视图
+     * 保留在LRU缓存中，同一视图不会为每个视图对重复从磁盘加载。
+     */
+    class CascadeHashingSession
+    {
+    public:
+        /**
+         * @brief 构造函数
+         * @param dist_ratio Lowe's比率测试阈值
+         */
+        explicit CascadeHashingSession(float dist_ratio = 0.8f);
+        ~CascadeHashingSession();
+
+        /**
+         * @brief 计算全局零均值并并行哈希所有视图
+         * @param all_descriptors 所有视图的描述子（共享数据，不拷贝；会话期间不应修改）
+         * @param num_threads 哈希线程数（同时决定落盘模式的缓存容量）
+         * @param spill_dir 哈希结果落盘目录，为空时常驻内存；文件写入其下本会话独有的子目录，会话结束时删除
+         * @return 是否至少有一个视图完成哈希
+         */
+        bool Build(const std::vector<cv::Mat> &all_descriptors,
+                   int num_threads,
+                   const std::string &spill_dir = "");
+
+        /**
+         * @brief 匹配视图对(i, j)，语义与Match(descriptors[i], descriptors[j])一致（i为查询，j为数据库）
+         * @param i 查询视图索引
+         * @param j 数据库视图索引
+         * @param matches 输出匹配结果
+         * @param cross_check 是否启用交叉检查
+         * @return 两个视图均已哈希且匹配成功时返回true，否则调用方应回退到逐对匹配
+         */
+        bool MatchPair(size_t i, size_t j, std::vector<cv::DMatch> &matches, bool cross_check) const;
+
+        /**
+         * @brief 已哈希的视图数量
+         */
+        size_t GetNumHashedViews() const { return num_hashed_views_; }
+
+        /**
+         * @brief 哈希结果是否落盘
+         */
+        bool IsSpilled() const { return !spill_files_.empty(); }
+
+    private:
+        std::shared_ptr<const HashedDescriptions> AcquireView(size_t idx) const;
+        void RemoveSessionDir();
+
+        float dist_ratio_;
+        std::unique_ptr<CascadeHasher> hasher_;
+        cv::Mat zero_mean_descriptor_;                                        // 数据集全局零均值向量
+        std::vector<cv::Mat> descriptors_;                                    // 各视图描述子（共享数据）
+        std::vector<std::shared_ptr<const HashedDescriptions>> hashed_views_; // 常驻内存的哈希结果
+        std::vector<std::string> spill_files_;                                // 落盘模式下各视图的哈希文件
+        std::string session_dir_;                                             // 落盘模式下本会话独有的目录
+        size_t num_hashed_views_ = 0;
+
+        // 落盘模式的LRU缓存：最近使用的视图在前
+        mutable std::mutex cache_mutex_;
+        mutable std::list<std::pair<size_t, std::shared_ptr<const HashedDescriptions>>> cache_;
+        size_t cache_capacity_ = 0;
+    };
+
 } // namespace PluginMethods
@@ -6,6 +6,7 @@
 
 #include "Img2MatchesParams.hpp"
 #include <algorithm>
+#include <cstdlib>
 #include <iomanip>
 #include <boost/algorithm/string.hpp>
 #include <po_core/po_logger.hpp>
@@ -36,6 +37,10 @@ namespace PluginMethods
         // Multi-threading configuration | 多线程配置
         base.num_threads = static_cast<int>(config_loader->GetOptionAsIndexT("num_threads", 4));
 
+        // Image prefetch configuration | 图像预读配置
+        base.io_prefetch_depth = static_cast<int>(config_loader->GetOptionAsIndexT("io_prefetch_depth", 8));
+        base.use_io_uring = config_loader->GetOptionAsBool("use_io_uring", true);
+
         // === Load SIFT parameters from specific_methods_config_ | 从specific_methods_config_加载SIFT参数 ===
         if (base.detector_type == "SIFT")
         {
@@ -150,6 +155,55 @@ namespace PluginMethods
         matching.cross_check = config_loader->GetOptionAsBool("cross_check", false);
         matching.ratio_thresh = static_cast<float>(config_loader->GetOptionAsDouble("ratio_thresh", 0.8));
         matching.max_matches = config_loader->GetOptionAsIndexT("max_matches", 0);
+        matching.cascade_global_session = config_loader->GetOptionAsBool("cascade_hashing_global_session", true);
+        matching.cascade_spill_dir = config_loader->GetOptionAsString("cascade_hashing_spill_dir", "");
+
+        // Descriptor reduction parameters | 描述子降维参数
+        descriptor_reduction.enable_pca = config_loader->GetOptionAsBool("enable_descriptor_pca", false);
+        descriptor_reduction.pca_dims = static_cast<int>(config_loader->GetOptionAsIndexT("pca_dims", 64));
+        descriptor_reduction.pca_model_path = config_loader->GetOptionAsString("pca_model_path", "");
+        descriptor_reduction.max_training_samples = config_loader->GetOptionAsIndexT("pca_max_training_samples", 200000);
+        descriptor_reduction.recall_benchmark_pairs = config_loader->GetOptionAsIndexT("pca_recall_benchmark_pairs", 0);
+
+        // Matcher autotuning parameters | 匹配器自动调优参数
+        autotune.enable = config_loader->GetOptionAsBool("enable_matcher_autotune", false);
+        autotune.sample_pairs = config_loader->GetOptionAsIndexT("autotune_sample_pairs", 24);
+        autotune.recall_target = config_loader->GetOptionAsDouble("autotune_recall_target", 0.95);
+        autotune.min_precision = config_loader->GetOptionAsDouble("autotune_min_precision", 0.8);
+        autotune.ratio_candidates = config_loader->GetOptionAsString("autotune_ratio_candidates", "0.7,0.75,0.8");
+        autotune.include_lightglue = config_loader->GetOptionAsBool("autotune_include_lightglue", false);
+        autotune.output_path = config_loader->GetOptionAsString("autotune_output_path", "");
+
+        // Spatial pair selection parameters | 空间视图对选择参数
+        pair_selection.enable_spatial = config_loader->GetOptionAsBool("enable_spatial_pair_selection", false);
+        pair_selection.mode = config_loader->GetOptionAsString("spatial_pair_mode", "knn");
+        pair_selection.k = config_loader->GetOptionAsIndexT("spatial_pair_k", 10);
+        pair_selection.radius = config_loader->GetOptionAsDouble("spatial_pair_radius", 50.0);
+        pair_selection.use_heading_overlap = config_loader->GetOptionAsBool("spatial_pair_heading_overlap", false);
+        pair_selection.fov_deg = config_loader->GetOptionAsDouble("spatial_pair_fov_deg", 60.0);
+        pair_selection.pose_prior_file = config_loader->GetOptionAsString("pose_prior_file", "");
+
+        // Sharded matching parameters | 分片匹配参数
+        sharding.shard_count = config_loader->GetOptionAsIndexT("shard_count", 0);
+        sharding.shard_index = std::atoi(config_loader->GetOptionAsString("shard_index", "-1").c_str());
+        sharding.shard_dir = config_loader->GetOptionAsString("shard_dir", "");
+        sharding.run_id = config_loader->GetOptionAsString("shard_run_id", "");
+        sharding.wait_timeout_s = config_loader->GetOptionAsDouble("shard_wait_timeout", 0.0);
+
+        // Resumable matching parameters | 断点续算参数
+        journal.journal_path = config_loader->GetOptionAsString("journal_path", "");
+        journal.flush_pairs = config_loader->GetOptionAsIndexT("journal_flush_pairs", 256);
+
+        // Deadline (anytime) mode parameters | 截止时间模式参数
+        deadline.time_budget_s = config_loader->GetOptionAsDouble("time_budget_s", 0.0);
+        deadline.min_pairs = config_loader->GetOptionAsIndexT("time_budget_min_pairs", 0);
+        deadline.pair_priority = config_loader->GetOptionAsString("pair_priority", "none");
+        deadline.skipped_pairs_path = config_loader->GetOptionAsString("skipped_pairs_path", "");
+
+        // Memory governor parameters | 内存压力控制参数
+        memory_governor.high_watermark = std::clamp(config_loader->GetOptionAsDouble("memory_high_watermark", 0.0), 0.0, 1.0);
+        memory_governor.low_watermark = std::clamp(config_loader->GetOptionAsDouble("memory_low_watermark", 0.0), 0.0, 1.0);
+        memory_governor.limit_mb = config_loader->GetOptionAsIndexT("memory_limit_mb", 0);
 
         // === Load FLANN parameters from specific_methods_config_ | 从specific_methods_config_加载FLANN参数 ===
         if (matching.matcher_type == MatcherType::FLANN)
@@ -239,6 +293,7 @@ namespace PluginMethods
         // Visualization parameters | 可视化参数
         visualization.show_view_pair_i = config_loader->GetOptionAsIndexT("show_view_pair_i", 0);
         visualization.show_view_pair_j = config_loader->GetOptionAsIndexT("show_view_pair_j", 1);
+        visualization.decode_reduce_factor = static_cast<int>(config_loader->GetOptionAsIndexT("decode_reduce_factor", 1));
     }
 
     bool Img2MatchesParameters::Validate(Interface::MethodPreset *method_ptr) const
@@ -276,6 +331,61 @@ namespace PluginMethods
             return false;
         }
 
+        // Validate descriptor reduction parameters | 验证描述子降维参数
+        if (descriptor_reduction.enable_pca && descriptor_reduction.pca_dims <= 0)
+        {
+            if (method_ptr)
+            {
+                LOG_ERROR_ZH << "[PoSDK | method_img2matches] 错误 >>> pca_dims必须大于0，当前值: " << descriptor_reduction.pca_dims;
+                LOG_ERROR_EN << "[PoSDK | method_img2matches] ERROR >>> pca_dims must be greater than 0, current value: " << descriptor_reduction.pca_dims;
+            }
+            else
+            {
+                LOG_ERROR_ZH << "[Img2Matches] 错误 >>> pca_dims必须大于0，当前值: " << descriptor_reduction.pca_dims;
+                LOG_ERROR_EN << "[Img2Matches] ERROR >>> pca_dims must be greater than 0, current value: " << descriptor_reduction.pca_dims;
+            }
+            std::cerr << std::endl;
+            return false;
+        }
+
+        // Validate spatial pair selection parameters | 验证空间视图对选择参数
+        if (pair_selection.enable_spatial && pair_selection.mode != "knn" && pair_selection.mode != "radius")
+        {
+            if (method_ptr)
+            {
+                LOG_ERROR_ZH << "[PoSDK | method_img2matches] 错误 >>> spatial_pair_mode必须为knn或radius，当前值: " << pair_selection.mode;
+                LOG_ERROR_EN << "[PoSDK | method_img2matches] ERROR >>> spatial_pair_mode must be knn or radius, current value: " << pair_selection.mode;
+            }
+            else
+            {
+                LOG_ERROR_ZH << "[Img2Matches] 错误 >>> spatial_pair_mode必须为knn或radius，当前值: " << pair_selection.mode;
+                LOG_ERROR_EN << "[Img2Matches] ERROR >>> spatial_pair_mode must be knn or radius, current value: " << pair_selection.mode;
+            }
+            std::cerr << std::endl;
+            return false;
+        }
+
+        // Validate deadline mode parameters | 验证截止时间模式参数
+        if (deadline.time_budget_s < 0.0 || (deadline.pair_priority != "none" && deadline.pair_priority != "overlap"))
+        {
+            if (method_ptr)
+            {
+                LOG_ERROR_ZH << "[PoSDK | method_img2matches] 错误 >>> time_budget_s必须>=0且pair_priority必须为none或overlap，当前值: "
+                             << deadline.time_budget_s << ", " << deadline.pair_priority;
+                LOG_ERROR_EN << "[PoSDK | method_img2matches] ERROR >>> time_budget_s must be >= 0 and pair_priority must be none or overlap, current value: "
+                             << deadline.time_budget_s << ", " << deadline.pair_priority;
+            }
+            else
+            {
+                LOG_ERROR_ZH << "[Img2Matches] 错误 >>> time_budget_s必须>=0且pair_priority必须为none或overlap，当前值: "
+                             << deadline.time_budget_s << ", " << deadline.pair_priority;
+                LOG_ERROR_EN << "[Img2Matches] ERROR >>> time_budget_s must be >= 0 and pair_priority must be none or overlap, current value: "
+                             << deadline.time_budget_s << ", " << deadline.pair_priority;
+            }
+            std::cerr << std::endl;
+            return false;
+        }
+
         // Validate visualization parameters | 验证可视化参数
         if (visualization.show_view_pair_i == visualization.show_view_pair_j)
         {
@@ -420,11 +530,13 @@ namespace PluginMethods
         LOG_DEBUG_ZH << "  cross_check: " << (matching.cross_check ? "true" : "false") << "\n";
         LOG_DEBUG_ZH << "  ratio_thresh: " << matching.ratio_thresh << "\n";
         LOG_DEBUG_ZH << "  max_matches: " << matching.max_matches << "\n";
+        LOG_DEBUG_ZH << "  cascade_hashing_global_session: " << (matching.cascade_global_session ? "true" : "false") << "\n";
         LOG_DEBUG_EN << "Matching Configuration:\n";
         LOG_DEBUG_EN << "  matcher_type: " << Img2MatchesParameterConverter::MatcherTypeToString(matching.matcher_type) << "\n";
         LOG_DEBUG_EN << "  cross_check: " << (matching.cross_check ? "true" : "false") << "\n";
         LOG_DEBUG_EN << "  ratio_thresh: " << matching.ratio_thresh << "\n";
         LOG_DEBUG_EN << "  max_matches: " << matching.max_matches << "\n";
+        LOG_DEBUG_EN << "  cascade_hashing_global_session: " << (matching.cascade_global_session ? "true" : "false") << "\n";
 
         // Output FLANN matcher parameters (only when using FLANN) | 输出FLANN匹配器参数（仅当使用FLANN时）
         if (matching.matcher_type == MatcherType::FLANN)
@@ -519,6 +631,8 @@ namespace PluginMethods
             {"run_mode", RunModeToString(params.base.run_mode)},
             {"detector_type", params.base.detector_type},
             {"num_threads", std::to_string(params.base.num_threads)},
+            {"io_prefetch_depth", std::to_string(params.base.io_prefetch_depth)},
+            {"use_io_uring", params.base.use_io_uring ? "true" : "false"},
             {"export_features", params.feature_export.export_features ? "ON" : "OFF"},
             {"export_fea_path", params.feature_export.export_fea_path},
             {"export_matches", params.matches_export.export_matches ? "ON" : "OFF"},
@@ -527,8 +641,44 @@ namespace PluginMethods
             {"cross_check", params.matching.cross_check ? "true" : "false"},
             {"ratio_thresh", std::to_string(params.matching.ratio_thresh)},
             {"max_matches", std::to_string(params.matching.max_matches)},
+            {"cascade_hashing_global_session", params.matching.cascade_global_session ? "true" : "false"},
+            {"cascade_hashing_spill_dir", params.matching.cascade_spill_dir},
+            {"enable_descriptor_pca", params.descriptor_reduction.enable_pca ? "true" : "false"},
+            {"pca_dims", std::to_string(params.descriptor_reduction.pca_dims)},
+            {"pca_model_path", params.descriptor_reduction.pca_model_path},
+            {"pca_max_training_samples", std::to_string(params.descriptor_reduction.max_training_samples)},
+            {"pca_recall_benchmark_pairs", std::to_string(params.descriptor_reduction.recall_benchmark_pairs)},
+            {"enable_matcher_autotune", params.autotune.enable ? "true" : "false"},
+            {"autotune_sample_pairs", std::to_string(params.autotune.sample_pairs)},
+            {"autotune_recall_target", std::to_string(params.autotune.recall_target)},
+            {"autotune_min_precision", std::to_string(params.autotune.min_precision)},
+            {"autotune_ratio_candidates", params.autotune.ratio_candidates},
+            {"autotune_include_lightglue", params.autotune.include_lightglue ? "true" : "false"},
+            {"autotune_output_path", params.autotune.output_path},
+            {"enable_spatial_pair_selection", params.pair_selection.enable_spatial ? "true" : "false"},
+            {"spatial_pair_mode", params.pair_selection.mode},
+            {"spatial_pair_k", std::to_string(params.pair_selection.k)},
+            {"spatial_pair_radius", std::to_string(params.pair_selection.radius)},
+            {"spatial_pair_heading_overlap", params.pair_selection.use_heading_overlap ? "true" : "false"},
+            {"spatial_pair_fov_deg", std::to_string(params.pair_selection.fov_deg)},
+            {"pose_prior_file", params.pair_selection.pose_prior_file},
+            {"shard_count", std::to_string(params.sharding.shard_count)},
+            {"shard_index", std::to_string(params.sharding.shard_index)},
+            {"shard_dir", params.sharding.shard_dir},
+            {"shard_run_id", params.sharding.run_id},
+            {"shard_wait_timeout", std::to_string(params.sharding.wait_timeout_s)},
+            {"journal_path", params.journal.journal_path},
+            {"journal_flush_pairs", std::to_string(params.journal.flush_pairs)},
+            {"time_budget_s", std::to_string(params.deadline.time_budget_s)},
+            {"time_budget_min_pairs", std::to_string(params.deadline.min_pairs)},
+            {"pair_priority", params.deadline.pair_priority},
+            {"skipped_pairs_path", params.deadline.skipped_pairs_path},
+            {"memory_high_watermark", std::to_string(params.memory_governor.high_watermark)},
+            {"memory_low_watermark", std::to_string(params.memory_governor.low_watermark)},
+            {"memory_limit_mb", std::to_string(params.memory_governor.limit_mb)},
             {"show_view_pair_i", std::to_string(params.visualization.show_view_pair_i)},
-            {"show_view_pair_j", std::to_string(params.visualization.show_view_pair_j)}};
+            {"show_view_pair_j", std::to_string(params.visualization.show_view_pair_j)},
+            {"decode_reduce_factor", std::to_string(params.visualization.decode_reduce_factor)}};
 
         // Add FLANN-specific parameters (using section|key format) | 添加FLANN特定参数（使用section|key格式）
         if (params.matching.matcher_type == MatcherType::FLANN)
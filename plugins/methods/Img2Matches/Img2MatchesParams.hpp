@@ -221,6 +221,8 @@ namespace PluginMethods
         DataTypesMode data_types_mode = DataTypesMode::Full; // 数据类型模式：Full=全量存储，Single=单文件流式处理 | Data types mode: Full=store all in memory, Single=single file stream processing
         std::string detector_type = "SIFT";                  // 特征检测器类型
         int num_threads = 4;                                 // 多线程数量（特征提取并行化）
+        int io_prefetch_depth = 8;                           // 预读图像数量（0=直接cv::imread） | Images read ahead of extraction (0 = plain cv::imread)
+        bool use_io_uring = true;                            // 预读优先使用io_uring（不可用时回退线程池） | Prefer io_uring for prefetch (thread pool fallback)
     };
 
     /**
@@ -377,6 +379,90 @@ namespace PluginMethods
         bool cross_check = false;                                     // 是否启用交叉检查
         float ratio_thresh = 0.8f;                                    // Lowe's比率测试阈值
         size_t max_matches = 0;                                       // 最大匹配数，0表示不限制
+        bool cascade_global_session = true;                           // FASTCASCADEHASHINGL2：全局零均值+每视图只哈希一次
+        std::string cascade_spill_dir = "";                           // 会话哈希结果落盘目录，为空时常驻内存
+    };
+
+    /**
+     * @brief 描述子降维参数（RootSIFT之后的PCA投影）
+     */
+    struct DescriptorReductionParameters
+    {
+        bool enable_pca = false;              // 是否启用PCA降维
+        int pca_dims = 64;                    // 目标维度（如64/32）
+        std::string pca_model_path = "";      // PCA模型文件路径，存在且维度一致则加载，否则学习后保存
+        size_t max_training_samples = 200000; // 学习PCA的最大样本数
+        size_t recall_benchmark_pairs = 0;    // 随机抽样与全维描述子对比召回率的视图对数量，0表示不评测
+    };
+
+    /**
+     * @brief 匹配器自动调优参数（快速模式）
+     */
+    struct AutotuneParameters
+    {
+        bool enable = false;                           // 是否在匹配前自动选择匹配器与参数
+        size_t sample_pairs = 24;                      // 随机抽样的视图对数
+        double recall_target = 0.95;                   // 相对暴力匹配参考的召回率目标
+        double min_precision = 0.8;                    // 最低精度（避免靠放宽比率阈值提高召回）
+        std::string ratio_candidates = "0.7,0.75,0.8"; // 参与调优的ratio_thresh（逗号分隔）
+        bool include_lightglue = false;                // 是否加入LightGlue候选（需缓存图像）
+        std::string output_path = "";                  // 调优结果ini片段；文件已存在时直接复用，不再调优
+    };
+
+    /**
+     * @brief 空间视图对选择参数（GPS/位姿先验，适用于航拍数据）
+     */
+    struct PairSelectionParameters
+    {
+        bool enable_spatial = false;      // 是否启用空间视图对选择（否则全对匹配）
+        std::string mode = "knn";         // knn | radius
+        size_t k = 10;                    // knn模式下的近邻数
+        double radius = 50.0;             // radius模式下的搜索半径（米，局部ENU）
+        bool use_heading_overlap = false; // 是否启用航向/视场重叠测试
+        double fov_deg = 60.0;            // 相机水平视场角（度）
+        std::string pose_prior_file = ""; // 位姿先验文件（image lat lon alt [heading]），为空时读取EXIF GPS
+    };
+
+    /**
+     * @brief 分片多进程匹配参数（快速模式）
+     */
+    struct ShardingParameters
+    {
+        size_t shard_count = 0;        // 分片数，0/1表示不分片
+        int shard_index = -1;          // 本进程匹配的分片，并在shard_dir中等待其他分片；-1表示不分片
+        std::string shard_dir = "";    // 分片文件目录（需在节点间共享），为空时使用以输入命名的临时目录
+        std::string run_id = "";       // 同一次运行的所有工作进程相同、每次运行不同
+        double wait_timeout_s = 0.0;   // 等待其他分片的秒数，0表示一直等待
+    };
+
+    /**
+     * @brief 断点续算参数（视图对日志）
+     */
+    struct JournalParameters
+    {
+        std::string journal_path = "";  // 日志文件，为空表示不启用；分片进程追加".shard-k-of-K"
+        size_t flush_pairs = 256;       // 每次批量写入并fsync的视图对数
+    };
+
+    /**
+     * @brief 截止时间（anytime）模式参数
+     */
+    struct DeadlineParameters
+    {
+        double time_budget_s = 0.0;          // 匹配阶段预算（秒），0表示不启用
+        size_t min_pairs = 0;                // 预算耗尽后仍保证匹配的视图对数，0表示视图数
+        std::string pair_priority = "none";  // none | overlap（索引相邻、特征多的视图对优先）
+        std::string skipped_pairs_path = ""; // 跳过的视图对列表（每行"i j"），为空表示不写出；分片进程追加".shard-k"
+    };
+
+    /**
+     * @brief 内存压力控制参数（多线程特征提取与匹配）
+     */
+    struct MemoryGovernorParameters
+    {
+        double high_watermark = 0.0; // 内存上限比例，超过后限制同时运行的任务数，0表示不启用
+        double low_watermark = 0.0;  // 低于该比例时恢复并发，0表示高水位-0.1
+        size_t limit_mb = 0;         // 内存上限（MB），0表示cgroup限制或物理内存
     };
 
     /**
@@ -386,6 +472,7 @@ namespace PluginMethods
     {
         size_t show_view_pair_i = 0; // 第一幅图像索引
         size_t show_view_pair_j = 1; // 第二幅图像索引
+        int decode_reduce_factor = 1; // 预览解码降采样因子(1/2/4/8)，仅影响viewer模式
     };
 
     /**
@@ -403,6 +490,13 @@ namespace PluginMethods
         FeatureExportParameters feature_export;
         MatchesExportParameters matches_export;
         MatchingParameters matching;
+        DescriptorReductionParameters descriptor_reduction;
+        AutotuneParameters autotune;
+        PairSelectionParameters pair_selection;
+        ShardingParameters sharding;
+        JournalParameters journal;
+        DeadlineParameters deadline;
+        MemoryGovernorParameters memory_governor;
         VisualizationParameters visualization;
 
         /**
@@ -0,0 +1,263 @@
+/**
+ * @file MatcherAutotuner.cpp
+ * @brief 匹配器与参数自动调优实现
+ * @copyright Copyright (c) 2024 PoSDK
+ */
+
+#include "MatcherAutotuner.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace PluginMethods
+{
+    double MatchCostModel::Predict(double n_i, double n_j) const
+    {
+        return c_product * n_i * n_j + c_linear * (n_i + n_j) + c_const;
+    }
+
+    MatchCostModel MatchCostModel::Fit(const std::vector<cv::Vec3d> &samples)
+    {
+        MatchCostModel best;
+        if (samples.empty())
+            return best;
+
+        // 对各项子集分别做最小二乘，只保留系数非负的解，取残差最小者（3项的非负最小二乘）
+        double best_residual = std::numeric_limits<double>::max();
+        for (int subset = 1; subset < 8; ++subset)
+        {
+            std::vector<int> terms;
+            for (int t = 0; t < 3; ++t)
+                if (subset & (1 << t))
+                    terms.push_back(t);
+            if (terms.size() > samples.size())
+                continue;
+
+            cv::Mat A(static_cast<int>(samples.size()), static_cast<int>(terms.size()), CV_64F);
+            cv::Mat b(static_cast<int>(samples.size()), 1, CV_64F);
+            for (int r = 0; r < A.rows; ++r)
+            {
+                const cv::Vec3d &s = samples[r];
+                const double features[3] = {s[0] * s[1], s[0] + s[1], 1.0};
+                for (int c = 0; c < A.cols; ++c)
+                    A.at<double>(r, c) = features[terms[c]];
+                b.at<double>(r) = s[2];
+            }
+
+            cv::Mat x;
+            if (!cv::solve(A, b, x, cv::DECOMP_SVD))
+                continue;
+
+            bool non_negative = true;
+            for (int c = 0; c < x.rows; ++c)
+                non_negative = non_negative && x.at<double>(c) >= 0.0;
+            if (!non_negative)
+                continue;
+
+            const double residual = cv::norm(A * x - b, cv::NORM_L2SQR);
+            if (residual < best_residual)
+            {
+                best_residual = residual;
+                best = MatchCostModel();
+                double *coefs[3] = {&best.c_product, &best.c_linear, &best.c_const};
+                for (int c = 0; c < x.rows; ++c)
+                    *coefs[terms[c]] = x.at<double>(c);
+            }
+        }
+        return best;
+    }
+
+    std::vector<MatcherCandidate> MatcherAutotuner::BuildCandidates(int descriptor_type,
+                                                                     const std::vector<float> &ratios,
+                                                                     const FLANNParameters &base_flann,
+                                                                     bool include_lightglue)
+    {
+        std::vector<MatcherCandidate> candidates;
+        auto add = [&](MatcherType type, const std::string &name, const FLANNParameters &flann)
+        {
+            for (float ratio : ratios)
+            {
+                MatcherCandidate candidate;
+                candidate.matcher_type = type;
+                candidate.ratio_thresh = ratio;
+                candidate.flann = flann;
+                std::ostringstream label;
+                label << name << " r=" << std::setprecision(3) << ratio;
+                candidate.label = label.str();
+                candidates.push_back(candidate);
+            }
+        };
+
+        if (descriptor_type == CV_32F)
+        {
+            add(MatcherType::FASTCASCADEHASHINGL2, "FASTCASCADEHASHINGL2", base_flann);
+            add(MatcherType::BF, "BF", base_flann);
+
+            // FLANN预设 + trees/checks网格（KDTree）
+            for (FLANNPreset preset : {FLANNPreset::FAST, FLANNPreset::BALANCED, FLANNPreset::ACCURATE})
+            {
+                FLANNParameters flann = base_flann;
+                flann.use_advanced_control = true;
+                flann.algorithm = FLANNAlgorithm::KDTREE;
+                flann.preset = preset;
+                flann.ApplyPreset();
+                add(MatcherType::FLANN, "FLANN(" + Img2MatchesParameterConverter::FLANNPresetToString(preset) + ")", flann);
+            }
+            for (int trees : {4, 8})
+            {
+                for (int checks : {16, 64, 256})
+                {
+                    FLANNParameters flann = base_flann;
+                    flann.use_advanced_control = true;
+                    flann.algorithm = FLANNAlgorithm::KDTREE;
+                    flann.preset = FLANNPreset::CUSTOM;
+                    flann.trees = trees;
+                    flann.checks = checks;
+                    add(MatcherType::FLANN, "FLANN(trees=" + std::to_string(trees) + ",checks=" + std::to_string(checks) + ")", flann);
+                }
+            }
+        }
+        else
+        {
+            // 二进制描述子：MatchFeaturesThreadSafe中FLANN/Cascade均回退为暴力匹配，只保留汉明暴力匹配
+            add(MatcherType::BF_HAMMING, "BF_HAMMING", base_flann);
+        }
+
+        if (include_lightglue)
+        {
+            MatcherCandidate candidate;
+            candidate.matcher_type = MatcherType::LIGHTGLUE;
+            candidate.ratio_thresh = ratios.empty() ? 0.8f : ratios.front();
+            candidate.flann = base_flann;
+            candidate.label = "LIGHTGLUE";
+            candidates.push_back(candidate);
+        }
+        return candidates;
+    }
+
+    std::vector<float> MatcherAutotuner::ParseRatios(const std::string &text, float fallback)
+    {
+        std::vector<float> ratios;
+        std::stringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            try
+            {
+                const float ratio = std::stof(item);
+                if (ratio > 0.0f && ratio < 1.0f)
+                    ratios.push_back(ratio);
+            }
+            catch (const std::exception &)
+            {
+            }
+        }
+        if (ratios.empty())
+            ratios.push_back(fallback);
+        std::sort(ratios.begin(), ratios.end());
+        ratios.erase(std::unique(ratios.begin(), ratios.end()), ratios.end());
+        return ratios;
+    }
+
+    size_t MatcherAutotuner::SelectBest(std::vector<MatcherCandidateResult> &results,
+                                        double recall_target, double min_precision)
+    {
+        size_t best = results.size();
+        size_t best_recall = 0;
+        for (size_t k = 0; k < results.size(); ++k)
+        {
+            auto &result = results[k];
+            result.feasible = result.recall >= recall_target && result.precision >= min_precision;
+            if (results[k].recall > results[best_recall].recall)
+                best_recall = k;
+            if (!result.feasible)
+                continue;
+
+            // 预测时间相同时取精度更高者
+            if (best == results.size() ||
+                result.predicted_seconds < results[best].predicted_seconds ||
+                (result.predicted_seconds == results[best].predicted_seconds && result.precision > results[best].precision))
+            {
+                best = k;
+            }
+        }
+        return best == results.size() ? best_recall : best;
+    }
+
+    bool MatcherAutotuner::WriteConfig(const std::string &path, const MatcherCandidate &candidate)
+    {
+        std::ofstream out(path);
+        if (!out)
+            return false;
+
+        out << "# Generated by the Img2Matches matcher autotuner: " << candidate.label << "\n";
+        out << "[method_img2matches]\n";
+        out << "matcher_type=" << Img2MatchesParameterConverter::MatcherTypeToString(candidate.matcher_type) << "\n";
+        out << "ratio_thresh=" << candidate.ratio_thresh << "\n";
+        if (candidate.matcher_type == MatcherType::FLANN)
+        {
+            const auto &flann = candidate.flann;
+            out << "\n[FLANN]\n";
+            out << "use_advanced_control=" << (flann.use_advanced_control ? "true" : "false") << "\n";
+            out << "algorithm=" << Img2MatchesParameterConverter::FLANNAlgorithmToString(flann.algorithm) << "\n";
+            out << "preset=" << Img2MatchesParameterConverter::FLANNPresetToString(flann.preset) << "\n";
+            out << "trees=" << flann.trees << "\n";
+            out << "checks=" << flann.checks << "\n";
+        }
+        return static_cast<bool>(out);
+    }
+
+    bool MatcherAutotuner::ReadConfig(const std::string &path, MatcherCandidate &candidate)
+    {
+        std::ifstream in(path);
+        if (!in)
+            return false;
+
+        std::string line, section;
+        while (std::getline(in, line))
+        {
+            line = line.substr(0, line.find('#'));
+            line.erase(0, line.find_first_not_of(" \t\r"));
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            if (line.empty())
+                continue;
+            if (line.front() == '[' && line.back() == ']')
+            {
+                section = line.substr(1, line.size() - 2);
+                continue;
+            }
+
+            const size_t eq = line.find('=');
+            if (eq == std::string::npos)
+                continue;
+            const std::string key = line.substr(0, eq);
+            const std::string value = line.substr(eq + 1);
+            try
+            {
+                if (section == "method_img2matches" && key == "matcher_type")
+                    candidate.matcher_type = Img2MatchesParameterConverter::StringToMatcherType(value);
+                else if (section == "method_img2matches" && key == "ratio_thresh")
+                    candidate.ratio_thresh = std::stof(value);
+                else if (section == "FLANN" && key == "use_advanced_control")
+                    candidate.flann.use_advanced_control = value == "true";
+                else if (section == "FLANN" && key == "algorithm")
+                    candidate.flann.algorithm = Img2MatchesParameterConverter::StringToFLANNAlgorithm(value);
+                else if (section == "FLANN" && key == "preset")
+                    candidate.flann.preset = Img2MatchesParameterConverter::StringToFLANNPreset(value);
+                else if (section == "FLANN" && key == "trees")
+                    candidate.flann.trees = std::stoi(value);
+                else if (section == "FLANN" && key == "checks")
+                    candidate.flann.checks = std::stoi(value);
+            }
+            catch (const std::exception &)
+            {
+                return false;
+            }
+        }
+        candidate.label = "file " + path;
+        return true;
+    }
+
+} // namespace PluginMethods
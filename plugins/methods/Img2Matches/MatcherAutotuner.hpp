@@ -0,0 +1,104 @@
+/**
+ * @file MatcherAutotuner.hpp
+ * @brief 匹配器与参数自动调优（在满足召回率目标的前提下选择最快配置）
+ * @copyright Copyright (c) 2024 PoSDK
+ */
+
+#pragma once
+
+#include "Img2MatchesParams.hpp"
+#include <opencv2/core.hpp>
+#include <string>
+#include <vector>
+
+namespace PluginMethods
+{
+    /**
+     * @brief 候选匹配配置
+     */
+    struct MatcherCandidate
+    {
+        MatcherType matcher_type = MatcherType::FLANN;
+        float ratio_thresh = 0.8f;
+        FLANNParameters flann; // 仅FLANN候选使用
+        std::string label;     // 日志中显示的名称，如 "FLANN(trees=8,checks=64) r=0.75"
+    };
+
+    /**
+     * @brief 候选配置在抽样视图对上的测量结果
+     */
+    struct MatcherCandidateResult
+    {
+        MatcherCandidate candidate;
+        double recall = 0.0;            // 相对暴力匹配参考的平均召回率
+        double precision = 0.0;         // 候选匹配中属于参考匹配的比例
+        double sample_seconds = 0.0;    // 抽样视图对上的总匹配时间
+        double predicted_seconds = 0.0; // 代价模型预测的全量匹配时间
+        bool feasible = false;          // 是否满足召回率/精度要求
+    };
+
+    /**
+     * @brief 匹配时间代价模型 t = c_product * n_i * n_j + c_linear * (n_i + n_j) + c_const
+     *
+     * n_i/n_j为视图对两侧的描述子数量；乘积项对应暴力/近邻搜索，线性项对应建索引和哈希。
+     */
+    struct MatchCostModel
+    {
+        double c_product = 0.0;
+        double c_linear = 0.0;
+        double c_const = 0.0;
+
+        double Predict(double n_i, double n_j) const;
+
+        /**
+         * @brief 由(n_i, n_j, 秒)样本最小二乘拟合，系数非负；样本不足时退化为按乘积比例缩放
+         */
+        static MatchCostModel Fit(const std::vector<cv::Vec3d> &samples);
+    };
+
+    /**
+     * @brief 匹配器自动调优器
+     *
+     * 在少量随机抽样的视图对上，用每个候选配置匹配并计时，以精确暴力匹配（配置的ratio_thresh）
+     * 为参考计算召回率；再按描述子数量拟合代价模型，预测全量视图对的匹配时间，
+     * 选出满足召回率目标且预测时间最短的配置。
+     */
+    class MatcherAutotuner
+    {
+    public:
+        /**
+         * @brief 构建候选配置
+         * @param descriptor_type 描述子类型（CV_32F或CV_8U）
+         * @param ratios 参与调优的比率阈值
+         * @param base_flann 当前FLANN参数（候选在其基础上修改trees/checks）
+         * @param include_lightglue 是否加入LightGlue候选
+         */
+        static std::vector<MatcherCandidate> BuildCandidates(int descriptor_type,
+                                                             const std::vector<float> &ratios,
+                                                             const FLANNParameters &base_flann,
+                                                             bool include_lightglue);
+
+        /**
+         * @brief 解析逗号分隔的比率阈值列表（非法值被忽略）
+         */
+        static std::vector<float> ParseRatios(const std::string &text, float fallback);
+
+        /**
+         * @brief 选择满足要求且预测时间最短的候选
+         * @return 结果下标；没有满足要求的候选时返回召回率最高者
+         */
+        static size_t SelectBest(std::vector<MatcherCandidateResult> &results,
+                                 double recall_target, double min_precision);
+
+        /**
+         * @brief 将选中的配置写为ini片段（[method_img2matches]与[FLANN]节），可直接合并到配置文件
+         */
+        static bool WriteConfig(const std::string &path, const MatcherCandidate &candidate);
+
+        /**
+         * @brief 读取WriteConfig写出的配置（未出现的键保持candidate中的原值）
+         */
+        static bool ReadConfig(const std::string &path, MatcherCandidate &candidate);
+    };
+
+} // namespace PluginMethods
@@ -0,0 +1,443 @@
+/**
+ * @file SpatialPairSelector.cpp
+ * @brief 基于GPS/位姿先验的空间视图对选择实现
+ * @copyright Copyright (c) 2024 PoSDK
+ */
+
+#include "SpatialPairSelector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <set>
+#include <sstream>
+
+namespace PluginMethods
+{
+    namespace
+    {
+        constexpr double kPi = 3.14159265358979323846;
+        constexpr double kDegToRad = kPi / 180.0;
+
+        // ===== 最小EXIF GPS解析（JPEG APP1 / TIFF IFD）=====
+
+        class TiffReader
+        {
+        public:
+            TiffReader(const uint8_t *data, size_t size, bool little_endian)
+                : data_(data), size_(size), little_endian_(little_endian) {}
+
+            bool U16(size_t offset, uint16_t &value) const
+            {
+                if (offset + 2 > size_)
+                    return false;
+                value = little_endian_ ? static_cast<uint16_t>(data_[offset] | (data_[offset + 1] << 8))
+                                       : static_cast<uint16_t>((data_[offset] << 8) | data_[offset + 1]);
+                return true;
+            }
+
+            bool U32(size_t offset, uint32_t &value) const
+            {
+                if (offset + 4 > size_)
+                    return false;
+                const uint8_t *p = data_ + offset;
+                value = little_endian_ ? (uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24))
+                                       : ((uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]));
+                return true;
+            }
+
+            bool Rational(size_t offset, double &value) const
+            {
+                uint32_t num = 0, den = 0;
+                if (!U32(offset, num) || !U32(offset + 4, den) || den == 0)
+                    return false;
+                value = static_cast<double>(num) / den;
+                return true;
+            }
+
+            uint8_t Byte(size_t offset) const { return offset < size_ ? data_[offset] : 0; }
+
+        private:
+            const uint8_t *data_;
+            size_t size_;
+            bool little_endian_;
+        };
+
+        /**
+         * @brief 在IFD中查找标签，返回值字段的偏移（内联值为条目内偏移，否则为指向的数据偏移）
+         */
+        bool FindTag(const TiffReader &tiff, uint32_t ifd_offset, uint16_t tag,
+                     uint32_t &value_offset, uint32_t &count)
+        {
+            uint16_t num_entries = 0;
+            if (!tiff.U16(ifd_offset, num_entries))
+                return false;
+
+            for (uint16_t e = 0; e < num_entries; ++e)
+            {
+                const size_t entry = ifd_offset + 2 + static_cast<size_t>(e) * 12;
+                uint16_t entry_tag = 0, type = 0;
+                if (!tiff.U16(entry, entry_tag) || !tiff.U16(entry + 2, type) || !tiff.U32(entry + 4, count))
+                    return false;
+                if (entry_tag != tag)
+                    continue;
+
+                static const uint32_t kTypeSizes[] = {0, 1, 1, 2, 4, 8, 1, 1, 2, 4, 8, 4, 8};
+                const uint32_t type_size = type < 13 ? kTypeSizes[type] : 0;
+                if (type_size * count <= 4)
+                {
+                    value_offset = static_cast<uint32_t>(entry + 8);
+                }
+                else if (!tiff.U32(entry + 8, value_offset))
+                {
+                    return false;
+                }
+                return true;
+            }
+            return false;
+        }
+
+        bool ReadDegrees(const TiffReader &tiff, uint32_t gps_ifd, uint16_t tag, double &degrees)
+        {
+            uint32_t offset = 0, count = 0;
+            double d = 0.0, m = 0.0, s = 0.0;
+            if (!FindTag(tiff, gps_ifd, tag, offset, count) || count < 3 ||
+                !tiff.Rational(offset, d) || !tiff.Rational(offset + 8, m) || !tiff.Rational(offset + 16, s))
+            {
+                return false;
+            }
+            degrees = d + m / 60.0 + s / 3600.0;
+            return true;
+        }
+
+        bool ParseExifGPS(const uint8_t *tiff_data, size_t tiff_size, GeoPrior &prior)
+        {
+            if (tiff_size < 8)
+                return false;
+            const bool little_endian = tiff_data[0] == 'I' && tiff_data[1] == 'I';
+            if (!little_endian && !(tiff_data[0] == 'M' && tiff_data[1] == 'M'))
+                return false;
+
+            TiffReader tiff(tiff_data, tiff_size, little_endian);
+            uint32_t ifd0 = 0, gps_ifd = 0, count = 0, value_offset = 0;
+            if (!tiff.U32(4, ifd0) || !FindTag(tiff, ifd0, 0x8825, value_offset, count) ||
+                !tiff.U32(value_offset, gps_ifd))
+            {
+                return false;
+            }
+
+            double latitude = 0.0, longitude = 0.0;
+            if (!ReadDegrees(tiff, gps_ifd, 0x0002, latitude) || !ReadDegrees(tiff, gps_ifd, 0x0004, longitude))
+                return false;
+
+            if (FindTag(tiff, gps_ifd, 0x0001, value_offset, count) && tiff.Byte(value_offset) == 'S')
+                latitude = -latitude;
+            if (FindTag(tiff, gps_ifd, 0x0003, value_offset, count) && tiff.Byte(value_offset) == 'W')
+                longitude = -longitude;
+
+            prior = GeoPrior();
+            prior.valid = true;
+            prior.latitude = latitude;
+            prior.longitude = longitude;
+
+            double altitude = 0.0;
+            if (FindTag(tiff, gps_ifd, 0x0006, value_offset, count) && tiff.Rational(value_offset, altitude))
+            {
+                const bool below_sea_level = FindTag(tiff, gps_ifd, 0x0005, value_offset, count) && tiff.Byte(value_offset) == 1;
+                prior.altitude = below_sea_level ? -altitude : altitude;
+            }
+
+            double heading = 0.0;
+            if (FindTag(tiff, gps_ifd, 0x0011, value_offset, count) && tiff.Rational(value_offset, heading))
+            {
+                prior.has_heading = true;
+                prior.heading_deg = heading;
+            }
+            return true;
+        }
+
+        // ===== 3D k-d树（中位数划分，精确kNN/半径查询）=====
+
+        class KdTree3D
+        {
+        public:
+            explicit KdTree3D(const std::vector<std::array<double, 3>> &points)
+                : points_(points), order_(points.size())
+            {
+                std::iota(order_.begin(), order_.end(), 0);
+                Build(0, order_.size(), 0);
+            }
+
+            void Knn(const std::array<double, 3> &query, size_t k, std::vector<std::pair<double, size_t>> &result) const
+            {
+                result.clear();
+                if (k == 0)
+                    return;
+                KnnRecursive(0, order_.size(), 0, query, k, result);
+                std::sort(result.begin(), result.end());
+            }
+
+            void Radius(const std::array<double, 3> &query, double radius, std::vector<size_t> &result) const
+            {
+                result.clear();
+                RadiusRecursive(0, order_.size(), 0, query, radius * radius, result);
+                std::sort(result.begin(), result.end());
+            }
+
+        private:
+            static double SquaredDistance(const std::array<double, 3> &a, const std::array<double, 3> &b)
+            {
+                const double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+                return dx * dx + dy * dy + dz * dz;
+            }
+
+            void Build(size_t begin, size_t end, int axis)
+            {
+                if (end - begin <= 1)
+                    return;
+                const size_t mid = begin + (end - begin) / 2;
+                std::nth_element(order_.begin() + begin, order_.begin() + mid, order_.begin() + end,
+                                 [&](size_t a, size_t b)
+                                 {
+                                     return points_[a][axis] < points_[b][axis] ||
+                                            (points_[a][axis] == points_[b][axis] && a < b);
+                                 });
+                Build(begin, mid, (axis + 1) % 3);
+                Build(mid + 1, end, (axis + 1) % 3);
+            }
+
+            void KnnRecursive(size_t begin, size_t end, int axis, const std::array<double, 3> &query,
+                              size_t k, std::vector<std::pair<double, size_t>> &heap) const
+            {
+                if (begin >= end)
+                    return;
+                const size_t mid = begin + (end - begin) / 2;
+                const size_t idx = order_[mid];
+
+                // 最大堆保存当前k个最近点（距离相同时按索引，保证确定性）
+                const std::pair<double, size_t> candidate{SquaredDistance(points_[idx], query), idx};
+                if (heap.size() < k)
+                {
+                    heap.push_back(candidate);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (candidate < heap.front())
+                {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = candidate;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+
+                const double delta = query[axis] - points_[idx][axis];
+                const int next_axis = (axis + 1) % 3;
+                const bool go_left = delta <= 0.0;
+                if (go_left)
+                    KnnRecursive(begin, mid, next_axis, query, k, heap);
+                else
+                    KnnRecursive(mid + 1, end, next_axis, query, k, heap);
+
+                if (heap.size() < k || delta * delta <= heap.front().first)
+                {
+                    if (go_left)
+                        KnnRecursive(mid + 1, end, next_axis, query, k, heap);
+                    else
+                        KnnRecursive(begin, mid, next_axis, query, k, heap);
+                }
+            }
+
+            void RadiusRecursive(size_t begin, size_t end, int axis, const std::array<double, 3> &query,
+                                 double radius_sq, std::vector<size_t> &result) const
+            {
+                if (begin >= end)
+                    return;
+                const size_t mid = begin + (end - begin) / 2;
+                const size_t idx = order_[mid];
+                if (SquaredDistance(points_[idx], query) <= radius_sq)
+                    result.push_back(idx);
+
+                const double delta = query[axis] - points_[idx][axis];
+                const int next_axis = (axis + 1) % 3;
+                if (delta <= 0.0 || delta * delta <= radius_sq)
+                    RadiusRecursive(begin, mid, next_axis, query, radius_sq, result);
+                if (delta >= 0.0 || delta * delta <= radius_sq)
+                    RadiusRecursive(mid + 1, end, next_axis, query, radius_sq, result);
+            }
+
+            const std::vector<std::array<double, 3>> &points_;
+            std::vector<size_t> order_;
+        };
+    } // namespace
+
+    bool SpatialPairSelector::ReadExifGPS(const std::string &image_path, GeoPrior &prior)
+    {
+        std::ifstream file(image_path, std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        uint8_t soi[2] = {0, 0};
+        if (!file.read(reinterpret_cast<char *>(soi), 2) || soi[0] != 0xFF || soi[1] != 0xD8)
+            return false; // 仅支持JPEG
+
+        // 遍历JPEG段，直到找到Exif APP1或图像数据开始
+        while (file)
+        {
+            uint8_t marker[2] = {0, 0};
+            if (!file.read(reinterpret_cast<char *>(marker), 2) || marker[0] != 0xFF)
+                return false;
+            if (marker[1] == 0xDA || marker[1] == 0xD9)
+                return false; // SOS/EOI: 无EXIF
+
+            uint8_t length_bytes[2] = {0, 0};
+            if (!file.read(reinterpret_cast<char *>(length_bytes), 2))
+                return false;
+            const size_t length = (static_cast<size_t>(length_bytes[0]) << 8) | length_bytes[1];
+            if (length < 2)
+                return false;
+
+            std::vector<uint8_t> segment(length - 2);
+            if (!file.read(reinterpret_cast<char *>(segment.data()), static_cast<std::streamsize>(segment.size())))
+                return false;
+
+            if (marker[1] == 0xE1 && segment.size() > 6 &&
+                std::equal(segment.begin(), segment.begin() + 6, "Exif\0\0"))
+            {
+                return ParseExifGPS(segment.data() + 6, segment.size() - 6, prior);
+            }
+        }
+        return false;
+    }
+
+    bool SpatialPairSelector::LoadPriorFile(const std::string &path, std::unordered_map<std::string, GeoPrior> &priors)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+            return false;
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::replace(line.begin(), line.end(), ',', ' ');
+
+            std::istringstream iss(line);
+            std::string name;
+            GeoPrior prior;
+            if (!(iss >> name >> prior.latitude >> prior.longitude >> prior.altitude))
+                continue;
+            prior.valid = true;
+            if (iss >> prior.heading_deg)
+                prior.has_heading = true;
+
+            priors[std::filesystem::path(name).filename().string()] = prior;
+        }
+        return true;
+    }
+
+    std::array<double, 3> SpatialPairSelector::GeodeticToENU(const GeoPrior &prior, const GeoPrior &reference)
+    {
+        // WGS84椭球参数
+        constexpr double a = 6378137.0;
+        constexpr double f = 1.0 / 298.257223563;
+        constexpr double e2 = f * (2.0 - f);
+
+        auto to_ecef = [&](const GeoPrior &p)
+        {
+            const double lat = p.latitude * kDegToRad;
+            const double lon = p.longitude * kDegToRad;
+            const double n = a / std::sqrt(1.0 - e2 * std::sin(lat) * std::sin(lat));
+            return std::array<double, 3>{(n + p.altitude) * std::cos(lat) * std::cos(lon),
+                                         (n + p.altitude) * std::cos(lat) * std::sin(lon),
+                                         (n * (1.0 - e2) + p.altitude) * std::sin(lat)};
+        };
+
+        const auto ecef = to_ecef(prior);
+        const auto ref = to_ecef(reference);
+        const double dx = ecef[0] - ref[0], dy = ecef[1] - ref[1], dz = ecef[2] - ref[2];
+
+        const double lat0 = reference.latitude * kDegToRad;
+        const double lon0 = reference.longitude * kDegToRad;
+        const double sin_lat = std::sin(lat0), cos_lat = std::cos(lat0);
+        const double sin_lon = std::sin(lon0), cos_lon = std::cos(lon0);
+
+        return {-sin_lon * dx + cos_lon * dy,
+                -sin_lat * cos_lon * dx - sin_lat * sin_lon * dy + cos_lat * dz,
+                cos_lat * cos_lon * dx + cos_lat * sin_lon * dy + sin_lat * dz};
+    }
+
+    bool SpatialPairSelector::HeadingOverlaps(const GeoPrior &a, const GeoPrior &b) const
+    {
+        if (!options_.use_heading_overlap || !a.has_heading || !b.has_heading)
+            return true;
+        double diff = std::fmod(std::fabs(a.heading_deg - b.heading_deg), 360.0);
+        if (diff > 180.0)
+            diff = 360.0 - diff;
+        return diff <= options_.fov_deg;
+    }
+
+    std::vector<std::pair<size_t, size_t>> SpatialPairSelector::SelectPairs(const std::vector<GeoPrior> &priors) const
+    {
+        std::vector<size_t> located;   // 有先验的视图
+        std::vector<size_t> unlocated; // 无先验的视图
+        for (size_t i = 0; i < priors.size(); ++i)
+        {
+            (priors[i].valid ? located : unlocated).push_back(i);
+        }
+
+        std::set<std::pair<size_t, size_t>> pairs;
+        auto add_pair = [&](size_t a, size_t b)
+        {
+            if (a != b)
+                pairs.emplace(std::min(a, b), std::max(a, b));
+        };
+
+        if (!located.empty())
+        {
+            const GeoPrior &reference = priors[located.front()];
+            std::vector<std::array<double, 3>> positions;
+            positions.reserve(located.size());
+            for (size_t idx : located)
+            {
+                positions.push_back(GeodeticToENU(priors[idx], reference));
+            }
+
+            KdTree3D tree(positions);
+            const bool radius_mode = options_.mode == "radius";
+            std::vector<std::pair<double, size_t>> knn;
+            std::vector<size_t> neighbours;
+            for (size_t n = 0; n < located.size(); ++n)
+            {
+                if (radius_mode)
+                {
+                    tree.Radius(positions[n], options_.radius, neighbours);
+                }
+                else
+                {
+                    // k+1：结果包含自身
+                    tree.Knn(positions[n], options_.k + 1, knn);
+                    neighbours.clear();
+                    for (const auto &entry : knn)
+                        neighbours.push_back(entry.second);
+                }
+
+                for (size_t m : neighbours)
+                {
+                    if (m != n && HeadingOverlaps(priors[located[n]], priors[located[m]]))
+                        add_pair(located[n], located[m]);
+                }
+            }
+        }
+
+        // 缺少先验的视图与所有视图配对
+        for (size_t u : unlocated)
+        {
+            for (size_t v = 0; v < priors.size(); ++v)
+                add_pair(u, v);
+        }
+
+        return std::vector<std::pair<size_t, size_t>>(pairs.begin(), pairs.end());
+    }
+
+} // namespace PluginMethods
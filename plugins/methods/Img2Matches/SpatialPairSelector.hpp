@@ -0,0 +1,91 @@
+/**
+ * @file SpatialPairSelector.hpp
+ * @brief 基于GPS/位姿先验的空间视图对选择（航拍数据集）
+ * @copyright Copyright (c) 2024 PoSDK
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace PluginMethods
+{
+    /**
+     * @brief 单幅图像的地理位置先验
+     */
+    struct GeoPrior
+    {
+        bool valid = false;
+        double latitude = 0.0;  // 纬度（度）
+        double longitude = 0.0; // 经度（度）
+        double altitude = 0.0;  // 椭球高（米）
+        bool has_heading = false;
+        double heading_deg = 0.0; // 航向角（度，正北为0，顺时针）
+    };
+
+    /**
+     * @brief 空间视图对选择器
+     *
+     * 将GPS先验转换到局部ENU坐标系并建立3D k-d树，按k近邻或半径选择候选视图对，
+     * 可选地用航向/视场重叠测试进一步过滤。候选对数量约与图像数成线性关系，
+     * 替代全对（平方级）匹配。缺少先验的视图与所有视图配对（保守处理）。
+     */
+    class SpatialPairSelector
+    {
+    public:
+        /**
+         * @brief 选择参数
+         */
+        struct Options
+        {
+            std::string mode = "knn";         // knn | radius
+            size_t k = 10;                    // knn模式下的近邻数
+            double radius = 50.0;             // radius模式下的搜索半径（米）
+            bool use_heading_overlap = false; // 是否启用航向/视场重叠测试
+            double fov_deg = 60.0;            // 相机水平视场角（度），航向差超过该值视为无重叠
+        };
+
+        explicit SpatialPairSelector(const Options &options) : options_(options) {}
+
+        /**
+         * @brief 从JPEG EXIF读取GPS信息（纬度/经度/高度/航向）
+         * @param image_path 图像路径
+         * @param prior 输出先验
+         * @return 是否读取到有效GPS
+         */
+        static bool ReadExifGPS(const std::string &image_path, GeoPrior &prior);
+
+        /**
+         * @brief 从文本文件加载位姿先验
+         * @details 每行: image_name latitude longitude altitude [heading_deg]，'#'开头为注释，
+         *          image_name按文件名（不含目录）匹配
+         * @param path 先验文件路径
+         * @param priors 输出：文件名 -> 先验
+         * @return 是否加载成功
+         */
+        static bool LoadPriorFile(const std::string &path, std::unordered_map<std::string, GeoPrior> &priors);
+
+        /**
+         * @brief WGS84经纬高转换为以reference为原点的局部ENU坐标（米）
+         */
+        static std::array<double, 3> GeodeticToENU(const GeoPrior &prior, const GeoPrior &reference);
+
+        /**
+         * @brief 选择候选视图对
+         * @param priors 与视图索引对齐的先验
+         * @return 候选视图对(i, j)，i < j，按字典序排列
+         */
+        std::vector<std::pair<size_t, size_t>> SelectPairs(const std::vector<GeoPrior> &priors) const;
+
+    private:
+        bool HeadingOverlaps(const GeoPrior &a, const GeoPrior &b) const;
+
+        Options options_;
+    };
+
+} // namespace PluginMethods
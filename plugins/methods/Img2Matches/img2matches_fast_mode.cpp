@@ -124,6 +124,13 @@ namespace PluginMethods
                     ExtractNewFeatures(image_paths_ptr, features_info_ptr, all_keypoints,
                                        all_descriptors, all_view_ids, all_image_paths, all_images_ptr);
                 }
+
+                // Descriptor post-processing: PCA after RootSIFT | 描述子后处理：RootSIFT之后的PCA降维
+                if (params_.descriptor_reduction.enable_pca)
+                {
+                    PROFILER_STAGE("Descriptor Reduction");
+                    ApplyDescriptorReduction(all_descriptors);
+                }
                 PROFILER_END();
                 // Print profiling statistics | 打印性能分析统计
                 if (SHOULD_LOG(DEBUG))
@@ -134,6 +141,19 @@ namespace PluginMethods
             LOG_INFO_ZH << "========== 特征提取完成，开始匹配阶段 ==========";
             LOG_INFO_EN << "========== Feature Extraction Complete, Starting Matching ==========";
 
+            // Candidate pairs from GPS / pose priors | 基于GPS/位姿先验的候选视图对
+            selected_pairs_.reset();
+            if (params_.pair_selection.enable_spatial)
+            {
+                SelectSpatialPairs(all_image_paths);
+            }
+
+            // Matcher autotuning on sampled pairs | 在抽样视图对上自动调优匹配器
+            if (params_.autotune.enable)
+            {
+                AutotuneMatcher(all_descriptors, all_view_ids, all_keypoints, all_images_ptr);
+            }
+
             // 6. Perform pairwise matching (core computation step) | 执行全对匹配（核心计算步骤）
             size_t successful_pairs = 0;
 
@@ -142,7 +162,18 @@ namespace PluginMethods
 
                 POSDK_START(enable_profiling_, metrics_config);
                 PROFILER_STAGE("Matching");
-                if (params_.base.num_threads > 1)
+                if (params_.sharding.shard_count > 1 && params_.sharding.shard_index < 0)
+                {
+                    LOG_WARNING_ZH << "shard_count>1但未设置shard_index，不分片匹配";
+                    LOG_WARNING_EN << "shard_count>1 without a shard_index, matching unsharded";
+                }
+                if (params_.sharding.shard_count > 1 && params_.sharding.shard_index >= 0)
+                {
+                    LOG_INFO_ZH << "使用分片多进程匹配 (shard_count=" << params_.sharding.shard_count << ")";
+                    LOG_INFO_EN << "Using sharded multi-process matching (shard_count=" << params_.sharding.shard_count << ")";
+                    successful_pairs = PerformShardedMatching(all_descriptors, all_view_ids, matches_ptr, &all_keypoints, all_images_ptr);
+                }
+                else if (params_.base.num_threads > 1)
                 {
                     LOG_INFO_ZH << "使用多线程匹配版本 (num_threads=" << params_.base.num_threads << ")";
                     LOG_INFO_EN << "Using multi-threaded matching version (num_threads=" << params_.base.num_threads << ")";
@@ -7,6 +7,7 @@
 #include "img2matches_pipeline.hpp"
 #include "FASTCASCADEHASHINGL2.hpp"
 #include "LightGlueMatcher.hpp"
+#include "MatcherAutotuner.hpp"
 #include <po_core/types.hpp>
 #include <po_core/po_logger.hpp>
 #include <opencv2/features2d.hpp>
@@ -17,9 +18,12 @@
 #include <regex>
 #include <algorithm>
 #include <iomanip>
+#include <map>
 #include <sstream>
 #include <atomic>
+#include <chrono>
 #include <mutex>
+#include <random>
 
 #ifdef USE_OPENMP
 #include <omp.h>
@@ -541,6 +545,23 @@ namespace PluginMethods
         const size_t total_views = features_info_ptr->size();
         size_t processed_views = 0;
         size_t last_progress_milestone = 0; // Track last shown progress milestone | 跟踪上次显示的进度里程碑
+        std::atomic<uint64_t> &images_metric = MetricImagesProcessed("feature_extraction");
+
+        // Prefetch the images of views with valid features, in loop order | 按循环顺序预读有效特征视图的图像
+        auto has_valid_features = [](const auto &image_feature)
+        {
+            return image_feature && !image_feature->GetFeaturePoints().empty() && !image_feature->GetImagePath().empty();
+        };
+        std::vector<std::string> prefetch_paths;
+        for (IndexT view_id = 0; view_id < features_info_ptr->size(); ++view_id)
+        {
+            if (has_valid_features((*features_info_ptr)[view_id]))
+            {
+                prefetch_paths.push_back((*features_info_ptr)[view_id]->GetImagePath());
+            }
+        }
+        auto prefetcher = CreateImagePrefetcher(std::move(prefetch_paths), {cv::IMREAD_GRAYSCALE});
+        size_t prefetch_index = 0;
 
         // FeaturesInfo is continuous, iterate directly | FeaturesInfo是连续的，直接遍历即可
         for (IndexT view_id = 0; view_id < features_info_ptr->size(); ++view_id)
@@ -548,7 +569,7 @@ namespace PluginMethods
             const auto &image_feature = (*features_info_ptr)[view_id];
 
             // Check if feature information is valid | 检查特征信息是否有效
-            if (!image_feature || image_feature->GetFeaturePoints().empty() || image_feature->GetImagePath().empty())
+            if (!has_valid_features(image_feature))
             {
                 LOG_WARNING_ZH << "视图ID " << view_id << " 的特征为空";
                 LOG_WARNING_ZH << "Empty features for view_id " << view_id;
@@ -556,7 +577,19 @@ namespace PluginMethods
             }
 
             // Read image | 读取图像
-            cv::Mat img = cv::imread(image_feature->GetImagePath(), cv::IMREAD_GRAYSCALE);
+            cv::Mat img;
+            if (prefetcher)
+            {
+                auto prefetched = prefetcher->Take(prefetch_index++);
+                if (prefetched.Ok())
+                {
+                    img = prefetched.decoded[0];
+                }
+            }
+            else
+            {
+                img = cv::imread(image_feature->GetImagePath(), cv::IMREAD_GRAYSCALE);
+            }
             if (img.empty())
             {
                 LOG_WARNING_ZH << "无法加载图像: " << image_feature->GetImagePath();
@@ -678,6 +711,7 @@ namespace PluginMethods
 
             // Update progress | 更新进度
             processed_views++;
+            images_metric.fetch_add(1, std::memory_order_relaxed);
             // Show progress at 20% intervals | 按20%间隔显示进度
             size_t current_milestone = (processed_views * 5) / total_views; // 0-5 represents 0%, 20%, 40%, 60%, 80%, 100%
             if (current_milestone > last_progress_milestone || processed_views == total_views)
@@ -688,6 +722,25 @@ namespace PluginMethods
         }
     }
 
+    std::unique_ptr<common::PrefetchingImageReader> Img2MatchesPipeline::CreateImagePrefetcher(
+        std::vector<std::string> paths, std::vector<int> decode_flags) const
+    {
+        if (params_.base.io_prefetch_depth <= 0 || paths.empty())
+        {
+            return nullptr;
+        }
+
+        common::PrefetchingImageReader::Options options;
+        options.prefetch_depth = static_cast<size_t>(params_.base.io_prefetch_depth);
+        options.num_io_threads = 2;
+        options.use_io_uring = params_.base.use_io_uring;
+
+        auto prefetcher = std::make_unique<common::PrefetchingImageReader>(std::move(paths), std::move(decode_flags), options);
+        LOG_DEBUG_ZH << "图像预读: 深度=" << options.prefetch_depth << ", 后端=" << prefetcher->BackendName();
+        LOG_DEBUG_EN << "Image prefetch: depth=" << options.prefetch_depth << ", backend=" << prefetcher->BackendName();
+        return prefetcher;
+    }
+
     void Img2MatchesPipeline::ExtractNewFeatures(
         ImagePathsPtr image_paths_ptr,
         FeaturesInfoPtr features_info_ptr,
@@ -740,6 +793,7 @@ namespace PluginMethods
         std::atomic<size_t> processed_views(0);
         size_t last_progress_milestone = 0; // Track last shown progress milestone | 跟踪上次显示的进度里程碑
         std::mutex progress_mutex;          // Mutex for thread-safe progress reporting | 进度报告的线程安全互斥锁
+        std::atomic<uint64_t> &images_metric = MetricImagesProcessed("feature_extraction");
 
         // Prepare thread-safe containers for results | 准备线程安全的结果容器
         all_keypoints.resize(valid_image_pairs.size());
@@ -769,21 +823,55 @@ namespace PluginMethods
         num_threads = 1;
 #endif
 
+        // Read ahead of the extraction threads; grayscale and color are decoded from one read
+        // 在提取线程之前预读；灰度图和彩色图从同一次读取中解码
+        std::vector<std::string> prefetch_paths;
+        prefetch_paths.reserve(valid_image_pairs.size());
+        for (const auto &[filename_number, img_path] : valid_image_pairs)
+        {
+            prefetch_paths.push_back(img_path);
+        }
+        auto prefetcher = CreateImagePrefetcher(std::move(prefetch_paths), {cv::IMREAD_GRAYSCALE, cv::IMREAD_COLOR});
+
+        // Limit concurrently extracted views under memory pressure | 内存紧张时限制同时提取的视图数
+        auto memory_governor = CreateMemoryGovernor(num_threads);
+
         // Re-extract all features and descriptors, using continuous view_id | 重新提取所有特征和描述子，使用连续的view_id
 #ifdef USE_OPENMP
-#pragma omp parallel for schedule(dynamic) shared(valid_image_pairs, all_keypoints, all_descriptors, all_view_ids, all_image_paths, all_images, features_info_ptr, processed_views, progress_mutex, last_progress_milestone, total_views)
+#pragma omp parallel for schedule(dynamic) shared(valid_image_pairs, all_keypoints, all_descriptors, all_view_ids, all_image_paths, all_images, features_info_ptr, processed_views, progress_mutex, last_progress_milestone, total_views, prefetcher, memory_governor)
 #endif
         for (IndexT view_id = 0; view_id < static_cast<IndexT>(valid_image_pairs.size()); ++view_id)
         {
             const std::string &img_path = valid_image_pairs[view_id].second;
 
-            // Read image | 读取图像
-            cv::Mat img = cv::imread(img_path, cv::IMREAD_GRAYSCALE);
+            // Read image (color is used for extracting RGB values at feature points)
+            // 读取图像（彩色图像用于提取特征点处的RGB值）
+            cv::Mat img;
+            cv::Mat img_color;
+            if (prefetcher)
+            {
+                auto prefetched = prefetcher->Take(view_id);
+                if (prefetched.Ok())
+                {
+                    img = prefetched.decoded[0];
+                    img_color = prefetched.decoded[1];
+                }
+            }
+            else
+            {
+                img = cv::imread(img_path, cv::IMREAD_GRAYSCALE);
+                if (!img.empty())
+                {
+                    img_color = cv::imread(img_path, cv::IMREAD_COLOR);
+                }
+            }
             if (img.empty())
                 continue;
 
-            // Read color image for extracting RGB values at feature points | 读取彩色图像以提取特征点处的RGB值
-            cv::Mat img_color = cv::imread(img_path, cv::IMREAD_COLOR);
+            // The slot is taken after the prefetcher read: Take() must stay in ascending order across threads
+            // 槽位在预读之后申请：各线程的Take()必须保持升序
+            common::MemoryGovernor::Slot memory_slot(*memory_governor);
+
             bool has_color_image = !img_color.empty();
 
             // 内存优化：只有LightGlue才需要缓存图像数据，SIFT+FLANN不需要
@@ -938,6 +1026,7 @@ namespace PluginMethods
 
             // Update progress with thread safety | 线程安全地更新进度
             size_t current_processed = processed_views.fetch_add(1) + 1;
+            images_metric.fetch_add(1, std::memory_order_relaxed);
 
             // Thread-safe progress reporting | 线程安全的进度报告
             {
@@ -950,6 +1039,7 @@ namespace PluginMethods
                 }
             }
         }
+        LogMemoryGovernorStats(*memory_governor);
 
         // 关键修复：重新组织数据以匹配旧版本的push_back行为
         // 确保数据访问索引与旧版本完全一致
@@ -1006,57 +1096,93 @@ namespace PluginMethods
         LOG_INFO_ZH << "开始对 " << all_view_ids.size() << " 个视图进行成对匹配";
         LOG_INFO_EN << "Starting pairwise matching for " << all_view_ids.size() << " views";
 
-        size_t total_pairs = 0;
+        std::vector<std::pair<size_t, size_t>> image_pairs = GetImagePairs(all_view_ids.size());
+        size_t total_pairs = image_pairs.size();
         size_t successful_pairs = 0;
 
-        for (size_t i = 0; i < all_view_ids.size(); ++i)
+        // Resume: replay journaled pairs, match only the rest | 断点续算：回放日志中的视图对，只匹配剩余部分
+        std::unique_ptr<common::PairJournal> journal =
+            OpenMatchingJournal(all_descriptors, all_keypoints, all_view_ids, image_pairs, matches_ptr, successful_pairs);
+
+        // Deadline mode: likely-overlapping pairs first, stop starting pairs once the budget expires
+        // 截止时间模式：可能重叠的视图对优先，预算耗尽后不再启动新视图对
+        const common::StageDeadline deadline(params_.deadline.time_budget_s);
+        const size_t min_pairs = params_.deadline.min_pairs > 0 ? params_.deadline.min_pairs : all_view_ids.size();
+        OrderPairsByPriority(image_pairs, all_descriptors);
+        std::vector<std::pair<size_t, size_t>> skipped_pairs;
+        std::atomic<uint64_t> &pairs_metric = MetricPairsProcessed("matching");
+        std::atomic<uint64_t> &cascade_hits = MetricCacheLookups("cascade_hashing_session", true);
+        std::atomic<uint64_t> &cascade_misses = MetricCacheLookups("cascade_hashing_session", false);
+
+        // FASTCASCADEHASHINGL2：与多线程路径相同的数据集级会话
+        std::unique_ptr<CascadeHashingSession> cascade_session = CreateCascadeHashingSession(all_descriptors, 1);
+
+        for (size_t pair_idx = 0; pair_idx < image_pairs.size(); ++pair_idx)
         {
-            for (size_t j = i + 1; j < all_view_ids.size(); ++j)
+            const auto &[i, j] = image_pairs[pair_idx];
+            if (pair_idx >= min_pairs && deadline.Expired())
             {
-                total_pairs++;
+                skipped_pairs.push_back(image_pairs[pair_idx]);
+                continue;
+            }
 
-                LOG_DEBUG_ZH << "匹配视图对 (" << all_view_ids[i] << ", " << all_view_ids[j] << ")";
-                LOG_DEBUG_EN << "Matching view pair (" << all_view_ids[i] << ", " << all_view_ids[j] << ")";
+            LOG_DEBUG_ZH << "匹配视图对 (" << all_view_ids[i] << ", " << all_view_ids[j] << ")";
+            LOG_DEBUG_EN << "Matching view pair (" << all_view_ids[i] << ", " << all_view_ids[j] << ")";
 
-                // Select matching method based on matcher type | 根据匹配器类型选择匹配方法
-                std::vector<cv::DMatch> matches;
-                if (params_.matching.matcher_type == MatcherType::LIGHTGLUE &&
-                    all_keypoints != nullptr && all_images != nullptr &&
-                    !all_keypoints->empty() && !all_images->empty() &&
-                    i < all_keypoints->size() && j < all_keypoints->size() &&
-                    i < all_images->size() && j < all_images->size())
-                {
-                    // Use LightGlue deep learning matcher | 使用LightGlue深度学习匹配器
-                    matches = MatchFeaturesWithLightGlue(
-                        (*all_images)[i], (*all_images)[j],
-                        (*all_keypoints)[i], (*all_keypoints)[j],
-                        all_descriptors[i], all_descriptors[j]);
-                }
-                else
-                {
-                    // Use traditional matcher (SIFT+FLANN) | 使用传统匹配器 (SIFT+FLANN)
-                    // 内存优化：传统匹配器不需要图像数据，只使用描述子
-                    matches = MatchFeatures(all_descriptors[i], all_descriptors[j]);
-                }
+            // Select matching method based on matcher type | 根据匹配器类型选择匹配方法
+            std::vector<cv::DMatch> matches;
+            if (params_.matching.matcher_type == MatcherType::LIGHTGLUE &&
+                all_keypoints != nullptr && all_images != nullptr &&
+                !all_keypoints->empty() && !all_images->empty() &&
+                i < all_keypoints->size() && j < all_keypoints->size() &&
+                i < all_images->size() && j < all_images->size())
+            {
+                // Use LightGlue deep learning matcher | 使用LightGlue深度学习匹配器
+                matches = MatchFeaturesWithLightGlue(
+                    (*all_images)[i], (*all_images)[j],
+                    (*all_keypoints)[i], (*all_keypoints)[j],
+                    all_descriptors[i], all_descriptors[j]);
+            }
+            else if (cascade_session &&
+                     cascade_session->MatchPair(i, j, matches, params_.matching.cross_check))
+            {
+                // Matched from pre-hashed views | 直接使用预哈希视图匹配
+                cascade_hits.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                if (cascade_session)
+                    cascade_misses.fetch_add(1, std::memory_order_relaxed);
+                // Use traditional matcher (SIFT+FLANN) | 使用传统匹配器 (SIFT+FLANN)
+                // 内存优化：传统匹配器不需要图像数据，只使用描述子
+                matches = MatchFeatures(all_descriptors[i], all_descriptors[j]);
+            }
+            JournalMatchedPair(journal.get(), all_view_ids[i], all_view_ids[j], matches);
 
-                if (!matches.empty())
-                {
-                    successful_pairs++;
-                    LOG_DEBUG_ZH << "视图对 (" << all_view_ids[i] << ", " << all_view_ids[j] << ") 找到 " << matches.size() << " 个匹配";
-                    LOG_DEBUG_EN << "Found " << matches.size() << " matches for view pair (" << all_view_ids[i] << ", " << all_view_ids[j] << ")";
+            if (!matches.empty())
+            {
+                successful_pairs++;
+                LOG_DEBUG_ZH << "视图对 (" << all_view_ids[i] << ", " << all_view_ids[j] << ") 找到 " << matches.size() << " 个匹配";
+                LOG_DEBUG_EN << "Found " << matches.size() << " matches for view pair (" << all_view_ids[i] << ", " << all_view_ids[j] << ")";
 
-                    // Convert and save matching results using correct view_id | 转换并保存匹配结果，使用正确的view_id
-                    OpenCVConverter::CVDMatch2Matches(matches,
-                                                      all_view_ids[i], all_view_ids[j], matches_ptr);
-                }
-                else
-                {
-                    LOG_DEBUG_ZH << "视图对 (" << all_view_ids[i] << ", " << all_view_ids[j] << ") 未找到匹配";
-                    LOG_DEBUG_EN << "No matches found for view pair (" << all_view_ids[i] << ", " << all_view_ids[j] << ")";
-                }
+                // Convert and save matching results using correct view_id | 转换并保存匹配结果，使用正确的view_id
+                OpenCVConverter::CVDMatch2Matches(matches,
+                                                  all_view_ids[i], all_view_ids[j], matches_ptr);
+            }
+            else
+            {
+                LOG_DEBUG_ZH << "视图对 (" << all_view_ids[i] << ", " << all_view_ids[j] << ") 未找到匹配";
+                LOG_DEBUG_EN << "No matches found for view pair (" << all_view_ids[i] << ", " << all_view_ids[j] << ")";
             }
+            pairs_metric.fetch_add(1, std::memory_order_relaxed);
         }
 
+        if (journal)
+        {
+            journal->Flush();
+        }
+        WriteSkippedPairs(skipped_pairs, all_view_ids, deadline, total_pairs);
+
         LOG_INFO_ZH << "匹配完成: " << successful_pairs << "/" << total_pairs << " 对视图有匹配结果";
         LOG_INFO_EN << "Matching completed: " << successful_pairs << "/" << total_pairs << " pairs have matches";
 
@@ -1074,24 +1200,31 @@ namespace PluginMethods
         LOG_INFO_ZH << "开始多线程对 " << all_view_ids.size() << " 个视图进行成对匹配";
         LOG_INFO_EN << "Starting multi-threaded pairwise matching for " << all_view_ids.size() << " views";
 
-        // Calculate total number of pairs | 计算总的匹配对数
+        // Generate image pairs for parallel processing (spatially selected or exhaustive) | 生成图像对用于并行处理（空间选择或全对）
         const size_t num_views = all_view_ids.size();
-        const size_t total_pairs_count = (num_views * (num_views - 1)) / 2;
-
-        // Generate all image pairs for parallel processing | 生成所有图像对用于并行处理
-        std::vector<std::pair<size_t, size_t>> image_pairs;
-        image_pairs.reserve(total_pairs_count);
-        for (size_t i = 0; i < num_views; ++i)
-        {
-            for (size_t j = i + 1; j < num_views; ++j)
-            {
-                image_pairs.emplace_back(i, j);
-            }
-        }
+        std::vector<std::pair<size_t, size_t>> image_pairs = GetImagePairs(num_views);
+        const size_t total_pairs_count = image_pairs.size();
+
+        // Resume: replay journaled pairs, match only the rest | 断点续算：回放日志中的视图对，只匹配剩余部分
+        size_t replayed_successful = 0;
+        std::unique_ptr<common::PairJournal> journal =
+            OpenMatchingJournal(all_descriptors, all_keypoints, all_view_ids, image_pairs, matches_ptr, replayed_successful);
+
+        // Deadline mode: likely-overlapping pairs first, stop starting pairs once the budget expires
+        // 截止时间模式：可能重叠的视图对优先，预算耗尽后不再启动新视图对
+        const common::StageDeadline deadline(params_.deadline.time_budget_s);
+        const size_t min_pairs = params_.deadline.min_pairs > 0 ? params_.deadline.min_pairs : num_views;
+        OrderPairsByPriority(image_pairs, all_descriptors);
+        std::vector<std::pair<size_t, size_t>> skipped_pairs;
+        std::mutex skipped_mutex;
+        std::unique_ptr<common::MemoryGovernor> memory_governor;
+        std::atomic<uint64_t> &pairs_metric = MetricPairsProcessed("matching");
+        std::atomic<uint64_t> &cascade_hits = MetricCacheLookups("cascade_hashing_session", true);
+        std::atomic<uint64_t> &cascade_misses = MetricCacheLookups("cascade_hashing_session", false);
 
         // Thread-safe progress tracking | 线程安全的进度跟踪
-        std::atomic<size_t> processed_pairs(0);
-        std::atomic<size_t> successful_pairs(0);
+        std::atomic<size_t> processed_pairs(total_pairs_count - image_pairs.size());
+        std::atomic<size_t> successful_pairs(replayed_successful);
         size_t last_progress_milestone = 0;
         std::mutex progress_mutex; // Mutex for thread-safe progress reporting | 进度报告的线程安全互斥锁
         std::mutex matches_mutex;  // Mutex for thread-safe matches writing | 匹配结果写入的线程安全互斥锁
@@ -1114,6 +1247,8 @@ namespace PluginMethods
         LOG_INFO_EN << "OpenMP not enabled, using single-threaded feature matching";
         num_threads = 1;
 #endif
+        // Limit concurrently matched pairs under memory pressure | 内存紧张时限制同时匹配的视图对数
+        memory_governor = CreateMemoryGovernor(num_threads);
 
         // 显示匹配器参数配置用于调试
         LOG_INFO_ZH << "多线程匹配器参数配置:";
@@ -1140,18 +1275,32 @@ namespace PluginMethods
             }
         }
 
+        // FASTCASCADEHASHINGL2：数据集级会话，全局零均值 + 每个视图只哈希一次
+        std::unique_ptr<CascadeHashingSession> cascade_session = CreateCascadeHashingSession(all_descriptors, num_threads);
+
         // 为确保FLANN匹配器的确定性结果，使用静态调度而非动态调度
         // 静态调度确保每次运行时任务分配给线程的顺序完全一致
+        // 截止时间模式下按块大小1轮转分配，使各线程都沿优先级顺序推进
         LOG_INFO_ZH << "使用静态调度确保多线程匹配的确定性结果";
         LOG_INFO_EN << "Using static scheduling for deterministic multi-threaded matching results";
 
         // Parallel matching of all image pairs | 并行匹配所有图像对
 #ifdef USE_OPENMP
-#pragma omp parallel for schedule(static) shared(image_pairs, all_descriptors, all_view_ids, all_keypoints, all_images, matches_ptr, processed_pairs, successful_pairs, progress_mutex, matches_mutex, flann_mutex, last_progress_milestone, total_pairs_count)
+        const int schedule_chunk = deadline.Enabled()
+                                       ? 1
+                                       : static_cast<int>(std::max<size_t>(1, (image_pairs.size() + num_threads - 1) / num_threads));
+#pragma omp parallel for schedule(static, schedule_chunk) shared(skipped_pairs, skipped_mutex, memory_governor, cascade_session, image_pairs, all_descriptors, all_view_ids, all_keypoints, all_images, matches_ptr, processed_pairs, successful_pairs, progress_mutex, matches_mutex, flann_mutex, last_progress_milestone, total_pairs_count)
 #endif
         for (size_t pair_idx = 0; pair_idx < image_pairs.size(); ++pair_idx)
         {
             const auto &[i, j] = image_pairs[pair_idx];
+            if (pair_idx >= min_pairs && deadline.Expired())
+            {
+                std::lock_guard<std::mutex> lock(skipped_mutex);
+                skipped_pairs.push_back(image_pairs[pair_idx]);
+                continue;
+            }
+            common::MemoryGovernor::Slot memory_slot(*memory_governor);
 
             LOG_DEBUG_ZH << "多线程匹配视图对 (" << all_view_ids[i] << ", " << all_view_ids[j] << ") - 特征数量: "
                          << all_descriptors[i].rows << "x" << all_descriptors[j].rows;
@@ -1182,13 +1331,22 @@ namespace PluginMethods
                     (*all_keypoints)[i], (*all_keypoints)[j],
                     all_descriptors[i], all_descriptors[j]);
             }
+            else if (cascade_session &&
+                     cascade_session->MatchPair(i, j, matches, params_.matching.cross_check))
+            {
+                // Matched from pre-hashed views | 直接使用预哈希视图匹配
+                cascade_hits.fetch_add(1, std::memory_order_relaxed);
+            }
             else
             {
+                if (cascade_session)
+                    cascade_misses.fetch_add(1, std::memory_order_relaxed);
                 // Use traditional matcher (SIFT+FLANN) | 使用传统匹配器 (SIFT+FLANN)
                 // 内存优化：传统匹配器不需要图像数据，只使用描述子
                 // 为确保多线程结果一致性，使用线程安全的匹配方法
                 matches = MatchFeaturesThreadSafe(all_descriptors[i], all_descriptors[j], all_view_ids[i], all_view_ids[j]);
             }
+            JournalMatchedPair(journal.get(), all_view_ids[i], all_view_ids[j], matches);
 
             // Thread-safe result processing | 线程安全的结果处理
             if (!matches.empty())
@@ -1212,6 +1370,7 @@ namespace PluginMethods
 
             // Update progress with thread safety | 线程安全地更新进度
             size_t current_processed = processed_pairs.fetch_add(1) + 1;
+            pairs_metric.fetch_add(1, std::memory_order_relaxed);
             size_t current_successful = successful_pairs.load();
 
             // Thread-safe progress reporting | 线程安全的进度报告
@@ -1227,6 +1386,13 @@ namespace PluginMethods
             }
         }
 
+        if (journal)
+        {
+            journal->Flush();
+        }
+        WriteSkippedPairs(skipped_pairs, all_view_ids, deadline, total_pairs_count);
+        LogMemoryGovernorStats(*memory_governor);
+
         size_t final_successful_pairs = successful_pairs.load();
         LOG_INFO_ZH << "多线程匹配完成: " << final_successful_pairs << "/" << total_pairs_count << " 对视图有匹配结果";
         LOG_INFO_EN << "Multi-threaded matching completed: " << final_successful_pairs << "/" << total_pairs_count << " pairs have matches";
@@ -1234,6 +1400,398 @@ namespace PluginMethods
         return final_successful_pairs;
     }
 
+    void Img2MatchesPipeline::SelectSpatialPairs(const std::vector<std::string> &all_image_paths)
+    {
+        selected_pairs_.reset();
+        const auto &selection = params_.pair_selection;
+
+        // 1. 收集先验：优先使用位姿先验文件，否则读取EXIF GPS
+        std::unordered_map<std::string, GeoPrior> file_priors;
+        if (!selection.pose_prior_file.empty() &&
+            !SpatialPairSelector::LoadPriorFile(selection.pose_prior_file, file_priors))
+        {
+            LOG_WARNING_ZH << "无法读取位姿先验文件: " << selection.pose_prior_file << "，改用EXIF GPS";
+            LOG_WARNING_EN << "Failed to read pose prior file: " << selection.pose_prior_file << ", using EXIF GPS instead";
+        }
+
+        std::vector<GeoPrior> priors(all_image_paths.size());
+        size_t num_located = 0;
+        for (size_t i = 0; i < all_image_paths.size(); ++i)
+        {
+            if (!file_priors.empty())
+            {
+                auto it = file_priors.find(std::filesystem::path(all_image_paths[i]).filename().string());
+                if (it != file_priors.end())
+                    priors[i] = it->second;
+            }
+            else
+            {
+                SpatialPairSelector::ReadExifGPS(all_image_paths[i], priors[i]);
+            }
+            num_located += priors[i].valid ? 1 : 0;
+        }
+
+        if (num_located < 2)
+        {
+            LOG_WARNING_ZH << "有效位置先验不足 (" << num_located << "/" << all_image_paths.size() << ")，使用全对匹配";
+            LOG_WARNING_EN << "Not enough position priors (" << num_located << "/" << all_image_paths.size() << "), using exhaustive matching";
+            return;
+        }
+
+        // 2. ENU + k-d树选择候选视图对
+        SpatialPairSelector::Options options;
+        options.mode = selection.mode;
+        options.k = selection.k;
+        options.radius = selection.radius;
+        options.use_heading_overlap = selection.use_heading_overlap;
+        options.fov_deg = selection.fov_deg;
+        selected_pairs_ = SpatialPairSelector(options).SelectPairs(priors);
+
+        const size_t num_views = all_image_paths.size();
+        const size_t exhaustive_pairs = num_views * (num_views - 1) / 2;
+        LOG_INFO_ZH << "空间视图对选择 (" << selection.mode << "): " << selected_pairs_->size() << "/" << exhaustive_pairs
+                    << " 对，位置先验: " << num_located << "/" << num_views;
+        LOG_INFO_EN << "Spatial pair selection (" << selection.mode << "): " << selected_pairs_->size() << "/" << exhaustive_pairs
+                    << " pairs, position priors: " << num_located << "/" << num_views;
+    }
+
+    std::vector<std::pair<size_t, size_t>> Img2MatchesPipeline::GetImagePairs(size_t num_views) const
+    {
+        std::vector<std::pair<size_t, size_t>> image_pairs;
+        if (selected_pairs_)
+        {
+            image_pairs = *selected_pairs_;
+        }
+        else
+        {
+            image_pairs.reserve(num_views > 1 ? num_views * (num_views - 1) / 2 : 0);
+            for (size_t i = 0; i < num_views; ++i)
+            {
+                for (size_t j = i + 1; j < num_views; ++j)
+                {
+                    image_pairs.emplace_back(i, j);
+                }
+            }
+        }
+
+        // Sharded matching: keep only the pairs of the active shard | 分片匹配：只保留当前分片的视图对
+        if (active_shard_ >= 0)
+        {
+            const size_t shard_count = params_.sharding.shard_count;
+            image_pairs.erase(std::remove_if(image_pairs.begin(), image_pairs.end(),
+                                             [&](const std::pair<size_t, size_t> &pair)
+                                             {
+                                                 return common::ShardOfPair(static_cast<IndexT>(pair.first),
+                                                                            static_cast<IndexT>(pair.second),
+                                                                            shard_count) != static_cast<size_t>(active_shard_);
+                                             }),
+                              image_pairs.end());
+        }
+        return image_pairs;
+    }
+
+    std::unique_ptr<CascadeHashingSession> Img2MatchesPipeline::CreateCascadeHashingSession(
+        const std::vector<cv::Mat> &all_descriptors, int num_threads) const
+    {
+        if (params_.matching.matcher_type != MatcherType::FASTCASCADEHASHINGL2 ||
+            !params_.matching.cascade_global_session)
+        {
+            return nullptr;
+        }
+
+        auto cascade_session = std::make_unique<CascadeHashingSession>(params_.matching.ratio_thresh);
+        if (!cascade_session->Build(all_descriptors, num_threads, params_.matching.cascade_spill_dir))
+        {
+            LOG_WARNING_ZH << "Cascade Hashing会话构建失败，回退到逐对哈希";
+            LOG_WARNING_EN << "Failed to build cascade hashing session, falling back to per-pair hashing";
+            return nullptr;
+        }
+        LOG_INFO_ZH << "Cascade Hashing会话: 已预哈希 " << cascade_session->GetNumHashedViews() << "/" << all_descriptors.size()
+                    << " 个视图" << (cascade_session->IsSpilled() ? "（已落盘）" : "（常驻内存）");
+        LOG_INFO_EN << "Cascade hashing session: pre-hashed " << cascade_session->GetNumHashedViews() << "/" << all_descriptors.size()
+                    << " views" << (cascade_session->IsSpilled() ? " (spilled to disk)" : " (resident)");
+        return cascade_session;
+    }
+
+    std::unique_ptr<common::MemoryGovernor> Img2MatchesPipeline::CreateMemoryGovernor(int num_threads) const
+    {
+        common::MemoryGovernorOptions options;
+        options.high_watermark = params_.memory_governor.high_watermark;
+        options.low_watermark = params_.memory_governor.low_watermark;
+        options.limit_bytes = static_cast<uint64_t>(params_.memory_governor.limit_mb) << 20;
+        options.max_active = static_cast<size_t>(std::max(1, num_threads));
+        auto governor = std::make_unique<common::MemoryGovernor>(options);
+        if (governor->Enabled())
+        {
+            LOG_INFO_ZH << "内存压力控制: 上限 " << (governor->Stats().limit_bytes >> 20) << " MB, 高水位 " << options.high_watermark;
+            LOG_INFO_EN << "Memory governor: limit " << (governor->Stats().limit_bytes >> 20) << " MB, high watermark " << options.high_watermark;
+        }
+        return governor;
+    }
+
+    void Img2MatchesPipeline::LogMemoryGovernorStats(const common::MemoryGovernor &governor)
+    {
+        if (!governor.Enabled())
+        {
+            return;
+        }
+        const common::MemoryGovernorStats stats = governor.Stats();
+        LOG_INFO_ZH << "内存压力控制: 峰值RSS " << (stats.peak_rss_bytes >> 20) << " MB, 最多同时运行 " << stats.peak_active
+                    << " 个任务, 等待 " << stats.throttled_waits << " 次";
+        LOG_INFO_EN << "Memory governor: peak RSS " << (stats.peak_rss_bytes >> 20) << " MB, at most " << stats.peak_active
+                    << " tasks at once, " << stats.throttled_waits << " waits";
+    }
+
+    void Img2MatchesPipeline::OrderPairsByPriority(std::vector<std::pair<size_t, size_t>> &image_pairs,
+                                                   const std::vector<cv::Mat> &all_descriptors) const
+    {
+        if (params_.deadline.pair_priority != "overlap")
+        {
+            return;
+        }
+        // Adjacent capture indices overlap most often; ties prefer pairs with more features
+        // 采集顺序相邻的视图最可能重叠；相同时特征数多的视图对优先
+        auto pair_features = [&](const std::pair<size_t, size_t> &pair)
+        {
+            return std::min(all_descriptors[pair.first].rows, all_descriptors[pair.second].rows);
+        };
+        std::stable_sort(image_pairs.begin(), image_pairs.end(),
+                         [&](const std::pair<size_t, size_t> &a, const std::pair<size_t, size_t> &b)
+                         {
+                             const size_t gap_a = a.second - a.first, gap_b = b.second - b.first;
+                             if (gap_a != gap_b)
+                                 return gap_a < gap_b;
+                             return pair_features(a) > pair_features(b);
+                         });
+    }
+
+    void Img2MatchesPipeline::WriteSkippedPairs(const std::vector<std::pair<size_t, size_t>> &skipped_pairs,
+                                                const std::vector<IndexT> &all_view_ids,
+                                                const common::StageDeadline &deadline,
+                                                size_t total_pairs) const
+    {
+        if (deadline.Enabled())
+        {
+            LOG_INFO_ZH << "截止时间模式: 用时 " << std::fixed << std::setprecision(2) << deadline.ElapsedSeconds() << "s / "
+                        << deadline.BudgetSeconds() << "s，跳过 " << skipped_pairs.size() << "/" << total_pairs << " 对视图";
+            LOG_INFO_EN << "Deadline mode: " << std::fixed << std::setprecision(2) << deadline.ElapsedSeconds() << "s / "
+                        << deadline.BudgetSeconds() << "s, skipped " << skipped_pairs.size() << "/" << total_pairs << " pairs";
+        }
+        if (params_.deadline.skipped_pairs_path.empty())
+        {
+            return;
+        }
+
+        std::vector<ViewPair> view_pairs;
+        view_pairs.reserve(skipped_pairs.size());
+        for (const auto &[i, j] : skipped_pairs)
+        {
+            view_pairs.emplace_back(all_view_ids[i], all_view_ids[j]);
+        }
+        std::sort(view_pairs.begin(), view_pairs.end());
+
+        const std::string path = active_shard_ >= 0
+                                     ? params_.deadline.skipped_pairs_path + ".shard-" + std::to_string(active_shard_)
+                                     : params_.deadline.skipped_pairs_path;
+        if (!common::WritePairList(path, view_pairs))
+        {
+            LOG_WARNING_ZH << "无法写入跳过的视图对列表: " << path;
+            LOG_WARNING_EN << "Unable to write skipped view pair list: " << path;
+        }
+    }
+
+    uint64_t Img2MatchesPipeline::MatchingInputFingerprint(
+        const std::vector<cv::Mat> &all_descriptors,
+        const std::vector<std::vector<cv::KeyPoint>> *all_keypoints,
+        const std::vector<IndexT> &all_view_ids,
+        const std::vector<std::pair<size_t, size_t>> &image_pairs) const
+    {
+        common::ShardFingerprint fingerprint;
+        const auto options = Img2MatchesParameterConverter::ToMethodOptions(params_);
+        const std::map<std::string, std::string> sorted_options(options.begin(), options.end());
+        for (const auto &[key, value] : sorted_options)
+        {
+            if (key.rfind("shard_", 0) == 0 || key.rfind("journal_", 0) == 0 || key.rfind("time_budget_", 0) == 0 || key.rfind("memory_", 0) == 0 ||
+                key == "pair_priority" || key == "skipped_pairs_path" ||
+                key == "num_threads" || key == "log_level" || key == "enable_profiling" || key == "ProfileCommit")
+            {
+                continue;
+            }
+            fingerprint.Add(key).Add(value);
+        }
+        for (size_t v = 0; v < all_descriptors.size() && v < all_view_ids.size(); ++v)
+        {
+            const cv::Mat &descriptors = all_descriptors[v];
+            fingerprint.Add(all_view_ids[v])
+                .Add(static_cast<uint64_t>(descriptors.rows))
+                .Add(static_cast<uint64_t>(descriptors.cols))
+                .Add(static_cast<uint64_t>(descriptors.type()));
+            if (descriptors.isContinuous())
+            {
+                fingerprint.Add(descriptors.data, descriptors.total() * descriptors.elemSize());
+            }
+            else
+            {
+                for (int row = 0; row < descriptors.rows; ++row)
+                {
+                    fingerprint.Add(descriptors.ptr(row), descriptors.cols * descriptors.elemSize());
+                }
+            }
+            if (all_keypoints && v < all_keypoints->size())
+            {
+                const auto &keypoints = (*all_keypoints)[v];
+                fingerprint.Add(keypoints.data(), keypoints.size() * sizeof(cv::KeyPoint));
+            }
+        }
+        for (const auto &[i, j] : image_pairs)
+        {
+            fingerprint.Add(i).Add(j);
+        }
+        return fingerprint.Value();
+    }
+
+    std::unique_ptr<common::PairJournal> Img2MatchesPipeline::OpenMatchingJournal(
+        const std::vector<cv::Mat> &all_descriptors,
+        const std::vector<std::vector<cv::KeyPoint>> *all_keypoints,
+        const std::vector<IndexT> &all_view_ids,
+        std::vector<std::pair<size_t, size_t>> &image_pairs,
+        MatchesPtr matches_ptr,
+        size_t &replayed_successful)
+    {
+        if (params_.journal.journal_path.empty())
+        {
+            return nullptr;
+        }
+
+        // Shard workers keep separate journals | 分片进程各自使用独立的日志文件
+        common::PairJournalOptions journal_options;
+        journal_options.path = params_.journal.journal_path;
+        if (active_shard_ >= 0)
+        {
+            journal_options.path += ".shard-" + std::to_string(active_shard_) + "-of-" + std::to_string(params_.sharding.shard_count);
+        }
+        journal_options.flush_pairs = params_.journal.flush_pairs;
+
+        const uint64_t fingerprint = MatchingInputFingerprint(all_descriptors, all_keypoints, all_view_ids, image_pairs);
+
+        auto journal = std::make_unique<common::PairJournal>(journal_options);
+        std::string error;
+        if (!journal->Open(fingerprint, error))
+        {
+            LOG_WARNING_ZH << "无法打开匹配日志，不支持断点续算: " << error;
+            LOG_WARNING_EN << "Cannot open matching journal, resuming disabled: " << error;
+            return nullptr;
+        }
+
+        // Replay completed pairs in pair order, keep the rest | 按视图对顺序回放已完成视图对，保留其余部分
+        const size_t total_pairs = image_pairs.size();
+        replayed_successful = 0;
+        auto is_replayed = [&](const std::pair<size_t, size_t> &pair)
+        {
+            const std::string *payload = journal->Find(all_view_ids[pair.first], all_view_ids[pair.second]);
+            if (!payload)
+                return false;
+            if (payload->empty())
+                return true; // Pair had no matches | 该视图对无匹配
+            if (!common::DecodeMatches(*payload, *matches_ptr))
+                return false;
+            ++replayed_successful;
+            return true;
+        };
+        image_pairs.erase(std::remove_if(image_pairs.begin(), image_pairs.end(), is_replayed), image_pairs.end());
+        journal->ReleaseReplayed();
+        MetricCacheLookups("matching_journal", true).fetch_add(total_pairs - image_pairs.size(), std::memory_order_relaxed);
+        MetricCacheLookups("matching_journal", false).fetch_add(image_pairs.size(), std::memory_order_relaxed);
+
+        LOG_INFO_ZH << "匹配日志: " << journal->Path() << "，回放 " << total_pairs - image_pairs.size()
+                    << " 个已完成视图对，待匹配 " << image_pairs.size() << " 个";
+        LOG_INFO_EN << "Matching journal: " << journal->Path() << ", replayed " << total_pairs - image_pairs.size()
+                    << " completed pairs, " << image_pairs.size() << " pairs to match";
+        return journal;
+    }
+
+    void Img2MatchesPipeline::JournalMatchedPair(common::PairJournal *journal, IndexT view_i, IndexT view_j,
+                                                 const std::vector<cv::DMatch> &matches)
+    {
+        if (!journal)
+        {
+            return;
+        }
+
+        std::string payload;
+        if (!matches.empty())
+        {
+            MatchesPtr pair_matches = std::make_shared<Matches>();
+            OpenCVConverter::CVDMatch2Matches(matches, view_i, view_j, pair_matches);
+            common::EncodeMatches(*pair_matches, payload);
+        }
+        journal->Append(view_i, view_j, payload);
+    }
+
+    size_t Img2MatchesPipeline::PerformShardedMatching(
+        const std::vector<cv::Mat> &all_descriptors,
+        const std::vector<IndexT> &all_view_ids,
+        MatchesPtr matches_ptr,
+        const std::vector<std::vector<cv::KeyPoint>> *all_keypoints,
+        const std::vector<cv::Mat> *all_images)
+    {
+        const auto &sharding = params_.sharding;
+        common::ShardOptions shard_options;
+        shard_options.shard_count = sharding.shard_count;
+        shard_options.shard_index = sharding.shard_index;
+        shard_options.shard_dir = sharding.shard_dir;
+        shard_options.run_id = sharding.run_id;
+        shard_options.wait_timeout_s = sharding.wait_timeout_s;
+
+        // Same input fingerprint as the journal, so stale shard files or files of another job are never merged
+        // 与日志相同的输入指纹，过期的分片文件或其他任务的文件不会被合并
+        const uint64_t fingerprint = MatchingInputFingerprint(all_descriptors, all_keypoints, all_view_ids,
+                                                              GetImagePairs(all_view_ids.size()));
+
+        auto task = [&](size_t shard_index, std::string &payload)
+        {
+            active_shard_ = static_cast<int>(shard_index);
+            auto shard_matches = std::make_shared<Matches>();
+            if (params_.base.num_threads > 1)
+            {
+                PerformPairwiseMatchingMultiThreads(all_descriptors, all_view_ids, shard_matches, all_keypoints, all_images);
+            }
+            else
+            {
+                PerformPairwiseMatching(all_descriptors, all_view_ids, shard_matches, all_keypoints, all_images);
+            }
+            active_shard_ = -1;
+            common::EncodeMatches(*shard_matches, payload);
+            return true;
+        };
+
+        std::vector<std::string> payloads;
+        std::string error;
+        if (!common::RunShardedPhase(shard_options, "matches", fingerprint, task, payloads, error))
+        {
+            LOG_ERROR_ZH << "分片匹配失败: " << error;
+            LOG_ERROR_EN << "Sharded matching failed: " << error;
+            return 0;
+        }
+
+        // Matches is ordered by view pair, so the merge does not depend on the shard count
+        // Matches按视图对有序，合并结果与分片数无关
+        for (size_t k = 0; k < payloads.size(); ++k)
+        {
+            if (!common::DecodeMatches(payloads[k], *matches_ptr))
+            {
+                LOG_ERROR_ZH << "分片 " << k << " 匹配数据损坏";
+                LOG_ERROR_EN << "Shard " << k << " has malformed match data";
+                matches_ptr->clear();
+                return 0;
+            }
+        }
+
+        LOG_INFO_ZH << "已合并 " << payloads.size() << " 个匹配分片: " << matches_ptr->size() << " 对视图有匹配结果";
+        LOG_INFO_EN << "Merged " << payloads.size() << " matching shards: " << matches_ptr->size() << " pairs have matches";
+        return matches_ptr->size();
+    }
+
     void Img2MatchesPipeline::LoadConfigurationAtRuntime()
     {
         LOG_DEBUG_ZH << "运行时加载配置...";
@@ -1399,6 +1957,317 @@ namespace PluginMethods
         LOG_DEBUG_EN << "RootSIFT normalization completed";
     }
 
+    void Img2MatchesPipeline::ApplyDescriptorReduction(std::vector<cv::Mat> &all_descriptors)
+    {
+        const auto &reduction = params_.descriptor_reduction;
+        if (!reduction.enable_pca || all_descriptors.empty())
+        {
+            return;
+        }
+
+        // LightGlue consumes the original descriptors, Hamming matching needs binary ones
+        // LightGlue需要原始描述子，Hamming匹配需要二进制描述子
+        if (params_.matching.matcher_type == MatcherType::LIGHTGLUE ||
+            params_.matching.matcher_type == MatcherType::BF_HAMMING)
+        {
+            LOG_WARNING_ZH << "当前匹配器不支持PCA降维描述子，跳过降维";
+            LOG_WARNING_EN << "Current matcher does not support PCA-reduced descriptors, skipping reduction";
+            return;
+        }
+
+        auto first_valid = std::find_if(all_descriptors.begin(), all_descriptors.end(),
+                                        [](const cv::Mat &d)
+                                        { return !d.empty(); });
+        if (first_valid == all_descriptors.end() || first_valid->type() != CV_32F)
+        {
+            LOG_WARNING_ZH << "PCA降维需要CV_32F描述子，跳过降维";
+            LOG_WARNING_EN << "PCA reduction requires CV_32F descriptors, skipping reduction";
+            return;
+        }
+        const int input_dims = first_valid->cols;
+
+        // 1. Load or learn projection | 加载或学习投影
+        DescriptorPCA pca;
+        bool loaded = false;
+        if (!reduction.pca_model_path.empty() && std::filesystem::exists(reduction.pca_model_path))
+        {
+            loaded = pca.Load(reduction.pca_model_path);
+            if (loaded && pca.GetInputDims() != input_dims)
+            {
+                LOG_WARNING_ZH << "PCA模型输入维度(" << pca.GetInputDims() << ")与描述子维度(" << input_dims << ")不一致，重新学习";
+                LOG_WARNING_EN << "PCA model input dims (" << pca.GetInputDims() << ") mismatch descriptor dims (" << input_dims << "), re-learning";
+                loaded = false;
+            }
+            else if (loaded && pca.GetOutputDims() != reduction.pca_dims)
+            {
+                LOG_WARNING_ZH << "PCA模型输出维度(" << pca.GetOutputDims() << ")与pca_dims(" << reduction.pca_dims << ")不一致，重新学习";
+                LOG_WARNING_EN << "PCA model output dims (" << pca.GetOutputDims() << ") mismatch pca_dims (" << reduction.pca_dims << "), re-learning";
+                loaded = false;
+            }
+        }
+
+        if (!loaded)
+        {
+            if (!pca.Learn(all_descriptors, reduction.pca_dims, reduction.max_training_samples))
+            {
+                LOG_WARNING_ZH << "PCA学习失败（目标维度: " << reduction.pca_dims << ", 输入维度: " << input_dims << "），使用全维描述子";
+                LOG_WARNING_EN << "PCA learning failed (target dims: " << reduction.pca_dims << ", input dims: " << input_dims << "), using full-dimension descriptors";
+                return;
+            }
+            if (!reduction.pca_model_path.empty() && !pca.Save(reduction.pca_model_path))
+            {
+                LOG_WARNING_ZH << "无法保存PCA模型: " << reduction.pca_model_path;
+                LOG_WARNING_EN << "Failed to save PCA model: " << reduction.pca_model_path;
+            }
+        }
+
+        // 2. Random sample of matched pairs (fixed seed, adjacent and non-adjacent), keep their full-dimension descriptors
+        // 随机抽样待匹配视图对（固定种子，含相邻与非相邻），保留其全维描述子用于召回率评测
+        std::vector<std::pair<size_t, size_t>> benchmark_pairs;
+        std::vector<cv::Mat> reference_descriptors(all_descriptors.size());
+        if (reduction.recall_benchmark_pairs > 0)
+        {
+            for (const auto &pair : GetImagePairs(all_descriptors.size()))
+            {
+                if (!all_descriptors[pair.first].empty() && !all_descriptors[pair.second].empty())
+                    benchmark_pairs.push_back(pair);
+            }
+            std::mt19937 rng(12345);
+            std::shuffle(benchmark_pairs.begin(), benchmark_pairs.end(), rng);
+            benchmark_pairs.resize(std::min(benchmark_pairs.size(), reduction.recall_benchmark_pairs));
+            for (const auto &[i, j] : benchmark_pairs)
+            {
+                reference_descriptors[i] = all_descriptors[i];
+                reference_descriptors[j] = all_descriptors[j];
+            }
+        }
+
+        // 3. Project all views | 投影所有视图
+        size_t full_bytes = 0;
+        size_t reduced_bytes = 0;
+        for (const auto &d : all_descriptors)
+        {
+            full_bytes += d.total() * d.elemSize();
+        }
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < static_cast<int>(all_descriptors.size()); ++i)
+        {
+            if (!all_descriptors[i].empty())
+            {
+                all_descriptors[i] = pca.Project(all_descriptors[i]);
+            }
+        }
+
+        for (const auto &d : all_descriptors)
+        {
+            reduced_bytes += d.total() * d.elemSize();
+        }
+
+        LOG_INFO_ZH << "描述子PCA降维: " << input_dims << " -> " << pca.GetOutputDims()
+                    << " (" << (loaded ? "从文件加载" : "按数据集学习") << ")";
+        LOG_INFO_EN << "Descriptor PCA reduction: " << input_dims << " -> " << pca.GetOutputDims()
+                    << " (" << (loaded ? "loaded from file" : "learned per dataset") << ")";
+        if (!loaded)
+        {
+            LOG_INFO_ZH << "  保留方差比例: " << std::fixed << std::setprecision(3) << pca.GetRetainedVariance();
+            LOG_INFO_EN << "  Retained variance: " << std::fixed << std::setprecision(3) << pca.GetRetainedVariance();
+        }
+        LOG_INFO_ZH << "  描述子内存: " << (full_bytes / 1024.0 / 1024.0) << " MB -> " << (reduced_bytes / 1024.0 / 1024.0) << " MB";
+        LOG_INFO_EN << "  Descriptor memory: " << (full_bytes / 1024.0 / 1024.0) << " MB -> " << (reduced_bytes / 1024.0 / 1024.0) << " MB";
+
+        // 4. Recall benchmark against full-dimension baseline | 与全维基线对比召回率
+        if (benchmark_pairs.empty())
+        {
+            return;
+        }
+
+        double recall_sum = 0.0;
+        size_t evaluated_pairs = 0;
+        for (const auto &[i, j] : benchmark_pairs)
+        {
+            auto full_matches = MatchFeaturesThreadSafe(reference_descriptors[i], reference_descriptors[j],
+                                                        static_cast<IndexT>(i), static_cast<IndexT>(j));
+            auto reduced_matches = MatchFeaturesThreadSafe(all_descriptors[i], all_descriptors[j],
+                                                           static_cast<IndexT>(i), static_cast<IndexT>(j));
+            double recall = DescriptorPCA::ComputeMatchRecall(full_matches, reduced_matches);
+            recall_sum += recall;
+            ++evaluated_pairs;
+
+            LOG_DEBUG_ZH << "  视图对 (" << i << "," << j << ") 全维匹配: " << full_matches.size()
+                         << ", 降维匹配: " << reduced_matches.size() << ", 召回率: " << recall;
+            LOG_DEBUG_EN << "  View pair (" << i << "," << j << ") full-dim matches: " << full_matches.size()
+                         << ", reduced matches: " << reduced_matches.size() << ", recall: " << recall;
+        }
+
+        if (evaluated_pairs > 0)
+        {
+            LOG_INFO_ZH << "  降维匹配平均召回率 (" << evaluated_pairs << " 个视图对): "
+                        << std::fixed << std::setprecision(3) << recall_sum / evaluated_pairs;
+            LOG_INFO_EN << "  Mean match recall of reduced descriptors (" << evaluated_pairs << " view pairs): "
+                        << std::fixed << std::setprecision(3) << recall_sum / evaluated_pairs;
+        }
+    }
+
+    void Img2MatchesPipeline::AutotuneMatcher(const std::vector<cv::Mat> &all_descriptors,
+                                              const std::vector<IndexT> &all_view_ids,
+                                              const std::vector<std::vector<cv::KeyPoint>> &all_keypoints,
+                                              const std::vector<cv::Mat> *all_images)
+    {
+        const auto &autotune = params_.autotune;
+        const MatchingParameters configured_matching = params_.matching;
+        const FLANNParameters configured_flann = params_.flann;
+
+        auto apply = [this](const MatcherCandidate &candidate)
+        {
+            params_.matching.matcher_type = candidate.matcher_type;
+            params_.matching.ratio_thresh = candidate.ratio_thresh;
+            if (candidate.matcher_type == MatcherType::FLANN)
+            {
+                params_.flann = candidate.flann;
+            }
+        };
+
+        // 0. Reuse an earlier tuning result | 复用之前的调优结果
+        if (!autotune.output_path.empty() && std::filesystem::exists(autotune.output_path))
+        {
+            MatcherCandidate loaded;
+            loaded.matcher_type = configured_matching.matcher_type;
+            loaded.ratio_thresh = configured_matching.ratio_thresh;
+            loaded.flann = configured_flann;
+            if (MatcherAutotuner::ReadConfig(autotune.output_path, loaded))
+            {
+                apply(loaded);
+                LOG_INFO_ZH << "匹配器自动调优: 复用 " << autotune.output_path << " (matcher_type="
+                            << Img2MatchesParameterConverter::MatcherTypeToString(loaded.matcher_type)
+                            << ", ratio_thresh=" << loaded.ratio_thresh << ")";
+                LOG_INFO_EN << "Matcher autotuning: reusing " << autotune.output_path << " (matcher_type="
+                            << Img2MatchesParameterConverter::MatcherTypeToString(loaded.matcher_type)
+                            << ", ratio_thresh=" << loaded.ratio_thresh << ")";
+                return;
+            }
+            LOG_WARNING_ZH << "无法读取调优结果文件，重新调优: " << autotune.output_path;
+            LOG_WARNING_EN << "Failed to read autotuning result, tuning again: " << autotune.output_path;
+        }
+
+        // 1. Random sample of candidate pairs (fixed seed) | 随机抽样候选视图对（固定种子）
+        const std::vector<std::pair<size_t, size_t>> all_pairs = GetImagePairs(all_descriptors.size());
+        std::vector<std::pair<size_t, size_t>> sample_pairs;
+        for (const auto &pair : all_pairs)
+        {
+            if (!all_descriptors[pair.first].empty() && !all_descriptors[pair.second].empty())
+                sample_pairs.push_back(pair);
+        }
+        std::mt19937 rng(12345);
+        std::shuffle(sample_pairs.begin(), sample_pairs.end(), rng);
+        sample_pairs.resize(std::min(sample_pairs.size(), autotune.sample_pairs));
+        if (sample_pairs.empty())
+        {
+            LOG_WARNING_ZH << "匹配器自动调优: 没有可抽样的视图对，保持当前配置";
+            LOG_WARNING_EN << "Matcher autotuning: no pairs to sample, keeping the current configuration";
+            return;
+        }
+        const int descriptor_type = all_descriptors[sample_pairs.front().first].type();
+
+        // 2. Exact brute-force reference at the configured ratio | 以配置的比率阈值做精确暴力匹配作为参考
+        params_.matching.matcher_type = descriptor_type == CV_32F ? MatcherType::BF : MatcherType::BF_HAMMING;
+        std::vector<std::vector<cv::DMatch>> reference(sample_pairs.size());
+        for (size_t k = 0; k < sample_pairs.size(); ++k)
+        {
+            const auto &[i, j] = sample_pairs[k];
+            reference[k] = MatchFeaturesThreadSafe(all_descriptors[i], all_descriptors[j], all_view_ids[i], all_view_ids[j]);
+        }
+
+        // 3. Time and score every candidate | 对每个候选配置计时并评分
+        const bool with_lightglue = autotune.include_lightglue && all_images != nullptr && !all_images->empty();
+        const std::vector<MatcherCandidate> candidates = MatcherAutotuner::BuildCandidates(
+            descriptor_type, MatcherAutotuner::ParseRatios(autotune.ratio_candidates, configured_matching.ratio_thresh),
+            configured_flann, with_lightglue);
+
+        std::vector<MatcherCandidateResult> results;
+        results.reserve(candidates.size());
+        for (const auto &candidate : candidates)
+        {
+            params_.matching = configured_matching;
+            params_.flann = configured_flann;
+            apply(candidate);
+
+            MatcherCandidateResult result;
+            result.candidate = candidate;
+            std::vector<cv::Vec3d> cost_samples;
+            for (size_t k = 0; k < sample_pairs.size(); ++k)
+            {
+                const auto &[i, j] = sample_pairs[k];
+                const auto start = std::chrono::steady_clock::now();
+                std::vector<cv::DMatch> matches;
+                if (candidate.matcher_type == MatcherType::LIGHTGLUE)
+                {
+                    if (i < all_images->size() && j < all_images->size() &&
+                        i < all_keypoints.size() && j < all_keypoints.size())
+                    {
+                        matches = MatchFeaturesWithLightGlue((*all_images)[i], (*all_images)[j],
+                                                             all_keypoints[i], all_keypoints[j],
+                                                             all_descriptors[i], all_descriptors[j]);
+                    }
+                }
+                else
+                {
+                    matches = MatchFeaturesThreadSafe(all_descriptors[i], all_descriptors[j], all_view_ids[i], all_view_ids[j]);
+                }
+                const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                cost_samples.emplace_back(all_descriptors[i].rows, all_descriptors[j].rows, seconds);
+                result.sample_seconds += seconds;
+                result.recall += DescriptorPCA::ComputeMatchRecall(reference[k], matches);
+                result.precision += DescriptorPCA::ComputeMatchRecall(matches, reference[k]);
+            }
+            result.recall /= sample_pairs.size();
+            result.precision /= sample_pairs.size();
+
+            // Predict the full run from descriptor counts | 按描述子数量预测全量匹配时间
+            const MatchCostModel model = MatchCostModel::Fit(cost_samples);
+            for (const auto &[i, j] : all_pairs)
+            {
+                result.predicted_seconds += model.Predict(all_descriptors[i].rows, all_descriptors[j].rows);
+            }
+
+            LOG_DEBUG_ZH << "  候选 " << candidate.label << ": 召回率=" << std::fixed << std::setprecision(3) << result.recall
+                         << ", 精度=" << result.precision << ", 抽样耗时=" << result.sample_seconds
+                         << "s, 预测全量耗时=" << result.predicted_seconds << "s";
+            LOG_DEBUG_EN << "  Candidate " << candidate.label << ": recall=" << std::fixed << std::setprecision(3) << result.recall
+                         << ", precision=" << result.precision << ", sample time=" << result.sample_seconds
+                         << "s, predicted full time=" << result.predicted_seconds << "s";
+            results.push_back(result);
+        }
+
+        // 4. Fastest configuration meeting the target | 满足目标的最快配置
+        params_.matching = configured_matching;
+        params_.flann = configured_flann;
+        const size_t best = MatcherAutotuner::SelectBest(results, autotune.recall_target, autotune.min_precision);
+        const auto &chosen = results[best];
+        apply(chosen.candidate);
+
+        LOG_INFO_ZH << "匹配器自动调优 (" << sample_pairs.size() << " 个抽样视图对, " << results.size() << " 个候选): "
+                    << chosen.candidate.label << ", 召回率=" << std::fixed << std::setprecision(3) << chosen.recall
+                    << ", 精度=" << chosen.precision << ", 预测全量耗时=" << chosen.predicted_seconds << "s";
+        LOG_INFO_EN << "Matcher autotuning (" << sample_pairs.size() << " sampled pairs, " << results.size() << " candidates): "
+                    << chosen.candidate.label << ", recall=" << std::fixed << std::setprecision(3) << chosen.recall
+                    << ", precision=" << chosen.precision << ", predicted full time=" << chosen.predicted_seconds << "s";
+        if (!chosen.feasible)
+        {
+            LOG_WARNING_ZH << "没有候选达到召回率目标 " << autotune.recall_target << "，使用召回率最高的配置";
+            LOG_WARNING_EN << "No candidate reached the recall target " << autotune.recall_target << ", using the highest-recall configuration";
+        }
+
+        if (!autotune.output_path.empty() && !MatcherAutotuner::WriteConfig(autotune.output_path, chosen.candidate))
+        {
+            LOG_WARNING_ZH << "无法写入调优结果: " << autotune.output_path;
+            LOG_WARNING_EN << "Failed to write autotuning result: " << autotune.output_path;
+        }
+    }
+
     cv::Mat Img2MatchesPipeline::ApplyFirstOctaveProcessing(const cv::Mat &img)
     {
         cv::Mat processed_img;
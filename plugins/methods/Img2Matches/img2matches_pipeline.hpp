@@ -9,12 +9,21 @@
 #include <po_core.hpp>
 #include <common/converter/converter_opencv.hpp>
 #include <common/image_viewer/image_viewer.hpp>
+#include <common/image_viewer/image_prefetcher.hpp>
+#include <common/io/metrics_exporter.hpp>
+#include <common/io/pair_journal.hpp>
+#include <common/parallel/memory_governor.hpp>
+#include <common/parallel/pair_shards.hpp>
+#include <common/parallel/stage_deadline.hpp>
 #include "Img2MatchesParams.hpp"
+#include "DescriptorPCA.hpp"
+#include "SpatialPairSelector.hpp"
 #include "../Img2Features/img2features_pipeline.hpp"
 #include <opencv2/features2d.hpp>
 #include <filesystem>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <po_core/po_logger.hpp>
 #include <atomic>
 #include <mutex>
@@ -31,6 +40,8 @@ namespace PluginMethods
     using namespace Converter;
     using namespace common;
 
+    class CascadeHashingSession;
+
     /**
      * @brief 图像特征匹配处理流水线
      *
@@ -159,6 +170,15 @@ namespace PluginMethods
                                      std::vector<std::string> &all_image_paths,
                                      std::vector<cv::Mat> *all_images = nullptr);
 
+        /**
+         * @brief 创建图像预读器（io_prefetch_depth为0时返回nullptr，调用方直接cv::imread）
+         * @param paths 按读取顺序排列的图像路径
+         * @param decode_flags 从同一份文件字节解码的cv::imread标志
+         * @return 预读器或nullptr
+         */
+        std::unique_ptr<common::PrefetchingImageReader> CreateImagePrefetcher(
+            std::vector<std::string> paths, std::vector<int> decode_flags) const;
+
         /**
          * @brief 提取新的特征数据
          * @param image_paths_ptr 图像路径指针
@@ -202,6 +222,19 @@ namespace PluginMethods
                                                    const std::vector<std::vector<cv::KeyPoint>> *all_keypoints = nullptr,
                                                    const std::vector<cv::Mat> *all_images = nullptr);
 
+        /**
+         * @brief 分片匹配：本进程只匹配shard_index分片的视图对，再与其他进程的分片按视图对顺序合并
+         * @param all_descriptors 所有描述子
+         * @param all_view_ids 所有视图ID
+         * @param matches_ptr 匹配结果指针（合并结果）
+         * @return 成功匹配的对数，分片失败时为0
+         */
+        size_t PerformShardedMatching(const std::vector<cv::Mat> &all_descriptors,
+                                      const std::vector<IndexT> &all_view_ids,
+                                      MatchesPtr matches_ptr,
+                                      const std::vector<std::vector<cv::KeyPoint>> *all_keypoints = nullptr,
+                                      const std::vector<cv::Mat> *all_images = nullptr);
+
         /**
          * @brief 导出结果数据
          * @param features_data_ptr 特征数据指针
@@ -222,6 +255,106 @@ namespace PluginMethods
          */
         void ApplyRootSIFTNormalization(cv::Mat &descriptors);
 
+        /**
+         * @brief 描述子PCA降维后处理（RootSIFT之后，匹配之前）
+         * @details 按数据集学习或从文件加载投影，原地替换为降维描述子；
+         *          可选地在前若干视图对上与全维描述子对比匹配召回率
+         * @param all_descriptors 所有视图的描述子（会被替换为降维结果）
+         */
+        void ApplyDescriptorReduction(std::vector<cv::Mat> &all_descriptors);
+
+        /**
+         * @brief 匹配器自动调优（匹配之前）
+         * @details 在随机抽样的视图对上评测候选匹配器/参数，以精确暴力匹配为参考计算召回率，
+         *          按描述子数量拟合代价模型预测全量匹配时间，将满足召回率目标的最快配置写入params_
+         * @param all_descriptors 所有视图的描述子
+         * @param all_view_ids 视图ID
+         * @param all_keypoints 所有视图的特征点（LightGlue候选使用）
+         * @param all_images 图像缓存（LightGlue候选使用，可为nullptr）
+         */
+        void AutotuneMatcher(const std::vector<cv::Mat> &all_descriptors,
+                             const std::vector<IndexT> &all_view_ids,
+                             const std::vector<std::vector<cv::KeyPoint>> &all_keypoints,
+                             const std::vector<cv::Mat> *all_images);
+
+        /**
+         * @brief 基于GPS/位姿先验选择候选视图对（结果保存到selected_pairs_）
+         * @param all_image_paths 与视图索引对齐的图像路径
+         */
+        void SelectSpatialPairs(const std::vector<std::string> &all_image_paths);
+
+        /**
+         * @brief 获取待匹配的视图索引对（空间选择结果或全对）
+         * @param num_views 视图数量
+         * @return 视图索引对(i, j)，i < j
+         */
+        std::vector<std::pair<size_t, size_t>> GetImagePairs(size_t num_views) const;
+
+        /**
+         * @brief 按memory_*参数创建多线程阶段的内存压力控制（每个任务申请一个槽位）
+         * @param num_threads 线程数，即无内存压力时的槽位数
+         */
+        std::unique_ptr<common::MemoryGovernor> CreateMemoryGovernor(int num_threads) const;
+
+        /**
+         * @brief 创建数据集级Cascade Hashing会话（FASTCASCADEHASHINGL2且启用cascade_hashing_global_session时）
+         * @details 单线程与多线程匹配共用，使匹配结果与num_threads无关
+         * @param all_descriptors 所有描述子
+         * @param num_threads 哈希线程数
+         * @return 会话，未启用或构建失败时为空（回退到逐对哈希）
+         */
+        std::unique_ptr<CascadeHashingSession> CreateCascadeHashingSession(const std::vector<cv::Mat> &all_descriptors,
+                                                                           int num_threads) const;
+
+        /**
+         * @brief 输出内存压力控制的统计（未启用时不输出）
+         */
+        static void LogMemoryGovernorStats(const common::MemoryGovernor &governor);
+
+        /**
+         * @brief 截止时间模式：按优先级重排待匹配视图对（pair_priority=overlap时索引相邻、特征多的优先）
+         * @details 匹配前没有视图对强度信息，以采集顺序相邻和特征数作为重叠的代理
+         */
+        void OrderPairsByPriority(std::vector<std::pair<size_t, size_t>> &image_pairs,
+                                  const std::vector<cv::Mat> &all_descriptors) const;
+
+        /**
+         * @brief 截止时间模式：写出因预算耗尽跳过的视图对（分片进程追加".shard-k"）
+         */
+        void WriteSkippedPairs(const std::vector<std::pair<size_t, size_t>> &skipped_pairs,
+                               const std::vector<IndexT> &all_view_ids,
+                               const common::StageDeadline &deadline,
+                               size_t total_pairs) const;
+
+        /**
+         * @brief 匹配输入指纹：影响结果的选项、完整的描述子和关键点数据、候选视图对（分片文件与日志共用）
+         */
+        uint64_t MatchingInputFingerprint(const std::vector<cv::Mat> &all_descriptors,
+                                          const std::vector<std::vector<cv::KeyPoint>> *all_keypoints,
+                                          const std::vector<IndexT> &all_view_ids,
+                                          const std::vector<std::pair<size_t, size_t>> &image_pairs) const;
+
+        /**
+         * @brief 打开匹配日志并回放已完成的视图对（断点续算）
+         * @param all_keypoints 所有关键点（可为空），与描述子一起完整计入输入指纹
+         * @param image_pairs 待匹配视图索引对，回放的视图对会被移除
+         * @param matches_ptr 回放的匹配结果写入其中
+         * @param replayed_successful 输出：回放视图对中有匹配结果的数量
+         * @return 日志实例；未启用或打开失败时为nullptr
+         */
+        std::unique_ptr<common::PairJournal> OpenMatchingJournal(const std::vector<cv::Mat> &all_descriptors,
+                                                                 const std::vector<std::vector<cv::KeyPoint>> *all_keypoints,
+                                                                 const std::vector<IndexT> &all_view_ids,
+                                                                 std::vector<std::pair<size_t, size_t>> &image_pairs,
+                                                                 MatchesPtr matches_ptr,
+                                                                 size_t &replayed_successful);
+
+        /**
+         * @brief 将一个视图对的匹配结果写入日志（无匹配时写入空记录）
+         */
+        static void JournalMatchedPair(common::PairJournal *journal, IndexT view_i, IndexT view_j,
+                                       const std::vector<cv::DMatch> &matches);
+
         /**
          * @brief 应用first_octave图像预处理（上采样/下采样）
          * @param img 输入图像
@@ -267,6 +400,12 @@ namespace PluginMethods
 
         // 参数容器
         Img2MatchesParameters params_;
+
+        // 空间视图对选择结果（未启用时为空，表示全对匹配）
+        std::optional<std::vector<std::pair<size_t, size_t>>> selected_pairs_;
+
+        // 当前进程匹配的分片（-1表示不限制，GetImagePairs()返回全部视图对）
+        int active_shard_ = -1;
     };
 
 } // namespace PluginMethods
@@ -11,6 +11,7 @@
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/highgui.hpp>
 #include <common/image_viewer/image_viewer.hpp>
+#include <common/image_viewer/image_loader.hpp>
 #include <filesystem>
 #include <regex>
 #include <algorithm>
@@ -71,8 +72,9 @@ namespace PluginMethods
             const std::string &path1 = valid_image_pairs[i].second;
             const std::string &path2 = valid_image_pairs[j].second;
 
-            cv::Mat img1 = cv::imread(path1, cv::IMREAD_GRAYSCALE);
-            cv::Mat img2 = cv::imread(path2, cv::IMREAD_GRAYSCALE);
+            // Preview only: decode at native reduced resolution | 仅用于预览：按原生降分辨率解码
+            cv::Mat img1 = ImageLoader::Load(path1, params_.visualization.decode_reduce_factor, false).image;
+            cv::Mat img2 = ImageLoader::Load(path2, params_.visualization.decode_reduce_factor, false).image;
 
             if (img1.empty() || img2.empty())
                 throw std::runtime_error("Failed to load images | 无法加载图像");
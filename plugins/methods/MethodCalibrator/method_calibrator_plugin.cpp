@@ -8,7 +8,9 @@
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/highgui.hpp>
 #include <opencv2/imgproc.hpp>
+#include <common/image_viewer/image_prefetcher.hpp>
 #include <filesystem>
+#include <memory>
 #include <po_core/po_logger.hpp>
 #include "CirclesPatternDetector.hpp"
 
@@ -376,12 +378,40 @@ namespace PoSDKPlugin
             const IndexT max_images = GetOptionAsIndexT("max_images", 100);
             IndexT valid_images = 0;
 
+            std::vector<std::string> calibration_paths;
             for (const auto &[img_path, is_valid] : *image_paths_ptr)
             {
-                if (!is_valid)
-                    continue;
+                if (is_valid)
+                    calibration_paths.push_back(img_path);
+            }
+
+            // Read ahead of corner detection; the reader stops when the loop breaks at max_images
+            // 在角点检测之前预读；循环在max_images处中断时读取器随之停止
+            std::unique_ptr<common::PrefetchingImageReader> prefetcher;
+            const IndexT prefetch_depth = GetOptionAsIndexT("io_prefetch_depth", 8);
+            if (prefetch_depth > 0)
+            {
+                common::PrefetchingImageReader::Options prefetch_options;
+                prefetch_options.prefetch_depth = prefetch_depth;
+                prefetcher = std::make_unique<common::PrefetchingImageReader>(
+                    calibration_paths, std::vector<int>{cv::IMREAD_GRAYSCALE}, prefetch_options);
+            }
+
+            for (size_t i = 0; i < calibration_paths.size(); ++i)
+            {
+                const std::string &img_path = calibration_paths[i];
 
-                cv::Mat image = cv::imread(img_path, cv::IMREAD_GRAYSCALE);
+                cv::Mat image;
+                if (prefetcher)
+                {
+                    auto prefetched = prefetcher->Take(i);
+                    if (prefetched.Ok())
+                        image = prefetched.decoded[0];
+                }
+                else
+                {
+                    image = cv::imread(img_path, cv::IMREAD_GRAYSCALE);
+                }
                 if (image.empty())
                 {
                     LOG_ERROR_ZH << "[MethodCalibrator] 加载图像失败: " << img_path;
@@ -9,6 +9,7 @@
 #include <sstream>
 #include <set>
 #include <algorithm>
+#include <cmath>
 
 namespace PluginMethods
 {
@@ -226,9 +227,12 @@ namespace PluginMethods
                 return false;
             }
 
-            // Read images | 读取图像
-            cv::Mat img1 = cv::imread(image_paths[view_i].first, cv::IMREAD_COLOR);
-            cv::Mat img2 = cv::imread(image_paths[view_j].first, cv::IMREAD_COLOR);
+            // Read images at the decoder's native reduced resolution | 按解码器原生降分辨率读取图像
+            int decode_reduce_factor = GetOptionAsIndexT("decode_reduce_factor", 1);
+            auto reduced1 = ImageLoader::Load(image_paths[view_i].first, decode_reduce_factor, true);
+            auto reduced2 = ImageLoader::Load(image_paths[view_j].first, decode_reduce_factor, true);
+            cv::Mat &img1 = reduced1.image;
+            cv::Mat &img2 = reduced2.image;
 
             if (img1.empty() || img2.empty())
             {
@@ -247,6 +251,10 @@ namespace PluginMethods
                 return false;
             }
 
+            // Bring keypoints into reduced image coordinates | 将特征点转换到降分辨率图像坐标
+            ImageLoader::ScaleKeyPoints(keypoints1, reduced1.scale);
+            ImageLoader::ScaleKeyPoints(keypoints2, reduced2.scale);
+
             // Convert match data | 转换匹配数据
             std::vector<cv::DMatch> cv_matches;
             size_t match_count = ConvertIdMatchesToCVMatches(matches, cv_matches);
@@ -311,7 +319,7 @@ namespace PluginMethods
 
             // Draw and save match image | 绘制并保存匹配图
             return DrawAndSaveMatches(img1, img2, keypoints1, keypoints2,
-                                      cv_matches, inlier_flags, output_path, enhance_outliers);
+                                      cv_matches, inlier_flags, output_path, enhance_outliers, reduced1.scale);
         }
         catch (const std::exception &e)
         {
@@ -353,7 +361,8 @@ namespace PluginMethods
         const std::vector<cv::DMatch> &matches,
         const std::vector<bool> &inlier_flags,
         const std::filesystem::path &output_path,
-        bool enhance_outliers)
+        bool enhance_outliers,
+        double draw_scale)
     {
         try
         {
@@ -361,9 +370,11 @@ namespace PluginMethods
             cv::Mat output_img;
             cv::hconcat(img1, img2, output_img);
 
-            // Get drawing parameters | 获取绘制参数
-            int keypoint_radius = GetOptionAsIndexT("keypoint_radius", 8);
-            int line_thickness = GetOptionAsIndexT("line_thickness", 2);
+            // Get drawing parameters, sizes are given for full-resolution images | 获取绘制参数，尺寸以全分辨率图像为准
+            const auto scaled_size = [draw_scale](int size)
+            { return std::max(1, static_cast<int>(std::lround(size * draw_scale))); };
+            int keypoint_radius = scaled_size(GetOptionAsIndexT("keypoint_radius", 8));
+            int line_thickness = scaled_size(GetOptionAsIndexT("line_thickness", 2));
             double line_alpha = GetOptionAsFloat("line_alpha", 0.6);
             double keypoint_alpha = GetOptionAsFloat("keypoint_alpha", 0.9);
             bool enable_color_diversity = GetOptionAsBool("enable_color_diversity", true);
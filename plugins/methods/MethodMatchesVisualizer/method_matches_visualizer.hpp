@@ -10,6 +10,7 @@
 #include <po_core.hpp>
 #include <common/converter/converter_opencv.hpp>
 #include <common/image_viewer/image_viewer.hpp>
+#include <common/image_viewer/image_loader.hpp>
 #include <opencv2/opencv.hpp>
 #include <opencv2/features2d.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -87,6 +88,7 @@ namespace PluginMethods
          * @param inlier_matches 内点匹配（用于区分颜色）
          * @param output_path 输出文件路径
          * @param enhance_outliers 是否增强外点显示
+         * @param draw_scale 图像相对全分辨率的缩放（降分辨率解码时缩放点半径和线宽）
          * @return 是否成功保存
          */
         bool DrawAndSaveMatches(
@@ -97,7 +99,8 @@ namespace PluginMethods
             const std::vector<cv::DMatch> &matches,
             const std::vector<bool> &inlier_flags,
             const std::filesystem::path &output_path,
-            bool enhance_outliers = false);
+            bool enhance_outliers = false,
+            double draw_scale = 1.0);
 
         /**
          * @brief 从特征信息中提取OpenCV关键点
@@ -24,6 +24,7 @@ using namespace lemon;
 #include "chatterjee/L1ADMM.h"
 #include "chatterjee/rotation.h"
 #include <po_core/po_logger.hpp>
+#include <common/io/metrics_exporter.hpp>
 
 namespace PluginMethods
 {
@@ -437,9 +438,11 @@ namespace PluginMethods
             // Current error and the previous one | 当前错误和前一个错误
             double e = std::numeric_limits<double>::max(), ep;
             unsigned iter = 0;
+            std::atomic<uint64_t> &iterations_metric = common::MetricIterations("rotation_averaging");
             // L1RA iterate optimization till the desired precision is reached | L1RA迭代优化直到达到期望精度
             do
             {
+                iterations_metric.fetch_add(1, std::memory_order_relaxed);
                 // compute errors for each relative rotation | 计算每个相对旋转的错误
                 FillErrorMatrix(RelRs, Rs, b);
 
@@ -498,8 +501,10 @@ namespace PluginMethods
             // current error and the previous one | 当前错误和前一个错误
             double e = std::numeric_limits<double>::max(), ep;
             unsigned int iter = 0;
+            std::atomic<uint64_t> &iterations_metric = common::MetricIterations("rotation_averaging");
             do
             {
+                iterations_metric.fetch_add(1, std::memory_order_relaxed);
                 xp = x;
                 // compute errors for each relative rotation | 计算每个相对旋转的错误
                 FillErrorMatrix(RelRs, Rs, b);
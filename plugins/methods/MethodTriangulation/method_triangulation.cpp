@@ -0,0 +1,118 @@
+/**
+ * @file method_triangulation.cpp
+ * @brief Parallel batch triangulation of tracks | 轨迹并行批量三角化
+ */
+
+#include "method_triangulation.hpp"
+#include <iomanip>
+
+namespace PluginMethods
+{
+    MethodTriangulation::MethodTriangulation()
+    {
+        // 注册所需数据类型
+        required_package_["data_tracks"] = nullptr;
+        required_package_["data_global_poses"] = nullptr;
+        required_package_["data_camera_models"] = nullptr;
+
+        // 初始化默认配置
+        InitializeDefaultConfigPath();
+    }
+
+    const common::OptionSchema<MethodTriangulation::TriangulationOptions> &MethodTriangulation::GetOptionSchema()
+    {
+        static const auto schema = common::OptionSchema<TriangulationOptions>()
+                                       .Add("kernel", &TriangulationOptions::kernel, "midpoint",
+                                            [](const std::string &value)
+                                            {
+                                                common::TriangulationKernel kernel;
+                                                return common::ParseTriangulationKernel(value, kernel);
+                                            })
+                                       .Add("max_reprojection_error", &TriangulationOptions::max_reprojection_error, 4.0,
+                                            [](const double &value)
+                                            { return value > 0.0; })
+                                       .Add("min_angle_deg", &TriangulationOptions::min_angle_deg, 1.0,
+                                            [](const double &value)
+                                            { return value >= 0.0 && value < 90.0; })
+                                       .Add("min_observations", &TriangulationOptions::min_observations, 2,
+                                            [](const IndexT &value)
+                                            { return value >= 2; })
+                                       .Add("refine_with_inliers", &TriangulationOptions::refine_with_inliers, true)
+                                       .Add("num_threads", &TriangulationOptions::num_threads, 0,
+                                            [](const int &value)
+                                            { return value >= 0; })
+                                       .Add("block_size", &TriangulationOptions::block_size, 4096,
+                                            [](const IndexT &value)
+                                            { return value > 0; });
+        return schema;
+    }
+
+    DataPtr MethodTriangulation::Run()
+    {
+        PROFILER_START_AUTO(enable_profiling_);
+
+        DisplayConfigInfo();
+        GetOptionSchema().CompileWithWarnings(GetMethodOptions(), options_, GetType());
+
+        auto tracks_ptr = GetDataPtr<Tracks>(required_package_["data_tracks"]);
+        auto poses_ptr = GetDataPtr<GlobalPoses>(required_package_["data_global_poses"]);
+        auto cameras_ptr = GetDataPtr<CameraModels>(required_package_["data_camera_models"]);
+        if (!tracks_ptr || !poses_ptr || !cameras_ptr)
+        {
+            LOG_ERROR_ZH << "[MethodTriangulation] 缺少输入数据（data_tracks / data_global_poses / data_camera_models）";
+            LOG_ERROR_EN << "[MethodTriangulation] Missing input data (data_tracks / data_global_poses / data_camera_models)";
+            return nullptr;
+        }
+
+        auto points_data = FactoryData::Create("data_points_3d");
+        auto points_ptr = GetDataPtr<WorldPointInfo>(points_data);
+        if (!points_ptr)
+        {
+            LOG_ERROR_ZH << "[MethodTriangulation] 创建data_points_3d失败";
+            LOG_ERROR_EN << "[MethodTriangulation] Failed to create data_points_3d";
+            return nullptr;
+        }
+
+        common::TrackTriangulationOptions triangulation;
+        common::ParseTriangulationKernel(options_.kernel, triangulation.kernel);
+        triangulation.max_reprojection_error = options_.max_reprojection_error;
+        triangulation.min_angle_deg = options_.min_angle_deg;
+        triangulation.min_observations = options_.min_observations;
+        triangulation.refine_with_inliers = options_.refine_with_inliers;
+        triangulation.num_threads = options_.num_threads;
+        triangulation.block_size = options_.block_size;
+
+        common::TrackTriangulationStats stats;
+        if (!common::TriangulateTracks(*tracks_ptr, *poses_ptr, *cameras_ptr, triangulation, *points_ptr, &stats))
+        {
+            LOG_ERROR_ZH << "[MethodTriangulation] 三角化失败：相机模型为空";
+            LOG_ERROR_EN << "[MethodTriangulation] Triangulation failed: no camera models";
+            return nullptr;
+        }
+
+        LOG_INFO_ZH << "[MethodTriangulation] " << options_.kernel << "三角化: " << stats.triangulated << "/" << stats.tracks
+                    << " 条轨迹成功（观测 " << stats.observations << "），耗时 " << std::fixed << std::setprecision(3)
+                    << stats.seconds << "s";
+        LOG_INFO_EN << "[MethodTriangulation] " << options_.kernel << " triangulation: " << stats.triangulated << "/" << stats.tracks
+                    << " tracks (" << stats.observations << " observations) in " << std::fixed << std::setprecision(3)
+                    << stats.seconds << "s";
+        LOG_DEBUG_ZH << "[MethodTriangulation] 拒绝: 观测不足 " << stats.too_few_observations
+                     << "，角度不足 " << stats.rejected_angle
+                     << "，正深度 " << stats.rejected_cheirality
+                     << "，重投影 " << stats.rejected_reprojection;
+        LOG_DEBUG_EN << "[MethodTriangulation] Rejected: too few observations " << stats.too_few_observations
+                     << ", angle " << stats.rejected_angle
+                     << ", cheirality " << stats.rejected_cheirality
+                     << ", reprojection " << stats.rejected_reprojection;
+
+        if (stats.triangulated == 0)
+        {
+            LOG_WARNING_ZH << "[MethodTriangulation] 没有轨迹通过三角化检查";
+            LOG_WARNING_EN << "[MethodTriangulation] No track passed the triangulation checks";
+        }
+        return points_data;
+    }
+
+} // namespace PluginMethods
+
+REGISTRATION_PLUGIN(PluginMethods::MethodTriangulation, "method_triangulation")
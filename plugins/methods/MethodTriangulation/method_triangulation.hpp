@@ -0,0 +1,54 @@
+/**
+ * @file method_triangulation.hpp
+ * @brief 轨迹并行批量三角化
+ * @details 输入Tracks + GlobalPoses + CameraModels，逐轨迹用中点法或DLT三角化，
+ *          经正深度和重投影检查后输出data_points_3d（点下标与轨迹ID一一对应），
+ *          可直接用于Meshlab和PoSDK2Colmap导出。
+ * @copyright Copyright (c) 2024 PoSDK
+ */
+
+#pragma once
+
+#include <po_core.hpp>
+#include <common/estimator/track_triangulation.hpp>
+#include <common/options/option_schema.hpp>
+#include <po_core/po_logger.hpp>
+
+namespace PluginMethods
+{
+    using namespace PoSDK;
+    using namespace Interface;
+    using namespace types;
+
+    class MethodTriangulation : public Interface::MethodPresetProfiler
+    {
+    public:
+        MethodTriangulation();
+        ~MethodTriangulation() = default;
+
+        DataPtr Run() override;
+
+        // ✨ GetType() is automatically implemented by REGISTRATION_PLUGIN macro
+        const std::string &GetType() const override;
+
+    private:
+        /**
+         * @brief 每次Run()编译一次的选项
+         */
+        struct TriangulationOptions
+        {
+            std::string kernel = "midpoint";     // midpoint | dlt
+            double max_reprojection_error = 4.0; // 像素
+            double min_angle_deg = 1.0;          // 点的最大射线夹角下限（度）
+            IndexT min_observations = 2;
+            bool refine_with_inliers = true;
+            int num_threads = 0; // 0表示硬件并发数
+            IndexT block_size = 4096;
+        };
+
+        static const common::OptionSchema<TriangulationOptions> &GetOptionSchema();
+
+        TriangulationOptions options_;
+    };
+
+} // namespace PluginMethods
@@ -27,9 +27,28 @@ namespace PluginMethods
         InitializeDefaultConfigPath();
     }
 
+    const common::OptionSchema<OpenCVTwoViewEstimator::EstimatorOptions> &OpenCVTwoViewEstimator::GetOptionSchema()
+    {
+        static const auto schema = common::OptionSchema<EstimatorOptions>()
+                                       .Add("view_i", &EstimatorOptions::view_i, 0)
+                                       .Add("view_j", &EstimatorOptions::view_j, 1)
+                                       .Add("algorithm", &EstimatorOptions::algorithm, "findEssentialMat_ransac")
+                                       .Add("ransac_threshold", &EstimatorOptions::ransac_threshold, 0.0)
+                                       .Add("confidence", &EstimatorOptions::confidence, 0.99,
+                                            [](const double &value)
+                                            { return value > 0.0 && value <= 1.0; })
+                                       .Add("max_iterations", &EstimatorOptions::max_iterations, 2000,
+                                            [](const IndexT &value)
+                                            { return value > 0; });
+        return schema;
+    }
+
     DataPtr OpenCVTwoViewEstimator::Run()
     {
         DisplayConfigInfo();
+        // Compile options only when they changed; the rest of Run() reads typed fields | 选项变化时才编译，Run()其余部分读取类型化字段
+        GetOptionSchema().CompileIfChanged(GetMethodOptions(), options_, GetType(), compiled_options_);
+
         // 1. Get input data | 1. 获取输入数据
         auto sample_ptr = CastToSample<IdMatches>(required_package_["data_sample"]);
         auto features_ptr = GetDataPtr<FeaturesInfo>(required_package_["data_features"]);
@@ -42,14 +61,11 @@ namespace PluginMethods
             return nullptr;
         }
 
-        // 2. 从method_options_获取视图对信息
-        ViewPair view_pair(
-            GetOptionAsIndexT("view_i", 0), // 源视图ID
-            GetOptionAsIndexT("view_j", 1)  // 目标视图ID
-        );
+        // 2. 获取视图对信息（类型化视图对优先，否则取自method_options_）
+        ViewPair view_pair = ResolveViewPair(options_.view_i, options_.view_j);
 
         // 3. 获取算法类型
-        std::string algorithm_str = GetOptionAsString("algorithm", "findEssentialMat_ransac");
+        const std::string &algorithm_str = options_.algorithm;
         OpenCVAlgorithm algorithm = CreateAlgorithmFromString(algorithm_str);
 
         std::string algo_msg = LanguageEnvironment::GetText(
@@ -391,9 +407,9 @@ namespace PluginMethods
         cv::Mat &inliers_mask)
     {
         int method = GetOpenCVMethodFlag(algorithm);
-        double ransac_threshold = GetOptionAsFloat("ransac_threshold", 1.0);
-        double confidence = GetOptionAsFloat("confidence", 0.99);
-        int max_iterations = GetOptionAsIndexT("max_iterations", 2000);
+        double ransac_threshold = options_.ransac_threshold > 0.0 ? options_.ransac_threshold : 1.0;
+        double confidence = options_.confidence;
+        int max_iterations = static_cast<int>(options_.max_iterations);
 
         cv::Mat fundamental_matrix;
 
@@ -432,9 +448,9 @@ namespace PluginMethods
         cv::Mat &inliers_mask)
     {
         int method = GetOpenCVMethodFlag(algorithm);
-        double ransac_threshold = GetOptionAsFloat("ransac_threshold", 1.0);
-        double confidence = GetOptionAsFloat("confidence", 0.99);
-        int max_iterations = GetOptionAsIndexT("max_iterations", 2000);
+        double ransac_threshold = options_.ransac_threshold > 0.0 ? options_.ransac_threshold : 1.0;
+        double confidence = options_.confidence;
+        int max_iterations = static_cast<int>(options_.max_iterations);
 
         cv::Mat essential_matrix;
 
@@ -463,9 +479,9 @@ namespace PluginMethods
         cv::Mat &inliers_mask)
     {
         int method = GetOpenCVMethodFlag(algorithm);
-        double ransac_threshold = GetOptionAsFloat("ransac_threshold", 3.0); // 单应性通常用较大阈值
-        double confidence = GetOptionAsFloat("confidence", 0.99);
-        int max_iterations = GetOptionAsIndexT("max_iterations", 2000);
+        double ransac_threshold = options_.ransac_threshold > 0.0 ? options_.ransac_threshold : 3.0; // 单应性通常用较大阈值
+        double confidence = options_.confidence;
+        int max_iterations = static_cast<int>(options_.max_iterations);
 
         cv::Mat homography;
 
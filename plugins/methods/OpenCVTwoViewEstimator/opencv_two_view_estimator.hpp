@@ -10,6 +10,7 @@
 
 #include <po_core.hpp>
 #include <common/converter/converter_opencv.hpp>
+#include <common/options/option_schema.hpp>
 #include <opencv2/calib3d.hpp>
 #include <opencv2/core.hpp>
 #include <boost/algorithm/string.hpp>
@@ -23,7 +24,8 @@ namespace PluginMethods
     using namespace Interface;
     using namespace types;
 
-    class OpenCVTwoViewEstimator : public MethodPresetProfiler
+    class OpenCVTwoViewEstimator : public MethodPresetProfiler,
+                                   public common::TypedViewPairTarget
     {
     public:
         /**
@@ -66,6 +68,25 @@ namespace PluginMethods
         const std::string &GetType() const override;
 
     private:
+        /**
+         * @brief Options compiled once per Run() | 每次Run()编译一次的选项
+         */
+        struct EstimatorOptions
+        {
+            IndexT view_i = 0;
+            IndexT view_j = 1;
+            std::string algorithm = "findEssentialMat_ransac";
+            // <= 0 keeps the algorithm default (1.0, homography 3.0) | <=0时使用算法默认值（1.0，单应性3.0）
+            double ransac_threshold = 0.0;
+            double confidence = 0.99;
+            IndexT max_iterations = 2000;
+        };
+
+        static const common::OptionSchema<EstimatorOptions> &GetOptionSchema();
+
+        EstimatorOptions options_;
+        std::optional<MethodOptions> compiled_options_; // options_编译自的选项表，未变化时不重新编译
+
         /**
          * @brief Create algorithm enum from string | 从字符串创建算法枚举
          * @param algorithm_str Algorithm string | 算法字符串
@@ -7,7 +7,9 @@
 #include "opengv_model_estimator.hpp"
 #include <opengv/relative_pose/methods.hpp>
 #include <opengv/triangulation/methods.hpp>
+#include <algorithm>
 #include <limits>
+#include <sstream>
 #include <cmath>
 #include <po_core/po_logger.hpp>
 #include <po_core/ProfilerManager.hpp> // Profiler system | 性能分析系统
@@ -29,13 +31,40 @@ namespace PluginMethods
         InitializeDefaultConfigPath("refine");
     }
 
+    const common::OptionSchema<OpenGVModelEstimator::EstimatorOptions> &OpenGVModelEstimator::GetOptionSchema()
+    {
+        // 默认阈值：800像素焦距下sqrt(2)*0.5像素误差对应的角度残差
+        static const double default_threshold = 2.0 * (1.0 - cos(atan(sqrt(2.0) * 0.5 / 800.0)));
+        static const auto schema = common::OptionSchema<EstimatorOptions>()
+                                       .Add("view_i", &EstimatorOptions::view_i, 0)
+                                       .Add("view_j", &EstimatorOptions::view_j, 1)
+                                       .Add("algorithm", &EstimatorOptions::algorithm, "fivept_stewenius")
+                                       .Add("refine_model", &EstimatorOptions::refine_model, "none")
+                                       .Add("ransac_threshold", &EstimatorOptions::ransac_threshold, default_threshold,
+                                            [](const double &value)
+                                            { return value > 0.0; })
+                                       .Add("ransac_max_iterations", &EstimatorOptions::ransac_max_iterations, 50)
+                                       .Add("ransac_confidence", &EstimatorOptions::ransac_confidence, 0.99,
+                                            [](const double &value)
+                                            { return value > 0.0 && value < 1.0; })
+                                       .Add("ransac_scoring_precision", &EstimatorOptions::ransac_scoring_precision, "double",
+                                            [](const std::string &value)
+                                            { return value == "double" || value == "float" || value == "validate"; })
+                                       .Add("use_weights", &EstimatorOptions::use_weights, false);
+        return schema;
+    }
+
     DataPtr OpenGVModelEstimator::Run()
     {
         LOG_DEBUG_ZH << "OpenGV 模型估计器: 调试输出已启用";
         LOG_DEBUG_EN << "OpenGV Model Estimator: Debug output is enabled";
         // DisplayConfigInfo();
 
-        std::string algorithm = GetOptionAsString("algorithm", "fivept_stewenius");
+        // 选项变化时才重新编译，Run()其余部分读取类型化字段
+        GetOptionSchema().CompileIfChanged(GetMethodOptions(), options_, GetType(), compiled_options_);
+        ReportRansacIterations(0);
+
+        const std::string &algorithm = options_.algorithm;
         std::string algo_msg = LanguageEnvironment::GetText(
             "OpenGV 模型估计器 - 来自选项的算法: " + algorithm,
             "OpenGV Model Estimator - Algorithm from options: " + algorithm);
@@ -55,11 +84,8 @@ namespace PluginMethods
             return nullptr;
         }
 
-        // 2. 从method_options_获取视图对信息
-        ViewPair view_pair(
-            GetOptionAsIndexT("view_i", 0), // 源视图ID
-            GetOptionAsIndexT("view_j", 1)  // 目标视图ID
-        );
+        // 2. 获取视图对信息（类型化视图对优先，否则取自method_options_）
+        ViewPair view_pair = ResolveViewPair(options_.view_i, options_.view_j);
 
         // 3. 获取匹配数据并进行初步检查
         if (sample_ptr->empty())
@@ -98,12 +124,40 @@ namespace PluginMethods
             LOG_DEBUG_EN << match_msg;
         }
 
-        // 4. 创建OpenGV适配器
+        // 4. 创建OpenGV适配器（原生求解器直接使用bearing pairs，仅在需要模型优化时填充适配器）
+        const bool is_native = IsNativeAlgorithm(algorithm);
+        BearingPairs bearing_pairs;
         opengv::bearingVectors_t bearingVectors1, bearingVectors2;
 
-        if (!Converter::OpenGVConverter::MatchesToBearingVectors(
+        bool converted = false;
+        common::minimal::AffineFrames affine_frames;
+        if (is_native)
+        {
+            converted = types::MatchesToBearingPairs(*sample_ptr, *features_ptr, *cameras_ptr, view_pair, bearing_pairs);
+            if (converted && IsAffineAlgorithm(algorithm))
+            {
+                // 特征无尺度/方向时affine_frames为空，估计时回退到五点法
+                common::MatchesToAffineFrames(*sample_ptr, *features_ptr, *cameras_ptr, view_pair, affine_frames);
+            }
+            if (converted && CreateRefineMethodFromString(options_.refine_model) != RefineMethod::NONE)
+            {
+                bearingVectors1.reserve(bearing_pairs.size());
+                bearingVectors2.reserve(bearing_pairs.size());
+                for (const auto &bp : bearing_pairs)
+                {
+                    bearingVectors1.emplace_back(bp.head<3>());
+                    bearingVectors2.emplace_back(bp.tail<3>());
+                }
+            }
+        }
+        else
+        {
+            converted = Converter::OpenGVConverter::MatchesToBearingVectors(
                 *sample_ptr, *features_ptr, *cameras_ptr, view_pair,
-                bearingVectors1, bearingVectors2))
+                bearingVectors1, bearingVectors2);
+        }
+
+        if (!converted)
         {
             std::string err_msg = LanguageEnvironment::GetText(
                 "转换匹配到 bearing vectors 失败",
@@ -131,7 +185,11 @@ namespace PluginMethods
             {
                 PROFILER_STAGE("ransac_estimation"); // Mark RANSAC stage | 标记RANSAC阶段
                 // RANSAC方法
-                transformation = EstimateRelativePoseRansac(adapter, inliers);
+                size_t realized_iterations = 0;
+                transformation = is_native ? EstimateRelativePoseNative(bearing_pairs, view_pair, inliers, nullptr, &realized_iterations,
+                                                                        affine_frames.empty() ? nullptr : &affine_frames)
+                                           : EstimateRelativePoseRansac(adapter, inliers, nullptr, &realized_iterations);
+                ReportRansacIterations(realized_iterations);
 
                 // 注意: 质量验证功能已移至TwoViewEstimator统一管控
                 // 这里只负责算法执行和内点标记，质量检查由上层框架处理
@@ -228,7 +286,7 @@ namespace PluginMethods
             }
 
             // 7. 检查是否需要进行模型优化
-            std::string refine_model_str = GetOptionAsString("refine_model", "none");
+            const std::string &refine_model_str = options_.refine_model;
             RefineMethod refine_method = CreateRefineMethodFromString(refine_model_str);
 
             if (refine_method != RefineMethod::NONE)
@@ -280,11 +338,120 @@ namespace PluginMethods
         return std::make_shared<DataMap<RelativePose>>(relative_pose, "data_relative_pose");
     }
 
+    bool OpenGVModelEstimator::SupportsBatchEstimation()
+    {
+        GetOptionSchema().CompileIfChanged(GetMethodOptions(), options_, GetType(), compiled_options_);
+        return options_.algorithm != "twopt" &&
+               options_.algorithm != "posdk_twopt_ransac" &&
+               !IsAffineAlgorithm(options_.algorithm) &&
+               CreateRefineMethodFromString(options_.refine_model) == RefineMethod::NONE;
+    }
+
+    void OpenGVModelEstimator::EstimateBatch(const common::TwoViewBatchSpan &items,
+                                             std::vector<common::TwoViewBatchResult> &results)
+    {
+        GetOptionSchema().CompileIfChanged(GetMethodOptions(), options_, GetType(), compiled_options_);
+        const std::string &algorithm = options_.algorithm;
+        const size_t min_samples = GetMinimumSamplesForAlgorithm(algorithm);
+        const bool is_ransac = IsRansacAlgorithm(algorithm);
+        const bool is_native = IsNativeAlgorithm(algorithm);
+
+        results.clear();
+        results.resize(items.size);
+
+        // 复用bearing缓冲区，避免逐对分配
+        opengv::bearingVectors_t bearing_vectors1, bearing_vectors2;
+        std::vector<int> inliers;
+
+        for (size_t k = 0; k < items.size; ++k)
+        {
+            const auto &item = items[k];
+            auto &result = results[k];
+            if (!item.bearing_pairs || item.bearing_pairs->size() < min_samples)
+            {
+                continue;
+            }
+
+            const auto &bearing_pairs = *item.bearing_pairs;
+            transformation_t transformation;
+            if (is_native)
+            {
+                // 原生求解器直接作用于预转换的bearing pairs
+                transformation = EstimateRelativePoseNative(bearing_pairs, item.view_pair, inliers,
+                                                            item.budget, &result.iterations);
+                result.inliers.assign(bearing_pairs.size(), false);
+                for (int idx : inliers)
+                {
+                    if (idx >= 0 && static_cast<size_t>(idx) < result.inliers.size())
+                    {
+                        result.inliers[idx] = true;
+                    }
+                }
+                if (transformation.block<3, 3>(0, 0).determinant() < 1e-6)
+                {
+                    result.inliers.assign(bearing_pairs.size(), false);
+                    continue;
+                }
+                result.pose = RelativePose(item.view_pair.first,
+                                           item.view_pair.second,
+                                           transformation.block<3, 3>(0, 0),
+                                           transformation.block<3, 1>(0, 3),
+                                           1.0f);
+                result.success = true;
+                continue;
+            }
+
+            bearing_vectors1.clear();
+            bearing_vectors2.clear();
+            bearing_vectors1.reserve(bearing_pairs.size());
+            bearing_vectors2.reserve(bearing_pairs.size());
+            for (const auto &bp : bearing_pairs)
+            {
+                bearing_vectors1.emplace_back(bp.head<3>());
+                bearing_vectors2.emplace_back(bp.tail<3>());
+            }
+
+            opengv::relative_pose::CentralRelativeAdapter adapter(bearing_vectors1, bearing_vectors2);
+
+            if (is_ransac)
+            {
+                transformation = EstimateRelativePoseRansac(adapter, inliers, item.budget, &result.iterations);
+                result.inliers.assign(bearing_pairs.size(), false);
+                for (int idx : inliers)
+                {
+                    if (idx >= 0 && static_cast<size_t>(idx) < result.inliers.size())
+                    {
+                        result.inliers[idx] = true;
+                    }
+                }
+            }
+            else
+            {
+                // 直接方法：所有匹配点都被认为是内点（与Run()一致）
+                transformation = EstimateRelativePose(adapter);
+                result.inliers.assign(bearing_pairs.size(), true);
+            }
+
+            if (transformation.block<3, 3>(0, 0).determinant() < 1e-6)
+            {
+                result.inliers.assign(bearing_pairs.size(), false);
+                continue;
+            }
+
+            result.pose = RelativePose(item.view_pair.first,
+                                       item.view_pair.second,
+                                       transformation.block<3, 3>(0, 0),
+                                       transformation.block<3, 1>(0, 3),
+                                       1.0f);
+            result.success = true;
+        }
+    }
+
     transformation_t OpenGVModelEstimator::EstimateRelativePose(
         opengv::relative_pose::CentralRelativeAdapter &adapter)
     {
         // 获取算法类型
-        auto algorithm = GetOptionAsString("algorithm", "fivept_stewenius");
+        const std::string &algorithm = options_.algorithm;
 
         opengv::transformation_t best_transformation = opengv::transformation_t::Zero();
 
@@ -444,14 +611,20 @@ namespace PluginMethods
 
     transformation_t OpenGVModelEstimator::EstimateRelativePoseRansac(
         opengv::relative_pose::CentralRelativeAdapter &adapter,
-        std::vector<int> &inliers)
+        std::vector<int> &inliers,
+        const common::RansacBudget *budget,
+        size_t *realized_iterations)
     {
         // 获取算法类型
-        std::string algorithm = GetOptionAsString("algorithm", "fivept_stewenius_ransac");
+        const std::string &algorithm = options_.algorithm;
 
-        // 配置RANSAC参数
-        double ransac_threshold = GetOptionAsFloat("ransac_threshold", 2.0 * (1.0 - cos(atan(sqrt(2.0) * 0.5 / 800.0))));
-        int max_iterations = GetOptionAsIndexT("ransac_max_iterations", 50);
+        // 配置RANSAC参数（逐对预算优先）
+        const double ransac_threshold = options_.ransac_threshold;
+        const int max_iterations = budget && budget->max_iterations > 0
+                                       ? static_cast<int>(budget->max_iterations)
+                                       : static_cast<int>(options_.ransac_max_iterations);
+        const double confidence = budget ? budget->confidence : options_.ransac_confidence;
+        int iterations_used = 0;
 
         opengv::transformation_t result_transformation = opengv::transformation_t::Zero();
         inliers.clear();
@@ -468,7 +641,9 @@ namespace PluginMethods
                 ransac.sac_model_ = problem;
                 ransac.threshold_ = ransac_threshold;
                 ransac.max_iterations_ = max_iterations;
+                ransac.probability_ = confidence;
                 ransac.computeModel();
+                iterations_used = ransac.iterations_;
 
                 // 构造变换矩阵 (仅旋转)
                 result_transformation.block<3, 3>(0, 0) = ransac.model_coefficients_;
@@ -485,7 +660,9 @@ namespace PluginMethods
                 ransac.sac_model_ = problem;
                 ransac.threshold_ = ransac_threshold;
                 ransac.max_iterations_ = max_iterations;
+                ransac.probability_ = confidence;
                 ransac.computeModel();
+                iterations_used = ransac.iterations_;
 
                 result_transformation = ransac.model_coefficients_;
                 inliers = ransac.inliers_;
@@ -500,7 +677,9 @@ namespace PluginMethods
                 ransac.sac_model_ = problem;
                 ransac.threshold_ = ransac_threshold;
                 ransac.max_iterations_ = max_iterations;
+                ransac.probability_ = confidence;
                 ransac.computeModel();
+                iterations_used = ransac.iterations_;
 
                 result_transformation = ransac.model_coefficients_;
                 inliers = ransac.inliers_;
@@ -515,7 +694,9 @@ namespace PluginMethods
                 ransac.sac_model_ = problem;
                 ransac.threshold_ = ransac_threshold;
                 ransac.max_iterations_ = max_iterations;
+                ransac.probability_ = confidence;
                 ransac.computeModel();
+                iterations_used = ransac.iterations_;
 
                 result_transformation = ransac.model_coefficients_;
                 inliers = ransac.inliers_;
@@ -530,7 +711,9 @@ namespace PluginMethods
                 ransac.sac_model_ = problem;
                 ransac.threshold_ = ransac_threshold;
                 ransac.max_iterations_ = max_iterations;
+                ransac.probability_ = confidence;
                 ransac.computeModel();
+                iterations_used = ransac.iterations_;
 
                 result_transformation = ransac.model_coefficients_;
                 inliers = ransac.inliers_;
@@ -545,7 +728,9 @@ namespace PluginMethods
                 ransac.sac_model_ = problem;
                 ransac.threshold_ = ransac_threshold;
                 ransac.max_iterations_ = max_iterations;
+                ransac.probability_ = confidence;
                 ransac.computeModel();
+                iterations_used = ransac.iterations_;
 
                 // 构造变换矩阵
                 result_transformation.block<3, 3>(0, 0) = ransac.model_coefficients_.rotation;
@@ -567,7 +752,9 @@ namespace PluginMethods
                 ransac.sac_model_ = problem;
                 ransac.threshold_ = ransac_threshold;
                 ransac.max_iterations_ = max_iterations;
+                ransac.probability_ = confidence;
                 ransac.computeModel();
+                iterations_used = ransac.iterations_;
 
                 result_transformation = ransac.model_coefficients_;
                 inliers = ransac.inliers_;
@@ -582,9 +769,164 @@ namespace PluginMethods
             LOG_ERROR_EN << err_msg << e.what();
         }
 
+        if (realized_iterations)
+        {
+            *realized_iterations = static_cast<size_t>(std::max(iterations_used, 0));
+        }
+        if (SHOULD_LOG(DEBUG))
+        {
+            LOG_DEBUG_ZH << "RANSAC 迭代: " << iterations_used << "/" << max_iterations << ", 内点: " << inliers.size();
+            LOG_DEBUG_EN << "RANSAC iterations: " << iterations_used << "/" << max_iterations << ", Inliers: " << inliers.size();
+        }
+
         return result_transformation;
     }
 
+    transformation_t OpenGVModelEstimator::EstimateRelativePoseNative(
+        const BearingPairs &bearing_pairs,
+        const ViewPair &view_pair,
+        std::vector<int> &inliers,
+        const common::RansacBudget *budget,
+        size_t *realized_iterations,
+        const common::minimal::AffineFrames *affine_frames)
+    {
+        using namespace common::minimal;
+        const std::string &algorithm = options_.algorithm;
+
+        // 逐对预算优先，否则使用ransac_*选项
+        NativeRansacOptions ransac_options;
+        ransac_options.threshold = options_.ransac_threshold;
+        ransac_options.max_iterations = budget && budget->max_iterations > 0
+                                            ? budget->max_iterations
+                                            : static_cast<size_t>(options_.ransac_max_iterations);
+        ransac_options.confidence = budget ? budget->confidence : options_.ransac_confidence;
+        // 按视图对确定随机种子，结果可复现
+        ransac_options.seed = static_cast<uint32_t>(view_pair.first * 73856093u ^ view_pair.second * 19349663u);
+
+        inliers.clear();
+        if (algorithm == "posdk_twopt_ransac")
+        {
+            auto it_R = prior_info_.find("R_prior");
+            auto R_ptr = it_R != prior_info_.end() ? GetDataPtr<opengv::rotation_t>(it_R->second) : nullptr;
+            if (!R_ptr)
+            {
+                std::string err_msg = LanguageEnvironment::GetText(
+                    "posdk_twopt_ransac 算法需要先验旋转矩阵",
+                    "Prior rotation matrix is required for posdk_twopt_ransac algorithm");
+                LOG_ERROR_ZH << err_msg;
+                LOG_ERROR_EN << err_msg;
+                return transformation_t::Zero();
+            }
+            // OpenGV的R12将视图2坐标变换到视图1，PoSDK约定 xj ~ R xi + t 对应其转置
+            ransac_options.prior_rotation = R_ptr->transpose();
+            ransac_options.has_prior_rotation = true;
+        }
+
+        if (IsAffineAlgorithm(algorithm) && affine_frames && affine_frames->size() == bearing_pairs.size())
+        {
+            ransac_options.affine_frames = affine_frames;
+        }
+
+        const auto run_ransac = [&](const NativeRansacOptions &run_options, NativeRansacResult &out)
+        {
+            if (algorithm == "posdk_fivept_ransac")
+            {
+                RunNativeRansac<FivePointSolver>(bearing_pairs, run_options, out);
+            }
+            else if (algorithm == "posdk_sevenpt_ransac")
+            {
+                RunNativeRansac<SevenPointSolver>(bearing_pairs, run_options, out);
+            }
+            else if (algorithm == "posdk_eightpt_ransac")
+            {
+                RunNativeRansac<EightPointSolver>(bearing_pairs, run_options, out);
+            }
+            else if (algorithm == "posdk_twopt_ransac")
+            {
+                RunNativeRansac<TwoPointSolver>(bearing_pairs, run_options, out);
+            }
+            else if (algorithm == "posdk_upright3pt_ransac")
+            {
+                RunNativeRansac<UprightThreePointSolver>(bearing_pairs, run_options, out);
+            }
+            else if (IsAffineAlgorithm(algorithm))
+            {
+                if (run_options.affine_frames)
+                {
+                    RunNativeRansac<TwoAffineSolver>(bearing_pairs, run_options, out);
+                }
+                else
+                {
+                    std::string warn_msg = LanguageEnvironment::GetText(
+                        "特征缺少尺度/方向，posdk_affine2pt_ransac 回退到 posdk_fivept_ransac",
+                        "Features carry no scale/orientation, posdk_affine2pt_ransac falls back to posdk_fivept_ransac");
+                    LOG_WARNING_ZH << warn_msg;
+                    LOG_WARNING_EN << warn_msg;
+                    RunNativeRansac<FivePointSolver>(bearing_pairs, run_options, out);
+                }
+            }
+            else
+            {
+                std::string warn_msg = LanguageEnvironment::GetText(
+                    "未知原生算法: " + algorithm + ", 使用默认 posdk_fivept_ransac",
+                    "Unknown native algorithm: " + algorithm + ", using default posdk_fivept_ransac");
+                LOG_WARNING_ZH << warn_msg;
+                LOG_WARNING_EN << warn_msg;
+                RunNativeRansac<FivePointSolver>(bearing_pairs, run_options, out);
+            }
+        };
+
+        // 评分精度：validate模式同时运行float32与double评分，比较后使用double结果
+        const std::string &precision = options_.ransac_scoring_precision;
+        ransac_options.scoring_precision = precision == "float" ? ScoringPrecision::Float : ScoringPrecision::Double;
+        NativeRansacResult result;
+        run_ransac(ransac_options, result);
+        if (precision == "validate")
+        {
+            NativeRansacOptions float_options = ransac_options;
+            float_options.scoring_precision = ScoringPrecision::Float;
+            NativeRansacResult float_result;
+            run_ransac(float_options, float_result);
+
+            const NativeRansacAgreement agreement = CompareNativeRansacResults(result, float_result);
+            std::ostringstream detail;
+            detail << "(" << view_pair.first << "," << view_pair.second << "): jaccard=" << agreement.inlier_jaccard
+                   << ", dR=" << agreement.rotation_deg << "deg, dt=" << agreement.translation_deg << "deg, inliers "
+                   << result.inliers.size() << "/" << float_result.inliers.size();
+            if (!agreement.WithinTolerance())
+            {
+                LOG_WARNING_ZH << "float32评分与double结果不一致 " << detail.str();
+                LOG_WARNING_EN << "float32 scoring disagrees with double " << detail.str();
+            }
+            else if (SHOULD_LOG(DEBUG))
+            {
+                LOG_DEBUG_ZH << "float32评分与double结果一致 " << detail.str();
+                LOG_DEBUG_EN << "float32 scoring agrees with double " << detail.str();
+            }
+        }
+
+        if (realized_iterations)
+        {
+            *realized_iterations = result.iterations;
+        }
+        if (SHOULD_LOG(DEBUG))
+        {
+            LOG_DEBUG_ZH << "原生 RANSAC 迭代: " << result.iterations << "/" << ransac_options.max_iterations << ", 内点: " << result.inliers.size();
+            LOG_DEBUG_EN << "Native RANSAC iterations: " << result.iterations << "/" << ransac_options.max_iterations << ", Inliers: " << result.inliers.size();
+        }
+        if (!result.success)
+        {
+            return transformation_t::Zero();
+        }
+
+        // 转换为OpenGV约定（与其他算法输出一致）: R12 = R^T, t12 = -R^T * t
+        inliers = std::move(result.inliers);
+        transformation_t transformation;
+        transformation.block<3, 3>(0, 0) = result.pose.R.transpose();
+        transformation.block<3, 1>(0, 3) = -result.pose.R.transpose() * result.pose.t;
+        return transformation;
+    }
+
     // 辅助函数:从Essential矩阵集合中选择最佳变换
     opengv::transformation_t OpenGVModelEstimator::GetBestTransformationFromEssentials(
         opengv::relative_pose::CentralRelativeAdapter &adapter,
@@ -901,7 +1243,7 @@ namespace PluginMethods
             transformation_t refined_transformation = initial_transformation;
 
             // 检查是否是 RANSAC 模式，如果是则只使用内点进行优化
-            std::string algorithm = GetOptionAsString("algorithm", "fivept_stewenius");
+            const std::string &algorithm = options_.algorithm;
             std::vector<int> inlier_indices;
 
             if (IsRansacAlgorithm(algorithm))
@@ -943,7 +1285,7 @@ namespace PluginMethods
                 }
 
                 // 获取优化参数
-                bool use_weights = GetOptionAsBool("use_weights", false);
+                bool use_weights = options_.use_weights;
 
                 // 使用特征值分解法优化旋转
                 rotation_t optimized_rotation;
@@ -1083,10 +1425,27 @@ namespace PluginMethods
     size_t OpenGVModelEstimator::GetMinimumSamplesForAlgorithm(const std::string &algorithm) const
     {
         // 参考OpenMVG和OpenGV的要求
-        if (algorithm == "twopt" || algorithm == "twopt_rotationOnly")
+        if (algorithm == "twopt" || algorithm == "twopt_rotationOnly" || algorithm == "posdk_twopt_ransac" ||
+            algorithm == "posdk_affine2pt_ransac")
         {
             return 2;
         }
+        else if (algorithm == "posdk_upright3pt_ransac")
+        {
+            return 3;
+        }
+        else if (algorithm == "posdk_fivept_ransac")
+        {
+            return 5;
+        }
+        else if (algorithm == "posdk_sevenpt_ransac")
+        {
+            return 7;
+        }
+        else if (algorithm == "posdk_eightpt_ransac")
+        {
+            return 8;
+        }
         else if (algorithm == "rotationOnly")
         {
             return 3; // Arun方法至少需要3个点
@@ -9,6 +9,10 @@
 
 #include <po_core.hpp>
 #include <common/converter/converter_opengv.hpp>
+#include <common/estimator/two_view_batch.hpp>
+#include <common/estimator/affine_frames.hpp>
+#include <common/estimator/minimal_ransac.hpp>
+#include <common/options/option_schema.hpp>
 #include <opengv/relative_pose/methods.hpp>
 #include <opengv/relative_pose/CentralRelativeAdapter.hpp>
 #include <opengv/sac/Ransac.hpp>
@@ -25,7 +29,9 @@ namespace PluginMethods
     using namespace types;
     using namespace opengv;
 
-    class OpenGVModelEstimator : public MethodPresetProfiler
+    class OpenGVModelEstimator : public MethodPresetProfiler,
+                                 public common::TwoViewBatchEstimator,
+                                 public common::TypedViewPairTarget
     {
     public:
         /**
@@ -47,7 +53,43 @@ namespace PluginMethods
         // ✨ GetType() is automatically implemented by REGISTRATION_PLUGIN macro
         const std::string &GetType() const override;
 
+        /**
+         * @brief 当前配置是否支持批量估计
+         * @details twopt/posdk_twopt_ransac需要逐对先验旋转、posdk_affine2pt_ransac需要逐对特征仿射、
+         *          refine_model需要逐对内点样本，这些情况回退到逐对Build()
+         */
+        bool SupportsBatchEstimation() override;
+
+        /**
+         * @brief 批量估计多个视图对的相对位姿（使用预转换的bearing pairs）
+         * @param items 批次视图对
+         * @param results 输出结果（位姿为OpenGV内部约定，内点位集与bearing pairs对齐）
+         */
+        void EstimateBatch(const common::TwoViewBatchSpan &items,
+                           std::vector<common::TwoViewBatchResult> &results) override;
+
     private:
+        /**
+         * @brief 由方法选项编译的类型化选项（选项变化时才重新编译）
+         */
+        struct EstimatorOptions
+        {
+            IndexT view_i = 0;
+            IndexT view_j = 1;
+            std::string algorithm = "fivept_stewenius";
+            std::string refine_model = "none";
+            double ransac_threshold = 0.0;
+            IndexT ransac_max_iterations = 50;
+            double ransac_confidence = 0.99;
+            std::string ransac_scoring_precision = "double"; // posdk_*算法的内点评分精度：double/float/validate
+            bool use_weights = false;
+        };
+
+        static const common::OptionSchema<EstimatorOptions> &GetOptionSchema();
+
+        EstimatorOptions options_;
+        std::optional<MethodOptions> compiled_options_; // options_编译自的选项表，未变化时不重新编译
+
         /**
          * @brief 从字符串创建优化方法枚举
          * @param refine_str 优化方法字符串
@@ -75,14 +117,56 @@ namespace PluginMethods
             return algorithm.find("_ransac") != std::string::npos;
         }
 
+        /**
+         * @brief 判断算法是否为PoSDK原生最小求解器（posdk_*，直接作用于bearing pairs）
+         */
+        bool IsNativeAlgorithm(const std::string &algorithm) const
+        {
+            return boost::algorithm::starts_with(algorithm, "posdk_");
+        }
+
+        /**
+         * @brief 判断算法是否使用特征尺度/方向构造的局部仿射（两点仿射对应求解器）
+         */
+        bool IsAffineAlgorithm(const std::string &algorithm) const
+        {
+            return algorithm == "posdk_affine2pt_ransac";
+        }
+
+        /**
+         * @brief 使用PoSDK原生最小求解器的RANSAC估计相对位姿（无需OpenGV适配器）
+         * @param bearing_pairs 视图对的bearing pairs
+         * @param view_pair 视图对（用于确定随机种子）
+         * @param inliers 输出内点索引
+         * @param budget 逐对RANSAC预算（迭代上限/置信度/阈值，为空时使用ransac_*选项）
+         * @param realized_iterations 输出实际迭代次数（可为空）
+         * @param affine_frames 与bearing_pairs对齐的局部仿射（posdk_affine2pt_ransac使用，为空时回退到五点法）
+         * @return OpenGV约定的变换矩阵（与其他算法一致），失败时为零矩阵
+         */
+        transformation_t EstimateRelativePoseNative(
+            const BearingPairs &bearing_pairs,
+            const ViewPair &view_pair,
+            std::vector<int> &inliers,
+            const common::RansacBudget *budget = nullptr,
+            size_t *realized_iterations = nullptr,
+            const common::minimal::AffineFrames *affine_frames = nullptr);
+
         // 估计相对位姿
         transformation_t EstimateRelativePose(
             opengv::relative_pose::CentralRelativeAdapter &adapter);
 
-        // RANSAC估计相对位姿
+        /**
+         * @brief RANSAC估计相对位姿
+         * @param adapter OpenGV适配器
+         * @param inliers 输出内点索引
+         * @param budget 逐对RANSAC预算（迭代上限/置信度/阈值，为空时使用ransac_*选项）
+         * @param realized_iterations 输出实际迭代次数（可为空）
+         */
         transformation_t EstimateRelativePoseRansac(
             opengv::relative_pose::CentralRelativeAdapter &adapter,
-            std::vector<int> &inliers);
+            std::vector<int> &inliers,
+            const common::RansacBudget *budget = nullptr,
+            size_t *realized_iterations = nullptr);
 
         /**
          * @brief 优化模型
@@ -27,12 +27,36 @@ namespace PluginMethods
         InitializeDefaultConfigPath("refine");
     }
 
+    const common::OptionSchema<PoseLibModelEstimator::EstimatorOptions> &PoseLibModelEstimator::GetOptionSchema()
+    {
+        static const auto schema = common::OptionSchema<EstimatorOptions>()
+                                       .Add("view_i", &EstimatorOptions::view_i, 0)
+                                       .Add("view_j", &EstimatorOptions::view_j, 1)
+                                       .Add("algorithm", &EstimatorOptions::algorithm, "relpose_5pt")
+                                       .Add("refine_model", &EstimatorOptions::refine_model, "none")
+                                       .Add("ransac_max_iterations", &EstimatorOptions::ransac_max_iterations, 1000)
+                                       .Add("ransac_threshold", &EstimatorOptions::ransac_threshold, 1e-4,
+                                            [](const double &value)
+                                            { return value > 0.0; })
+                                       .Add("ransac_success_prob", &EstimatorOptions::ransac_success_prob, 0.9999,
+                                            [](const double &value)
+                                            { return value > 0.0 && value < 1.0; })
+                                       .Add("progressive_sampling", &EstimatorOptions::progressive_sampling, true)
+                                       .Add("max_iterations", &EstimatorOptions::max_iterations, 100)
+                                       .Add("loss_scale", &EstimatorOptions::loss_scale, 1.0);
+        return schema;
+    }
+
     DataPtr PoseLibModelEstimator::Run()
     {
         DisplayConfigInfo();
 
+        // 选项变化时才重新编译，Run()其余部分读取类型化字段
+        GetOptionSchema().CompileIfChanged(GetMethodOptions(), options_, GetType(), compiled_options_);
+        ReportRansacIterations(0);
+
         // 获取算法参数
-        std::string algorithm = GetOptionAsString("algorithm", "relpose_5pt");
+        const std::string &algorithm = options_.algorithm;
 
         // 1. 获取输入数据
         auto sample_ptr = CastToSample<IdMatches>(required_package_["data_sample"]);
@@ -47,11 +71,8 @@ namespace PluginMethods
             return nullptr;
         }
 
-        // 2. 从method_options_获取视图对信息
-        ViewPair view_pair(
-            GetOptionAsIndexT("view_i", 0), // 源视图ID
-            GetOptionAsIndexT("view_j", 1)  // 目标视图ID
-        );
+        // 2. 获取视图对信息（类型化视图对优先，否则取自method_options_）
+        ViewPair view_pair = ResolveViewPair(options_.view_i, options_.view_j);
 
         // 3. 获取匹配数据并进行初步检查
         if (sample_ptr->empty())
@@ -203,7 +224,7 @@ namespace PluginMethods
             }
 
             // 7. 检查是否需要进行模型优化
-            std::string refine_model_str = GetOptionAsString("refine_model", "none");
+            const std::string &refine_model_str = options_.refine_model;
             RefineMethod refine_method = CreateRefineMethodFromString(refine_model_str);
 
             if (refine_method != RefineMethod::NONE)
@@ -252,7 +273,7 @@ namespace PluginMethods
         const poselib::Camera &camera1,
         const poselib::Camera &camera2)
     {
-        std::string algorithm = GetOptionAsString("algorithm", "relpose_5pt");
+        const std::string &algorithm = options_.algorithm;
         poselib::CameraPoseVector poses;
 
         try
@@ -376,14 +397,15 @@ namespace PluginMethods
         const poselib::Camera &camera2,
         std::vector<char> &inliers)
     {
-        std::string algorithm = GetOptionAsString("algorithm", "relpose_5pt_ransac");
+        const std::string &algorithm = options_.algorithm;
         poselib::CameraPose best_pose;
 
         // 创建RANSAC配置
         poselib::RansacOptions ransac_opt;
-        ransac_opt.max_iterations = GetOptionAsIndexT("ransac_max_iterations", 1000);
-        ransac_opt.max_epipolar_error = GetOptionAsFloat("ransac_threshold", 1e-4);
-        ransac_opt.progressive_sampling = GetOptionAsBool("progressive_sampling", true);
+        ransac_opt.max_iterations = options_.ransac_max_iterations;
+        ransac_opt.max_epipolar_error = options_.ransac_threshold;
+        ransac_opt.success_prob = options_.ransac_success_prob;
+        ransac_opt.progressive_sampling = options_.progressive_sampling;
 
         // 创建Bundle配置
         poselib::BundleOptions bundle_opt;
@@ -394,6 +416,7 @@ namespace PluginMethods
             // 使用转换后的2D points进行RANSAC估计
             poselib::RansacStats stats = poselib::estimate_relative_pose(
                 points1, points2, camera1, camera2, ransac_opt, bundle_opt, &best_pose, &inliers);
+            ReportRansacIterations(stats.iterations);
 
             if (SHOULD_LOG(DEBUG))
             {
@@ -433,9 +456,9 @@ namespace PluginMethods
             {
                 // Bundle Adjustment优化
                 poselib::BundleOptions bundle_opt;
-                bundle_opt.max_iterations = GetOptionAsIndexT("max_iterations", 100);
+                bundle_opt.max_iterations = options_.max_iterations;
                 bundle_opt.loss_type = (refine_method == RefineMethod::BUNDLE_ADJUST) ? poselib::BundleOptions::LossType::CAUCHY : poselib::BundleOptions::LossType::TRIVIAL;
-                bundle_opt.loss_scale = GetOptionAsFloat("loss_scale", 1.0);
+                bundle_opt.loss_scale = options_.loss_scale;
 
                 // refine_relpose假设使用归一化坐标，需要转换像素坐标为归一化坐标
                 std::vector<poselib::Point2D> norm_points1, norm_points2;
@@ -629,9 +652,10 @@ namespace PluginMethods
     poselib::RansacOptions PoseLibModelEstimator::CreateRansacOptions() const
     {
         poselib::RansacOptions ransac_opt;
-        ransac_opt.max_iterations = GetOptionAsIndexT("ransac_max_iterations", 1000);
-        ransac_opt.max_epipolar_error = GetOptionAsFloat("ransac_threshold", 1e-4);
-        ransac_opt.progressive_sampling = GetOptionAsBool("progressive_sampling", true);
+        ransac_opt.max_iterations = options_.ransac_max_iterations;
+        ransac_opt.max_epipolar_error = options_.ransac_threshold;
+        ransac_opt.success_prob = options_.ransac_success_prob;
+        ransac_opt.progressive_sampling = options_.progressive_sampling;
 
         return ransac_opt;
     }
@@ -9,6 +9,7 @@
 
 #include <po_core.hpp>
 #include <common/converter/converter_opengv.hpp>
+#include <common/options/option_schema.hpp>
 #include <boost/algorithm/string.hpp>
 
 // PoseLib头文件
@@ -20,7 +21,8 @@ namespace PluginMethods
     using namespace Interface;
     using namespace types;
 
-    class PoseLibModelEstimator : public MethodPresetProfiler
+    class PoseLibModelEstimator : public MethodPresetProfiler,
+                                  public common::TypedViewPairTarget
     {
     public:
         /**
@@ -42,6 +44,28 @@ namespace PluginMethods
         const std::string &GetType() const override;
 
     private:
+        /**
+         * @brief 由方法选项编译的类型化选项（选项变化时才重新编译）
+         */
+        struct EstimatorOptions
+        {
+            IndexT view_i = 0;
+            IndexT view_j = 1;
+            std::string algorithm = "relpose_5pt";
+            std::string refine_model = "none";
+            IndexT ransac_max_iterations = 1000;
+            double ransac_threshold = 1e-4;
+            double ransac_success_prob = 0.9999;
+            bool progressive_sampling = true;
+            IndexT max_iterations = 100;
+            double loss_scale = 1.0;
+        };
+
+        static const common::OptionSchema<EstimatorOptions> &GetOptionSchema();
+
+        EstimatorOptions options_;
+        std::optional<MethodOptions> compiled_options_; // options_编译自的选项表，未变化时不重新编译
+
         /**
          * @brief 从字符串创建优化方法枚举
          * @param refine_str 优化方法字符串
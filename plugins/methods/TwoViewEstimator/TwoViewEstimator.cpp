@@ -14,6 +14,7 @@
 #include <mutex>
 #include <numeric>
 #include <algorithm>
+#include <map>
 
 #ifdef USE_OPENMP
 #include <omp.h>
@@ -25,6 +26,55 @@ namespace PluginMethods
     using namespace Interface;
     using namespace types;
 
+    namespace
+    {
+        /**
+         * @brief 视图对的日志记录：只有显式Commit()的结果才写入日志
+         * @details 成功估计与确定性跳过（匹配为空/不足、视图ID无效）需要提交；方法创建、bearing转换、
+         *          异常等可能是暂时性的失败不提交，续算时重新估计
+         */
+        class PairJournalRecord
+        {
+        public:
+            PairJournalRecord(common::PairJournal *journal, const ViewPair &view_pair, const IdMatches &matches)
+                : journal_(journal), view_pair_(view_pair), matches_(matches) {}
+
+            void Commit(const RelativePose *pose = nullptr)
+            {
+                if (!journal_)
+                    return;
+                std::vector<RelativePose> poses;
+                if (pose)
+                {
+                    poses.push_back(*pose);
+                }
+                Matches pair_matches;
+                pair_matches.emplace(view_pair_, matches_);
+                std::string payload;
+                common::EncodeTwoViewShard(poses, pair_matches, payload);
+                journal_->Append(view_pair_.first, view_pair_.second, payload);
+            }
+
+        private:
+            common::PairJournal *journal_;
+            ViewPair view_pair_;
+            const IdMatches &matches_;
+        };
+
+        /**
+         * @brief 将视图对及其全部匹配（含内点标记）追加到输入指纹
+         */
+        void AddPairToFingerprint(common::ShardFingerprint &fingerprint, const ViewPair &view_pair, const IdMatches &matches)
+        {
+            fingerprint.Add(view_pair.first).Add(view_pair.second).Add(matches.size());
+            for (const auto &match : matches)
+            {
+                fingerprint.Add((static_cast<uint64_t>(match.i) << 33) | (static_cast<uint64_t>(match.j) << 1) |
+                                (match.is_inlier ? 1u : 0u));
+            }
+        }
+    } // namespace
+
     TwoViewEstimator::TwoViewEstimator()
     {
         // 注册所需数据类型
@@ -36,6 +86,95 @@ namespace PluginMethods
         InitializeDefaultConfigPath();
     }
 
+    const common::OptionSchema<TwoViewEstimator::TwoViewOptions> &TwoViewEstimator::GetOptionSchema()
+    {
+        static const common::RansacBudgetOptions kBudgetDefaults;
+        static const auto IsProbability = [](const double &value)
+        { return value > 0.0 && value < 1.0; };
+        static const auto schema = common::OptionSchema<TwoViewOptions>()
+                                       .Add("estimator", &TwoViewOptions::estimator, "opencv_two_view_estimator")
+                                       .Add("algorithm", &TwoViewOptions::algorithm, "")
+                                       .Add("enable_refine", &TwoViewOptions::enable_refine, false)
+                                       .Add("min_num_required_pairs", &TwoViewOptions::min_num_required_pairs, 50)
+                                       .Add("num_threads", &TwoViewOptions::num_threads, 4)
+                                       .Add("enable_quality_validation", &TwoViewOptions::enable_quality_validation, true)
+                                       .Add("min_geometric_inliers", &TwoViewOptions::min_geometric_inliers, 50)
+                                       .Add("min_inlier_ratio", &TwoViewOptions::min_inlier_ratio, 0.25,
+                                            [](const double &value)
+                                            { return value >= 0.0 && value <= 1.0; })
+                                       .Add("enable_evaluator", &TwoViewOptions::enable_evaluator, false)
+                                       .Add("enable_batch_estimation", &TwoViewOptions::enable_batch_estimation, true)
+                                       .Add("batch_size", &TwoViewOptions::batch_size, 64)
+                                       .Add("shard_count", &TwoViewOptions::shard_count, 0)
+                                       .Add("shard_index", &TwoViewOptions::shard_index, -1,
+                                            [](const int &value)
+                                            { return value >= -1; })
+                                       .Add("shard_dir", &TwoViewOptions::shard_dir, "")
+                                       .Add("shard_run_id", &TwoViewOptions::shard_run_id, "")
+                                       .Add("shard_wait_timeout", &TwoViewOptions::shard_wait_timeout, 0.0)
+                                       .Add("journal_path", &TwoViewOptions::journal_path, "")
+                                       .Add("journal_flush_pairs", &TwoViewOptions::journal_flush_pairs, 256)
+                                       .Add("time_budget_s", &TwoViewOptions::time_budget_s, 0.0,
+                                            [](const double &value)
+                                            { return value >= 0.0; })
+                                       .Add("time_budget_min_pairs", &TwoViewOptions::time_budget_min_pairs, 0)
+                                       .Add("pair_priority", &TwoViewOptions::pair_priority, "none",
+                                            [](const std::string &value)
+                                            { return value == "none" || value == "matches"; })
+                                       .Add("skipped_pairs_path", &TwoViewOptions::skipped_pairs_path, "")
+                                       .Add("memory_high_watermark", &TwoViewOptions::memory_high_watermark, 0.0,
+                                            [](const double &value)
+                                            { return value >= 0.0 && value <= 1.0; })
+                                       .Add("memory_low_watermark", &TwoViewOptions::memory_low_watermark, 0.0,
+                                            [](const double &value)
+                                            { return value >= 0.0 && value <= 1.0; })
+                                       .Add("memory_limit_mb", &TwoViewOptions::memory_limit_mb, 0)
+                                       // 自适应RANSAC预算：默认值取自common::RansacBudgetOptions
+                                       .Add("adaptive_ransac_budget", &TwoViewOptions::adaptive_ransac_budget, false)
+                                       .Add("budget_min_iterations", &TwoViewOptions::budget_min_iterations,
+                                            kBudgetDefaults.min_iterations)
+                                       .Add("budget_max_iterations", &TwoViewOptions::budget_max_iterations,
+                                            kBudgetDefaults.max_iterations,
+                                            [](const size_t &value)
+                                            { return value > 0; })
+                                       .Add("budget_confidence", &TwoViewOptions::budget_confidence,
+                                            kBudgetDefaults.confidence, IsProbability)
+                                       .Add("budget_hard_confidence", &TwoViewOptions::budget_hard_confidence,
+                                            kBudgetDefaults.hard_confidence, IsProbability)
+                                       .Add("budget_safety_factor", &TwoViewOptions::budget_safety_factor,
+                                            kBudgetDefaults.safety_factor,
+                                            [](const double &value)
+                                            { return value > 0.0 && value <= 1.0; })
+                                       .Add("budget_hard_ratio", &TwoViewOptions::budget_hard_ratio,
+                                            kBudgetDefaults.hard_ratio, IsProbability)
+                                       .Add("budget_reference_matches", &TwoViewOptions::budget_reference_matches,
+                                            kBudgetDefaults.reference_matches,
+                                            [](const size_t &value)
+                                            { return value > 0; })
+                                       // 内点率先验的系数
+                                       .Add("budget_count_prior_floor", &TwoViewOptions::budget_count_prior_floor,
+                                            kBudgetDefaults.count_prior_floor, IsProbability)
+                                       .Add("budget_count_prior_gain", &TwoViewOptions::budget_count_prior_gain,
+                                            kBudgetDefaults.count_prior_gain, IsProbability)
+                                       .Add("budget_graph_prior_base", &TwoViewOptions::budget_graph_prior_base,
+                                            kBudgetDefaults.graph_prior_base, IsProbability)
+                                       .Add("budget_graph_prior_slope", &TwoViewOptions::budget_graph_prior_slope,
+                                            kBudgetDefaults.graph_prior_slope,
+                                            [](const double &value)
+                                            { return value >= 0.0; })
+                                       .Add("budget_graph_prior_min", &TwoViewOptions::budget_graph_prior_min,
+                                            kBudgetDefaults.graph_prior_min, IsProbability)
+                                       .Add("budget_graph_prior_max", &TwoViewOptions::budget_graph_prior_max,
+                                            kBudgetDefaults.graph_prior_max, IsProbability)
+                                       .Add("budget_flagged_weight", &TwoViewOptions::budget_flagged_weight,
+                                            kBudgetDefaults.flagged_weight, IsProbability)
+                                       .Add("budget_min_inlier_ratio", &TwoViewOptions::budget_min_inlier_ratio,
+                                            kBudgetDefaults.min_inlier_ratio, IsProbability)
+                                       .Add("budget_max_inlier_ratio", &TwoViewOptions::budget_max_inlier_ratio,
+                                            kBudgetDefaults.max_inlier_ratio, IsProbability);
+        return schema;
+    }
+
     DataPtr TwoViewEstimator::Run()
     {
         // Start profiling for the entire TwoViewEstimator::Run function | 开始对整个TwoViewEstimator::Run函数进行性能分析
@@ -43,10 +182,31 @@ namespace PluginMethods
 
         DisplayConfigInfo();
 
+        // 编译一次选项，逐视图对循环中直接读取类型化字段
+        GetOptionSchema().CompileWithWarnings(GetMethodOptions(), options_, GetType());
+
+        // 截止时间模式：预算在外层Run()中开始计时一次，RunSharded()再次调用的Run()沿用同一截止时间
+        if (active_shard_ < 0)
+        {
+            deadline_ = common::StageDeadline(options_.time_budget_s);
+        }
+
+        // 分片模式：由RunSharded()为本进程的分片再次调用Run()
+        if (options_.shard_count > 1 && options_.shard_index < 0 && active_shard_ < 0)
+        {
+            LOG_WARNING_ZH << "[TwoViewEstimator] shard_count>1但未设置shard_index，不分片运行";
+            LOG_WARNING_EN << "[TwoViewEstimator] shard_count>1 without a shard_index, running unsharded";
+        }
+        else if (options_.shard_count > 1 && active_shard_ < 0)
+        {
+            PROFILER_END(); // 各分片的Run()单独统计
+            return RunSharded();
+        }
+
         // ======== 显示启动信息 ========
-        std::string estimator = GetOptionAsString("estimator", "opencv_two_view_estimator");
-        bool enable_refine = GetOptionAsBool("enable_refine", false);
-        std::string algorithm = GetOptionAsString("algorithm", "");
+        const std::string estimator = options_.estimator;
+        const bool enable_refine = options_.enable_refine;
+        const std::string algorithm = options_.algorithm;
 
         LOG_INFO_ZH << "========================================";
         LOG_INFO_EN << "========================================";
@@ -153,7 +313,7 @@ namespace PluginMethods
         size_t invalid_poses = 0;
 
         // 获取最小匹配对数量要求
-        int min_num_required_pairs = GetOptionAsIndexT("min_num_required_pairs", 50);
+        int min_num_required_pairs = static_cast<int>(options_.min_num_required_pairs);
         LOG_DEBUG_ZH << "[TwoViewEstimator] Minimum required pairs: " << min_num_required_pairs;
         LOG_DEBUG_EN << "[TwoViewEstimator] Minimum required pairs: " << min_num_required_pairs;
 
@@ -162,8 +322,33 @@ namespace PluginMethods
         view_pair_list.reserve(matches_ptr->size());
         for (auto &[view_pair, matches] : *matches_ptr)
         {
+            // 分片进程只处理属于本分片的视图对
+            if (active_shard_ >= 0 &&
+                common::ShardOfPair(view_pair.first, view_pair.second, options_.shard_count) != static_cast<size_t>(active_shard_))
+            {
+                continue;
+            }
             view_pair_list.emplace_back(view_pair, &matches);
         }
+        total_view_pairs = view_pair_list.size();
+
+        // 截止时间模式：匹配数多的视图对优先估计，预算耗尽时保留的是最强的视图对
+        if (options_.pair_priority == "matches")
+        {
+            std::stable_sort(view_pair_list.begin(), view_pair_list.end(),
+                             [](const std::pair<ViewPair, IdMatches *> &a, const std::pair<ViewPair, IdMatches *> &b)
+                             { return a.second->size() > b.second->size(); });
+        }
+        deadline_min_pairs_ = options_.time_budget_min_pairs > 0 ? options_.time_budget_min_pairs : features_ptr->size();
+        if (deadline_.Enabled())
+        {
+            LOG_INFO_ZH << "  截止时间模式: 预算 " << deadline_.BudgetSeconds() << "s, 优先级=" << options_.pair_priority
+                        << ", 至少处理 " << deadline_min_pairs_ << " 个视图对";
+            LOG_INFO_EN << "  Deadline mode: budget " << deadline_.BudgetSeconds() << "s, priority=" << options_.pair_priority
+                        << ", at least " << deadline_min_pairs_ << " view pairs";
+        }
+        std::vector<ViewPair> skipped_pairs;
+        std::mutex skipped_mutex;
 
         // 线程安全的统计变量
         std::atomic<size_t> atomic_processed_pairs(0);
@@ -175,6 +360,8 @@ namespace PluginMethods
         std::atomic<size_t> atomic_conversion_failures(0);
         std::atomic<size_t> atomic_method_failures(0);
         std::atomic<size_t> atomic_invalid_poses(0);
+        std::atomic<size_t> atomic_realized_iterations(0); // 逐对路径上报的实际RANSAC迭代
+        std::atomic<size_t> atomic_reported_pairs(0);
 
         // 线程安全的结果容器
         std::vector<RelativePose> thread_safe_poses;
@@ -184,9 +371,10 @@ namespace PluginMethods
         // 进度跟踪变量
         size_t last_progress_milestone = 0;
         std::mutex progress_mutex;
+        std::atomic<uint64_t> &pairs_metric = common::MetricPairsProcessed("two_view");
 
         // 配置多线程
-        int num_threads = GetOptionAsIndexT("num_threads", 4);
+        int num_threads = static_cast<int>(options_.num_threads);
         if (num_threads <= 0)
         {
             num_threads = 1;
@@ -208,525 +396,691 @@ namespace PluginMethods
 #endif
         LOG_INFO_ALL << "----------------------------------------";
 
-        // 并行处理所有视图对
-#ifdef USE_OPENMP
-#pragma omp parallel for schedule(dynamic) shared(view_pair_list, features_ptr, cameras_ptr, estimator, algorithm, enable_refine, min_num_required_pairs, full_algorithm_name, atomic_processed_pairs, atomic_successful_pairs, atomic_empty_matches, atomic_invalid_view_ids, atomic_insufficient_inliers, atomic_insufficient_pairs, atomic_conversion_failures, atomic_method_failures, atomic_invalid_poses, thread_safe_poses, poses_mutex, last_progress_milestone, progress_mutex, total_view_pairs)
-#endif
-        for (size_t pair_idx = 0; pair_idx < view_pair_list.size(); ++pair_idx)
+        // 内存压力控制：接近水位时限制同时估计的视图对数（线程等待，不退出）
+        common::MemoryGovernorOptions governor_options;
+        governor_options.high_watermark = options_.memory_high_watermark;
+        governor_options.low_watermark = options_.memory_low_watermark;
+        governor_options.limit_bytes = static_cast<uint64_t>(options_.memory_limit_mb) << 20;
+        governor_options.max_active = static_cast<size_t>(num_threads);
+        memory_governor_ = std::make_unique<common::MemoryGovernor>(governor_options);
+        if (memory_governor_->Enabled())
         {
-            const auto &[view_pair, matches_ptr_local] = view_pair_list[pair_idx];
-            IdMatches &matches = *matches_ptr_local;
+            LOG_INFO_ZH << "  内存压力控制: 上限 " << (memory_governor_->Stats().limit_bytes >> 20) << " MB, 高水位 "
+                        << options_.memory_high_watermark;
+            LOG_INFO_EN << "  Memory governor: limit " << (memory_governor_->Stats().limit_bytes >> 20) << " MB, high watermark "
+                        << options_.memory_high_watermark;
+        }
 
-            // 为每个线程创建独立的方法实例
-            auto thread_method = std::dynamic_pointer_cast<Interface::MethodPreset>(FactoryMethod::Create(estimator.c_str()));
-            if (!thread_method)
-            {
-                LOG_ERROR_ZH << "线程中创建方法失败: " << estimator;
-                LOG_ERROR_EN << "Failed to create method in thread: " << estimator;
-                atomic_method_failures.fetch_add(1);
-                continue;
-            }
+        // GT相对位姿索引（逐对评估使用）
+        PrepareGTPoseIndex();
+
+        // 批量估计预处理：后端支持TwoViewBatchEstimator时按批转换bearing并估计
+        std::vector<common::TwoViewBatchResult> batch_results;
+        std::vector<char> batch_done;
+        // 逐对RANSAC预算：由匹配统计量预测内点率，设置每个视图对的迭代上限/置信度/阈值
+        std::vector<common::RansacBudget> pair_budgets =
+            ComputeRansacBudgets(view_pair_list, *matches_ptr, algorithm);
+
+        // 断点续算：回放日志中已完成的视图对（预算已按完整输入计算），只估计剩余视图对
+        std::vector<RelativePose> replayed_poses;
+        std::unique_ptr<common::PairJournal> journal =
+            OpenPairJournal(view_pair_list, pair_budgets, *matches_ptr, replayed_poses);
+        const size_t num_replayed = total_view_pairs - view_pair_list.size();
+        thread_safe_poses.insert(thread_safe_poses.end(), replayed_poses.begin(), replayed_poses.end());
+        atomic_processed_pairs.store(num_replayed);
+        atomic_successful_pairs.store(replayed_poses.size());
+
+        // 每个线程复用一个估计器实例（选项未变化时估计器不重新编译）
+        // GT评估时逐对创建实例，避免无GT的视图对沿用上一对的GT数据
+        std::vector<Interface::MethodPresetPtr> thread_methods(static_cast<size_t>(num_threads));
+        const bool reuse_methods = gt_pose_index_.Empty();
+
+        // 按块处理：每块先批量估计，再由主循环验证/精细优化并写入日志。启用日志时块大小取
+        // max(journal_flush_pairs, batch_size×线程数)，中断最多损失一块；未启用日志时整体为一块
+        const size_t chunk_pairs =
+            journal ? std::max<size_t>(options_.journal_flush_pairs, std::max<size_t>(1, options_.batch_size) * num_threads)
+                    : view_pair_list.size();
+        for (size_t chunk_begin = 0; chunk_begin < view_pair_list.size(); chunk_begin += chunk_pairs)
+        {
+            const size_t chunk_end = std::min(chunk_begin + chunk_pairs, view_pair_list.size());
+            RunBatchEstimation(view_pair_list, chunk_begin, chunk_end, *features_ptr, *cameras_ptr, estimator, algorithm,
+                               static_cast<size_t>(min_num_required_pairs), pair_budgets,
+                               batch_results, batch_done);
 
-            // 设置评估器算法名称（线程安全）
-            thread_method->SetEvaluatorAlgorithm(full_algorithm_name);
+            // 并行处理本块的视图对
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) shared(thread_methods, reuse_methods, pair_budgets, batch_results, batch_done, skipped_pairs, skipped_mutex, view_pair_list, features_ptr, cameras_ptr, estimator, algorithm, enable_refine, min_num_required_pairs, full_algorithm_name, atomic_processed_pairs, atomic_successful_pairs, atomic_empty_matches, atomic_invalid_view_ids, atomic_insufficient_inliers, atomic_insufficient_pairs, atomic_conversion_failures, atomic_method_failures, atomic_invalid_poses, atomic_realized_iterations, atomic_reported_pairs, thread_safe_poses, poses_mutex, last_progress_milestone, progress_mutex, total_view_pairs)
+#endif
+            for (size_t pair_idx = chunk_begin; pair_idx < chunk_end; ++pair_idx)
+            {
+                const auto &[view_pair, matches_ptr_local] = view_pair_list[pair_idx];
+                IdMatches &matches = *matches_ptr_local;
 
-            // 递增处理计数器
-            size_t current_processed = atomic_processed_pairs.fetch_add(1) + 1;
+                // 截止时间模式：预算耗尽后不再启动新的视图对（批量估计已得到结果的除外）
+                // 跳过的视图对只是没有相对位姿，其匹配（含内点标记）保持不变，且不写入日志以便续算时重新估计
+                if (deadline_.Expired() && pair_idx >= deadline_min_pairs_ && (batch_done.empty() || !batch_done[pair_idx]))
+                {
+                    std::lock_guard<std::mutex> lock(skipped_mutex);
+                    skipped_pairs.push_back(view_pair);
+                    continue;
+                }
 
-            if (SHOULD_LOG(DEBUG))
-            {
-                LOG_DEBUG_ZH << "处理视图对 (" << view_pair.first << "," << view_pair.second << "): " << current_processed << "/" << total_view_pairs;
-                LOG_DEBUG_EN << "Processing view pair (" << view_pair.first << "," << view_pair.second << "): " << current_processed << "/" << total_view_pairs;
-            }
+                common::MemoryGovernor::Slot memory_slot(*memory_governor_);
+                PairJournalRecord journal_record(journal.get(), view_pair, matches);
 
-            // 统计处理前的匹配数量
-            size_t initial_matches_count = matches.size();
-            size_t initial_inliers_count = 0;
-            for (const auto &match : matches)
-            {
-                if (match.is_inlier)
-                    initial_inliers_count++;
-            }
+                // 递增处理计数器（批量估计完成的视图对已在批次中计入指标）
+                size_t current_processed = atomic_processed_pairs.fetch_add(1) + 1;
+                if (batch_done.empty() || !batch_done[pair_idx])
+                {
+                    pairs_metric.fetch_add(1, std::memory_order_relaxed);
+                }
 
-            // 预先验证视图对和匹配数据
-            if (matches.empty())
-            {
-                LOG_WARNING_ZH << "Warning: Empty matches for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                LOG_WARNING_EN << "Warning: Empty matches for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                atomic_empty_matches.fetch_add(1);
-                continue;
-            }
+                if (SHOULD_LOG(DEBUG))
+                {
+                    LOG_DEBUG_ZH << "处理视图对 (" << view_pair.first << "," << view_pair.second << "): " << current_processed << "/" << total_view_pairs;
+                    LOG_DEBUG_EN << "Processing view pair (" << view_pair.first << "," << view_pair.second << "): " << current_processed << "/" << total_view_pairs;
+                }
 
-            // 检查匹配对数量是否满足最小要求
-            if (static_cast<int>(matches.size()) < min_num_required_pairs)
-            {
-                LOG_WARNING_ZH << "Warning: Insufficient match pairs (" << matches.size()
-                               << " < " << min_num_required_pairs << ") for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                LOG_WARNING_EN << "Warning: Insufficient match pairs (" << matches.size()
-                               << " < " << min_num_required_pairs << ") for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-
-                // 将所有匹配对的is_inlier标志设置为false
-                for (auto &match : matches)
+                // 统计处理前的匹配数量
+                size_t initial_matches_count = matches.size();
+                size_t initial_inliers_count = 0;
+                for (const auto &match : matches)
                 {
-                    match.is_inlier = false;
+                    if (match.is_inlier)
+                        initial_inliers_count++;
                 }
 
-                atomic_insufficient_pairs.fetch_add(1);
-                continue;
-            }
+                // 预先验证视图对和匹配数据
+                if (matches.empty())
+                {
+                    LOG_WARNING_ZH << "Warning: Empty matches for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    LOG_WARNING_EN << "Warning: Empty matches for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    atomic_empty_matches.fetch_add(1);
+                    journal_record.Commit();
+                    continue;
+                }
 
-            // 显示处理前的匹配统计
-            if (SHOULD_LOG(DEBUG))
-            {
-                LOG_DEBUG_ZH << "视图对 (" << view_pair.first << "," << view_pair.second
-                             << ") - Initial matches: " << initial_matches_count
-                             << " (inliers: " << initial_inliers_count << ")";
-                LOG_DEBUG_EN << "View pair (" << view_pair.first << "," << view_pair.second
-                             << ") - Initial matches: " << initial_matches_count
-                             << " (inliers: " << initial_inliers_count << ")";
-            }
+                // 检查匹配对数量是否满足最小要求
+                if (static_cast<int>(matches.size()) < min_num_required_pairs)
+                {
+                    LOG_WARNING_ZH << "Warning: Insufficient match pairs (" << matches.size()
+                                   << " < " << min_num_required_pairs << ") for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    LOG_WARNING_EN << "Warning: Insufficient match pairs (" << matches.size()
+                                   << " < " << min_num_required_pairs << ") for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
 
-            // 验证view_id是否在有效范围内
-            if (view_pair.first >= features_ptr->size() || view_pair.second >= features_ptr->size())
-            {
-                LOG_ERROR_ZH << "Invalid view_pair (" << view_pair.first << "," << view_pair.second
-                             << ") - exceeds features size " << features_ptr->size();
-                LOG_ERROR_EN << "Invalid view_pair (" << view_pair.first << "," << view_pair.second
-                             << ") - exceeds features size " << features_ptr->size();
-                atomic_invalid_view_ids.fetch_add(1);
-                continue;
-            }
+                    // 将所有匹配对的is_inlier标志设置为false
+                    for (auto &match : matches)
+                    {
+                        match.is_inlier = false;
+                    }
 
-            // 转换为射线向量
-            BearingPairs bearing_pairs;
-            if (!types::MatchesToBearingPairs(matches, *features_ptr, *cameras_ptr, view_pair, bearing_pairs))
-            {
-                LOG_WARNING_ZH << "Failed to convert matches to bearing pairs for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                LOG_WARNING_EN << "Failed to convert matches to bearing pairs for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                atomic_conversion_failures.fetch_add(1);
-                continue;
-            }
+                    atomic_insufficient_pairs.fetch_add(1);
+                    journal_record.Commit();
+                    continue;
+                }
 
-            // 根据算法类型准备数据（统一处理所有estimator）
-            // 1. 创建共享的matches数据（避免拷贝）
-            auto matches_shared = std::shared_ptr<IdMatches>(matches_ptr, &matches);
-            auto matches_data = std::make_shared<DataSample<IdMatches>>(matches_shared);
+                // 显示处理前的匹配统计
+                if (SHOULD_LOG(DEBUG))
+                {
+                    LOG_DEBUG_ZH << "视图对 (" << view_pair.first << "," << view_pair.second
+                                 << ") - Initial matches: " << initial_matches_count
+                                 << " (inliers: " << initial_inliers_count << ")";
+                    LOG_DEBUG_EN << "View pair (" << view_pair.first << "," << view_pair.second
+                                 << ") - Initial matches: " << initial_matches_count
+                                 << " (inliers: " << initial_inliers_count << ")";
+                }
 
-            // 2. 设置通用方法选项
-            MethodOptions options;
-            options["view_i"] = std::to_string(view_pair.first);
-            options["view_j"] = std::to_string(view_pair.second);
+                // 验证view_id是否在有效范围内
+                if (view_pair.first >= features_ptr->size() || view_pair.second >= features_ptr->size())
+                {
+                    LOG_ERROR_ZH << "Invalid view_pair (" << view_pair.first << "," << view_pair.second
+                                 << ") - exceeds features size " << features_ptr->size();
+                    LOG_ERROR_EN << "Invalid view_pair (" << view_pair.first << "," << view_pair.second
+                                 << ") - exceeds features size " << features_ptr->size();
+                    atomic_invalid_view_ids.fetch_add(1);
+                    journal_record.Commit();
+                    continue;
+                }
 
-            // 3. 传递算法参数（如果指定）
-            std::string algorithm = GetOptionAsString("algorithm", "");
-            if (!algorithm.empty())
-            {
-                options["algorithm"] = algorithm;
-            }
+                // 转换为射线向量（批量路径已在批内转换并校验）
+                const bool has_batch_result = !batch_done.empty() && batch_done[pair_idx];
+                BearingPairs bearing_pairs;
+                if (!has_batch_result && !types::MatchesToBearingPairs(matches, *features_ptr, *cameras_ptr, view_pair, bearing_pairs))
+                {
+                    LOG_WARNING_ZH << "Failed to convert matches to bearing pairs for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    LOG_WARNING_EN << "Failed to convert matches to bearing pairs for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    atomic_conversion_failures.fetch_add(1);
+                    continue;
+                }
 
-            // 4. PoseLib特殊处理：传递统一精细优化参数
-            if (boost::iequals(estimator, "poselib_model_estimator"))
-            {
-                bool enable_refine = GetOptionAsBool("enable_refine", false);
-                if (enable_refine)
+                DataPtr result;
+                if (has_batch_result)
                 {
-                    options["refine_model"] = "nonlinear";
-                    if (SHOULD_LOG(DEBUG))
+                    // 使用批量估计结果：同步内点位集到匹配数据
+                    const auto &batch_result = batch_results[pair_idx];
+                    if (batch_result.success)
                     {
-                        LOG_DEBUG_ZH << "启用PoseLib内部精细优化 (refine_model=nonlinear) for view pair ("
-                                     << view_pair.first << "," << view_pair.second << ")";
-                        LOG_DEBUG_EN << "Enabling PoseLib internal refinement (refine_model=nonlinear) for view pair ("
-                                     << view_pair.first << "," << view_pair.second << ")";
+                        for (size_t k = 0; k < matches.size(); ++k)
+                        {
+                            matches[k].is_inlier = batch_result.inliers[k];
+                        }
+                        result = std::make_shared<DataMap<RelativePose>>(batch_result.pose, "data_relative_pose");
                     }
                 }
-            }
+                else
+                {
+                    // 取当前线程的方法实例，首次使用时创建
+#ifdef USE_OPENMP
+                    const size_t thread_id = static_cast<size_t>(omp_get_thread_num());
+#else
+                    const size_t thread_id = 0;
+#endif
+                    const bool reuse_slot = reuse_methods && thread_id < thread_methods.size();
+                    Interface::MethodPresetPtr thread_method = reuse_slot ? thread_methods[thread_id] : nullptr;
+                    if (!thread_method)
+                    {
+                        thread_method = std::dynamic_pointer_cast<Interface::MethodPreset>(FactoryMethod::Create(estimator.c_str()));
+                        if (!thread_method)
+                        {
+                            LOG_ERROR_ZH << "线程中创建方法失败: " << estimator;
+                            LOG_ERROR_EN << "Failed to create method in thread: " << estimator;
+                            atomic_method_failures.fetch_add(1);
+                            continue;
+                        }
 
-            // 5. 设置方法选项和输入数据（统一流程）
-            thread_method->SetMethodOptions(options);
-            thread_method->SetRequiredData(matches_data);
-            thread_method->SetRequiredData(required_package_["data_features"]);
-            thread_method->SetRequiredData(required_package_["data_camera_models"]);
+                        // 设置评估器算法名称（线程安全）
+                        thread_method->SetEvaluatorAlgorithm(full_algorithm_name);
+                        if (reuse_slot)
+                        {
+                            thread_methods[thread_id] = thread_method;
+                        }
+                    }
 
-            // 设置GTdata(如果先验数据有的话) - 使用thread_method
-            SetCurrentViewPairGTDataForMethod(view_pair, thread_method);
+                    // 根据算法类型准备数据（统一处理所有estimator）
+                    // 1. 创建共享的matches数据（避免拷贝）
+                    auto matches_shared = std::shared_ptr<IdMatches>(matches_ptr, &matches);
+                    auto matches_data = std::make_shared<DataSample<IdMatches>>(matches_shared);
 
-            // 执行位姿估计
-            auto result = thread_method->Build();
+                    // 2. 设置视图对：支持类型化通道的估计器直接传入，否则写入字符串选项
+                    MethodOptions options;
+                    auto *typed_target = dynamic_cast<common::TypedViewPairTarget *>(thread_method.get());
+                    if (typed_target)
+                    {
+                        typed_target->SetTypedViewPair(view_pair);
+                    }
+                    else
+                    {
+                        options["view_i"] = std::to_string(view_pair.first);
+                        options["view_j"] = std::to_string(view_pair.second);
+                    }
 
-            if (!result)
-            {
-                // 算法执行失败：清除所有内点标志
-                for (auto &match : matches)
-                {
-                    match.is_inlier = false;
-                }
+                    // 3. 传递算法参数（如果指定）
+                    if (!algorithm.empty())
+                    {
+                        options["algorithm"] = algorithm;
+                    }
 
-                LOG_WARNING_ZH << "Method Build() failed for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                LOG_WARNING_EN << "Method Build() failed for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                atomic_method_failures.fetch_add(1);
-                continue;
-            }
+                    // 4. PoseLib特殊处理：传递统一精细优化参数
+                    if (boost::iequals(estimator, "poselib_model_estimator"))
+                    {
+                        if (enable_refine)
+                        {
+                            options["refine_model"] = "nonlinear";
+                            if (SHOULD_LOG(DEBUG))
+                            {
+                                LOG_DEBUG_ZH << "启用PoseLib内部精细优化 (refine_model=nonlinear) for view pair ("
+                                             << view_pair.first << "," << view_pair.second << ")";
+                                LOG_DEBUG_EN << "Enabling PoseLib internal refinement (refine_model=nonlinear) for view pair ("
+                                             << view_pair.first << "," << view_pair.second << ")";
+                            }
+                        }
+                    }
 
-            // 处理内点信息并进行统一的质量验证
-            // OpenGV、OpenCV、Barath和PoseLib估计器会自动更新匹配数据中的内点标志
+                    // 5. 逐对RANSAC预算（启用adaptive_ransac_budget时）
+                    if (!pair_budgets.empty())
+                    {
+                        ApplyRansacBudget(pair_budgets[pair_idx], estimator, options);
+                    }
 
-            // 统计内点数量（对所有算法统一处理）
-            size_t final_inlier_count = 0;
-            for (const auto &match : matches)
-            {
-                if (match.is_inlier)
-                    final_inlier_count++;
-            }
+                    // 6. 设置方法选项和输入数据（统一流程）
+                    thread_method->SetMethodOptions(options);
+                    thread_method->SetRequiredData(matches_data);
+                    thread_method->SetRequiredData(required_package_["data_features"]);
+                    thread_method->SetRequiredData(required_package_["data_camera_models"]);
 
-            // 显示处理后的匹配统计（算法执行后）
-            LOG_DEBUG_ZH << "视图对 (" << view_pair.first << "," << view_pair.second
-                         << ") - After estimation: " << matches.size() << " matches, "
-                         << final_inlier_count << " inliers ("
-                         << std::fixed << std::setprecision(1)
-                         << (100.0 * final_inlier_count / matches.size()) << "%)";
-            LOG_DEBUG_EN << "View pair (" << view_pair.first << "," << view_pair.second
-                         << ") - After estimation: " << matches.size() << " matches, "
-                         << final_inlier_count << " inliers ("
-                         << std::fixed << std::setprecision(1)
-                         << (100.0 * final_inlier_count / matches.size()) << "%)";
-
-            // 统一的质量验证处理（对所有算法统一管控）
-            bool quality_validation_passed = false;
-            bool enable_quality_validation = GetOptionAsBool("enable_quality_validation", true);
-
-            if (enable_quality_validation)
-            {
-                // 使用统一的质量验证函数
-                quality_validation_passed = ValidateEstimationQuality(final_inlier_count, matches.size(), estimator);
+                    // 设置GTdata(如果先验数据有的话) - 使用thread_method
+                    SetCurrentViewPairGTDataForMethod(view_pair, thread_method);
 
-                if (!quality_validation_passed)
-                {
-                    // 质量验证失败：清除所有内点标志
-                    for (auto &match : matches)
-                    {
-                        match.is_inlier = false;
-                    }
+                    // 执行位姿估计
+                    result = thread_method->Build();
 
-                    if (log_level_ >= 2)
+                    // 实际RANSAC迭代（估计器经类型化通道上报时）
+                    const size_t iterations = typed_target ? typed_target->LastRansacIterations() : 0;
+                    if (iterations > 0)
                     {
-                        LOG_WARNING_ZH << "Quality validation failed for view pair ("
-                                       << view_pair.first << "," << view_pair.second << ")";
-                        LOG_WARNING_EN << "Quality validation failed for view pair ("
-                                       << view_pair.first << "," << view_pair.second << ")";
+                        atomic_realized_iterations.fetch_add(iterations);
+                        atomic_reported_pairs.fetch_add(1);
+                        if (SHOULD_LOG(DEBUG))
+                        {
+                            const size_t cap = pair_budgets.empty() ? 0 : pair_budgets[pair_idx].max_iterations;
+                            LOG_DEBUG_ZH << "视图对 (" << view_pair.first << "," << view_pair.second << ") RANSAC迭代: "
+                                         << iterations << (cap > 0 ? " / 预算 " + std::to_string(cap) : std::string());
+                            LOG_DEBUG_EN << "View pair (" << view_pair.first << "," << view_pair.second << ") RANSAC iterations: "
+                                         << iterations << (cap > 0 ? " / budget " + std::to_string(cap) : std::string());
+                        }
                     }
-                    atomic_insufficient_inliers.fetch_add(1);
-                    continue; // 跳过该视图对，不保存pose结果
                 }
-            }
-            else
-            {
-                // 如果不启用质量验证，仅进行基本的内点数量检查
-                if (final_inlier_count < 6) // 双视图估计至少需要8个内点
+
+                if (!result)
                 {
-                    // 基本验证失败：清除所有内点标志
+                    // 算法执行失败：清除所有内点标志
                     for (auto &match : matches)
                     {
                         match.is_inlier = false;
                     }
 
-                    if (log_level_ >= 2)
-                    {
-                        LOG_WARNING_ZH << "Warning: Insufficient final inliers (" << final_inlier_count
-                                       << ") for view pair (" << view_pair.first << "," << view_pair.second << ")";
-                        LOG_WARNING_EN << "Warning: Insufficient final inliers (" << final_inlier_count
-                                       << ") for view pair (" << view_pair.first << "," << view_pair.second << ")";
-                    }
-                    atomic_insufficient_inliers.fetch_add(1);
-                    continue; // 跳过该视图对，不保存pose结果
+                    LOG_WARNING_ZH << "Method Build() failed for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    LOG_WARNING_EN << "Method Build() failed for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    atomic_method_failures.fetch_add(1);
+                    continue;
                 }
-                quality_validation_passed = true; // 基本检查通过
-            }
 
-            LOG_DEBUG_ZH << "Final inlier count: " << final_inlier_count
-                         << "/" << matches.size() << " for view pair ("
-                         << view_pair.first << "," << view_pair.second << ")";
-            LOG_DEBUG_EN << "Final inlier count: " << final_inlier_count
-                         << "/" << matches.size() << " for view pair ("
-                         << view_pair.first << "," << view_pair.second << ")";
+                // 处理内点信息并进行统一的质量验证
+                // OpenGV、OpenCV、Barath和PoseLib估计器会自动更新匹配数据中的内点标志
 
-            // 获取估计结果并验证有效性
-            auto pose_result = GetDataPtr<RelativePose>(result);
-            if (!pose_result)
-            {
-                // 结果提取失败：清除所有内点标志
-                for (auto &match : matches)
-                {
-                    match.is_inlier = false;
-                }
-                if (log_level_ >= 2)
+                // 统计内点数量（对所有算法统一处理）
+                size_t final_inlier_count = 0;
+                for (const auto &match : matches)
                 {
-                    LOG_WARNING_ZH << "Failed to extract RelativePose from result for view pair ("
-                                   << view_pair.first << "," << view_pair.second << ")";
-                    LOG_WARNING_EN << "Failed to extract RelativePose from result for view pair ("
-                                   << view_pair.first << "," << view_pair.second << ")";
+                    if (match.is_inlier)
+                        final_inlier_count++;
                 }
-                atomic_method_failures.fetch_add(1);
-                continue;
-            }
 
-            // 统一精细优化：根据估计器类型选择合适的精细优化方法
-            bool enable_refine = GetOptionAsBool("enable_refine", false);
-            if (enable_refine)
-            {
-                // 检查是否为支持PoSDK精细优化的方法
-                bool supports_posdk_refine = (boost::iequals(estimator, "opencv_two_view_estimator") ||
-                                              boost::iequals(estimator, "barath_two_view_estimator") ||
-                                              boost::iequals(estimator, "opengv_model_estimator"));
+                // 显示处理后的匹配统计（算法执行后）
+                LOG_DEBUG_ZH << "视图对 (" << view_pair.first << "," << view_pair.second
+                             << ") - After estimation: " << matches.size() << " matches, "
+                             << final_inlier_count << " inliers ("
+                             << std::fixed << std::setprecision(1)
+                             << (100.0 * final_inlier_count / matches.size()) << "%)";
+                LOG_DEBUG_EN << "View pair (" << view_pair.first << "," << view_pair.second
+                             << ") - After estimation: " << matches.size() << " matches, "
+                             << final_inlier_count << " inliers ("
+                             << std::fixed << std::setprecision(1)
+                             << (100.0 * final_inlier_count / matches.size()) << "%)";
+
+                // 统一的质量验证处理（对所有算法统一管控）
+                bool quality_validation_passed = false;
+                const bool enable_quality_validation = options_.enable_quality_validation;
 
-                if (supports_posdk_refine)
+                if (enable_quality_validation)
                 {
-                    // 从matches转换bearing_pairs，只使用内点
-                    BearingPairs refinement_bearing_pairs;
-                    if (!types::MatchesToBearingPairsInliersOnly(matches, *features_ptr, *cameras_ptr, view_pair, refinement_bearing_pairs))
+                    // 使用统一的质量验证函数
+                    quality_validation_passed = ValidateEstimationQuality(final_inlier_count, matches.size(), estimator);
+
+                    if (!quality_validation_passed)
                     {
-                        if (SHOULD_LOG(DEBUG))
+                        // 质量验证失败：清除所有内点标志
+                        for (auto &match : matches)
                         {
-                            LOG_DEBUG_ZH << "Failed to convert inlier matches to bearing pairs for refinement, skipping for view pair ("
-                                         << view_pair.first << "," << view_pair.second << ")";
-                            LOG_DEBUG_EN << "Failed to convert inlier matches to bearing pairs for refinement, skipping for view pair ("
-                                         << view_pair.first << "," << view_pair.second << ")";
+                            match.is_inlier = false;
                         }
-                        refinement_bearing_pairs.clear(); // 确保为空，跳过精细优化
-                    }
 
-                    if (!refinement_bearing_pairs.empty())
+                        if (log_level_ >= 2)
+                        {
+                            LOG_WARNING_ZH << "Quality validation failed for view pair ("
+                                           << view_pair.first << "," << view_pair.second << ")";
+                            LOG_WARNING_EN << "Quality validation failed for view pair ("
+                                           << view_pair.first << "," << view_pair.second << ")";
+                        }
+                        atomic_insufficient_inliers.fetch_add(1);
+                        continue; // 跳过该视图对，不保存pose结果
+                    }
+                }
+                else
+                {
+                    // 如果不启用质量验证，仅进行基本的内点数量检查
+                    if (final_inlier_count < 6) // 双视图估计至少需要8个内点
                     {
-                        // 统计精细优化前的状态
-                        size_t pre_refinement_total_matches = matches.size();
-                        size_t pre_refinement_inliers = 0;
-                        for (const auto &match : matches)
+                        // 基本验证失败：清除所有内点标志
+                        for (auto &match : matches)
                         {
-                            if (match.is_inlier)
-                                pre_refinement_inliers++;
+                            match.is_inlier = false;
                         }
 
-                        LOG_DEBUG_ZH << "[PoSDK Refinement] 精细优化前统计 - 视图对 (" << view_pair.first << "," << view_pair.second << "):";
-                        LOG_DEBUG_ZH << "  总匹配数: " << pre_refinement_total_matches;
-                        LOG_DEBUG_ZH << "  内点数: " << pre_refinement_inliers << " ("
-                                     << std::fixed << std::setprecision(1) << (100.0 * pre_refinement_inliers / pre_refinement_total_matches) << "%)";
-                        LOG_DEBUG_ZH << "  用于优化的bearing_pairs数: " << refinement_bearing_pairs.size();
-
-                        LOG_DEBUG_EN << "[PoSDK Refinement] Pre-refinement statistics - View pair (" << view_pair.first << "," << view_pair.second << "):";
-                        LOG_DEBUG_EN << "  Total matches: " << pre_refinement_total_matches;
-                        LOG_DEBUG_EN << "  Inliers: " << pre_refinement_inliers << " ("
-                                     << std::fixed << std::setprecision(1) << (100.0 * pre_refinement_inliers / pre_refinement_total_matches) << "%)";
-                        LOG_DEBUG_EN << "  Bearing pairs for optimization: " << refinement_bearing_pairs.size();
-
-                        auto optimized_pose_result = ApplyPoSDKRefinement(*pose_result, refinement_bearing_pairs, view_pair, matches);
-                        if (optimized_pose_result)
+                        if (log_level_ >= 2)
                         {
-                            // 统计精细优化后的状态
-                            size_t post_refinement_total_matches = matches.size();
-                            size_t post_refinement_inliers = 0;
-                            for (const auto &match : matches)
-                            {
-                                if (match.is_inlier)
-                                    post_refinement_inliers++;
-                            }
+                            LOG_WARNING_ZH << "Warning: Insufficient final inliers (" << final_inlier_count
+                                           << ") for view pair (" << view_pair.first << "," << view_pair.second << ")";
+                            LOG_WARNING_EN << "Warning: Insufficient final inliers (" << final_inlier_count
+                                           << ") for view pair (" << view_pair.first << "," << view_pair.second << ")";
+                        }
+                        atomic_insufficient_inliers.fetch_add(1);
+                        continue; // 跳过该视图对，不保存pose结果
+                    }
+                    quality_validation_passed = true; // 基本检查通过
+                }
 
-                            LOG_DEBUG_ZH << "[PoSDK Refinement] 精细优化后统计 - 视图对 (" << view_pair.first << "," << view_pair.second << "):";
-                            LOG_DEBUG_ZH << "  总匹配数: " << post_refinement_total_matches;
-                            LOG_DEBUG_ZH << "  内点数: " << post_refinement_inliers << " ("
-                                         << std::fixed << std::setprecision(1) << (100.0 * post_refinement_inliers / post_refinement_total_matches) << "%)";
-                            LOG_DEBUG_ZH << "  内点变化: " << static_cast<int>(post_refinement_inliers) - static_cast<int>(pre_refinement_inliers);
+                LOG_DEBUG_ZH << "Final inlier count: " << final_inlier_count
+                             << "/" << matches.size() << " for view pair ("
+                             << view_pair.first << "," << view_pair.second << ")";
+                LOG_DEBUG_EN << "Final inlier count: " << final_inlier_count
+                             << "/" << matches.size() << " for view pair ("
+                             << view_pair.first << "," << view_pair.second << ")";
 
-                            LOG_DEBUG_EN << "[PoSDK Refinement] Post-refinement statistics - View pair (" << view_pair.first << "," << view_pair.second << "):";
-                            LOG_DEBUG_EN << "  Total matches: " << post_refinement_total_matches;
-                            LOG_DEBUG_EN << "  Inliers: " << post_refinement_inliers << " ("
-                                         << std::fixed << std::setprecision(1) << (100.0 * post_refinement_inliers / post_refinement_total_matches) << "%)";
-                            LOG_DEBUG_EN << "  Inlier change: " << static_cast<int>(post_refinement_inliers) - static_cast<int>(pre_refinement_inliers);
+                // 获取估计结果并验证有效性
+                auto pose_result = GetDataPtr<RelativePose>(result);
+                if (!pose_result)
+                {
+                    // 结果提取失败：清除所有内点标志
+                    for (auto &match : matches)
+                    {
+                        match.is_inlier = false;
+                    }
+                    if (log_level_ >= 2)
+                    {
+                        LOG_WARNING_ZH << "Failed to extract RelativePose from result for view pair ("
+                                       << view_pair.first << "," << view_pair.second << ")";
+                        LOG_WARNING_EN << "Failed to extract RelativePose from result for view pair ("
+                                       << view_pair.first << "," << view_pair.second << ")";
+                    }
+                    atomic_method_failures.fetch_add(1);
+                    continue;
+                }
 
-                            // 使用优化后的位姿替换原始估计
-                            pose_result = optimized_pose_result;
+                // 统一精细优化：根据估计器类型选择合适的精细优化方法
+                if (enable_refine)
+                {
+                    // 检查是否为支持PoSDK精细优化的方法
+                    bool supports_posdk_refine = (boost::iequals(estimator, "opencv_two_view_estimator") ||
+                                                  boost::iequals(estimator, "barath_two_view_estimator") ||
+                                                  boost::iequals(estimator, "opengv_model_estimator"));
 
+                    if (supports_posdk_refine)
+                    {
+                        // 从matches转换bearing_pairs，只使用内点
+                        BearingPairs refinement_bearing_pairs;
+                        if (!types::MatchesToBearingPairsInliersOnly(matches, *features_ptr, *cameras_ptr, view_pair, refinement_bearing_pairs))
+                        {
                             if (SHOULD_LOG(DEBUG))
                             {
-                                LOG_DEBUG_ZH << "PoSDK refinement applied successfully for " << estimator
-                                             << " view pair (" << view_pair.first << "," << view_pair.second << ")";
-                                LOG_DEBUG_EN << "PoSDK refinement applied successfully for " << estimator
-                                             << " view pair (" << view_pair.first << "," << view_pair.second << ")";
+                                LOG_DEBUG_ZH << "Failed to convert inlier matches to bearing pairs for refinement, skipping for view pair ("
+                                             << view_pair.first << "," << view_pair.second << ")";
+                                LOG_DEBUG_EN << "Failed to convert inlier matches to bearing pairs for refinement, skipping for view pair ("
+                                             << view_pair.first << "," << view_pair.second << ")";
                             }
+                            refinement_bearing_pairs.clear(); // 确保为空，跳过精细优化
                         }
-                        else
+
+                        if (!refinement_bearing_pairs.empty())
                         {
-                            // 精细优化失败意味着整个view pair的估计都有问题
-                            // 清除所有内点标志并跳过这个view pair
-                            for (auto &match : matches)
+                            // 统计精细优化前的状态
+                            size_t pre_refinement_total_matches = matches.size();
+                            size_t pre_refinement_inliers = 0;
+                            for (const auto &match : matches)
                             {
-                                match.is_inlier = false;
+                                if (match.is_inlier)
+                                    pre_refinement_inliers++;
                             }
 
-                            LOG_WARNING_ZH << "[PoSDK Refinement] 精细优化失败，拒绝整个view pair ("
-                                           << view_pair.first << "," << view_pair.second << ") - 初始估计也不可信";
-                            LOG_WARNING_EN << "[PoSDK Refinement] Refinement failed, rejecting entire view pair ("
-                                           << view_pair.first << "," << view_pair.second << ") - initial estimate also unreliable";
+                            LOG_DEBUG_ZH << "[PoSDK Refinement] 精细优化前统计 - 视图对 (" << view_pair.first << "," << view_pair.second << "):";
+                            LOG_DEBUG_ZH << "  总匹配数: " << pre_refinement_total_matches;
+                            LOG_DEBUG_ZH << "  内点数: " << pre_refinement_inliers << " ("
+                                         << std::fixed << std::setprecision(1) << (100.0 * pre_refinement_inliers / pre_refinement_total_matches) << "%)";
+                            LOG_DEBUG_ZH << "  用于优化的bearing_pairs数: " << refinement_bearing_pairs.size();
 
-                            atomic_method_failures.fetch_add(1);
-                            continue; // 跳过后续处理，不添加pose结果
+                            LOG_DEBUG_EN << "[PoSDK Refinement] Pre-refinement statistics - View pair (" << view_pair.first << "," << view_pair.second << "):";
+                            LOG_DEBUG_EN << "  Total matches: " << pre_refinement_total_matches;
+                            LOG_DEBUG_EN << "  Inliers: " << pre_refinement_inliers << " ("
+                                         << std::fixed << std::setprecision(1) << (100.0 * pre_refinement_inliers / pre_refinement_total_matches) << "%)";
+                            LOG_DEBUG_EN << "  Bearing pairs for optimization: " << refinement_bearing_pairs.size();
+
+                            auto optimized_pose_result = ApplyPoSDKRefinement(*pose_result, refinement_bearing_pairs, view_pair, matches);
+                            if (optimized_pose_result)
+                            {
+                                // 统计精细优化后的状态
+                                size_t post_refinement_total_matches = matches.size();
+                                size_t post_refinement_inliers = 0;
+                                for (const auto &match : matches)
+                                {
+                                    if (match.is_inlier)
+                                        post_refinement_inliers++;
+                                }
+
+                                LOG_DEBUG_ZH << "[PoSDK Refinement] 精细优化后统计 - 视图对 (" << view_pair.first << "," << view_pair.second << "):";
+                                LOG_DEBUG_ZH << "  总匹配数: " << post_refinement_total_matches;
+                                LOG_DEBUG_ZH << "  内点数: " << post_refinement_inliers << " ("
+                                             << std::fixed << std::setprecision(1) << (100.0 * post_refinement_inliers / post_refinement_total_matches) << "%)";
+                                LOG_DEBUG_ZH << "  内点变化: " << static_cast<int>(post_refinement_inliers) - static_cast<int>(pre_refinement_inliers);
+
+                                LOG_DEBUG_EN << "[PoSDK Refinement] Post-refinement statistics - View pair (" << view_pair.first << "," << view_pair.second << "):";
+                                LOG_DEBUG_EN << "  Total matches: " << post_refinement_total_matches;
+                                LOG_DEBUG_EN << "  Inliers: " << post_refinement_inliers << " ("
+                                             << std::fixed << std::setprecision(1) << (100.0 * post_refinement_inliers / post_refinement_total_matches) << "%)";
+                                LOG_DEBUG_EN << "  Inlier change: " << static_cast<int>(post_refinement_inliers) - static_cast<int>(pre_refinement_inliers);
+
+                                // 使用优化后的位姿替换原始估计
+                                pose_result = optimized_pose_result;
+
+                                if (SHOULD_LOG(DEBUG))
+                                {
+                                    LOG_DEBUG_ZH << "PoSDK refinement applied successfully for " << estimator
+                                                 << " view pair (" << view_pair.first << "," << view_pair.second << ")";
+                                    LOG_DEBUG_EN << "PoSDK refinement applied successfully for " << estimator
+                                                 << " view pair (" << view_pair.first << "," << view_pair.second << ")";
+                                }
+                            }
+                            else
+                            {
+                                // 精细优化失败意味着整个view pair的估计都有问题
+                                // 清除所有内点标志并跳过这个view pair
+                                for (auto &match : matches)
+                                {
+                                    match.is_inlier = false;
+                                }
+
+                                LOG_WARNING_ZH << "[PoSDK Refinement] 精细优化失败，拒绝整个view pair ("
+                                               << view_pair.first << "," << view_pair.second << ") - 初始估计也不可信";
+                                LOG_WARNING_EN << "[PoSDK Refinement] Refinement failed, rejecting entire view pair ("
+                                               << view_pair.first << "," << view_pair.second << ") - initial estimate also unreliable";
+
+                                atomic_method_failures.fetch_add(1);
+                                continue; // 跳过后续处理，不添加pose结果
+                            }
                         }
                     }
-                }
-                else if (boost::iequals(estimator, "poselib_model_estimator"))
-                {
-                    // poselib_model_estimator的精细优化已在上面通过refine_model参数处理
-                    if (SHOULD_LOG(DEBUG))
+                    else if (boost::iequals(estimator, "poselib_model_estimator"))
                     {
-                        LOG_DEBUG_ZH << "PoseLib internal refinement enabled for view pair ("
-                                     << view_pair.first << "," << view_pair.second << ")";
-                        LOG_DEBUG_EN << "PoseLib internal refinement enabled for view pair ("
-                                     << view_pair.first << "," << view_pair.second << ")";
+                        // poselib_model_estimator的精细优化已在上面通过refine_model参数处理
+                        if (SHOULD_LOG(DEBUG))
+                        {
+                            LOG_DEBUG_ZH << "PoseLib internal refinement enabled for view pair ("
+                                         << view_pair.first << "," << view_pair.second << ")";
+                            LOG_DEBUG_EN << "PoseLib internal refinement enabled for view pair ("
+                                         << view_pair.first << "," << view_pair.second << ")";
+                        }
                     }
-                }
-                else
-                {
-                    // 其他估计器不支持精细优化，记录警告信息
-                    if (SHOULD_LOG(DEBUG))
+                    else
                     {
-                        LOG_DEBUG_ZH << "Refinement not supported for estimator " << estimator
-                                     << ", ignoring enable_refine=true for view pair ("
-                                     << view_pair.first << "," << view_pair.second << ")";
-                        LOG_DEBUG_EN << "Refinement not supported for estimator " << estimator
-                                     << ", ignoring enable_refine=true for view pair ("
-                                     << view_pair.first << "," << view_pair.second << ")";
+                        // 其他估计器不支持精细优化，记录警告信息
+                        if (SHOULD_LOG(DEBUG))
+                        {
+                            LOG_DEBUG_ZH << "Refinement not supported for estimator " << estimator
+                                         << ", ignoring enable_refine=true for view pair ("
+                                         << view_pair.first << "," << view_pair.second << ")";
+                            LOG_DEBUG_EN << "Refinement not supported for estimator " << estimator
+                                         << ", ignoring enable_refine=true for view pair ("
+                                         << view_pair.first << "," << view_pair.second << ")";
+                        }
                     }
                 }
-            }
-
-            // 验证位姿数据的有效性
-            bool pose_valid = true;
 
-            // 检查旋转矩阵是否有效
-            double det = pose_result->GetRotation().determinant();
-            if (std::abs(det - 1.0) > 0.1) // 旋转矩阵行列式应该接近1
-            {
-                LOG_WARNING_ZH << "Warning: Invalid rotation matrix determinant " << det
-                               << " for view pair (" << view_pair.first << "," << view_pair.second << ")";
-                LOG_WARNING_EN << "Warning: Invalid rotation matrix determinant " << det
-                               << " for view pair (" << view_pair.first << "," << view_pair.second << ")";
-                pose_valid = false;
-            }
+                // 验证位姿数据的有效性
+                bool pose_valid = true;
 
-            // 检查旋转矩阵和平移向量是否包含NaN或Inf
-            if (!pose_result->GetRotation().allFinite() || !pose_result->GetTranslation().allFinite())
-            {
-                LOG_WARNING_ZH << "Warning: Non-finite values in pose for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                LOG_WARNING_EN << "Warning: Non-finite values in pose for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                pose_valid = false;
-            }
-
-            // 检查平移向量是否为零向量（可能的估计失败）
-            if (pose_result->GetTranslation().norm() < 1e-12)
-            {
-                LOG_WARNING_ZH << "Warning: Zero translation vector for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                LOG_WARNING_EN << "Warning: Zero translation vector for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                // 零平移可能是有效的（纯旋转），所以只警告不拒绝
-            }
+                // 检查旋转矩阵是否有效
+                double det = pose_result->GetRotation().determinant();
+                if (std::abs(det - 1.0) > 0.1) // 旋转矩阵行列式应该接近1
+                {
+                    LOG_WARNING_ZH << "Warning: Invalid rotation matrix determinant " << det
+                                   << " for view pair (" << view_pair.first << "," << view_pair.second << ")";
+                    LOG_WARNING_EN << "Warning: Invalid rotation matrix determinant " << det
+                                   << " for view pair (" << view_pair.first << "," << view_pair.second << ")";
+                    pose_valid = false;
+                }
 
-            if (pose_valid)
-            {
-                // 将算法内部格式转换为PoSDK标准格式
-                RelativePose converted_pose = ToPoSDKRelativePoseFormat(*pose_result);
+                // 检查旋转矩阵和平移向量是否包含NaN或Inf
+                if (!pose_result->GetRotation().allFinite() || !pose_result->GetTranslation().allFinite())
+                {
+                    LOG_WARNING_ZH << "Warning: Non-finite values in pose for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    LOG_WARNING_EN << "Warning: Non-finite values in pose for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    pose_valid = false;
+                }
 
-                // 线程安全地添加结果
+                // 检查平移向量是否为零向量（可能的估计失败）
+                if (pose_result->GetTranslation().norm() < 1e-12)
                 {
-                    std::lock_guard<std::mutex> lock(poses_mutex);
-                    thread_safe_poses.push_back(converted_pose);
+                    LOG_WARNING_ZH << "Warning: Zero translation vector for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    LOG_WARNING_EN << "Warning: Zero translation vector for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    // 零平移可能是有效的（纯旋转），所以只警告不拒绝
                 }
-                atomic_successful_pairs.fetch_add(1);
 
-                // 打印估计结果（显示转换后的PoSDK标准格式, 10位小数）
-                if (SHOULD_LOG(DEBUG))
+                if (pose_valid)
                 {
-                    LOG_DEBUG_ZH << "Successfully estimated relative pose: ("
-                                 << view_pair.first << "," << view_pair.second << ")";
-                    LOG_DEBUG_EN << "Successfully estimated relative pose: ("
-                                 << view_pair.first << "," << view_pair.second << ")";
-                    LOG_DEBUG_ZH << "PoSDK format - Rotation: " << std::endl
-                                 << std::fixed << std::setprecision(10) << converted_pose.GetRotation() << std::endl;
-                    LOG_DEBUG_EN << "PoSDK format - Rotation: " << std::endl
-                                 << std::fixed << std::setprecision(10) << converted_pose.GetRotation() << std::endl;
+                    // 将算法内部格式转换为PoSDK标准格式
+                    RelativePose converted_pose = ToPoSDKRelativePoseFormat(*pose_result);
 
-                    LOG_DEBUG_ZH << "PoSDK format - Translation: " << std::endl
-                                 << std::fixed << std::setprecision(10) << converted_pose.GetTranslation().transpose() << std::endl;
-                    LOG_DEBUG_EN << "PoSDK format - Translation: " << std::endl
-                                 << std::fixed << std::setprecision(10) << converted_pose.GetTranslation().transpose() << std::endl;
+                    // 线程安全地添加结果
+                    {
+                        std::lock_guard<std::mutex> lock(poses_mutex);
+                        thread_safe_poses.push_back(converted_pose);
+                    }
+                    journal_record.Commit(&converted_pose);
+                    atomic_successful_pairs.fetch_add(1);
 
-                    // 可选：同时显示原始算法输出（调试用）
+                    // 打印估计结果（显示转换后的PoSDK标准格式, 10位小数）
                     if (SHOULD_LOG(DEBUG))
                     {
-                        LOG_DEBUG_ZH << "Original algorithm format - Rotation: " << std::endl
-                                     << pose_result->GetRotation() << std::endl;
-                        LOG_DEBUG_EN << "Original algorithm format - Rotation: " << std::endl
-                                     << pose_result->GetRotation() << std::endl;
-                        LOG_DEBUG_ZH << "Original algorithm format - Translation: " << std::endl
-                                     << pose_result->GetTranslation().transpose() << std::endl;
-                        LOG_DEBUG_EN << "Original algorithm format - Translation: " << std::endl
-                                     << pose_result->GetTranslation().transpose() << std::endl;
+                        LOG_DEBUG_ZH << "Successfully estimated relative pose: ("
+                                     << view_pair.first << "," << view_pair.second << ")";
+                        LOG_DEBUG_EN << "Successfully estimated relative pose: ("
+                                     << view_pair.first << "," << view_pair.second << ")";
+                        LOG_DEBUG_ZH << "PoSDK format - Rotation: " << std::endl
+                                     << std::fixed << std::setprecision(10) << converted_pose.GetRotation() << std::endl;
+                        LOG_DEBUG_EN << "PoSDK format - Rotation: " << std::endl
+                                     << std::fixed << std::setprecision(10) << converted_pose.GetRotation() << std::endl;
+
+                        LOG_DEBUG_ZH << "PoSDK format - Translation: " << std::endl
+                                     << std::fixed << std::setprecision(10) << converted_pose.GetTranslation().transpose() << std::endl;
+                        LOG_DEBUG_EN << "PoSDK format - Translation: " << std::endl
+                                     << std::fixed << std::setprecision(10) << converted_pose.GetTranslation().transpose() << std::endl;
+
+                        // 可选：同时显示原始算法输出（调试用）
+                        if (SHOULD_LOG(DEBUG))
+                        {
+                            LOG_DEBUG_ZH << "Original algorithm format - Rotation: " << std::endl
+                                         << pose_result->GetRotation() << std::endl;
+                            LOG_DEBUG_EN << "Original algorithm format - Rotation: " << std::endl
+                                         << pose_result->GetRotation() << std::endl;
+                            LOG_DEBUG_ZH << "Original algorithm format - Translation: " << std::endl
+                                         << pose_result->GetTranslation().transpose() << std::endl;
+                            LOG_DEBUG_EN << "Original algorithm format - Translation: " << std::endl
+                                         << pose_result->GetTranslation().transpose() << std::endl;
+                        }
                     }
-                }
 
-                // 显示最新的评估结果（如果启用了评估器）
-                if (GetOptionAsBool("enable_evaluator"))
-                {
-                    // 构造完整的算法名称，与上面SetEvaluatorAlgorithm中的逻辑一致
-                    std::string display_algorithm = estimator;
-                    if (!algorithm.empty())
+                    // 显示最新的评估结果（如果启用了评估器）
+                    if (options_.enable_evaluator)
                     {
-                        display_algorithm += "_" + algorithm;
+                        // 构造完整的算法名称，与上面SetEvaluatorAlgorithm中的逻辑一致
+                        std::string display_algorithm = estimator;
+                        if (!algorithm.empty())
+                        {
+                            display_algorithm += "_" + algorithm;
+                        }
+                        if (enable_refine)
+                        {
+                            display_algorithm += "_refine";
+                        }
+
+                        // 显示最新评估结果，包含view_pairs和匹配数量信息
+                        std::string view_pair_info = "(" + std::to_string(view_pair.first) + "," + std::to_string(view_pair.second) + ")";
+                        // EvaluatorManager::PrintLatestEvaluationResults("RelativePose", display_algorithm, "view_pairs|match_num");
                     }
-                    bool enable_refine = GetOptionAsBool("enable_refine", false);
-                    if (enable_refine)
+                }
+                else
+                {
+                    // 位姿验证失败：清除所有内点标志
+                    for (auto &match : matches)
                     {
-                        display_algorithm += "_refine";
+                        match.is_inlier = false;
                     }
 
-                    // 显示最新评估结果，包含view_pairs和匹配数量信息
-                    std::string view_pair_info = "(" + std::to_string(view_pair.first) + "," + std::to_string(view_pair.second) + ")";
-                    // EvaluatorManager::PrintLatestEvaluationResults("RelativePose", display_algorithm, "view_pairs|match_num");
+                    LOG_WARNING_ZH << "Rejected invalid pose for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    LOG_WARNING_EN << "Rejected invalid pose for view pair ("
+                                   << view_pair.first << "," << view_pair.second << ")";
+                    atomic_invalid_poses.fetch_add(1);
                 }
-            }
-            else
-            {
-                // 位姿验证失败：清除所有内点标志
-                for (auto &match : matches)
+
+                // 更新进度条（线程安全）
                 {
-                    match.is_inlier = false;
+                    std::lock_guard<std::mutex> lock(progress_mutex);
+                    size_t current_milestone = (atomic_processed_pairs.load() * 5) / total_view_pairs;
+                    if (current_milestone > last_progress_milestone || atomic_processed_pairs.load() == total_view_pairs)
+                    {
+                        std::string task_name = "(successful: " + std::to_string(atomic_successful_pairs.load()) + "):";
+                        ShowProgressBar(atomic_processed_pairs.load(), total_view_pairs, task_name);
+                        last_progress_milestone = current_milestone;
+                    }
                 }
+            }
 
-                LOG_WARNING_ZH << "Rejected invalid pose for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                LOG_WARNING_EN << "Rejected invalid pose for view pair ("
-                               << view_pair.first << "," << view_pair.second << ")";
-                atomic_invalid_poses.fetch_add(1);
+            // 本块结果落盘后再开始下一块
+            if (journal)
+            {
+                journal->Flush();
             }
+        }
+
+        if (memory_governor_->Enabled())
+        {
+            const common::MemoryGovernorStats memory_stats = memory_governor_->Stats();
+            LOG_INFO_ZH << "  内存压力控制: 峰值RSS " << (memory_stats.peak_rss_bytes >> 20) << " MB, 最多同时估计 "
+                        << memory_stats.peak_active << " 个视图对, 等待 " << memory_stats.throttled_waits << " 次";
+            LOG_INFO_EN << "  Memory governor: peak RSS " << (memory_stats.peak_rss_bytes >> 20) << " MB, at most "
+                        << memory_stats.peak_active << " pairs at once, " << memory_stats.throttled_waits << " waits";
+        }
 
-            // 更新进度条（线程安全）
+        if (deadline_.Enabled())
+        {
+            std::sort(skipped_pairs.begin(), skipped_pairs.end());
+            LOG_INFO_ZH << "  截止时间模式: 用时 " << std::fixed << std::setprecision(2) << deadline_.ElapsedSeconds()
+                        << "s / " << deadline_.BudgetSeconds() << "s, 跳过 " << skipped_pairs.size() << "/" << total_view_pairs << " 个视图对";
+            LOG_INFO_EN << "  Deadline mode: " << std::fixed << std::setprecision(2) << deadline_.ElapsedSeconds()
+                        << "s / " << deadline_.BudgetSeconds() << "s, skipped " << skipped_pairs.size() << "/" << total_view_pairs << " view pairs";
+        }
+        if (!options_.skipped_pairs_path.empty())
+        {
+            // 分片进程各自写出，文件名追加分片号
+            const std::string skipped_path = active_shard_ >= 0
+                                                 ? options_.skipped_pairs_path + ".shard-" + std::to_string(active_shard_)
+                                                 : options_.skipped_pairs_path;
+            if (!common::WritePairList(skipped_path, skipped_pairs))
             {
-                std::lock_guard<std::mutex> lock(progress_mutex);
-                size_t current_milestone = (atomic_processed_pairs.load() * 5) / total_view_pairs;
-                if (current_milestone > last_progress_milestone || atomic_processed_pairs.load() == total_view_pairs)
-                {
-                    std::string task_name = "(successful: " + std::to_string(atomic_successful_pairs.load()) + "):";
-                    ShowProgressBar(atomic_processed_pairs.load(), total_view_pairs, task_name);
-                    last_progress_milestone = current_milestone;
-                }
+                LOG_WARNING_ZH << "无法写入跳过的视图对列表: " << skipped_path;
+                LOG_WARNING_EN << "Unable to write skipped view pair list: " << skipped_path;
             }
         }
 
@@ -741,6 +1095,14 @@ namespace PluginMethods
         method_failures = atomic_method_failures.load();
         invalid_poses = atomic_invalid_poses.load();
 
+        if (atomic_reported_pairs.load() > 0)
+        {
+            LOG_INFO_ZH << "  逐对估计实际RANSAC迭代总数: " << atomic_realized_iterations.load()
+                        << " (" << atomic_reported_pairs.load() << " 个视图对)";
+            LOG_INFO_EN << "  Per-pair estimation realised RANSAC iterations: " << atomic_realized_iterations.load()
+                        << " (" << atomic_reported_pairs.load() << " view pairs)";
+        }
+
         // 将多线程结果复制到最终的poses容器
         for (const auto &pose : thread_safe_poses)
         {
@@ -793,7 +1155,7 @@ namespace PluginMethods
         }
 
         // 5.5. 添加成功率评估结果到EvaluatorManager
-        if (total_view_pairs > 0 && GetOptionAsBool("enable_evaluator"))
+        if (total_view_pairs > 0 && options_.enable_evaluator)
         {
             double success_ratio = static_cast<double>(successful_pairs) / static_cast<double>(total_view_pairs);
 
@@ -866,37 +1228,259 @@ namespace PluginMethods
             return nullptr;
         }
 
-        LOG_DEBUG_ZH << "[TwoViewEstimator] Successfully estimated " << poses->size()
-                     << " relative poses using " << estimator;
-        LOG_DEBUG_EN << "[TwoViewEstimator] Successfully estimated " << poses->size()
-                     << " relative poses using " << estimator;
+        LOG_DEBUG_ZH << "[TwoViewEstimator] Successfully estimated " << poses->size()
+                     << " relative poses using " << estimator;
+        LOG_DEBUG_EN << "[TwoViewEstimator] Successfully estimated " << poses->size()
+                     << " relative poses using " << estimator;
+
+        // 6. 创建输出数据包，包含相对位姿和修改后的匹配数据
+        DataPackagePtr data_package_ptr = std::make_shared<DataPackage>();
+
+        // 添加相对位姿数据
+        data_package_ptr->AddData("data_relative_poses", data_relative_poses);
+
+        // 添加修改后的匹配数据（包含更新的is_inlier信息）
+        data_package_ptr->AddData("data_matches", required_package_["data_matches"]);
+
+        LOG_DEBUG_ZH << "[TwoViewEstimator] Output package contains:";
+        LOG_DEBUG_EN << "[TwoViewEstimator] Output package contains:";
+        LOG_DEBUG_ZH << "  - data_relative_poses: " << poses->size() << " poses";
+        LOG_DEBUG_EN << "  - data_relative_poses: " << poses->size() << " poses";
+        LOG_DEBUG_ZH << "  - data_matches: " << matches_ptr->size() << " view pairs (with updated inlier flags)";
+        LOG_DEBUG_EN << "  - data_matches: " << matches_ptr->size() << " view pairs (with updated inlier flags)";
+
+        // End profiling and display statistics | 结束性能分析并显示统计信息
+        PROFILER_END();
+
+        // Print profiling statistics | 打印性能分析统计
+        if (SHOULD_LOG(DEBUG))
+        {
+            PROFILER_PRINT_STATS(enable_profiling_); // 当前会话统计
+        }
+
+        return data_package_ptr;
+    }
+
+    DataPtr TwoViewEstimator::RunSharded()
+    {
+        auto matches_ptr = GetDataPtr<Matches>(required_package_["data_matches"]);
+        if (!matches_ptr)
+        {
+            LOG_ERROR_ZH << "无效输入数据";
+            LOG_ERROR_EN << "Invalid input data";
+            return nullptr;
+        }
+
+        common::ShardOptions shard_options;
+        shard_options.shard_count = options_.shard_count;
+        shard_options.shard_index = options_.shard_index;
+        shard_options.shard_dir = options_.shard_dir;
+        shard_options.run_id = options_.shard_run_id;
+        shard_options.wait_timeout_s = options_.shard_wait_timeout;
+
+        // 输入指纹：影响结果的选项 + 视图对及其匹配内容（过期或其他任务的分片文件不会被合并）
+        common::ShardFingerprint fingerprint = ResultOptionsFingerprint();
+        for (const auto &[view_pair, id_matches] : *matches_ptr)
+        {
+            AddPairToFingerprint(fingerprint, view_pair, id_matches);
+        }
+
+        // 每个分片：只对本分片视图对运行Run()，输出位姿及其内点标记
+        auto task = [this, &matches_ptr](size_t shard_index, std::string &payload)
+        {
+            active_shard_ = static_cast<int>(shard_index);
+            DataPtr shard_result = Run();
+            active_shard_ = -1;
+
+            // 分片内没有有效位姿时Run()返回nullptr，此时输出空分片
+            std::vector<RelativePose> shard_poses;
+            if (auto shard_package = std::dynamic_pointer_cast<DataPackage>(shard_result))
+            {
+                if (auto shard_relative_poses = GetDataPtr<RelativePoses>(shard_package->GetData("data_relative_poses")))
+                {
+                    for (const auto &pose : *shard_relative_poses)
+                    {
+                        shard_poses.push_back(pose);
+                    }
+                }
+            }
+
+            Matches shard_matches;
+            for (const auto &[view_pair, id_matches] : *matches_ptr)
+            {
+                if (common::ShardOfPair(view_pair.first, view_pair.second, options_.shard_count) == shard_index)
+                {
+                    shard_matches.emplace(view_pair, id_matches);
+                }
+            }
+            common::EncodeTwoViewShard(shard_poses, shard_matches, payload);
+            return true;
+        };
+
+        std::vector<std::string> payloads;
+        std::string error;
+        if (!common::RunShardedPhase(shard_options, "two_view", fingerprint.Value(), task, payloads, error))
+        {
+            LOG_ERROR_ZH << "[TwoViewEstimator] 分片双视图估计失败: " << error;
+            LOG_ERROR_EN << "[TwoViewEstimator] Sharded two-view estimation failed: " << error;
+            return nullptr;
+        }
+
+        // 合并：内点标记写回完整匹配，位姿按视图对排序（与分片数无关）
+        std::vector<RelativePose> merged_poses;
+        for (size_t k = 0; k < payloads.size(); ++k)
+        {
+            if (!common::DecodeTwoViewShard(payloads[k], merged_poses, *matches_ptr))
+            {
+                LOG_ERROR_ZH << "[TwoViewEstimator] 分片 " << k << " 数据损坏或与当前匹配不一致";
+                LOG_ERROR_EN << "[TwoViewEstimator] Shard " << k << " is malformed or inconsistent with the current matches";
+                return nullptr;
+            }
+        }
+        std::sort(merged_poses.begin(), merged_poses.end(),
+                  [](const RelativePose &a, const RelativePose &b)
+                  { return std::make_pair(a.GetViewIdI(), a.GetViewIdJ()) < std::make_pair(b.GetViewIdI(), b.GetViewIdJ()); });
+
+        auto data_relative_poses = FactoryData::Create("data_relative_poses");
+        auto poses = GetDataPtr<RelativePoses>(data_relative_poses);
+        if (!poses)
+        {
+            LOG_ERROR_ZH << "Failed to create relative poses container";
+            LOG_ERROR_EN << "Failed to create relative poses container";
+            return nullptr;
+        }
+        for (auto &pose : merged_poses)
+        {
+            poses->push_back(pose);
+        }
+
+        LOG_INFO_ZH << "[TwoViewEstimator] 已合并 " << payloads.size() << " 个分片: " << poses->size() << "/"
+                    << matches_ptr->size() << " 个视图对得到相对位姿";
+        LOG_INFO_EN << "[TwoViewEstimator] Merged " << payloads.size() << " shards: " << poses->size() << "/"
+                    << matches_ptr->size() << " view pairs have relative poses";
 
-        // 6. 创建输出数据包，包含相对位姿和修改后的匹配数据
-        DataPackagePtr data_package_ptr = std::make_shared<DataPackage>();
+        // 与Run()一致的算法名称（外部启动时其他分片进程中的设置不会传回）
+        std::string full_algorithm_name = options_.estimator;
+        if (!options_.algorithm.empty())
+        {
+            full_algorithm_name += "_" + options_.algorithm;
+        }
+        if (options_.enable_refine)
+        {
+            full_algorithm_name += "_refine";
+        }
+        SetEvaluatorAlgorithm(full_algorithm_name);
 
-        // 添加相对位姿数据
-        data_package_ptr->AddData("data_relative_poses", data_relative_poses);
+        if (options_.enable_evaluator && !matches_ptr->empty())
+        {
+            const double success_ratio = static_cast<double>(poses->size()) / static_cast<double>(matches_ptr->size());
+            Interface::EvaluatorManager::AddEvaluationResult("RelativePoses", full_algorithm_name,
+                                                             GetOptionAsString("ProfileCommit"), "SuccessfulRatio",
+                                                             success_ratio, "Success rate of pose estimation");
+        }
 
-        // 添加修改后的匹配数据（包含更新的is_inlier信息）
+        if (poses->empty())
+        {
+            LOG_WARNING_ZH << "[TwoViewEstimator] Critical Error: Failed to estimate any valid relative poses!";
+            LOG_WARNING_EN << "[TwoViewEstimator] Critical Error: Failed to estimate any valid relative poses!";
+            return nullptr;
+        }
+
+        DataPackagePtr data_package_ptr = std::make_shared<DataPackage>();
+        data_package_ptr->AddData("data_relative_poses", data_relative_poses);
         data_package_ptr->AddData("data_matches", required_package_["data_matches"]);
+        return data_package_ptr;
+    }
 
-        LOG_DEBUG_ZH << "[TwoViewEstimator] Output package contains:";
-        LOG_DEBUG_EN << "[TwoViewEstimator] Output package contains:";
-        LOG_DEBUG_ZH << "  - data_relative_poses: " << poses->size() << " poses";
-        LOG_DEBUG_EN << "  - data_relative_poses: " << poses->size() << " poses";
-        LOG_DEBUG_ZH << "  - data_matches: " << matches_ptr->size() << " view pairs (with updated inlier flags)";
-        LOG_DEBUG_EN << "  - data_matches: " << matches_ptr->size() << " view pairs (with updated inlier flags)";
+    common::ShardFingerprint TwoViewEstimator::ResultOptionsFingerprint()
+    {
+        common::ShardFingerprint fingerprint;
+        const std::map<std::string, std::string> sorted_options(GetMethodOptions().begin(), GetMethodOptions().end());
+        for (const auto &[key, value] : sorted_options)
+        {
+            if (boost::starts_with(key, "shard_") || boost::starts_with(key, "journal_") ||
+                boost::starts_with(key, "time_budget_") || boost::starts_with(key, "memory_") || key == "skipped_pairs_path" ||
+                key == "num_threads" || key == "log_level" || key == "enable_profiling" ||
+                key == "enable_evaluator" || key == "ProfileCommit")
+            {
+                continue;
+            }
+            fingerprint.Add(key).Add(value);
+        }
+        return fingerprint;
+    }
 
-        // End profiling and display statistics | 结束性能分析并显示统计信息
-        PROFILER_END();
+    std::unique_ptr<common::PairJournal> TwoViewEstimator::OpenPairJournal(
+        std::vector<std::pair<ViewPair, IdMatches *>> &view_pair_list,
+        std::vector<common::RansacBudget> &pair_budgets,
+        Matches &matches,
+        std::vector<RelativePose> &replayed_poses)
+    {
+        if (options_.journal_path.empty())
+        {
+            return nullptr;
+        }
 
-        // Print profiling statistics | 打印性能分析统计
-        if (SHOULD_LOG(DEBUG))
+        // 分片进程各自使用独立的日志文件
+        common::PairJournalOptions journal_options;
+        journal_options.path = options_.journal_path;
+        if (active_shard_ >= 0)
         {
-            PROFILER_PRINT_STATS(enable_profiling_); // 当前会话统计
+            journal_options.path += ".shard-" + std::to_string(active_shard_) + "-of-" + std::to_string(options_.shard_count);
         }
+        journal_options.flush_pairs = options_.journal_flush_pairs;
 
-        return data_package_ptr;
+        // 输入指纹：影响结果的选项 + 视图对及其匹配
+        common::ShardFingerprint fingerprint = ResultOptionsFingerprint();
+        for (const auto &[view_pair, pair_matches] : view_pair_list)
+        {
+            AddPairToFingerprint(fingerprint, view_pair, *pair_matches);
+        }
+
+        auto journal = std::make_unique<common::PairJournal>(journal_options);
+        std::string error;
+        if (!journal->Open(fingerprint.Value(), error))
+        {
+            LOG_WARNING_ZH << "[TwoViewEstimator] 无法打开视图对日志，不支持断点续算: " << error;
+            LOG_WARNING_EN << "[TwoViewEstimator] Cannot open pair journal, resuming disabled: " << error;
+            return nullptr;
+        }
+
+        // 回放已完成的视图对：写回内点标记并收集位姿，其余视图对保持原顺序
+        size_t kept = 0;
+        for (size_t k = 0; k < view_pair_list.size(); ++k)
+        {
+            const ViewPair &view_pair = view_pair_list[k].first;
+            const std::string *payload = journal->Find(view_pair.first, view_pair.second);
+            std::vector<RelativePose> pair_poses;
+            if (payload && common::DecodeTwoViewShard(*payload, pair_poses, matches))
+            {
+                replayed_poses.insert(replayed_poses.end(), pair_poses.begin(), pair_poses.end());
+                continue;
+            }
+
+            view_pair_list[kept] = view_pair_list[k];
+            if (!pair_budgets.empty())
+            {
+                pair_budgets[kept] = pair_budgets[k];
+            }
+            ++kept;
+        }
+        const size_t num_replayed = view_pair_list.size() - kept;
+        view_pair_list.resize(kept);
+        if (!pair_budgets.empty())
+        {
+            pair_budgets.resize(kept);
+        }
+        journal->ReleaseReplayed();
+        common::MetricCacheLookups("two_view_journal", true).fetch_add(num_replayed, std::memory_order_relaxed);
+        common::MetricCacheLookups("two_view_journal", false).fetch_add(kept, std::memory_order_relaxed);
+
+        LOG_INFO_ZH << "[TwoViewEstimator] 视图对日志: " << journal->Path() << "，回放 " << num_replayed
+                    << " 个已完成视图对，待估计 " << kept << " 个";
+        LOG_INFO_EN << "[TwoViewEstimator] Pair journal: " << journal->Path() << ", replayed " << num_replayed
+                    << " completed pairs, " << kept << " pairs to estimate";
+        return journal;
     }
 
     RelativePose TwoViewEstimator::ToPoSDKRelativePoseFormat(const RelativePose &pose_result)
@@ -927,8 +1511,8 @@ namespace PluginMethods
     bool TwoViewEstimator::ValidateEstimationQuality(size_t inlier_count, size_t total_matches, const std::string &estimator_name) const
     {
         // 获取质量控制参数
-        size_t min_geometric_inliers = GetOptionAsIndexT("min_geometric_inliers", 50);
-        double min_inlier_ratio = GetOptionAsFloat("min_inlier_ratio", 0.25);
+        const size_t min_geometric_inliers = options_.min_geometric_inliers;
+        const double min_inlier_ratio = options_.min_inlier_ratio;
 
         // 1. 检查几何内点数量（参考OpenMVG的50个内点要求）
         if (inlier_count < min_geometric_inliers)
@@ -983,147 +1567,88 @@ namespace PluginMethods
         return true;
     }
 
-    void TwoViewEstimator::SetCurrentViewPairGTData(const ViewPair &view_pair)
+    void TwoViewEstimator::PrepareGTPoseIndex()
     {
-        try
-        {
-            // 检查是否有GT数据
-            auto gt_data_it = prior_info_.find("gt_data");
-            if (gt_data_it == prior_info_.end() || !gt_data_it->second)
-            {
-                LOG_DEBUG_ZH << "[TwoViewEstimator] No GT data found in prior_info_";
-                LOG_DEBUG_EN << "[TwoViewEstimator] No GT data found in prior_info_";
-                return;
-            }
-
-            DataPtr gt_data = gt_data_it->second;
+        gt_pose_index_.Reset(nullptr);
+        gt_relative_poses_.reset();
 
-            // 尝试转换为RelativePoses数据
-            auto gt_poses_ptr = GetDataPtr<RelativePoses>(gt_data);
-            if (!gt_poses_ptr)
-            {
-                LOG_DEBUG_ZH << "[TwoViewEstimator] GT data is not RelativePoses type: " << gt_data->GetType();
-                LOG_DEBUG_EN << "[TwoViewEstimator] GT data is not RelativePoses type: " << gt_data->GetType();
-                return;
-            }
+        // 检查是否有GT数据
+        auto gt_data_it = prior_info_.find("gt_data");
+        if (gt_data_it == prior_info_.end() || !gt_data_it->second)
+        {
+            LOG_DEBUG_ZH << "[TwoViewEstimator] No GT data found in prior_info_";
+            LOG_DEBUG_EN << "[TwoViewEstimator] No GT data found in prior_info_";
+            return;
+        }
 
-            // 使用新实现的GetRelativePose函数获取当前view_pair的GT位姿
-            Matrix3d R_gt;
-            Vector3d t_gt;
-            if (gt_poses_ptr->GetRelativePose(view_pair, R_gt, t_gt))
-            {
-                // 创建单个RelativePose作为GT数据
-                RelativePose current_gt_pose(view_pair.first, view_pair.second, R_gt.transpose(), -R_gt.transpose() * t_gt);
+        // 尝试转换为RelativePoses数据
+        DataPtr gt_data = gt_data_it->second;
+        gt_relative_poses_ = GetDataPtr<RelativePoses>(gt_data);
+        if (!gt_relative_poses_)
+        {
+            LOG_DEBUG_ZH << "[TwoViewEstimator] GT data is not RelativePoses type: " << gt_data->GetType();
+            LOG_DEBUG_EN << "[TwoViewEstimator] GT data is not RelativePoses type: " << gt_data->GetType();
+            return;
+        }
 
-                // 包装为DataMap
-                auto current_gt_pose_datamap = std::make_shared<DataMap<RelativePose>>(current_gt_pose, "data_relative_pose");
-                DataPtr current_gt_pose_data = std::static_pointer_cast<DataIO>(current_gt_pose_datamap);
+        // 每个数据集只建一次索引，逐对查询为二分查找
+        gt_pose_index_.Reset(gt_relative_poses_.get());
+        LOG_DEBUG_ZH << "[TwoViewEstimator] GT相对位姿索引: " << gt_pose_index_.Size() << " 个视图对";
+        LOG_DEBUG_EN << "[TwoViewEstimator] GT relative pose index: " << gt_pose_index_.Size() << " view pairs";
+    }
 
-                // 为method设置GT数据
-                if (current_method_)
-                {
-                    auto method_cast = std::dynamic_pointer_cast<MethodPresetProfiler>(current_method_);
-                    if (method_cast)
-                    {
-                        method_cast->SetGTData(current_gt_pose_data);
-                        LOG_DEBUG_ZH << "[TwoViewEstimator] Set GT pose for view pair ("
-                                     << view_pair.first << "," << view_pair.second << ")";
-                        LOG_DEBUG_EN << "[TwoViewEstimator] Set GT pose for view pair ("
-                                     << view_pair.first << "," << view_pair.second << ")";
-                    }
-                    else
-                    {
-                        LOG_DEBUG_ZH << "[TwoViewEstimator] Method does not support GT data setting";
-                        LOG_DEBUG_EN << "[TwoViewEstimator] Method does not support GT data setting";
-                    }
-                }
-                else
-                {
-                    LOG_DEBUG_ZH << "[TwoViewEstimator] current_method_ is null";
-                    LOG_DEBUG_EN << "[TwoViewEstimator] current_method_ is null";
-                }
-            }
-            else
-            {
-                LOG_DEBUG_ZH << "[TwoViewEstimator] No GT pose found for view pair ("
-                             << view_pair.first << "," << view_pair.second << ")";
-                LOG_DEBUG_EN << "[TwoViewEstimator] No GT pose found for view pair ("
-                             << view_pair.first << "," << view_pair.second << ")";
-            }
-        }
-        catch (const std::exception &e)
+    void TwoViewEstimator::SetCurrentViewPairGTData(const ViewPair &view_pair)
+    {
+        if (!current_method_)
         {
-            std::cerr << "[TwoViewEstimator] Error setting GT data for view pair ("
-                      << view_pair.first << "," << view_pair.second << "): " << e.what();
-            LOG_ERROR_ZH << "[TwoViewEstimator] Error setting GT data for view pair ("
-                         << view_pair.first << "," << view_pair.second << "): " << e.what();
-            LOG_ERROR_EN << "[TwoViewEstimator] Error setting GT data for view pair ("
-                         << view_pair.first << "," << view_pair.second << "): " << e.what();
+            LOG_DEBUG_ZH << "[TwoViewEstimator] current_method_ is null";
+            LOG_DEBUG_EN << "[TwoViewEstimator] current_method_ is null";
+            return;
         }
+        SetCurrentViewPairGTDataForMethod(view_pair, current_method_);
     }
 
     void TwoViewEstimator::SetCurrentViewPairGTDataForMethod(const ViewPair &view_pair, Interface::MethodPresetPtr method)
     {
+        if (gt_pose_index_.Empty() || !method)
+        {
+            return;
+        }
+
         try
         {
-            // 检查是否有GT数据
-            auto gt_data_it = prior_info_.find("gt_data");
-            if (gt_data_it == prior_info_.end() || !gt_data_it->second)
+            // 从索引获取当前view_pair的GT位姿
+            Matrix3d R_gt;
+            Vector3d t_gt;
+            if (!gt_pose_index_.Find(view_pair, R_gt, t_gt))
             {
-                LOG_DEBUG_ZH << "[TwoViewEstimator] No GT data found in prior_info_";
-                LOG_DEBUG_EN << "[TwoViewEstimator] No GT data found in prior_info_";
+                LOG_DEBUG_ZH << "[TwoViewEstimator] No GT pose found for view pair ("
+                             << view_pair.first << "," << view_pair.second << ")";
+                LOG_DEBUG_EN << "[TwoViewEstimator] No GT pose found for view pair ("
+                             << view_pair.first << "," << view_pair.second << ")";
                 return;
             }
 
-            DataPtr gt_data = gt_data_it->second;
-
-            // 尝试转换为RelativePoses数据
-            auto gt_poses_ptr = GetDataPtr<RelativePoses>(gt_data);
-            if (!gt_poses_ptr)
+            auto method_cast = std::dynamic_pointer_cast<MethodPresetProfiler>(method);
+            if (!method_cast)
             {
-                LOG_DEBUG_ZH << "[TwoViewEstimator] GT data is not RelativePoses type: " << gt_data->GetType();
-                LOG_DEBUG_EN << "[TwoViewEstimator] GT data is not RelativePoses type: " << gt_data->GetType();
+                LOG_DEBUG_ZH << "[TwoViewEstimator] Method cannot be cast to MethodPresetProfiler for GT data setting";
+                LOG_DEBUG_EN << "[TwoViewEstimator] Method cannot be cast to MethodPresetProfiler for GT data setting";
                 return;
             }
 
-            // 使用新实现的GetRelativePose函数获取当前view_pair的GT位姿
-            Matrix3d R_gt;
-            Vector3d t_gt;
-            if (gt_poses_ptr->GetRelativePose(view_pair, R_gt, t_gt))
-            {
-                // 创建单个RelativePose作为GT数据
-                RelativePose current_gt_pose(view_pair.first, view_pair.second, R_gt.transpose(), -R_gt.transpose() * t_gt);
+            // 创建单个RelativePose作为GT数据
+            RelativePose current_gt_pose(view_pair.first, view_pair.second, R_gt.transpose(), -R_gt.transpose() * t_gt);
 
-                // 包装为DataMap
-                auto current_gt_pose_datamap = std::make_shared<DataMap<RelativePose>>(current_gt_pose, "data_relative_pose");
-                DataPtr current_gt_pose_data = std::static_pointer_cast<DataIO>(current_gt_pose_datamap);
+            // 每个视图对单独分配DataMap：方法可能持有GT的DataPtr，不能在视图对之间复用
+            auto current_gt_pose_datamap = std::make_shared<DataMap<RelativePose>>(current_gt_pose, "data_relative_pose");
+            DataPtr current_gt_pose_data = std::static_pointer_cast<DataIO>(current_gt_pose_datamap);
+            method_cast->SetGTData(current_gt_pose_data);
 
-                // 为指定method设置GT数据
-                if (method)
-                {
-                    auto method_cast = std::dynamic_pointer_cast<MethodPresetProfiler>(method);
-                    if (method_cast)
-                    {
-                        method_cast->SetGTData(current_gt_pose_data);
-                        LOG_DEBUG_ZH << "[TwoViewEstimator] Set GT pose for view pair ("
-                                     << view_pair.first << "," << view_pair.second << ")";
-                        LOG_DEBUG_EN << "[TwoViewEstimator] Set GT pose for view pair ("
-                                     << view_pair.first << "," << view_pair.second << ")";
-                    }
-                    else
-                    {
-                        LOG_DEBUG_ZH << "[TwoViewEstimator] Method cannot be cast to MethodPresetProfiler for GT data setting";
-                        LOG_DEBUG_EN << "[TwoViewEstimator] Method cannot be cast to MethodPresetProfiler for GT data setting";
-                    }
-                }
-            }
-            else
-            {
-                LOG_DEBUG_ZH << "[TwoViewEstimator] No GT pose found for view pair ("
-                             << view_pair.first << "," << view_pair.second << ")";
-                LOG_DEBUG_EN << "[TwoViewEstimator] No GT pose found for view pair ("
-                             << view_pair.first << "," << view_pair.second << ")";
-            }
+            LOG_DEBUG_ZH << "[TwoViewEstimator] Set GT pose for view pair ("
+                         << view_pair.first << "," << view_pair.second << ")";
+            LOG_DEBUG_EN << "[TwoViewEstimator] Set GT pose for view pair ("
+                         << view_pair.first << "," << view_pair.second << ")";
         }
         catch (const std::exception &e)
         {
@@ -1427,6 +1952,286 @@ namespace PluginMethods
         }
     }
 
+    void TwoViewEstimator::RunBatchEstimation(
+        const std::vector<std::pair<ViewPair, IdMatches *>> &view_pair_list,
+        size_t range_begin,
+        size_t range_end,
+        const FeaturesInfo &features,
+        const CameraModels &cameras,
+        const std::string &estimator,
+        const std::string &algorithm,
+        size_t min_num_required_pairs,
+        const std::vector<common::RansacBudget> &pair_budgets,
+        std::vector<common::TwoViewBatchResult> &batch_results,
+        std::vector<char> &batch_done)
+    {
+        batch_results.clear();
+        batch_done.clear();
+
+        if (!options_.enable_batch_estimation || range_begin >= range_end)
+        {
+            return;
+        }
+
+        // 评估器需要为每个视图对设置GT，保持逐对路径
+        if (options_.enable_evaluator)
+        {
+            LOG_DEBUG_ZH << "[TwoViewEstimator] 已启用评估器，使用逐对估计";
+            LOG_DEBUG_EN << "[TwoViewEstimator] Evaluator enabled, using per-pair estimation";
+            return;
+        }
+
+        MethodOptions options;
+        if (!algorithm.empty())
+        {
+            options["algorithm"] = algorithm;
+        }
+
+        // 1. 检测后端是否支持批量估计
+        auto probe_method = std::dynamic_pointer_cast<Interface::MethodPreset>(FactoryMethod::Create(estimator.c_str()));
+        auto *probe_batch = dynamic_cast<common::TwoViewBatchEstimator *>(probe_method.get());
+        if (!probe_batch)
+        {
+            LOG_DEBUG_ZH << "[TwoViewEstimator] 估计器 " << estimator << " 不支持批量接口，使用逐对估计";
+            LOG_DEBUG_EN << "[TwoViewEstimator] Estimator " << estimator << " has no batch interface, using per-pair estimation";
+            return;
+        }
+        probe_method->SetMethodOptions(options);
+        if (!probe_batch->SupportsBatchEstimation())
+        {
+            LOG_INFO_ZH << "[TwoViewEstimator] 当前配置不支持批量估计，使用逐对估计";
+            LOG_INFO_EN << "[TwoViewEstimator] Current configuration does not support batch estimation, using per-pair estimation";
+            return;
+        }
+
+        const size_t total_pairs = view_pair_list.size();
+        batch_results.resize(total_pairs);
+        batch_done.assign(total_pairs, 0);
+
+        // 2. 与逐对路径相同的预筛选（未通过的留给主循环统计），bearing在批内转换
+        std::vector<size_t> ready_indices;
+        ready_indices.reserve(range_end - range_begin);
+        for (size_t idx = range_begin; idx < range_end; ++idx)
+        {
+            const ViewPair &view_pair = view_pair_list[idx].first;
+            const IdMatches &matches = *view_pair_list[idx].second;
+            if (!matches.empty() && matches.size() >= min_num_required_pairs &&
+                view_pair.first < features.size() && view_pair.second < features.size())
+            {
+                ready_indices.push_back(idx);
+            }
+        }
+
+        // 3. 按批估计：每个线程复用一个方法实例（选项相同，估计器只编译一次），批次间并行
+#ifdef USE_OPENMP
+        std::vector<Interface::MethodPresetPtr> batch_methods(static_cast<size_t>(std::max(1, omp_get_max_threads())));
+#else
+        std::vector<Interface::MethodPresetPtr> batch_methods(1);
+#endif
+        batch_methods[0] = probe_method;
+        const size_t batch_size = std::max<size_t>(1, options_.batch_size);
+        const size_t num_batches = (ready_indices.size() + batch_size - 1) / batch_size;
+        std::atomic<size_t> batched_pairs(0);
+        std::atomic<size_t> realized_iterations(0);
+        std::atomic<uint64_t> &pairs_metric = common::MetricPairsProcessed("two_view");
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int b = 0; b < static_cast<int>(num_batches); ++b)
+        {
+#ifdef USE_OPENMP
+            const size_t thread_id = static_cast<size_t>(omp_get_thread_num());
+#else
+            const size_t thread_id = 0;
+#endif
+            Interface::MethodPresetPtr method = thread_id < batch_methods.size() ? batch_methods[thread_id] : nullptr;
+            if (!method)
+            {
+                method = std::dynamic_pointer_cast<Interface::MethodPreset>(FactoryMethod::Create(estimator.c_str()));
+                if (!method)
+                {
+                    continue; // 整批回退到逐对估计
+                }
+                method->SetMethodOptions(options);
+                if (thread_id < batch_methods.size())
+                {
+                    batch_methods[thread_id] = method;
+                }
+            }
+            auto *batch_estimator = dynamic_cast<common::TwoViewBatchEstimator *>(method.get());
+            if (!batch_estimator)
+            {
+                continue; // 整批回退到逐对估计
+            }
+
+            const size_t begin = static_cast<size_t>(b) * batch_size;
+            const size_t end = std::min(begin + batch_size, ready_indices.size());
+
+            // 截止时间模式：预算耗尽后不再启动新批次，其视图对交由主循环跳过
+            if (deadline_.Expired() && ready_indices[begin] >= deadline_min_pairs_)
+            {
+                continue;
+            }
+            common::MemoryGovernor::Slot memory_slot(*memory_governor_);
+
+            // 本批的bearing pairs，批次结束时释放；转换失败的视图对留给主循环统计
+            std::vector<BearingPairs> bearings(end - begin);
+            std::vector<size_t> item_indices;
+            std::vector<common::TwoViewBatchItem> items;
+            item_indices.reserve(end - begin);
+            items.reserve(end - begin);
+            for (size_t k = begin; k < end; ++k)
+            {
+                const size_t idx = ready_indices[k];
+                IdMatches &matches = *view_pair_list[idx].second;
+                BearingPairs &item_bearings = bearings[k - begin];
+                if (!types::MatchesToBearingPairs(matches, features, cameras, view_pair_list[idx].first, item_bearings) ||
+                    item_bearings.size() != matches.size())
+                {
+                    item_bearings.clear();
+                    continue;
+                }
+                common::TwoViewBatchItem item{view_pair_list[idx].first, &item_bearings};
+                if (!pair_budgets.empty())
+                {
+                    item.budget = &pair_budgets[idx];
+                }
+                item_indices.push_back(idx);
+                items.push_back(item);
+            }
+            if (items.empty())
+            {
+                continue;
+            }
+
+            std::vector<common::TwoViewBatchResult> results;
+            batch_estimator->EstimateBatch({items.data(), items.size()}, results);
+            if (results.size() != items.size())
+            {
+                continue; // 整批回退到逐对估计
+            }
+
+            for (size_t k = 0; k < items.size(); ++k)
+            {
+                const size_t idx = item_indices[k];
+                auto &result = results[k];
+                if (result.success && result.inliers.size() != items[k].bearing_pairs->size())
+                {
+                    continue; // 内点位集不一致，该视图对回退到逐对估计
+                }
+                realized_iterations.fetch_add(result.iterations);
+                batch_results[idx] = std::move(result);
+                batch_done[idx] = 1;
+                batched_pairs.fetch_add(1);
+                pairs_metric.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        LOG_INFO_ZH << "  批量估计: " << batched_pairs.load() << "/" << (range_end - range_begin)
+                    << " 个视图对 (批大小: " << batch_size << ", 批次数: " << num_batches << ")";
+        LOG_INFO_EN << "  Batch estimation: " << batched_pairs.load() << "/" << (range_end - range_begin)
+                    << " view pairs (batch size: " << batch_size << ", batches: " << num_batches << ")";
+        if (realized_iterations.load() > 0)
+        {
+            LOG_INFO_ZH << "  批量估计实际RANSAC迭代总数: " << realized_iterations.load();
+            LOG_INFO_EN << "  Batch estimation realised RANSAC iterations: " << realized_iterations.load();
+        }
+    }
+
+    std::vector<common::RansacBudget> TwoViewEstimator::ComputeRansacBudgets(
+        const std::vector<std::pair<ViewPair, IdMatches *>> &view_pair_list,
+        const Matches &matches,
+        const std::string &algorithm)
+    {
+        std::vector<common::RansacBudget> budgets;
+        if (!options_.adaptive_ransac_budget || view_pair_list.empty())
+        {
+            return budgets;
+        }
+
+        common::RansacBudgetOptions budget_options;
+        budget_options.sample_size = common::RansacBudgetController::SampleSizeForAlgorithm(algorithm);
+        budget_options.min_iterations = options_.budget_min_iterations;
+        budget_options.max_iterations = options_.budget_max_iterations;
+        budget_options.confidence = options_.budget_confidence;
+        budget_options.hard_confidence = options_.budget_hard_confidence;
+        budget_options.safety_factor = options_.budget_safety_factor;
+        budget_options.hard_ratio = options_.budget_hard_ratio;
+        budget_options.reference_matches = options_.budget_reference_matches;
+        budget_options.count_prior_floor = options_.budget_count_prior_floor;
+        budget_options.count_prior_gain = options_.budget_count_prior_gain;
+        budget_options.graph_prior_base = options_.budget_graph_prior_base;
+        budget_options.graph_prior_slope = options_.budget_graph_prior_slope;
+        budget_options.graph_prior_min = options_.budget_graph_prior_min;
+        budget_options.graph_prior_max = options_.budget_graph_prior_max;
+        budget_options.flagged_weight = options_.budget_flagged_weight;
+        budget_options.min_inlier_ratio = options_.budget_min_inlier_ratio;
+        budget_options.max_inlier_ratio = options_.budget_max_inlier_ratio;
+
+        common::RansacBudgetController controller(budget_options);
+        controller.BuildViewGraphPrior(matches);
+
+        budgets.reserve(view_pair_list.size());
+        size_t total_budget = 0;
+        size_t hard_pairs = 0;
+        for (const auto &[view_pair, pair_matches] : view_pair_list)
+        {
+            budgets.push_back(controller.ComputeBudget(controller.CollectStatistics(view_pair, *pair_matches)));
+            const auto &budget = budgets.back();
+            total_budget += budget.max_iterations;
+            hard_pairs += budget.is_hard ? 1 : 0;
+
+            if (SHOULD_LOG(DEBUG))
+            {
+                LOG_DEBUG_ZH << "视图对 (" << view_pair.first << "," << view_pair.second << ") RANSAC预算: 预测内点率="
+                             << std::fixed << std::setprecision(2) << budget.predicted_inlier_ratio
+                             << ", 迭代上限=" << budget.max_iterations << ", 置信度=" << budget.confidence;
+                LOG_DEBUG_EN << "View pair (" << view_pair.first << "," << view_pair.second << ") RANSAC budget: predicted inlier ratio="
+                             << std::fixed << std::setprecision(2) << budget.predicted_inlier_ratio
+                             << ", iteration cap=" << budget.max_iterations << ", confidence=" << budget.confidence;
+            }
+        }
+
+        const size_t uniform_budget = budget_options.max_iterations * view_pair_list.size();
+        LOG_INFO_ZH << "  自适应RANSAC预算: 迭代上限总计 " << total_budget << " (统一上限: " << uniform_budget
+                    << "), 困难视图对: " << hard_pairs << "/" << view_pair_list.size()
+                    << ", 最小样本数: " << budget_options.sample_size;
+        LOG_INFO_EN << "  Adaptive RANSAC budget: total iteration cap " << total_budget << " (uniform cap: " << uniform_budget
+                    << "), hard pairs: " << hard_pairs << "/" << view_pair_list.size()
+                    << ", minimal sample size: " << budget_options.sample_size;
+        return budgets;
+    }
+
+    void TwoViewEstimator::ApplyRansacBudget(const common::RansacBudget &budget,
+                                             const std::string &estimator,
+                                             MethodOptions &options) const
+    {
+        // OpenCV/Barath使用max_iterations与confidence，OpenGV使用ransac_max_iterations与ransac_confidence，
+        // PoseLib使用ransac_max_iterations与ransac_success_prob。
+        // 阈值不随预算改变：各后端的阈值单位不同（像素、1-cos、对极距离），由估计器自身配置决定
+        if (boost::iequals(estimator, "opencv_two_view_estimator") ||
+            boost::iequals(estimator, "barath_two_view_estimator"))
+        {
+            options["max_iterations"] = std::to_string(budget.max_iterations);
+            options["confidence"] = std::to_string(budget.confidence);
+        }
+        else if (boost::iequals(estimator, "opengv_model_estimator"))
+        {
+            options["ransac_max_iterations"] = std::to_string(budget.max_iterations);
+            options["ransac_confidence"] = std::to_string(budget.confidence);
+        }
+        else if (boost::iequals(estimator, "poselib_model_estimator"))
+        {
+            options["ransac_max_iterations"] = std::to_string(budget.max_iterations);
+            options["ransac_success_prob"] = std::to_string(budget.confidence);
+        }
+        else
+        {
+            return; // 未知估计器：保持其自身配置
+        }
+    }
+
     void TwoViewEstimator::ShowProgressBar(size_t current, size_t total, const std::string &task_name, int bar_width)
     {
         if (total == 0)
@@ -8,6 +8,15 @@
 
 #include <po_core.hpp>
 #include <common/converter/converter_opengv.hpp>
+#include <common/estimator/two_view_batch.hpp>
+#include <common/estimator/gt_pose_index.hpp>
+#include <common/estimator/ransac_budget.hpp>
+#include <common/io/metrics_exporter.hpp>
+#include <common/io/pair_journal.hpp>
+#include <common/options/option_schema.hpp>
+#include <common/parallel/pair_shards.hpp>
+#include <common/parallel/memory_governor.hpp>
+#include <common/parallel/stage_deadline.hpp>
 #include <opengv/relative_pose/methods.hpp>
 #include <po_core/po_logger.hpp>
 namespace PluginMethods
@@ -28,6 +37,91 @@ namespace PluginMethods
 
         // 实现 Call 接口
     private:
+        /**
+         * @brief 每次Run()编译一次的选项（逐视图对循环中直接读取）
+         */
+        struct TwoViewOptions
+        {
+            std::string estimator = "opencv_two_view_estimator";
+            std::string algorithm;
+            bool enable_refine = false;
+            IndexT min_num_required_pairs = 50;
+            IndexT num_threads = 4;
+            bool enable_quality_validation = true;
+            IndexT min_geometric_inliers = 50;
+            double min_inlier_ratio = 0.25;
+            bool enable_evaluator = false;
+            bool enable_batch_estimation = true;
+            IndexT batch_size = 64;
+            IndexT shard_count = 0;
+            int shard_index = -1;
+            std::string shard_dir;
+            std::string shard_run_id;
+            double shard_wait_timeout = 0.0;
+            std::string journal_path;
+            IndexT journal_flush_pairs = 256;
+            double time_budget_s = 0.0;        // 截止时间模式的阶段预算（秒），0表示不限
+            IndexT time_budget_min_pairs = 0;  // 预算耗尽后仍保证处理的视图对数，0表示视图数
+            std::string pair_priority = "none"; // none | matches（匹配数多的视图对优先）
+            std::string skipped_pairs_path;    // 因预算耗尽跳过的视图对列表文件，为空表示不写出
+            double memory_high_watermark = 0.0; // 内存上限比例，超过后限制同时运行的视图对数，0表示不启用
+            double memory_low_watermark = 0.0;  // 低于该比例时恢复并发，0表示高水位-0.1
+            IndexT memory_limit_mb = 0;         // 内存上限（MB），0表示cgroup限制或物理内存
+            // 自适应RANSAC预算（默认值只在GetOptionSchema()中声明，取自common::RansacBudgetOptions）
+            bool adaptive_ransac_budget{};
+            size_t budget_min_iterations{};
+            size_t budget_max_iterations{};
+            double budget_confidence{};
+            double budget_hard_confidence{};
+            double budget_safety_factor{};
+            double budget_hard_ratio{};
+            size_t budget_reference_matches{};
+            double budget_count_prior_floor{};
+            double budget_count_prior_gain{};
+            double budget_graph_prior_base{};
+            double budget_graph_prior_slope{};
+            double budget_graph_prior_min{};
+            double budget_graph_prior_max{};
+            double budget_flagged_weight{};
+            double budget_min_inlier_ratio{};
+            double budget_max_inlier_ratio{};
+        };
+
+        static const common::OptionSchema<TwoViewOptions> &GetOptionSchema();
+
+        TwoViewOptions options_;
+
+        /**
+         * @brief 分片执行：本进程只对shard_index分片运行Run()，再与其他进程的分片按视图对顺序合并相对位姿和内点标记
+         * @return 与Run()相同结构的输出数据包
+         */
+        DataPtr RunSharded();
+
+        /**
+         * @brief 影响结果的选项的指纹（不含线程、分片、日志、时间预算、内存控制等执行选项）
+         * @details 分片文件和视图对日志共用，视图对及匹配内容由调用方追加
+         */
+        common::ShardFingerprint ResultOptionsFingerprint();
+
+        int active_shard_ = -1; ///< 当前正在计算的分片（-1表示不限制视图对）
+        common::StageDeadline deadline_; ///< 本阶段的时间预算（截止时间模式），外层Run()启动，分片Run()沿用
+        size_t deadline_min_pairs_ = 0;  ///< 预算耗尽后仍处理的前若干个视图对
+        std::unique_ptr<common::MemoryGovernor> memory_governor_; ///< 本次Run()的内存压力并发控制
+
+        /**
+         * @brief 打开视图对日志并回放已完成的视图对（断点续算）
+         * @param view_pair_list 待处理视图对，回放的视图对会被移除
+         * @param pair_budgets 与view_pair_list对齐的RANSAC预算（可为空），同步移除
+         * @param matches 全部匹配，回放视图对的内点标记写回其中
+         * @param replayed_poses 输出：回放得到的相对位姿
+         * @return 日志实例；未启用或打开失败时为nullptr
+         */
+        std::unique_ptr<common::PairJournal> OpenPairJournal(
+            std::vector<std::pair<ViewPair, IdMatches *>> &view_pair_list,
+            std::vector<common::RansacBudget> &pair_budgets,
+            Matches &matches,
+            std::vector<RelativePose> &replayed_poses);
+
         /**
          * @brief 从优化器的DataSample中同步内点信息到IdMatches
          * @param matches 匹配点引用，将被修改
@@ -58,10 +152,15 @@ namespace PluginMethods
          */
         bool ValidateEstimationQuality(size_t inlier_count, size_t total_matches, const std::string &estimator_name) const;
 
+        /**
+         * @brief 从prior_info_中的GT相对位姿建立逐对查询索引（每次Run()一次）
+         */
+        void PrepareGTPoseIndex();
+
         /**
          * @brief 为当前method设置对应view_pair的GT相对位姿数据
          * @param view_pair 当前处理的视图对
-         * @details 从prior_info_中获取GT相对位姿数据，提取当前view_pair对应的位姿，并设置给method
+         * @details 从GT索引中查询当前view_pair对应的位姿，并设置给method
          */
         void SetCurrentViewPairGTData(const ViewPair &view_pair);
 
@@ -69,7 +168,7 @@ namespace PluginMethods
          * @brief 为指定method设置对应view_pair的GT相对位姿数据（线程安全版本）
          * @param view_pair 当前处理的视图对
          * @param method 指定的方法实例
-         * @details 从prior_info_中获取GT相对位姿数据，提取当前view_pair对应的位姿，并设置给指定的method
+         * @details 从GT索引中查询当前view_pair对应的位姿，并设置给指定的method（需先调用PrepareGTPoseIndex）
          */
         void SetCurrentViewPairGTDataForMethod(const ViewPair &view_pair, Interface::MethodPresetPtr method);
 
@@ -87,6 +186,56 @@ namespace PluginMethods
             const ViewPair &view_pair,
             IdMatches &matches);
 
+        /**
+         * @brief 批量估计预处理（后端实现common::TwoViewBatchEstimator时启用）
+         * @details bearing pairs按批转换，批次结束即释放，峰值内存与批大小相关而非总匹配数
+         * @param view_pair_list 所有视图对及其匹配
+         * @param range_begin 本次估计的视图对范围起点（分块处理）
+         * @param range_end 本次估计的视图对范围终点（不含）
+         * @param features 特征信息
+         * @param cameras 相机模型
+         * @param estimator 估计器名称
+         * @param algorithm 子算法名称
+         * @param min_num_required_pairs 最小匹配数要求（与逐对路径一致的预筛选）
+         * @param batch_results 输出：按视图对索引存放的批量估计结果
+         * @param batch_done 输出：视图对是否已由批量路径处理（未处理的回退到逐对Build()）
+         * @param pair_budgets 逐对RANSAC预算（为空时使用估计器自身配置）
+         */
+        void RunBatchEstimation(
+            const std::vector<std::pair<ViewPair, IdMatches *>> &view_pair_list,
+            size_t range_begin,
+            size_t range_end,
+            const FeaturesInfo &features,
+            const CameraModels &cameras,
+            const std::string &estimator,
+            const std::string &algorithm,
+            size_t min_num_required_pairs,
+            const std::vector<common::RansacBudget> &pair_budgets,
+            std::vector<common::TwoViewBatchResult> &batch_results,
+            std::vector<char> &batch_done);
+
+        /**
+         * @brief 根据匹配统计量为每个视图对计算RANSAC预算
+         * @param view_pair_list 所有视图对及其匹配
+         * @param matches 全部匹配（用于视图图先验）
+         * @param algorithm 子算法名称（决定最小样本数）
+         * @return 与view_pair_list同序的预算；未启用adaptive_ransac_budget时为空
+         */
+        std::vector<common::RansacBudget> ComputeRansacBudgets(
+            const std::vector<std::pair<ViewPair, IdMatches *>> &view_pair_list,
+            const Matches &matches,
+            const std::string &algorithm);
+
+        /**
+         * @brief 将单个视图对的预算写入估计器选项（按估计器的选项名映射）
+         * @param budget 视图对预算
+         * @param estimator 估计器名称
+         * @param options 输出：估计器选项
+         */
+        void ApplyRansacBudget(const common::RansacBudget &budget,
+                               const std::string &estimator,
+                               MethodOptions &options) const;
+
         /**
          * @brief 显示进度条
          * @param current 当前进度
@@ -97,6 +246,9 @@ namespace PluginMethods
         void ShowProgressBar(size_t current, size_t total, const std::string &task_name, int bar_width = 50);
 
         Interface::MethodPresetPtr current_method_; ///< 当前使用的方法实例
+
+        std::shared_ptr<RelativePoses> gt_relative_poses_; ///< 建立索引的GT相对位姿
+        common::GTRelativePoseIndex gt_pose_index_;        ///< GT相对位姿索引
     };
 
 } // namespace PluginMethods
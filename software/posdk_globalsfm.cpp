@@ -10,7 +10,23 @@
 #include <filesystem>
 #include <iostream>
 #include <chrono>
+#include <atomic>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char **environ;
+#endif
 
 using namespace PoSDK;
 using namespace Interface;
@@ -30,6 +46,11 @@ DEFINE_string(compared_pipelines, "", "对比流水线列表（逗号分隔）
 DEFINE_int32(log_level, 0, "日志级别 / Log level");
 DEFINE_string(language, "ZH", "语言设置：ZH(中文), EN(英文) / Language setting: ZH(Chinese), EN(English)");
 DEFINE_string(preset, "default", "参数预设模式：default(使用配置文件默认值), custom(使用命令行自定义参数) / Parameter preset mode: default(use config file defaults), custom(use command line custom parameters)");
+DEFINE_int32(shard_count, 0, "分片进程数，0或1表示不分片（custom模式） / Number of shard processes, 0 or 1 disables sharding (custom mode)");
+DEFINE_string(shard_launch, "spawn", "分片启动方式：spawn(本机启动全新工作进程), external(每个节点运行一个分片) / Shard launch mode: spawn(fresh local worker processes), external(one shard per node)");
+DEFINE_int32(shard_index, 0, "external模式下本进程计算的分片索引 / Shard computed by this process in external mode");
+DEFINE_string(shard_run_id, "", "本次分片运行的标识，external模式下所有分片须相同，spawn模式自动生成 / Id of this sharded run, must match across shards in external mode, generated in spawn mode");
+DEFINE_string(shard_dir, "", "分片文件目录（external模式需为共享目录） / Shard file directory (must be shared in external mode)");
 
 // 早期配置双语日志系统 / Configure Early Bilingual Logging System
 void ConfigureEarlyLogging()
@@ -121,6 +142,25 @@ bool ValidateParameters()
         return false;
     }
 
+    // 验证分片启动方式 / Validate shard launch mode
+    if (FLAGS_shard_launch != "spawn" && FLAGS_shard_launch != "external")
+    {
+        BILINGUAL_LOG_ERROR(ZH) << "错误：不支持的分片启动方式: " << FLAGS_shard_launch;
+        BILINGUAL_LOG_ERROR(EN) << "Error: Unsupported shard launch mode: " << FLAGS_shard_launch;
+        BILINGUAL_LOG_ERROR(ZH) << "支持的方式：spawn, external";
+        BILINGUAL_LOG_ERROR(EN) << "Supported modes: spawn, external";
+        return false;
+    }
+
+    // external模式下各节点须使用同一运行标识，避免合并旧运行遗留的分片文件
+    // In external mode every node must share one run id so leftover shard files of older runs are never merged
+    if (FLAGS_shard_count > 1 && FLAGS_shard_launch == "external" && FLAGS_shard_run_id.empty())
+    {
+        BILINGUAL_LOG_ERROR(ZH) << "错误：external分片模式需要 --shard_run_id";
+        BILINGUAL_LOG_ERROR(EN) << "Error: external shard launch requires --shard_run_id";
+        return false;
+    }
+
     // 验证预处理类型 / Validate preprocessing type
     if (FLAGS_preprocess_type != "openmvg" && FLAGS_preprocess_type != "posdk" &&
         FLAGS_preprocess_type != "colmap" && FLAGS_preprocess_type != "glomap")
@@ -218,6 +258,41 @@ void PrintParameters()
     LOG_INFO_ALL << "==================\n";
 }
 
+#ifndef _WIN32
+// spawn模式：以全新进程（posix_spawn，不fork当前进程）启动分片1..N-1，它们以external模式运行同一命令
+// spawn mode: start shards 1..N-1 as fresh processes (posix_spawn, the current process is not forked)
+// running the same command in external mode
+std::vector<pid_t> SpawnShardWorkers(const std::vector<std::string> &args)
+{
+    std::vector<pid_t> workers;
+    for (int k = 1; k < FLAGS_shard_count; ++k)
+    {
+        // gflags以最后出现的值为准 / gflags keeps the last occurrence of a flag
+        std::vector<std::string> worker_args = args;
+        worker_args.push_back("--shard_launch=external");
+        worker_args.push_back("--shard_index=" + std::to_string(k));
+        worker_args.push_back("--shard_run_id=" + FLAGS_shard_run_id);
+        std::vector<char *> worker_argv;
+        for (auto &arg : worker_args)
+        {
+            worker_argv.push_back(arg.data());
+        }
+        worker_argv.push_back(nullptr);
+
+        pid_t pid = 0;
+        const int rc = posix_spawnp(&pid, worker_argv[0], nullptr, nullptr, worker_argv.data(), environ);
+        if (rc != 0)
+        {
+            BILINGUAL_LOG_ERROR(ZH) << "错误：无法启动分片工作进程 " << k << ": " << std::strerror(rc);
+            BILINGUAL_LOG_ERROR(EN) << "Error: Failed to start shard worker " << k << ": " << std::strerror(rc);
+            break;
+        }
+        workers.push_back(pid);
+    }
+    return workers;
+}
+#endif
+
 // 执行GlobalSfM流水线 / Execute GlobalSfM Pipeline
 bool RunGlobalSfMPipeline()
 {
@@ -275,6 +350,18 @@ bool RunGlobalSfMPipeline()
                 options["compared_pipelines"] = FLAGS_compared_pipelines;
             }
 
+            // 如果启用了分片，添加分片选项 / If sharding is enabled, add shard options
+            if (FLAGS_shard_count > 1)
+            {
+                options["shard_count"] = std::to_string(FLAGS_shard_count);
+                options["shard_run_id"] = FLAGS_shard_run_id;
+                options["shard_index"] = std::to_string(FLAGS_shard_index);
+                if (!FLAGS_shard_dir.empty())
+                {
+                    options["shard_dir"] = FLAGS_shard_dir;
+                }
+            }
+
             globalsfm_pipeline->SetMethodOptions(options);
 
             // 如果是单数据集模式，创建并设置输入数据 / If single dataset mode, create and set input data
@@ -361,6 +448,9 @@ bool RunGlobalSfMPipeline()
 
 int main(int argc, char *argv[])
 {
+    // spawn模式的工作进程使用原始命令行 / Workers of spawn mode reuse the original command line
+    const std::vector<std::string> original_args(argv, argv + argc);
+
     // 设置gflags / Setup gflags
     gflags::SetUsageMessage("PoSDK GlobalSfM Pipeline - 基于PoSDK的全局SfM重建流水线 / PoSDK-based Global SfM Reconstruction Pipeline\n"
                             "\n运行模式 / Running Modes:\n"
@@ -402,9 +492,93 @@ int main(int argc, char *argv[])
     // 打印参数信息 / Print parameter information
     PrintParameters();
 
+    // spawn模式：本进程作为分片0，其余分片在全新进程中运行 / spawn mode: this process is shard 0, the other shards run in fresh processes
+    const bool spawn_workers = FLAGS_preset == "custom" && FLAGS_shard_count > 1 && FLAGS_shard_launch == "spawn";
+#ifndef _WIN32
+    std::vector<pid_t> workers;
+    std::atomic<bool> workers_ok(true);
+    std::thread worker_watcher;
+    if (spawn_workers)
+    {
+        // 每次运行使用新的标识（pid+时间+随机数） / A fresh id per run (pid + time + random)
+        if (FLAGS_shard_run_id.empty())
+        {
+            std::ostringstream run_id;
+            run_id << ::getpid() << "-"
+                   << std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count()
+                   << "-" << std::hex << std::random_device{}();
+            FLAGS_shard_run_id = run_id.str();
+        }
+        workers = SpawnShardWorkers(original_args);
+        if (static_cast<int>(workers.size()) + 1 < FLAGS_shard_count)
+        {
+            for (pid_t pid : workers)
+            {
+                ::kill(pid, SIGTERM);
+                ::waitpid(pid, nullptr, 0);
+            }
+            return 1;
+        }
+        BILINGUAL_LOG_INFO(ZH) << "已启动 " << workers.size() << " 个分片工作进程，本进程计算分片0";
+        BILINGUAL_LOG_INFO(EN) << "Started " << workers.size() << " shard worker processes, this process computes shard 0";
+        FLAGS_shard_launch = "external";
+        FLAGS_shard_index = 0;
+
+        // 工作进程失败时分片0会一直等待其分片文件，因此结束整个任务
+        // Shard 0 would wait forever for a failed worker's shard file, so the whole job is stopped
+        worker_watcher = std::thread(
+            [&workers, &workers_ok]()
+            {
+                for (size_t k = 0; k < workers.size(); ++k)
+                {
+                    int status = 0;
+                    if (::waitpid(workers[k], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                    {
+                        if (!workers_ok.exchange(false))
+                        {
+                            continue; // 分片0已失败并终止工作进程 / shard 0 already failed and stopped the workers
+                        }
+                        BILINGUAL_LOG_ERROR(ZH) << "错误：分片工作进程 " << (k + 1) << " 失败，终止任务";
+                        BILINGUAL_LOG_ERROR(EN) << "Error: Shard worker " << (k + 1) << " failed, stopping the job";
+                        for (pid_t pid : workers)
+                        {
+                            ::kill(pid, SIGTERM);
+                        }
+                        std::_Exit(1);
+                    }
+                }
+            });
+    }
+#else
+    if (spawn_workers)
+    {
+        BILINGUAL_LOG_ERROR(ZH) << "错误：当前平台不支持spawn分片启动方式";
+        BILINGUAL_LOG_ERROR(EN) << "Error: spawn shard launch is not supported on this platform";
+        return 1;
+    }
+#endif
+
     // 执行流水线 / Execute pipeline
     bool success = RunGlobalSfMPipeline();
 
+#ifndef _WIN32
+    if (worker_watcher.joinable())
+    {
+        // 分片0失败时工作进程可能仍在等待，先终止它们 / Workers may still be waiting when shard 0 failed, stop them first
+        if (!success && workers_ok.exchange(false))
+        {
+            for (pid_t pid : workers)
+            {
+                ::kill(pid, SIGTERM);
+            }
+        }
+        worker_watcher.join();
+        success = success && workers_ok.load();
+    }
+#endif
+
     // 显示版权信息汇总 / Display copyright information summary
     BILINGUAL_LOG_INFO(ZH) << "\n========================================";
     BILINGUAL_LOG_INFO(ZH) << "版权信息汇总 | Copyright Information Summary";
@@ -0,0 +1,392 @@
+/**
+ * @file posdk_solver_bench.cpp
+ * @brief 最小求解器微基准：PoSDK原生求解器 vs OpenGV，以及仿射对应RANSAC vs 五点法RANSAC
+ *        Minimal solver microbenchmark: PoSDK native solvers vs OpenGV, affine-correspondence vs five-point RANSAC
+ * @author PoSDK Team
+ */
+
+#include <gflags/gflags.h>
+#include <common/estimator/minimal_ransac.hpp>
+#include <opengv/relative_pose/CentralRelativeAdapter.hpp>
+#include <opengv/relative_pose/methods.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace common::minimal;
+using PoSDK::types::BearingPairs;
+
+DEFINE_int32(trials, 10000, "每个求解器的随机场景数 / Random scenes per solver");
+DEFINE_int32(points, 8, "每个场景的对应数（>= 8） / Correspondences per scene (>= 8)");
+DEFINE_double(noise, 0.0, "射线噪声标准差（弧度） / Bearing noise standard deviation (radians)");
+DEFINE_uint32(seed, 42, "随机种子 / Random seed");
+DEFINE_int32(ransac_trials, 50, "仿射对应RANSAC对比的场景数 / Scenes for the affine-correspondence RANSAC comparison");
+DEFINE_int32(ransac_points, 300, "RANSAC场景的对应数 / Correspondences per RANSAC scene");
+DEFINE_double(affine_noise, 0.02, "仿射噪声标准差（逐元素） / Affine frame noise standard deviation (per entry)");
+DEFINE_double(validation_noise, 1e-3, "float32评分验证场景的射线噪声 / Bearing noise of the float32 scoring validation scenes");
+DEFINE_double(validation_min_jaccard, 0.99, "float32评分验证：内点集最小Jaccard / float32 validation: minimum inlier Jaccard");
+DEFINE_double(validation_max_angle, 0.1, "float32评分验证：最大位姿差（度） / float32 validation: maximum pose difference (degrees)");
+
+namespace
+{
+    /**
+     * @brief 合成场景（PoSDK约定 xj ~ R xi + t）/ Synthetic scene (PoSDK convention xj ~ R xi + t)
+     */
+    struct Scene
+    {
+        Mat3<double> R;
+        Vec3<double> t;
+        BearingPairs pairs;
+        AffineFrames frames;                             // 局部平面诱导的仿射
+        opengv::bearingVectors_t bearings_i, bearings_j; // OpenGV输入（计时外构造）
+    };
+
+    /**
+     * @brief Exact local affine frame of a point on a random plane facing camera i | 朝向相机i的随机平面上点的精确局部仿射
+     */
+    Mat2<double> LocalAffine(std::mt19937 &rng, const Mat3<double> &R, const Vec3<double> &t, const Vec3<double> &X)
+    {
+        std::normal_distribution<double> normal;
+        const Vec3<double> n = (Vec3<double>(normal(rng), normal(rng), normal(rng)).normalized() - 2.0 * Vec3<double>::UnitZ()).normalized();
+        const Mat3<double> H = R + t * n.transpose() / n.dot(X); // pj ~ H pi
+        const Vec3<double> q = H * (X / X.z());
+        return (H.topLeftCorner<2, 2>() * q.z() - q.head<2>() * H.block<1, 2>(2, 0)) / (q.z() * q.z());
+    }
+
+    Scene MakeScene(std::mt19937 &rng, bool upright, int num_points = FLAGS_points, double outlier_ratio = 0.0,
+                    double noise = FLAGS_noise)
+    {
+        std::normal_distribution<double> normal;
+        Scene scene;
+        if (upright)
+        {
+            const double theta = 0.5 * normal(rng);
+            scene.R = Eigen::AngleAxisd(theta, Vec3<double>::UnitY()).toRotationMatrix();
+        }
+        else
+        {
+            const Vec3<double> axis(normal(rng), normal(rng), normal(rng));
+            scene.R = Eigen::AngleAxisd(0.3 * normal(rng), axis.normalized()).toRotationMatrix();
+        }
+        scene.t = Vec3<double>(normal(rng), normal(rng), normal(rng)).normalized();
+
+        std::uniform_real_distribution<double> uniform(-0.3, 0.3);
+        for (int k = 0; k < num_points; ++k)
+        {
+            const Vec3<double> X(normal(rng), normal(rng), 5.0 + normal(rng));
+            Vec3<double> xi = X.normalized();
+            Vec3<double> xj = (scene.R * X + scene.t).normalized();
+            Mat2<double> A = LocalAffine(rng, scene.R, scene.t, X);
+            if (noise > 0.0)
+            {
+                xi = (xi + noise * Vec3<double>(normal(rng), normal(rng), normal(rng))).normalized();
+                xj = (xj + noise * Vec3<double>(normal(rng), normal(rng), normal(rng))).normalized();
+                A += FLAGS_affine_noise * Mat2<double>::NullaryExpr([&]() { return normal(rng); });
+            }
+            if (k < outlier_ratio * num_points)
+            {
+                xj = Vec3<double>(uniform(rng), uniform(rng), 1.0).normalized();
+                A = Mat2<double>::NullaryExpr([&]() { return normal(rng); });
+            }
+            scene.frames.push_back(A);
+            Eigen::Matrix<double, 6, 1> pair;
+            pair.head<3>() = xi;
+            pair.tail<3>() = xj;
+            scene.pairs.push_back(pair);
+            scene.bearings_i.push_back(xi);
+            scene.bearings_j.push_back(xj);
+        }
+        return scene;
+    }
+
+    /**
+     * @brief 是否有任一本质矩阵（任一转置方向）满足全部对应 / Whether any essential (either orientation) fits all correspondences
+     */
+    template <typename Container>
+    bool AnyEssentialFits(const Container &essentials, const Scene &scene)
+    {
+        const double tolerance = FLAGS_noise > 0.0 ? 10.0 * FLAGS_noise * FLAGS_noise : 1e-12;
+        for (const auto &E : essentials)
+        {
+            for (const Mat3<double> &candidate : {Mat3<double>(E), Mat3<double>(E.transpose())})
+            {
+                double worst = 0.0;
+                for (const auto &pair : scene.pairs)
+                {
+                    worst = std::max(worst, AngularEpipolarError<double>(candidate, pair.head<3>(), pair.tail<3>()));
+                }
+                if (worst < tolerance)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    struct BenchResult
+    {
+        double micros_per_call = 0.0;
+        double success_rate = 0.0;
+    };
+
+    /**
+     * @brief 计时并统计成功率 / Time a solver and count successes
+     */
+    BenchResult Run(const std::vector<Scene> &scenes, const std::function<bool(const Scene &)> &solve)
+    {
+        size_t successes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto &scene : scenes)
+        {
+            successes += solve(scene) ? 1 : 0;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        BenchResult result;
+        result.micros_per_call = 1e6 * seconds / scenes.size();
+        result.success_rate = static_cast<double>(successes) / scenes.size();
+        return result;
+    }
+
+    void PrintRow(const std::string &solver, const BenchResult &native, const BenchResult *library)
+    {
+        if (library)
+        {
+            std::printf("%-24s %12.2f %10.1f%% %12.2f %10.1f%% %9.2fx\n", solver.c_str(),
+                        native.micros_per_call, 100.0 * native.success_rate,
+                        library->micros_per_call, 100.0 * library->success_rate,
+                        library->micros_per_call / native.micros_per_call);
+        }
+        else
+        {
+            std::printf("%-24s %12.2f %10.1f%% %12s %11s %10s\n", solver.c_str(),
+                        native.micros_per_call, 100.0 * native.success_rate, "-", "-", "-");
+        }
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    gflags::SetUsageMessage("PoSDK minimal solver microbenchmark");
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    if (FLAGS_points < 8 || FLAGS_trials <= 0)
+    {
+        std::fprintf(stderr, "--points must be >= 8 and --trials > 0\n");
+        return 1;
+    }
+
+    std::mt19937 rng(FLAGS_seed);
+    std::vector<Scene> scenes, upright_scenes;
+    scenes.reserve(FLAGS_trials);
+    upright_scenes.reserve(FLAGS_trials);
+    for (int k = 0; k < FLAGS_trials; ++k)
+    {
+        scenes.push_back(MakeScene(rng, false));
+        upright_scenes.push_back(MakeScene(rng, true));
+    }
+
+    const size_t sample[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    const std::vector<int> indices5 = {0, 1, 2, 3, 4};
+    const std::vector<int> indices7 = {0, 1, 2, 3, 4, 5, 6};
+    const std::vector<int> indices8 = {0, 1, 2, 3, 4, 5, 6, 7};
+    const std::vector<int> indices2 = {0, 1};
+
+    std::printf("trials=%d points=%d noise=%g\n", FLAGS_trials, FLAGS_points, FLAGS_noise);
+    std::printf("%-24s %12s %11s %12s %11s %10s\n", "solver", "posdk us", "posdk ok", "opengv us", "opengv ok", "speedup");
+
+    // 5-point
+    {
+        const BenchResult native = Run(scenes, [&](const Scene &scene)
+                                       {
+                                           FixedVector<Mat3<double>, 10> essentials;
+                                           FivePoint<double>(scene.pairs, sample, essentials);
+                                           return AnyEssentialFits(essentials, scene); });
+        const BenchResult stewenius = Run(scenes, [&](const Scene &scene)
+                                          {
+                                              opengv::relative_pose::CentralRelativeAdapter adapter(scene.bearings_i, scene.bearings_j);
+                                              const opengv::complexEssentials_t complex = opengv::relative_pose::fivept_stewenius(adapter, indices5);
+                                              std::vector<Mat3<double>> essentials;
+                                              for (const auto &E : complex)
+                                                  if (E.imag().norm() < 1e-9)
+                                                      essentials.push_back(E.real());
+                                              return AnyEssentialFits(essentials, scene); });
+        const BenchResult nister = Run(scenes, [&](const Scene &scene)
+                                       {
+                                           opengv::relative_pose::CentralRelativeAdapter adapter(scene.bearings_i, scene.bearings_j);
+                                           return AnyEssentialFits(opengv::relative_pose::fivept_nister(adapter, indices5), scene); });
+        PrintRow("fivept (vs stewenius)", native, &stewenius);
+        PrintRow("fivept (vs nister)", native, &nister);
+    }
+
+    // 7-point
+    {
+        const BenchResult native = Run(scenes, [&](const Scene &scene)
+                                       {
+                                           FixedVector<Mat3<double>, 3> essentials;
+                                           SevenPoint<double>(scene.pairs, sample, essentials);
+                                           return AnyEssentialFits(essentials, scene); });
+        const BenchResult library = Run(scenes, [&](const Scene &scene)
+                                        {
+                                            opengv::relative_pose::CentralRelativeAdapter adapter(scene.bearings_i, scene.bearings_j);
+                                            return AnyEssentialFits(opengv::relative_pose::sevenpt(adapter, indices7), scene); });
+        PrintRow("sevenpt", native, &library);
+    }
+
+    // 8-point
+    {
+        const BenchResult native = Run(scenes, [&](const Scene &scene)
+                                       {
+                                           std::vector<Mat3<double>> essentials(1);
+                                           EightPoint<double, 8>(scene.pairs, sample, essentials[0]);
+                                           return AnyEssentialFits(essentials, scene); });
+        const BenchResult library = Run(scenes, [&](const Scene &scene)
+                                        {
+                                            opengv::relative_pose::CentralRelativeAdapter adapter(scene.bearings_i, scene.bearings_j);
+                                            const std::vector<Mat3<double>> essentials = {opengv::relative_pose::eightpt(adapter, indices8)};
+                                            return AnyEssentialFits(essentials, scene); });
+        PrintRow("eightpt", native, &library);
+    }
+
+    // 2-point with known rotation | 已知旋转的两点法
+    {
+        const auto translation_ok = [](const Vec3<double> &estimate, const Vec3<double> &truth)
+        {
+            return estimate.normalized().cross(truth.normalized()).norm() < (FLAGS_noise > 0.0 ? 1e-2 : 1e-6);
+        };
+        const BenchResult native = Run(scenes, [&](const Scene &scene)
+                                       {
+                                           PoseSolution<double> pose;
+                                           return TwoPointKnownRotation<double>(scene.R, scene.pairs, sample, pose) &&
+                                                  translation_ok(pose.t, scene.t); });
+        const BenchResult library = Run(scenes, [&](const Scene &scene)
+                                        {
+                                            // OpenGV: R12 = R^T, t12 = -R^T t
+                                            opengv::relative_pose::CentralRelativeAdapter adapter(scene.bearings_i, scene.bearings_j);
+                                            adapter.setR12(scene.R.transpose());
+                                            const opengv::translation_t t12 = opengv::relative_pose::twopt(adapter, false, indices2);
+                                            return translation_ok(t12, -scene.R.transpose() * scene.t); });
+        PrintRow("twopt (known R)", native, &library);
+    }
+
+    // Upright 3-point (no OpenGV counterpart) | 竖直三点法（OpenGV无对应求解器）
+    {
+        const BenchResult native = Run(upright_scenes, [&](const Scene &scene)
+                                       {
+                                           FixedVector<PoseSolution<double>, 6> poses;
+                                           UprightThreePoint<double>(scene.pairs, sample, poses);
+                                           for (const auto &pose : poses)
+                                               if ((pose.R - scene.R).norm() < (FLAGS_noise > 0.0 ? 1e-1 : 1e-6))
+                                                   return true;
+                                           return false; });
+        PrintRow("upright3pt", native, nullptr);
+    }
+
+    // 2-point affine correspondences vs five-point (no OpenGV counterpart) | 两点仿射对应 vs 五点法
+    {
+        const BenchResult native = Run(scenes, [&](const Scene &scene)
+                                       {
+                                           FixedVector<Mat3<double>, 10> essentials;
+                                           TwoAffinePoint<double>(scene.pairs, scene.frames, sample, essentials);
+                                           return AnyEssentialFits(essentials, scene); });
+        PrintRow("affine2pt", native, nullptr);
+    }
+
+    // RANSAC: iterations and time of affine2pt vs fivept at increasing outlier ratios
+    // RANSAC：不同外点率下affine2pt与fivept的迭代次数和耗时
+    std::printf("\nRANSAC (%d scenes x %d points, noise=%g, affine_noise=%g)\n",
+                FLAGS_ransac_trials, FLAGS_ransac_points, FLAGS_noise, FLAGS_affine_noise);
+    std::printf("%-10s %-10s %12s %12s %11s\n", "outliers", "solver", "iterations", "ms", "ok");
+    for (const double outlier_ratio : {0.5, 0.7, 0.8, 0.9})
+    {
+        std::vector<Scene> ransac_scenes;
+        for (int k = 0; k < FLAGS_ransac_trials; ++k)
+            ransac_scenes.push_back(MakeScene(rng, false, FLAGS_ransac_points, outlier_ratio));
+
+        const auto run_ransac = [&](const char *name, auto solver_tag)
+        {
+            using Solver = decltype(solver_tag);
+            double iterations = 0.0, seconds = 0.0;
+            size_t successes = 0;
+            for (size_t k = 0; k < ransac_scenes.size(); ++k)
+            {
+                const Scene &scene = ransac_scenes[k];
+                NativeRansacOptions options;
+                options.threshold = FLAGS_noise > 0.0 ? 8.0 * FLAGS_noise * FLAGS_noise : 1e-10;
+                options.max_iterations = 100000;
+                options.seed = static_cast<uint32_t>(k);
+                options.affine_frames = &scene.frames;
+                NativeRansacResult result;
+                const auto start = std::chrono::steady_clock::now();
+                RunNativeRansac<Solver>(scene.pairs, options, result);
+                seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                iterations += result.iterations;
+                successes += result.success && Eigen::AngleAxisd(result.pose.R.transpose() * scene.R).angle() < 0.01 &&
+                                     result.pose.t.normalized().dot(scene.t) > 0.999
+                                 ? 1
+                                 : 0;
+            }
+            std::printf("%-10.2f %-10s %12.1f %12.3f %10.1f%%\n", outlier_ratio, name,
+                        iterations / ransac_scenes.size(), 1e3 * seconds / ransac_scenes.size(),
+                        100.0 * successes / ransac_scenes.size());
+        };
+        run_ransac("fivept", FivePointSolver());
+        run_ransac("affine2pt", TwoAffineSolver());
+    }
+
+    // Mixed-precision validation: float32 scoring must reproduce the double inlier sets and poses
+    // 混合精度验证：float32评分需复现double的内点集和位姿
+    std::printf("\nScoring precision (%d scenes x %d points, noise=%g, threshold=8 noise^2)\n",
+                FLAGS_ransac_trials, FLAGS_ransac_points, FLAGS_validation_noise);
+    std::printf("%-10s %-10s %12s %12s %10s %10s %10s %6s\n",
+                "outliers", "solver", "double ms", "float ms", "min jacc", "max dR", "max dt", "pass");
+    bool validation_passed = true;
+    for (const double outlier_ratio : {0.3, 0.6, 0.8})
+    {
+        std::vector<Scene> validation_scenes;
+        for (int k = 0; k < FLAGS_ransac_trials; ++k)
+            validation_scenes.push_back(MakeScene(rng, false, FLAGS_ransac_points, outlier_ratio, FLAGS_validation_noise));
+
+        const auto validate = [&](const char *name, auto solver_tag)
+        {
+            using Solver = decltype(solver_tag);
+            double seconds[2] = {0.0, 0.0};
+            double min_jaccard = 1.0, max_rotation = 0.0, max_translation = 0.0;
+            bool passed = true;
+            for (size_t k = 0; k < validation_scenes.size(); ++k)
+            {
+                const Scene &scene = validation_scenes[k];
+                NativeRansacOptions options;
+                options.threshold = 8.0 * FLAGS_validation_noise * FLAGS_validation_noise;
+                options.max_iterations = 20000;
+                options.seed = static_cast<uint32_t>(k);
+                options.affine_frames = &scene.frames;
+
+                NativeRansacResult results[2];
+                const ScoringPrecision precisions[2] = {ScoringPrecision::Double, ScoringPrecision::Float};
+                for (int p = 0; p < 2; ++p)
+                {
+                    options.scoring_precision = precisions[p];
+                    const auto start = std::chrono::steady_clock::now();
+                    RunNativeRansac<Solver>(scene.pairs, options, results[p]);
+                    seconds[p] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                }
+                const NativeRansacAgreement agreement = CompareNativeRansacResults(results[0], results[1]);
+                min_jaccard = std::min(min_jaccard, agreement.inlier_jaccard);
+                max_rotation = std::max(max_rotation, agreement.rotation_deg);
+                max_translation = std::max(max_translation, agreement.translation_deg);
+                passed = passed && agreement.WithinTolerance(FLAGS_validation_min_jaccard, FLAGS_validation_max_angle);
+            }
+            validation_passed = validation_passed && passed;
+            std::printf("%-10.2f %-10s %12.3f %12.3f %10.4f %10.4f %10.4f %6s\n", outlier_ratio, name,
+                        1e3 * seconds[0] / validation_scenes.size(), 1e3 * seconds[1] / validation_scenes.size(),
+                        min_jaccard, max_rotation, max_translation, passed ? "yes" : "NO");
+        };
+        validate("fivept", FivePointSolver());
+        validate("eightpt", EightPointSolver());
+        validate("affine2pt", TwoAffineSolver());
+    }
+
+    return validation_passed ? 0 : 2;
+}